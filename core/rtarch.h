@@ -27,8 +27,13 @@
  * and rtarch_***_***.h for SIMD instructions.
  *
  * At present, Intel SSE2 (32-bit x86 ISA) and ARM NEON (32-bit ARMv7 ISA)
- * are two primary targets, although wider SIMD, 64-bit addressing along with
- * more available registers, and other architectures can be supported by design.
+ * are two primary targets, AArch64 NEON (64-bit ARMv8 ISA) is supported with
+ * 64-bit addressing, x32 ABI SSE (x86_64 with 32-bit pointers) is supported
+ * with 16 core/SIMD registers, although wider SIMD, more available registers,
+ * and other architectures can be supported by design.
+ * Reference target (RT_REF) implements the same API as plain C statements
+ * on an emulated register file, it runs on any host and is used as a semantic
+ * oracle for the native targets.
  *
  * Preliminary naming scheme for potential future targets.
  *
@@ -37,18 +42,24 @@
  *  - rtarch_arm_mpe.h     - 32-bit ARMv7 ISA, 16 SIMD registers, 8 + temps used
  *  - rtarch_x86.h         - 32-bit x86 ISA, 8 core registers, 6 + esp, ebp used
  *  - rtarch_x86_sse.h     - 32-bit x86 ISA, 8 SIMD registers, 8 used
+ *  - rtarch_x32.h         - 32-bit x32 ABI, 16 core registers, 14 + esp, ebp
+ *  - rtarch_x32_128.h     - 32-bit x32 ABI, 16 SIMD registers, SSE 128-bit
  *
  * Future 32-bit targets:
  *  - rtarch_a32.h         - 32-bit ARMv8 ISA, 16 core registers, new features
  *  - rtarch_a32_128.h     - 32-bit ARMv8 ISA, 16 SIMD registers, new features
- *  - rtarch_x32.h         - 32-bit x32 ABI, 16 core registers, 32-bit pointers
- *  - rtarch_x32_128.h     - 32-bit x32 ABI, 16 SIMD registers, SSE 128-bit
  *  - rtarch_x32_256.h     - 32-bit x32 ABI, 16 SIMD registers, AVX 256-bit
  *  - rtarch_x32_512.h     - 32-bit x32 ABI, 32 SIMD registers, AVX 512-bit
  *
+ * Current 64-bit targets:
+ *  - rtarch_a64.h         - 64-bit ARMv8 ISA, 32 core registers, 8 + temps used
+ *  - rtarch_a64_128.h     - 64-bit ARMv8 ISA, 32 SIMD registers, 16 + temps
+ *
+ * Reference target (portable C, any host with GCC-compatible compiler):
+ *  - rtarch_ref.h         - C statements, 15 core registers, host-sized ptrs
+ *  - rtarch_ref_128.h     - C statements, 16 SIMD registers, 128-bit
+ *
  * Future 64-bit targets:
- *  - rtarch_a64.h         - 64-bit ARMv8 ISA, 32 core registers, new features
- *  - rtarch_a64_128.h     - 64-bit ARMv8 ISA, 32 SIMD registers, new features
  *  - rtarch_x64.h         - 64-bit x64 ABI, 16 core registers, 64-bit pointers
  *  - rtarch_x64_128.h     - 64-bit x64 ABI, 16 SIMD registers, SSE 128-bit
  *  - rtarch_x64_256.h     - 64-bit x64 ABI, 16 SIMD registers, AVX 256-bit
@@ -80,12 +91,82 @@
  *  - Reax, ... , Redi, Reg8, Reg9, RegA, ... , RegV
  *  - Xmm0, ... , Xmm7, Xmm8, Xmm9, XmmA, ... , XmmV
  *
+ * Number of SIMD registers exposed by the chosen target is RT_SIMD_REGS
+ * (8 or 16 for now), kernels can use Xmm8..XmmF when it is 16 or more.
+ * Number of core registers is RT_CORE_REGS (8 or 15 for now, RegF is
+ * reserved as temp), kernels can use Reg8..RegE when it is 15 or more.
+ *
+ * Masked moves and gathers/scatters share one aliasing contract on all
+ * targets: loads (mmvpx_ld, gatpx_ld) may have RG the same as RK/RI,
+ * while stores (mmvpx_st, scapx_st) must not have RG the same as RK/RI,
+ * as some targets rotate both registers lane by lane while storing.
+ *
  * While register names are fixed, register sizes are not and depend on the
  * chosen target (only 32-bit core and 128-bit SIMD are implemented for now).
  * Core registers can be 32-bit/64-bit wide, while their SIMD counterparts
  * depend on the architecture and SIMD version chosen for the target.
  * Fractional sub-registers don't have names and aren't architecturally
  * visible in the assembler as it would complicate SPMD programming model.
+ * Packed 8-bit/16-bit elements are accessible only through the dedicated
+ * cmdpb_**, cmdph_** instructions intended for pixel/image processing.
+ */
+
+/******************************************************************************/
+/********************************   FEATURES   ********************************/
+/******************************************************************************/
+
+/*
+ * Optional hardware features are selected at build time by defining
+ * corresponding flags to 1 in the compiler command line, default is 0
+ * unless the feature is part of the target's baseline ISA.
+ *
+ * RT_SIMD_FP16 - native fp16 conversions in cvhps_ld, cvpsh_st instructions
+ *                (F16C in x86, NEON half-precision extension in ARM),
+ *                bit-manipulation fallback is used otherwise,
+ *                default is 1 in AArch64 as conversions are in baseline,
+ *                default is 1 in reference target (exact C conversions).
+ */
+#ifndef RT_SIMD_FP16
+#if   defined (RT_A64) || defined (RT_REF)
+#define RT_SIMD_FP16        1
+#else  /* RT_X86, RT_X32, RT_ARM */
+#define RT_SIMD_FP16        0
+#endif /* RT_A64, RT_REF */
+#endif /* RT_SIMD_FP16 */
+
+/*
+ * RT_SIMD_PREC - precision level of divps_**, sqrps_** instructions in targets
+ *                where these are emulated (ARMv7 NEON), other targets always
+ *                produce IEEE results with native instructions,
+ *                RT_SIMD_PREC_FAST - estimate with 1 Newton-Raphson step,
+ *                RT_SIMD_PREC_NORM - estimate with 2 Newton-Raphson steps,
+ *                RT_SIMD_PREC_FULL - VFP scalar fallback per element,
+ *                default is RT_SIMD_PREC_NORM.
+ */
+#define RT_SIMD_PREC_FAST   1
+#define RT_SIMD_PREC_NORM   2
+#define RT_SIMD_PREC_FULL   3
+
+#ifndef RT_SIMD_PREC
+#define RT_SIMD_PREC        RT_SIMD_PREC_NORM
+#endif /* RT_SIMD_PREC */
+
+/*
+ * RT_ARM_IDIV  - native sdiv/udiv in divx*_xm, remx*_xm instructions
+ *                (IDIV extension in ARMv7 cores starting with Cortex-A7/A15),
+ *                exact VFP double-precision fallback is used otherwise,
+ *                which destroys Xmm0, AArch64 always has native division.
+ */
+#ifndef RT_ARM_IDIV
+#define RT_ARM_IDIV         0
+#endif /* RT_ARM_IDIV */
+
+/*
+ * RT_COUNT     - static counting build (GCC only), asm blocks are not emitted,
+ *                their assembly text is passed to rt_count_asm(name, text)
+ *                instead, which is provided by the application (simd_test),
+ *                so that instructions and bytes of kernels in any native target
+ *                can be tallied on any host without running them.
  */
 
 /******************************************************************************/
@@ -116,7 +197,7 @@
                             {                                               \
                                 stack_sa()                                  \
                                 label_ld(info)                              \
-                                movxx_ld(Rebp, Oeax, PLAIN)
+                                movxa_ld(Rebp, Oeax, PLAIN)
 #define ASM_LEAVE(info)         stack_la()                                  \
                             }
 
@@ -151,13 +232,46 @@
 #define ASM_ENTER(info)     asm volatile                                    \
                             (                                               \
                                 stack_sa()                                  \
-                                movxx_ld(Rebp, Oeax, PLAIN)
+                                movxa_ld(Rebp, Oeax, PLAIN)
 #define ASM_LEAVE(info)         stack_la()                                  \
                                 :                                           \
                                 : "a" (&info)                               \
                                 : "cc",  "memory"                           \
                             );
 
+/* ---------------------------------   X32   -------------------------------- */
+
+#elif defined (RT_X32)
+
+#define ASM_OP0(op)             #op
+#define ASM_OP1(op, p1)         #op"  "#p1
+#define ASM_OP2(op, p1, p2)     #op"  "#p2", "#p1
+
+#define ASM_BEG /*internal*/    ""
+#define ASM_END /*internal*/    "\n"
+
+#define EMITB(b)                ASM_BEG ASM_OP1(.byte, b) ASM_END
+#define label_ld(lb)/*Reax*/    ASM_BEG ASM_OP2(leal, %%eax, lb(%%rip)) ASM_END
+
+#define ASM_IF(c) /*internal*/  ASM_BEG ASM_OP1(.if, c) ASM_END
+#define ASM_FI    /*internal*/  ASM_BEG ASM_OP0(.endif) ASM_END
+
+#include "rtarch_x32_128.h"
+
+#define ASM_ENTER(info)     asm volatile                                    \
+                            (                                               \
+                                stack_sa()                                  \
+                                movxa_ld(Rebp, Oeax, PLAIN)
+#define ASM_LEAVE(info)         stack_la()                                  \
+                                :                                           \
+                                : "a" (&info)                               \
+                                : "cc",  "memory",                          \
+                                  "xmm0",  "xmm1",  "xmm2",  "xmm3",        \
+                                  "xmm4",  "xmm5",  "xmm6",  "xmm7",        \
+                                  "xmm8",  "xmm9",  "xmm10", "xmm11",       \
+                                  "xmm12", "xmm13", "xmm14", "xmm15"        \
+                            );
+
 /* ---------------------------------   ARM   -------------------------------- */
 
 #elif defined (RT_ARM)
@@ -172,13 +286,16 @@
 #define EMITB(b)                ASM_BEG ASM_OP1(.byte, b) ASM_END
 #define label_ld(lb)/*Reax*/    ASM_BEG ASM_OP2(adr, r0, lb) ASM_END
 
+#define ASM_IF(c) /*internal*/  ASM_BEG ASM_OP1(.if, c) ASM_END
+#define ASM_FI    /*internal*/  ASM_BEG ASM_OP0(.endif) ASM_END
+
 #include "rtarch_arm_mpe.h"
 
 #define ASM_ENTER(info)     asm volatile                                    \
                             (                                               \
                                 stack_sa()                                  \
                                 ASM_BEG ASM_OP2(mov, r0, %[info]) ASM_END   \
-                                movxx_ld(Rebp, Oeax, PLAIN)
+                                movxa_ld(Rebp, Oeax, PLAIN)
 #define ASM_LEAVE(info)         stack_la()                                  \
                                 :                                           \
                                 : [info] "r" (&info)                        \
@@ -191,7 +308,81 @@
                                   "d20", "d21"                              \
                             );
 
-#endif /* RT_X86, RT_ARM */
+/* ---------------------------------   A64   -------------------------------- */
+
+#elif defined (RT_A64)
+
+#define ASM_OP0(op)             #op
+#define ASM_OP1(op, p1)         #op"  "#p1
+#define ASM_OP2(op, p1, p2)     #op"  "#p1", "#p2
+
+#define ASM_BEG /*internal*/    ""
+#define ASM_END /*internal*/    "\n"
+
+#define EMITB(b)                ASM_BEG ASM_OP1(.byte, b) ASM_END
+#define label_ld(lb)/*Reax*/    ASM_BEG ASM_OP2(adr, x0, lb) ASM_END
+
+#define ASM_IF(c) /*internal*/  ASM_BEG ASM_OP1(.if, c) ASM_END
+#define ASM_FI    /*internal*/  ASM_BEG ASM_OP0(.endif) ASM_END
+
+#include "rtarch_a64_128.h"
+
+#define ASM_ENTER(info)     asm volatile                                    \
+                            (                                               \
+                                stack_sa()                                  \
+                                ASM_BEG ASM_OP2(mov, x0, %[info]) ASM_END   \
+                                movxa_ld(Rebp, Oeax, PLAIN)
+#define ASM_LEAVE(info)         stack_la()                                  \
+                                :                                           \
+                                : [info] "r" (&info)                        \
+                                : "cc",  "memory",                          \
+                                  "v0",  "v1",  "v2",  "v3",                \
+                                  "v4",  "v5",  "v6",  "v7",                \
+                                  "v8",  "v9",  "v10", "v11",               \
+                                  "v12", "v13", "v14", "v15",               \
+                                  "v16", "v17", "v18"                       \
+                            );
+
+/* ---------------------------------   REF   -------------------------------- */
+
+#elif defined (RT_REF)
+
+#define label_ld(lb)/*Reax*/    ref.r[0x00] = (rt_full)(rt_addr)&&lb;
+
+#include "rtarch_ref_128.h"
+
+#define ASM_ENTER(info)     {                                               \
+                                rt_REF_REGS ref;                            \
+                                memset(&ref, 0, sizeof(ref));               \
+                                ref.r[0x04] = (rt_full)(rt_addr)            \
+                                        (ref.stk + RT_REF_STACK);           \
+                                stack_sa()                                  \
+                                ref.r[0x00] = (rt_full)(rt_addr)&info;      \
+                                movxa_ld(Rebp, Oeax, PLAIN)
+#define ASM_LEAVE(info)         stack_la()                                  \
+                            }
+
+#endif /* RT_X86, RT_X32, RT_ARM, RT_A64, RT_REF */
+
+/* --------------------------------   COUNT   ------------------------------- */
+
+#if defined (RT_COUNT)
+
+#if defined (RT_REF)
+#error "RT_COUNT is not supported in reference target"
+#endif /* RT_REF */
+
+rt_void rt_count_asm(rt_pstr name, rt_pstr text);
+
+#undef  ASM_ENTER
+#undef  ASM_LEAVE
+
+#define ASM_ENTER(info)     rt_count_asm(__FUNCTION__,                      \
+                                stack_sa()                                  \
+                                movxa_ld(Rebp, Oeax, PLAIN)
+#define ASM_LEAVE(info)         stack_la());
+
+#endif /* RT_COUNT */
 
 #endif /* OS, COMPILER, ARCH */
 
@@ -222,6 +413,15 @@
 #endif /* in case S is defined outside */
 #define S                   RT_SIMD_WIDTH
 
+/*
+ * Short name P for RT_POINTER/32, pointer-size factor.
+ * Not to be used outside backend headers.
+ */
+#ifdef P
+#undef P
+#endif /* in case P is defined outside */
+#define P                   (RT_POINTER/32)
+
 /*
  * Wider SIMD are supported in backend structs (S = 8, 16 were tested).
  */
@@ -265,8 +465,39 @@ struct rt_SIMD_INFO
     rt_word gpc05[S];       /* 0x3F800000 */
 #define inf_GPC05           DP(Q*0x050)
 
-    rt_real pad02[S*10];    /* reserved, do not use! */
-#define inf_PAD02           DP(Q*0x060)
+    /* fp16 conversion constants (fallback) */
+
+    rt_word gpc06[S];       /* 0x7F800000 */
+#define inf_GPC06           DP(Q*0x060)
+
+    rt_word gpc07[S];       /* 0x00007FFF */
+#define inf_GPC07           DP(Q*0x070)
+
+    rt_word gpc08[S];       /* 0x77800000, 2^(+112) */
+#define inf_GPC08           DP(Q*0x080)
+
+    rt_real gpc09[S];       /* +31743.0 */
+#define inf_GPC09           DP(Q*0x090)
+
+    rt_word gpc10[S];       /* 0x08800000, 2^(-110) */
+#define inf_GPC10           DP(Q*0x0A0)
+
+    rt_word gpc11[S];       /* 0x38800000, 2^(-14) */
+#define inf_GPC11           DP(Q*0x0B0)
+
+    rt_word gpc12[S];       /* 0x07800000 */
+#define inf_GPC12           DP(Q*0x0C0)
+
+    rt_word gpc13[S];       /* 0x00007C00 */
+#define inf_GPC13           DP(Q*0x0D0)
+
+    rt_word gpc14[S];       /* 0x00000FFF */
+#define inf_GPC14           DP(Q*0x0E0)
+
+    /* tail mask constants */
+
+    rt_cell gpc15[S];       /* 0, 1, 2, .. S-1 */
+#define inf_GPC15           DP(Q*0x0F0)
 
 };
 
@@ -321,6 +552,8 @@ struct rt_SIMD_INFO
         cbsps_rr(W(RG), W(R1), W(R2), W(RM))                                \
         cbsps_rr(W(RG), W(R1), W(R2), W(RM))
 
+#if !defined (RT_A64) /* AArch64 defines rcpps_rr, rsqps_rr with 2 steps */
+
 /* rcp */
 
 #define rcpps_rr(RG, RM) /* destroys RM */                                  \
@@ -333,6 +566,72 @@ struct rt_SIMD_INFO
         rseps_rr(W(RG), W(RM))                                              \
         rssps_rr(W(RG), W(RM)) /* <- not reusable without extra temp reg */
 
+#endif /* RT_A64 */
+
+/* cvh (fp16 <-> fp32) */
+
+#if RT_SIMD_FP16 == 0
+
+/*
+ * Branchless conversions based on the ideas by Fabian Giesen
+ * and Marat Dukhan (FP16 library), converted to S-way SIMD version.
+ * Fp16 values are kept in the lower 16 bits of 32-bit elements,
+ * fp16 denormals are flushed to zero in ARM (NEON fp32 is FTZ-only).
+ */
+#define cvhps_rr(RG, R1, R2, RM) /* not portable, do not use outside */     \
+        movpx_rr(W(R1), W(RM))   /* destroys R1, R2 (temp regs) */          \
+        andpx_ld(W(R1), Mebp, inf_GPC07) /* exponent & mantissa */          \
+        movpx_rr(W(R2), W(RM))                                              \
+        xorpx_rr(W(R2), W(R1))                                              \
+        shlpx_ri(W(R2), IB(16))  /* sign to fp32 position */                \
+        movpx_rr(W(RG), W(R1))                                              \
+        shlpx_ri(W(RG), IB(13))                                             \
+        mulps_ld(W(RG), Mebp, inf_GPC08) /* rebias exponent */              \
+        cvtpn_rr(W(R1), W(R1))                                              \
+        cgtps_ld(W(R1), Mebp, inf_GPC09) /* inf/nan mask */                 \
+        andpx_ld(W(R1), Mebp, inf_GPC06)                                    \
+        orrpx_rr(W(RG), W(R1))                                              \
+        orrpx_rr(W(RG), W(R2))
+
+#define cvpsh_rr(RG, R1, R2, RM) /* not portable, do not use outside */     \
+        movpx_rr(W(R1), W(RM))   /* destroys R1, R2 (temp regs) */          \
+        andpx_ld(W(R1), Mebp, inf_GPC04) /* abs */                          \
+        movpx_rr(W(R2), W(RM))                                              \
+        shrpx_ri(W(R2), IB(31))                                             \
+        shlpx_ri(W(R2), IB(15))  /* sign to fp16 position */                \
+        movpx_rr(W(RG), W(R1))                                              \
+        cneps_rr(W(RG), W(RG))   /* nan mask */                             \
+        shrpx_ri(W(RG), IB(26))                                             \
+        shlpx_ri(W(RG), IB(9))   /* 0x7E00 for nan */                       \
+        orrpx_rr(W(R2), W(RG))                                              \
+        movpx_rr(W(RG), W(R1))                                              \
+        mulps_ld(W(RG), Mebp, inf_GPC08) /* overflow to inf */              \
+        mulps_ld(W(RG), Mebp, inf_GPC10)                                    \
+        andpx_ld(W(R1), Mebp, inf_GPC06)                                    \
+        maxps_ld(W(R1), Mebp, inf_GPC11) /* denormal threshold */           \
+        addpx_ld(W(R1), Mebp, inf_GPC12)                                    \
+        addps_rr(W(R1), W(RG))   /* round mantissa in current mode */       \
+        movpx_rr(W(RG), W(R1))                                              \
+        shrpx_ri(W(RG), IB(13))                                             \
+        andpx_ld(W(RG), Mebp, inf_GPC13)                                    \
+        andpx_ld(W(R1), Mebp, inf_GPC14)                                    \
+        addpx_rr(W(RG), W(R1))                                              \
+        orrpx_rr(W(RG), W(R2))
+
+#define cvhps_ld(RG, R1, R2, RM, DP) /* destroys R1, R2 (temp regs) */      \
+        movlx_ld(W(RG), W(RM), W(DP))                                       \
+        unlph_rr(W(RG), W(RG))                                              \
+        cvhps_rr(W(RG), W(R1), W(R2), W(RG))
+
+#define cvpsh_st(RG, R1, R2, RM, DP) /* destroys RG, R1, R2 (temp regs) */  \
+        cvpsh_rr(W(RG), W(R1), W(R2), W(RG))                                \
+        shlpx_ri(W(RG), IB(16))                                             \
+        shrpn_ri(W(RG), IB(16))                                             \
+        pckpn_rr(W(RG), W(RG))                                              \
+        movlx_st(W(RG), W(RM), W(DP))
+
+#endif /* RT_SIMD_FP16 */
+
 #endif /* RT_RTARCH_H */
 
 /******************************************************************************/
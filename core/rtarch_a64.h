@@ -0,0 +1,603 @@
+/******************************************************************************/
+/* Copyright (c) 2013-2015 VectorChief (at github, bitbucket, sourceforge)    */
+/* Distributed under the MIT software license, see the accompanying           */
+/* file COPYING or http://www.opensource.org/licenses/mit-license.php         */
+/******************************************************************************/
+
+#ifndef RT_RTARCH_A64_H
+#define RT_RTARCH_A64_H
+
+#define RT_CORE_REGS        15
+
+/******************************************************************************/
+/*********************************   LEGEND   *********************************/
+/******************************************************************************/
+
+/*
+ * rtarch_a64.h: Implementation of AArch64 core instructions.
+ *
+ * This file is a part of the unified SIMD assembler framework (rtarch.h)
+ * designed to be compatible with different processor architectures,
+ * while maintaining strictly defined common API.
+ *
+ * Recommended naming scheme for instructions:
+ *
+ * cmdxx_ri - applies [cmd] to [r]egister from [i]mmediate
+ * cmdxx_mi - applies [cmd] to [m]emory   from [i]mmediate
+ *
+ * cmdxx_rm - applies [cmd] to [r]egister from [m]emory
+ * cmdxx_ld - applies [cmd] as above
+ * cmdxx_mr - applies [cmd] to [m]emory   from [r]egister
+ * cmdxx_st - applies [cmd] as above (arg list as cmdxx_ld)
+ *
+ * cmdxx_rr - applies [cmd] to [r]egister from [r]egister
+ * cmdxx_mm - applies [cmd] to [m]emory   from [m]emory
+ * cmdxx_rr - applies [cmd] to [r]egister (one operand cmd)
+ * cmdxx_mm - applies [cmd] to [m]emory   (one operand cmd)
+ *
+ * cmdxx_rx - applies [cmd] to [r]egister from x-register
+ * cmdxx_mx - applies [cmd] to [m]emory   from x-register
+ * cmdxx_xr - applies [cmd] to x-register from [r]egister
+ * cmdxx_xm - applies [cmd] to x-register from [m]emory
+ *
+ * cmdxx_rl - applies [cmd] to [r]egister from [l]abel
+ * cmdxx_xl - applies [cmd] to x-register from [l]abel
+ * cmdxx_lb - applies [cmd] as above
+ * label_ld - applies [adr] as above
+ *
+ * stack_st - applies [mov] to stack from register (push)
+ * stack_ld - applies [mov] to register from stack (pop)
+ * stack_sa - applies [mov] to stack from all registers
+ * stack_la - applies [mov] to all registers from stack
+ *
+ * cmdx*_** - applies [cmd] to core register/memory/immediate args
+ * cmd*x_** - applies [cmd] to unsigned integer args, [x] - default
+ * cmd*n_** - applies [cmd] to   signed integer args, [n] - negatable
+ * cmd*a_** - applies [cmd] to address-sized args, [a] - address
+ *
+ * Argument x-register is fixed by the implementation.
+ * Some formal definitions are not given below to encourage
+ * use of friendly aliases for better code readability.
+ *
+ * Core registers are 64-bit wide and hold pointers, while data-elements
+ * in memory are 32-bit wide. Thus mov, adr, add, sub, and, orr, not, jmp
+ * operate on full registers (add/sub sign-extend 32-bit operands),
+ * while load/store, shifts, mul, div and cmp operate on lower 32 bits.
+ * Condition flags are only guaranteed after cmpxx_** instructions.
+ * Registers x8 - x14 are available as Reg8 - RegE, x15 - x17 are reserved
+ * as temps, x18 (platform), x19 - x28 (callee-saved), x29 - x31 are unused.
+ */
+
+/******************************************************************************/
+/********************************   INTERNAL   ********************************/
+/******************************************************************************/
+
+/* emitters */
+
+#define EMPTY   ASM_BEG ASM_END
+
+#define EMITW(w) /* little endian */                                        \
+        EMITB((w) >> 0x00 & 0xFF)                                           \
+        EMITB((w) >> 0x08 & 0xFF)                                           \
+        EMITB((w) >> 0x10 & 0xFF)                                           \
+        EMITB((w) >> 0x18 & 0xFF)
+
+/* structural */
+
+#define MRM(reg, ren, rem)                                                  \
+        ((rem) << 16 | (ren) << 5 | (reg))
+
+#define AUX(sib, cdp, cim)  sib  cdp  cim
+
+/* selectors  */
+
+#define REG(reg, mod, sib)  reg
+#define MOD(reg, mod, sib)  mod
+#define SIB(reg, mod, sib)  sib
+
+#define VAL(val, typ, cmd)  val
+#define TYP(val, typ, cmd)  typ
+#define CMD(val, typ, cmd)  cmd
+
+/* registers    REG */
+
+#define TPxx    0x0F                    /* x15 */
+#define TMxx    0x10                    /* x16 */
+#define TIxx    0x11                    /* x17, not used together with TDxx */
+#define TDxx    0x11                    /* x17, not used together with TIxx */
+
+/******************************************************************************/
+/********************************   EXTERNAL   ********************************/
+/******************************************************************************/
+
+/* registers    REG,  MOD,  SIB */
+
+#define Reax    0x00, 0x00, EMPTY       /* x0 */
+#define Recx    0x01, 0x00, EMPTY       /* x1 */
+#define Redx    0x02, 0x00, EMPTY       /* x2 */
+#define Rebx    0x03, 0x00, EMPTY       /* x3 */
+#define Resp    0x04, 0x00, EMPTY       /* x4 */
+#define Rebp    0x05, 0x00, EMPTY       /* x5 */
+#define Resi    0x06, 0x00, EMPTY       /* x6 */
+#define Redi    0x07, 0x00, EMPTY       /* x7 */
+#define Reg8    0x08, 0x00, EMPTY       /* x8 */
+#define Reg9    0x09, 0x00, EMPTY       /* x9 */
+#define RegA    0x0A, 0x00, EMPTY       /* x10 */
+#define RegB    0x0B, 0x00, EMPTY       /* x11 */
+#define RegC    0x0C, 0x00, EMPTY       /* x12 */
+#define RegD    0x0D, 0x00, EMPTY       /* x13 */
+#define RegE    0x0E, 0x00, EMPTY       /* x14 */
+
+/* addressing   REG,  MOD,  SIB */
+
+#define Oeax    0x00, 0x00, EMPTY       /* [x0] */
+
+#define Mecx    0x01, 0x01, EMPTY       /* [x1, DP] */
+#define Medx    0x02, 0x02, EMPTY       /* [x2, DP] */
+#define Mebx    0x03, 0x03, EMPTY       /* [x3, DP] */
+#define Mebp    0x05, 0x05, EMPTY       /* [x5, DP] */
+#define Mesi    0x06, 0x06, EMPTY       /* [x6, DP] */
+#define Medi    0x07, 0x07, EMPTY       /* [x7, DP] */
+#define Meg8    0x08, 0x08, EMPTY       /* [x8, DP] */
+#define Meg9    0x09, 0x09, EMPTY       /* [x9, DP] */
+#define MegA    0x0A, 0x0A, EMPTY       /* [x10, DP] */
+#define MegB    0x0B, 0x0B, EMPTY       /* [x11, DP] */
+#define MegC    0x0C, 0x0C, EMPTY       /* [x12, DP] */
+#define MegD    0x0D, 0x0D, EMPTY       /* [x13, DP] */
+#define MegE    0x0E, 0x0E, EMPTY       /* [x14, DP] */
+
+#define Iecx    0x01, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x01,    0x00))
+#define Iedx    0x02, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x02,    0x00))
+#define Iebx    0x03, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x03,    0x00))
+#define Iebp    0x05, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x05,    0x00))
+#define Iesi    0x06, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x06,    0x00))
+#define Iedi    0x07, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x07,    0x00))
+#define Ieg8    0x08, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x08,    0x00))
+#define Ieg9    0x09, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x09,    0x00))
+#define IegA    0x0A, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x0A,    0x00))
+#define IegB    0x0B, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x0B,    0x00))
+#define IegC    0x0C, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x0C,    0x00))
+#define IegD    0x0D, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x0D,    0x00))
+#define IegE    0x0E, TPxx, EMITW(0x8B000000 | MRM(TPxx,    0x0E,    0x00))
+
+/* immediate    VAL,  TYP,  CMD */
+
+#define IB(im)  (im), MRM(0x00, 0x00, TIxx),    /* drop sign-ext in x86 */  \
+                EMITW(0x52800000 | MRM(TIxx,    0x00,    0x00) |            \
+                     (0x007F & (im)) << 5)
+
+#define IH(im)  (im), MRM(0x00, 0x00, TIxx),                                \
+                EMITW(0x52800000 | MRM(TIxx,    0x00,    0x00) |            \
+                     (0xFFFF & (im)) << 5)
+
+#define IW(im)  (im), MRM(0x00, 0x00, TIxx),   /* sign-ext for addresses */ \
+                EMITW(0x52800000 | MRM(TIxx,    0x00,    0x00) |            \
+                     (0xFFFF & (im)) << 5)                                  \
+                EMITW(0x72A00000 | MRM(TIxx,    0x00,    0x00) |            \
+                     (0xFFFF & (im) >> 16) << 5)                            \
+                EMITW(0x93407C00 | MRM(TIxx,    TIxx,    0x00))
+
+/* displacement VAL,  TYP,  CMD */
+
+#define DP(im)  (im), 0x00000000,                                           \
+                EMPTY
+
+#define DH(im)  (im), MRM(0x00, 0x00, TDxx),  /* only for SIMD instructions */ \
+                EMITW(0x52800000 | MRM(TDxx,    0x00,    0x00) |            \
+                     (0xFFFF & (im)) << 5)
+
+#define DW(im)  (im), MRM(0x00, 0x00, TDxx),  /* only for SIMD instructions */ \
+                EMITW(0x52800000 | MRM(TDxx,    0x00,    0x00) |            \
+                     (0xFFFF & (im)) << 5)                                  \
+                EMITW(0x72A00000 | MRM(TDxx,    0x00,    0x00) |            \
+                     (0xFFFF & (im) >> 16) << 5)
+
+#define PLAIN   DP(0)
+
+/* triplet pass-through wrapper */
+
+#define W(p1, p2, p3)       p1,  p2,  p3
+
+/******************************************************************************/
+/**********************************   A64   ***********************************/
+/******************************************************************************/
+
+/* mov */
+
+#define movxx_ri(RM, IM)     /* one unnecessary op for IB, IH, IW */        \
+        AUX(EMPTY,   EMPTY,   CMD(IM))                                      \
+        EMITW(0xAA0003E0 | MRM(REG(RM), 0x00,    0x00) |                    \
+                           TYP(IM))
+
+#define movxx_mi(RM, DP, IM)                                                \
+        AUX(SIB(RM), EMPTY,   CMD(IM))                                      \
+        EMITW(0xB9000000 | MRM(TIxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+#define movxx_rr(RG, RM)                                                    \
+        EMITW(0xAA0003E0 | MRM(REG(RG), 0x00,    REG(RM)))
+
+#define movxx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(REG(RG), MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+#define movxx_st(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9000000 | MRM(REG(RG), MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+#define movxa_ld(RG, RM, DP) /* address-sized load, DP is 8-byte aligned */ \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xF9400000 | MRM(REG(RG), MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 3) << 10)
+
+#define movxa_st(RG, RM, DP) /* address-sized store, DP is 8-byte aligned */ \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xF9000000 | MRM(REG(RG), MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 3) << 10)
+
+#define adrxx_ld(RG, RM, DP) /* only 12-bit offsets */                      \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0x91000000 | MRM(REG(RG), MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP)) << 10)
+
+#define adrxx_lb(lb) /* load label to Reax */                               \
+        label_ld(lb)
+
+#define stack_st(RM) /* 16-byte steps to keep sp aligned */                 \
+        EMITW(0xF81F0FE0 | MRM(REG(RM), 0x00,    0x00))
+
+#define stack_ld(RM) /* 16-byte steps to keep sp aligned */                 \
+        EMITW(0xF84107E0 | MRM(REG(RM), 0x00,    0x00))
+
+#define stack_sa() /* save all [x0 - x17], 18 regs in total */              \
+        EMITW(0xA9BF07E0)                                                   \
+        EMITW(0xA9BF0FE2)                                                   \
+        EMITW(0xA9BF17E4)                                                   \
+        EMITW(0xA9BF1FE6)                                                   \
+        EMITW(0xA9BF27E8)                                                   \
+        EMITW(0xA9BF2FEA)                                                   \
+        EMITW(0xA9BF37EC)                                                   \
+        EMITW(0xA9BF3FEE)                                                   \
+        EMITW(0xA9BF47F0)
+
+#define stack_la() /* load all [x0 - x17], 18 regs in total */              \
+        EMITW(0xA8C147F0)                                                   \
+        EMITW(0xA8C13FEE)                                                   \
+        EMITW(0xA8C137EC)                                                   \
+        EMITW(0xA8C12FEA)                                                   \
+        EMITW(0xA8C127E8)                                                   \
+        EMITW(0xA8C11FE6)                                                   \
+        EMITW(0xA8C117E4)                                                   \
+        EMITW(0xA8C10FE2)                                                   \
+        EMITW(0xA8C107E0)
+
+/* and */
+
+#define andxx_ri(RM, IM)                                                    \
+        AUX(EMPTY,   EMPTY,   CMD(IM))                                      \
+        EMITW(0xEA000000 | MRM(REG(RM), REG(RM), 0x00) |                    \
+                           TYP(IM))
+
+#define andxx_mi(RM, DP, IM)                                                \
+        AUX(SIB(RM), EMPTY,   CMD(IM))                                      \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xEA000000 | MRM(TMxx,    TMxx,    0x00) |                    \
+                           TYP(IM))                                         \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+#define andxx_rr(RG, RM)                                                    \
+        EMITW(0xEA000000 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define andxx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xEA000000 | MRM(REG(RG), REG(RG), TMxx))
+
+#define andxx_st(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xEA000000 | MRM(TMxx,    TMxx,    REG(RG)))                  \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+/* orr */
+
+#define orrxx_ri(RM, IM)                                                    \
+        AUX(EMPTY,   EMPTY,   CMD(IM))                                      \
+        EMITW(0xAA000000 | MRM(REG(RM), REG(RM), 0x00) |                    \
+                           TYP(IM))
+
+#define orrxx_mi(RM, DP, IM)                                                \
+        AUX(SIB(RM), EMPTY,   CMD(IM))                                      \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xAA000000 | MRM(TMxx,    TMxx,    0x00) |                    \
+                           TYP(IM))                                         \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+#define orrxx_rr(RG, RM)                                                    \
+        EMITW(0xAA000000 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define orrxx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xAA000000 | MRM(REG(RG), REG(RG), TMxx))
+
+#define orrxx_st(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xAA000000 | MRM(TMxx,    TMxx,    REG(RG)))                  \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+/* not */
+
+#define notxx_rr(RM)                                                        \
+        EMITW(0xAA2003E0 | MRM(REG(RM), 0x00,    REG(RM)))
+
+#define notxx_mm(RM, DP)                                                    \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xAA2003E0 | MRM(TMxx,    0x00,    TMxx))                     \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+/* add */
+
+#define addxx_ri(RM, IM)                                                    \
+        AUX(EMPTY,   EMPTY,   CMD(IM))                                      \
+        EMITW(0xAB20C000 | MRM(REG(RM), REG(RM), 0x00) |                    \
+                           TYP(IM))
+
+#define addxx_mi(RM, DP, IM)                                                \
+        AUX(SIB(RM), EMPTY,   CMD(IM))                                      \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xAB20C000 | MRM(TMxx,    TMxx,    0x00) |                    \
+                           TYP(IM))                                         \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+#define addxx_rr(RG, RM)                                                    \
+        EMITW(0xAB20C000 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define addxx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xAB20C000 | MRM(REG(RG), REG(RG), TMxx))
+
+#define addxx_st(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xAB20C000 | MRM(TMxx,    TMxx,    REG(RG)))                  \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+/* sub */
+
+#define subxx_ri(RM, IM)                                                    \
+        AUX(EMPTY,   EMPTY,   CMD(IM))                                      \
+        EMITW(0xEB20C000 | MRM(REG(RM), REG(RM), 0x00) |                    \
+                           TYP(IM))
+
+#define subxx_mi(RM, DP, IM)                                                \
+        AUX(SIB(RM), EMPTY,   CMD(IM))                                      \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xEB20C000 | MRM(TMxx,    TMxx,    0x00) |                    \
+                           TYP(IM))                                         \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+#define subxx_rr(RG, RM)                                                    \
+        EMITW(0xEB20C000 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define subxx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xEB20C000 | MRM(REG(RG), REG(RG), TMxx))
+
+#define subxx_st(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0xEB20C000 | MRM(TMxx,    TMxx,    REG(RG)))                  \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+#define subxx_mr(RM, DP, RG)                                                \
+        subxx_st(W(RG), W(RM), W(DP))
+
+/* shl */
+
+#define shlxx_ri(RM, IM)                                                    \
+        EMITW(0x53000000 | MRM(REG(RM), REG(RM), 0x00) |                    \
+             (0x0000001F & (32 - VAL(IM))) << 16 |                          \
+             (0x0000001F & (31 - VAL(IM))) << 10)
+
+#define shlxx_mi(RM, DP, IM)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x53000000 | MRM(TMxx,    TMxx,    0x00) |                    \
+             (0x0000001F & (32 - VAL(IM))) << 16 |                          \
+             (0x0000001F & (31 - VAL(IM))) << 10)                           \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+/* shr */
+
+#define shrxx_ri(RM, IM)                                                    \
+        EMITW(0x53007C00 | MRM(REG(RM), REG(RM), 0x00) |                    \
+             (0x0000001F & VAL(IM)) << 16)
+
+#define shrxx_mi(RM, DP, IM)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x53007C00 | MRM(TMxx,    TMxx,    0x00) |                    \
+             (0x0000001F & VAL(IM)) << 16)                                  \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+#define shrxn_ri(RM, IM)                                                    \
+        EMITW(0x13007C00 | MRM(REG(RM), REG(RM), 0x00) |                    \
+             (0x0000001F & VAL(IM)) << 16)
+
+#define shrxn_mi(RM, DP, IM)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x13007C00 | MRM(TMxx,    TMxx,    0x00) |                    \
+             (0x0000001F & VAL(IM)) << 16)                                  \
+        EMITW(0xB9000000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)
+
+/* mul */
+
+#define mulxn_ri(RM, IM)                                                    \
+        AUX(EMPTY,   EMPTY,   CMD(IM))                                      \
+        EMITW(0x1B007C00 | MRM(REG(RM), REG(RM), 0x00) |                    \
+                           TYP(IM))
+
+#define mulxn_rr(RG, RM)                                                    \
+        EMITW(0x1B007C00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define mulxn_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x1B007C00 | MRM(REG(RG), REG(RG), TMxx))
+
+#define mulxn_xm(RM, DP) /* Reax is in/out, destroys Redx (in x86) */       \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x1B007C00 | MRM(0x00,    0x00,    TMxx))
+
+/* div */
+
+#define divxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x1AC00800 | MRM(0x00,    0x00,    TMxx))
+
+#define divxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x1AC00C00 | MRM(0x00,    0x00,    TMxx))
+
+/* rem */
+
+#define remxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x1AC00800 | MRM(TIxx,    0x00,    TMxx))                     \
+        EMITW(0x1B008000 | MRM(0x02,    TIxx,    TMxx)) /* rem */           \
+        EMITW(0x2A0003E0 | MRM(0x00,    0x00,    TIxx))
+
+#define remxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x1AC00C00 | MRM(TIxx,    0x00,    TMxx))                     \
+        EMITW(0x1B008000 | MRM(0x02,    TIxx,    TMxx)) /* rem */           \
+        EMITW(0x2A0003E0 | MRM(0x00,    0x00,    TIxx))
+
+/* cmp */
+
+#define cmpxx_ri(RM, IM)                                                    \
+        AUX(EMPTY,   EMPTY,   CMD(IM))                                      \
+        EMITW(0x6B00001F | MRM(0x00,    REG(RM), 0x00) |                    \
+                           TYP(IM))
+
+#define cmpxx_mi(RM, DP, IM)                                                \
+        AUX(SIB(RM), EMPTY,   CMD(IM))                                      \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x6B00001F | MRM(0x00,    TMxx,    0x00) |                    \
+                           TYP(IM))
+
+#define cmpxx_rr(RG, RM)                                                    \
+        EMITW(0x6B00001F | MRM(0x00,    REG(RG), REG(RM)))
+
+#define cmpxx_rm(RG, RM, DP)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x6B00001F | MRM(0x00,    REG(RG), TMxx))
+
+#define cmpxx_mr(RM, DP, RG)                                                \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xB9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 2) << 10)                             \
+        EMITW(0x6B00001F | MRM(0x00,    TMxx,    REG(RG)))
+
+/* jmp */
+
+#define jmpxx_mm(RM, DP) /* address-sized, DP is 8-byte aligned */          \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xF9400000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP) >> 3) << 10)                             \
+        EMITW(0xD61F0000 | MRM(0x00,    TMxx,    0x00))
+
+#define jmpxx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b,    lb) ASM_END
+
+#define jeqxx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b.eq, lb) ASM_END
+
+#define jnexx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b.ne, lb) ASM_END
+
+#define jnzxx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b.ne, lb) ASM_END
+
+#define jltxx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b.lo, lb) ASM_END
+
+#define jlexx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b.ls, lb) ASM_END
+
+#define jgtxx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b.hi, lb) ASM_END
+
+#define jgexx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b.hs, lb) ASM_END
+
+#define jltxn_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b.lt, lb) ASM_END
+
+#define jlexn_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b.le, lb) ASM_END
+
+#define jgtxn_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b.gt, lb) ASM_END
+
+#define jgexn_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(b.ge, lb) ASM_END
+
+#define LBL(lb)                                                             \
+        ASM_BEG ASM_OP0(lb:) ASM_END
+
+#endif /* RT_RTARCH_A64_H */
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
@@ -0,0 +1,965 @@
+/******************************************************************************/
+/* Copyright (c) 2013-2015 VectorChief (at github, bitbucket, sourceforge)    */
+/* Distributed under the MIT software license, see the accompanying           */
+/* file COPYING or http://www.opensource.org/licenses/mit-license.php         */
+/******************************************************************************/
+
+#ifndef RT_RTARCH_A64_128_H
+#define RT_RTARCH_A64_128_H
+
+#include "rtarch_a64.h"
+
+#define RT_SIMD_REGS        16
+#define RT_SIMD_WIDTH       4
+#define RT_SIMD_ALIGN       16
+#define RT_SIMD_SET(s, v)   s[0]=s[1]=s[2]=s[3]=v
+
+#define RT_SIMD_WIDTH64     2
+#define RT_SIMD_SET64(s, v) s[0]=s[1]=v
+
+/******************************************************************************/
+/*********************************   LEGEND   *********************************/
+/******************************************************************************/
+
+/*
+ * rtarch_a64_128.h: Implementation of AArch64 128-bit SIMD instructions.
+ *
+ * This file is a part of the unified SIMD assembler framework (rtarch.h)
+ * designed to be compatible with different processor architectures,
+ * while maintaining strictly defined common API.
+ *
+ * Recommended naming scheme for instructions:
+ *
+ * cmdp*_ri - applies [cmd] to [p]acked: [r]egister from [i]mmediate
+ * cmdp*_rr - applies [cmd] to [p]acked: [r]egister from [r]egister
+ *
+ * cmdp*_rm - applies [cmd] to [p]acked: [r]egister from [m]emory
+ * cmdp*_ld - applies [cmd] to [p]acked: as above
+ * cmdp*_mr - applies [cmd] to [p]acked: [m]emory   from [r]egister
+ * cmdp*_st - applies [cmd] to [p]acked: as above (arg list as cmdxx_ld)
+ *
+ * cmdpx_** - applies [cmd] to [p]acked unsigned integer args, [x] - default
+ * cmdpn_** - applies [cmd] to [p]acked   signed integer args, [n] - negatable
+ * cmdps_** - applies [cmd] to [p]acked floating point   args, [s] - scalable
+ * cmdpd_** - applies [cmd] to [p]acked double precision args, [d] - double
+ *
+ * cmdpb_** - applies [cmd] to [p]acked unsigned  8-bit integer args, [b]yte
+ * cmdph_** - applies [cmd] to [p]acked unsigned 16-bit integer args, [h]alf
+ *
+ * The cmdp*_** instructions are intended for SPMD programming model
+ * and can potentially be configured per target to work with 32-bit/64-bit
+ * data-elements (integers/pointers, floating point).
+ * In this model data paths are fixed-width, core and SIMD data-elements are
+ * width-compatible, code path divergence is handled via CHECK_MASK macro.
+ *
+ * The cmdpb_**, cmdph_** instructions are intended for pixel/image kernels
+ * and work with fixed-width 8-bit/16-bit data-elements regardless of target,
+ * thus a register holds 4*S bytes or 2*S halfwords respectively.
+ *
+ * The cmdpd_** instructions work with 64-bit floating point data-elements,
+ * thus a register holds RT_SIMD_WIDTH64 (S/2) doubles.
+ *
+ * Registers v0 - v15 are available as Xmm0 - XmmF, v16 - v18 are reserved
+ * as temps (Tmm1 - Tmm3), v19 - v31 are left unnamed, as the common API
+ * stops at XmmF in all targets for now (see register legend in rtarch.h).
+ */
+
+/******************************************************************************/
+/********************************   INTERNAL   ********************************/
+/******************************************************************************/
+
+/* structural */
+
+/* SIMD memory operands: DP offsets are encoded in the instruction (MPM)
+ * scaled by the access size given in sh, DH and DW offsets are added
+ * to the base register in TPxx (PRE) which is then used directly */
+
+#define MPM(rg, reg, mod, sib, val, typ, cmd, sh)                           \
+        (MRM(rg, (mod) + (((typ) != 0) & (TPxx - (mod))), 0x00) |           \
+        (0x00000FFF & ((val) & ~((typ) != 0)) >> (sh)) << 10)
+
+#define PRE(reg, mod, sib, val, typ, cmd)                                   \
+        ASM_IF((typ) != 0)                                                  \
+        EMITW(0x8B000000 | MRM(TPxx,    mod,     0x00) | typ)               \
+        ASM_FI
+
+/* registers    REG */
+
+#define Tmm1    0x10                    /* v16 */
+#define Tmm2    0x11                    /* v17 */
+#define Tmm3    0x12                    /* v18 */
+
+/******************************************************************************/
+/********************************   EXTERNAL   ********************************/
+/******************************************************************************/
+
+/* registers    REG,  MOD,  SIB */
+
+#define Xmm0    0x00, 0x00, EMPTY       /* v0 */
+#define Xmm1    0x01, 0x00, EMPTY       /* v1 */
+#define Xmm2    0x02, 0x00, EMPTY       /* v2 */
+#define Xmm3    0x03, 0x00, EMPTY       /* v3 */
+#define Xmm4    0x04, 0x00, EMPTY       /* v4 */
+#define Xmm5    0x05, 0x00, EMPTY       /* v5 */
+#define Xmm6    0x06, 0x00, EMPTY       /* v6 */
+#define Xmm7    0x07, 0x00, EMPTY       /* v7 */
+#define Xmm8    0x08, 0x00, EMPTY       /* v8 */
+#define Xmm9    0x09, 0x00, EMPTY       /* v9 */
+#define XmmA    0x0A, 0x00, EMPTY       /* v10 */
+#define XmmB    0x0B, 0x00, EMPTY       /* v11 */
+#define XmmC    0x0C, 0x00, EMPTY       /* v12 */
+#define XmmD    0x0D, 0x00, EMPTY       /* v13 */
+#define XmmE    0x0E, 0x00, EMPTY       /* v14 */
+#define XmmF    0x0F, 0x00, EMPTY       /* v15 */
+
+/******************************************************************************/
+/**********************************   A64   ***********************************/
+/******************************************************************************/
+
+/**************************   packed generic (NEON)   *************************/
+
+/* mov */
+
+#define movpx_rr(RG, RM)                                                    \
+        EMITW(0x4EA01C00 | MRM(REG(RG), REG(RM), REG(RM)))
+
+#define movpx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(REG(RG), RM, DP, 4))
+
+#define movpx_st(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3D800000 | MPM(REG(RG), RM, DP, 4))
+
+#define adrpx_ld(RG, RM, DP) /* RG is a core reg, DP is SIMD-aligned */     \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x91000000 | MPM(REG(RG), RM, DP, 0))
+
+#define movlx_ld(RG, RM, DP) /* lower half from memory, upper zeroed */     \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xFD400000 | MPM(REG(RG), RM, DP, 3))
+
+#define movlx_st(RG, RM, DP) /* lower half to memory */                     \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xFD000000 | MPM(REG(RG), RM, DP, 3))
+
+#define movux_ld(RG, RM, DP) /* full vector from unaligned memory */        \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(REG(RG), RM, DP, 4))
+
+#define movnx_st(RG, RM, DP) /* regular store, STNP has pair form only */   \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3D800000 | MPM(REG(RG), RM, DP, 4))
+
+#define prfxx_ld(RM, DP) /* prefetch cache line into all levels */          \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF9800000 | MPM(0x00,    RM, DP, 3))
+
+#define fence_st() /* orders preceding non-temporal stores */               \
+        EMITW(0xD5033ABF)
+
+/* and */
+
+#define andpx_rr(RG, RM)                                                    \
+        EMITW(0x4E201C00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define andpx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E201C00 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* ann */
+
+#define annpx_rr(RG, RM)                                                    \
+        EMITW(0x4E601C00 | MRM(REG(RG), REG(RM), REG(RG)))
+
+#define annpx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E601C00 | MRM(REG(RG), Tmm1,    REG(RG)))
+
+/* orr */
+
+#define orrpx_rr(RG, RM)                                                    \
+        EMITW(0x4EA01C00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define orrpx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4EA01C00 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* xor */
+
+#define xorpx_rr(RG, RM)                                                    \
+        EMITW(0x6E201C00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define xorpx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E201C00 | MRM(REG(RG), REG(RG), Tmm1))
+
+/**************   packed single precision floating point (NEON)   *************/
+
+/* add */
+
+#define addps_rr(RG, RM)                                                    \
+        EMITW(0x4E20D400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define addps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E20D400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* sub */
+
+#define subps_rr(RG, RM)                                                    \
+        EMITW(0x4EA0D400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define subps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4EA0D400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* mul */
+
+#define mulps_rr(RG, RM)                                                    \
+        EMITW(0x6E20DC00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define mulps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E20DC00 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* div */
+
+#define divps_rr(RG, RM)                                                    \
+        EMITW(0x6E20FC00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define divps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E20FC00 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* sqr */
+
+#define sqrps_rr(RG, RM)                                                    \
+        EMITW(0x6EA1F800 | MRM(REG(RG), REG(RM), 0x00))
+
+#define sqrps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6EA1F800 | MRM(REG(RG), Tmm1,    0x00))
+
+/* cbr */
+
+        /* cbe, cbs, cbr defined in rtarch.h
+         * under "COMMON SIMD INSTRUCTIONS" section */
+
+/* rcp */
+
+#define rceps_rr(RG, RM)                                                    \
+        EMITW(0x4EA1D800 | MRM(REG(RG), REG(RM), 0x00))
+
+#define rcsps_rr(RG, RM) /* destroys RM */                                  \
+        EMITW(0x4E20FC00 | MRM(REG(RM), REG(RM), REG(RG)))                  \
+        EMITW(0x6E20DC00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define rcpps_rr(RG, RM) /* destroys RM */                                  \
+        EMITW(0x4EA1D800 | MRM(REG(RG), REG(RM), 0x00))                     \
+        EMITW(0x4E20FC00 | MRM(Tmm1,    REG(RM), REG(RG)))                  \
+        EMITW(0x6E20DC00 | MRM(REG(RG), REG(RG), Tmm1))                     \
+        EMITW(0x4E20FC00 | MRM(REG(RM), REG(RM), REG(RG)))                  \
+        EMITW(0x6E20DC00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+        /* 8-bit estimate takes 2 N-R steps to reach x86 accuracy,
+         * so rcpps_rr is not taken from rtarch.h common section */
+
+/* rsq */
+
+#define rseps_rr(RG, RM)                                                    \
+        EMITW(0x6EA1D800 | MRM(REG(RG), REG(RM), 0x00))
+
+#define rssps_rr(RG, RM) /* destroys RM */                                  \
+        EMITW(0x6E20DC00 | MRM(REG(RM), REG(RM), REG(RG)))                  \
+        EMITW(0x4EA0FC00 | MRM(REG(RM), REG(RM), REG(RG)))                  \
+        EMITW(0x6E20DC00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define rsqps_rr(RG, RM) /* destroys RM */                                  \
+        EMITW(0x6EA1D800 | MRM(REG(RG), REG(RM), 0x00))                     \
+        EMITW(0x6E20DC00 | MRM(Tmm1,    REG(RM), REG(RG)))                  \
+        EMITW(0x4EA0FC00 | MRM(Tmm1,    Tmm1,    REG(RG)))                  \
+        EMITW(0x6E20DC00 | MRM(REG(RG), REG(RG), Tmm1))                     \
+        EMITW(0x6E20DC00 | MRM(REG(RM), REG(RM), REG(RG)))                  \
+        EMITW(0x4EA0FC00 | MRM(REG(RM), REG(RM), REG(RG)))                  \
+        EMITW(0x6E20DC00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+        /* 8-bit estimate takes 2 N-R steps to reach x86 accuracy,
+         * so rsqps_rr is not taken from rtarch.h common section */
+
+/* min */
+
+#define minps_rr(RG, RM)                                                    \
+        EMITW(0x4EA0F400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define minps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4EA0F400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* max */
+
+#define maxps_rr(RG, RM)                                                    \
+        EMITW(0x4E20F400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define maxps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E20F400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* cmp */
+
+#define ceqps_rr(RG, RM)                                                    \
+        EMITW(0x4E20E400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define ceqps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E20E400 | MRM(REG(RG), REG(RG), Tmm1))
+
+#define cneps_rr(RG, RM)                                                    \
+        EMITW(0x4E20E400 | MRM(REG(RG), REG(RG), REG(RM)))                  \
+        EMITW(0x6E205800 | MRM(REG(RG), REG(RG), 0x00))
+
+#define cneps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E20E400 | MRM(REG(RG), REG(RG), Tmm1))                     \
+        EMITW(0x6E205800 | MRM(REG(RG), REG(RG), 0x00))
+
+#define cltps_rr(RG, RM)                                                    \
+        EMITW(0x6EA0E400 | MRM(REG(RG), REG(RM), REG(RG)))
+
+#define cltps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6EA0E400 | MRM(REG(RG), Tmm1,    REG(RG)))
+
+#define cleps_rr(RG, RM)                                                    \
+        EMITW(0x6E20E400 | MRM(REG(RG), REG(RM), REG(RG)))
+
+#define cleps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E20E400 | MRM(REG(RG), Tmm1,    REG(RG)))
+
+#define cgtps_rr(RG, RM)                                                    \
+        EMITW(0x6EA0E400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define cgtps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6EA0E400 | MRM(REG(RG), REG(RG), Tmm1))
+
+#define cgeps_rr(RG, RM)                                                    \
+        EMITW(0x6E20E400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define cgeps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E20E400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/**************   packed double precision floating point (NEON)   *************/
+
+/* add */
+
+#define addpd_rr(RG, RM)                                                    \
+        EMITW(0x4E60D400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define addpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E60D400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* sub */
+
+#define subpd_rr(RG, RM)                                                    \
+        EMITW(0x4EE0D400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define subpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4EE0D400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* mul */
+
+#define mulpd_rr(RG, RM)                                                    \
+        EMITW(0x6E60DC00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define mulpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E60DC00 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* div */
+
+#define divpd_rr(RG, RM)                                                    \
+        EMITW(0x6E60FC00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define divpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E60FC00 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* sqr */
+
+#define sqrpd_rr(RG, RM)                                                    \
+        EMITW(0x6EE1F800 | MRM(REG(RG), REG(RM), 0x00))
+
+#define sqrpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6EE1F800 | MRM(REG(RG), Tmm1,    0x00))
+
+/* min */
+
+#define minpd_rr(RG, RM)                                                    \
+        EMITW(0x4EE0F400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define minpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4EE0F400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* max */
+
+#define maxpd_rr(RG, RM)                                                    \
+        EMITW(0x4E60F400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define maxpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E60F400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* cmp */
+
+#define ceqpd_rr(RG, RM)                                                    \
+        EMITW(0x4E60E400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define ceqpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E60E400 | MRM(REG(RG), REG(RG), Tmm1))
+
+#define cnepd_rr(RG, RM)                                                    \
+        EMITW(0x4E60E400 | MRM(REG(RG), REG(RG), REG(RM)))                  \
+        EMITW(0x6E205800 | MRM(REG(RG), REG(RG), 0x00))
+
+#define cnepd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E60E400 | MRM(REG(RG), REG(RG), Tmm1))                     \
+        EMITW(0x6E205800 | MRM(REG(RG), REG(RG), 0x00))
+
+#define cltpd_rr(RG, RM)                                                    \
+        EMITW(0x6EE0E400 | MRM(REG(RG), REG(RM), REG(RG)))
+
+#define cltpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6EE0E400 | MRM(REG(RG), Tmm1,    REG(RG)))
+
+#define clepd_rr(RG, RM)                                                    \
+        EMITW(0x6E60E400 | MRM(REG(RG), REG(RM), REG(RG)))
+
+#define clepd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E60E400 | MRM(REG(RG), Tmm1,    REG(RG)))
+
+#define cgtpd_rr(RG, RM)                                                    \
+        EMITW(0x6EE0E400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define cgtpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6EE0E400 | MRM(REG(RG), REG(RG), Tmm1))
+
+#define cgepd_rr(RG, RM)                                                    \
+        EMITW(0x6E60E400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define cgepd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E60E400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* cvt (fp32 <-> fp64) */
+
+#define cvtsd_rr(RG, RM) /* lower S/2 fp32 elements to fp64 */              \
+        EMITW(0x0E617800 | MRM(REG(RG), REG(RM), 0x00))
+
+#define cvtds_rr(RG, RM) /* fp64 elements to lower S/2 fp32, zero upper */  \
+        EMITW(0x0E616800 | MRM(REG(RG), REG(RM), 0x00))
+
+/**************************   packed integer (NEON)   *************************/
+
+/* cvt */
+
+#define cvtps_rr(RG, RM) /* round in current mode, then convert */          \
+        EMITW(0x6EA19800 | MRM(REG(RG), REG(RM), 0x00))                     \
+        EMITW(0x4EA1B800 | MRM(REG(RG), REG(RG), 0x00))
+
+#define cvtps_ld(RG, RM, DP) /* round in current mode, then convert */      \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(REG(RG), RM, DP, 4))                         \
+        EMITW(0x6EA19800 | MRM(REG(RG), REG(RG), 0x00))                     \
+        EMITW(0x4EA1B800 | MRM(REG(RG), REG(RG), 0x00))
+
+#define cvtpn_rr(RG, RM)                                                    \
+        EMITW(0x4E21D800 | MRM(REG(RG), REG(RM), 0x00))
+
+#define cvtpn_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E21D800 | MRM(REG(RG), Tmm1,    0x00))
+
+/* add */
+
+#define addpx_rr(RG, RM)                                                    \
+        EMITW(0x4EA08400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define addpx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4EA08400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* sub */
+
+#define subpx_rr(RG, RM)                                                    \
+        EMITW(0x6EA08400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define subpx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6EA08400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* shl */
+
+#define shlpx_ri(RM, IM)                                                    \
+        EMITW(0x4F205400 | MRM(REG(RM), REG(RM), 0x00) |                    \
+             (0x0000001F & VAL(IM)) << 16)
+
+#define shlpx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xBD400000 | MPM(Tmm1,    RM, DP, 2))                         \
+        EMITW(0x4E040400 | MRM(Tmm1,    Tmm1,    0x00))                     \
+        EMITW(0x6EA04400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* shr */
+
+#define shrpx_ri(RM, IM) /* emits nothing for shifts by zero */             \
+        ASM_IF((VAL(IM)) != 0)                                              \
+        EMITW(0x6F200400 | MRM(REG(RM), REG(RM), 0x00) |                    \
+             (0x0000001F & (32 - VAL(IM))) << 16)                           \
+        ASM_FI
+
+#define shrpx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xBD400000 | MPM(Tmm1,    RM, DP, 2))                         \
+        EMITW(0x4E040400 | MRM(Tmm1,    Tmm1,    0x00))                     \
+        EMITW(0x6EA0B800 | MRM(Tmm1,    Tmm1,    0x00))                     \
+        EMITW(0x6EA04400 | MRM(REG(RG), REG(RG), Tmm1))
+
+#define shrpn_ri(RM, IM) /* emits nothing for shifts by zero */             \
+        ASM_IF((VAL(IM)) != 0)                                              \
+        EMITW(0x4F200400 | MRM(REG(RM), REG(RM), 0x00) |                    \
+             (0x0000001F & (32 - VAL(IM))) << 16)                           \
+        ASM_FI
+
+#define shrpn_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xBD400000 | MPM(Tmm1,    RM, DP, 2))                         \
+        EMITW(0x4E040400 | MRM(Tmm1,    Tmm1,    0x00))                     \
+        EMITW(0x6EA0B800 | MRM(Tmm1,    Tmm1,    0x00))                     \
+        EMITW(0x4EA04400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* cgt (signed) */
+
+#define cgtpn_rr(RG, RM)                                                    \
+        EMITW(0x4EA03400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define cgtpn_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4EA03400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/**********************   packed byte/half integer (NEON)   *******************/
+
+/* add */
+
+#define addpb_rr(RG, RM)                                                    \
+        EMITW(0x4E208400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define addpb_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E208400 | MRM(REG(RG), REG(RG), Tmm1))
+
+#define addph_rr(RG, RM)                                                    \
+        EMITW(0x4E608400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define addph_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x4E608400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* ads (add with unsigned saturation) */
+
+#define adspb_rr(RG, RM)                                                    \
+        EMITW(0x6E200C00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define adspb_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E200C00 | MRM(REG(RG), REG(RG), Tmm1))
+
+#define adsph_rr(RG, RM)                                                    \
+        EMITW(0x6E600C00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define adsph_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E600C00 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* sub */
+
+#define subpb_rr(RG, RM)                                                    \
+        EMITW(0x6E208400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define subpb_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E208400 | MRM(REG(RG), REG(RG), Tmm1))
+
+#define subph_rr(RG, RM)                                                    \
+        EMITW(0x6E608400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define subph_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E608400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* sbs (sub with unsigned saturation) */
+
+#define sbspb_rr(RG, RM)                                                    \
+        EMITW(0x6E202C00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define sbspb_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E202C00 | MRM(REG(RG), REG(RG), Tmm1))
+
+#define sbsph_rr(RG, RM)                                                    \
+        EMITW(0x6E602C00 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define sbsph_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E602C00 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* avg (rounded average, (a + b + 1) >> 1) */
+
+#define avgpb_rr(RG, RM)                                                    \
+        EMITW(0x6E201400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define avgpb_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E201400 | MRM(REG(RG), REG(RG), Tmm1))
+
+#define avgph_rr(RG, RM)                                                    \
+        EMITW(0x6E601400 | MRM(REG(RG), REG(RG), REG(RM)))
+
+#define avgph_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x3DC00000 | MPM(Tmm1,    RM, DP, 4))                         \
+        EMITW(0x6E601400 | MRM(REG(RG), REG(RG), Tmm1))
+
+/* unl, unh (widen lower/upper half with zero-extension) */
+
+#define unlpb_rr(RG, RM) /* bytes to halves */                              \
+        EMITW(0x2F08A400 | MRM(REG(RG), REG(RM), 0x00))
+
+#define unhpb_rr(RG, RM) /* bytes to halves */                              \
+        EMITW(0x6F08A400 | MRM(REG(RG), REG(RM), 0x00))
+
+#define unlph_rr(RG, RM) /* halves to words */                              \
+        EMITW(0x2F10A400 | MRM(REG(RG), REG(RM), 0x00))
+
+#define unhph_rr(RG, RM) /* halves to words */                              \
+        EMITW(0x6F10A400 | MRM(REG(RG), REG(RM), 0x00))
+
+/* pck (narrow RG into lower half, RM into upper half with saturation) */
+
+#define pckph_rr(RG, RM) /* signed halves to unsigned bytes */              \
+        EMITW(0x2E212800 | MRM(Tmm1,    REG(RG), 0x00))                     \
+        EMITW(0x6E212800 | MRM(Tmm1,    REG(RM), 0x00))                     \
+        EMITW(0x4EA01C00 | MRM(REG(RG), Tmm1,    Tmm1))
+
+#define pckpn_rr(RG, RM) /* signed words to signed halves */                \
+        EMITW(0x0E614800 | MRM(Tmm1,    REG(RG), 0x00))                     \
+        EMITW(0x4E614800 | MRM(Tmm1,    REG(RM), 0x00))                     \
+        EMITW(0x4EA01C00 | MRM(REG(RG), Tmm1,    Tmm1))
+
+/**********************   lane shift/broadcast (NEON)   ***********************/
+
+/*
+ * Lane shifts move 32-bit elements of RM up (towards higher lanes, sln)
+ * or down (srn) by IM lanes (1..S-1), vacated lanes are zeroed.
+ * Broadcasts copy element IM (0..S-1) of RM (splpx_ri) or 32-bit element
+ * at [RM + DP] (splpx_ld, DP is not required to be SIMD-aligned)
+ * to all lanes.
+ */
+
+/* sln */
+
+#define slnpx_ri(RM, IM) /* zero from Tmm1, lanes via ext */                \
+        EMITW(0x6E201C00 | MRM(Tmm1,    Tmm1,    Tmm1))                     \
+        EMITW(0x6E000000 | MRM(REG(RM), Tmm1,    REG(RM)) |                 \
+             (0x0000000F & (16 - VAL(IM) * 4)) << 11)
+
+/* srn */
+
+#define srnpx_ri(RM, IM) /* zero from Tmm1, lanes via ext */                \
+        EMITW(0x6E201C00 | MRM(Tmm1,    Tmm1,    Tmm1))                     \
+        EMITW(0x6E000000 | MRM(REG(RM), REG(RM), Tmm1) |                    \
+             (0x0000000F & (VAL(IM) * 4)) << 11)
+
+/* spl */
+
+#define splpx_ri(RM, IM)                                                    \
+        EMITW(0x4E040400 | MRM(REG(RM), REG(RM), 0x00) |                    \
+             (0x00000003 & VAL(IM)) << 19)
+
+#define splpx_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xBD400000 | MPM(REG(RG), RM, DP, 2))                         \
+        EMITW(0x4E040400 | MRM(REG(RG), REG(RG), 0x00))
+
+/************************   masked load/store (NEON)   ************************/
+
+/*
+ * Lanes with non-zero RK elements are loaded/stored at [base + DP],
+ * other lanes are zeroed in RG on load and left untouched in memory on store,
+ * memory behind masked-out lanes is never accessed (safe for array tails).
+ * RM is a [base + DP] addressing form (Mecx..Medi), the emulation uses
+ * per-lane branches over core loads/stores through core temps and Tmm1.
+ */
+
+/* msk */
+
+#define mskpx_rr(RG, RM) /* RM is a core reg, count of active lanes */      \
+        EMITW(0x4E040C00 | MRM(REG(RG), REG(RM), 0x00))                     \
+        cgtpn_ld(W(RG), Mebp, inf_GPC15)
+
+/* mmv */
+
+#define mmvpx_ld(RG, RK, RM, DP) /* RG may be the same as RK */             \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x91000000 | MPM(TPxx,    RM, DP, 0))                         \
+        EMITW(0x6F00E400 | MRM(Tmm1,    0x00,    0x00))                     \
+        mmlxx_rx(Tmm1,      REG(RK),   0x00)                                \
+        mmlxx_rx(Tmm1,      REG(RK),   0x01)                                \
+        mmlxx_rx(Tmm1,      REG(RK),   0x02)                                \
+        mmlxx_rx(Tmm1,      REG(RK),   0x03)                                \
+        EMITW(0x4EA01C00 | MRM(REG(RG), Tmm1,    Tmm1))
+
+#define mmvpx_st(RG, RK, RM, DP) /* RG must not be the same as RK */        \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x91000000 | MPM(TPxx,    RM, DP, 0))                         \
+        mmsxx_rx(REG(RG),   REG(RK),   0x00)                                \
+        mmsxx_rx(REG(RG),   REG(RK),   0x01)                                \
+        mmsxx_rx(REG(RG),   REG(RK),   0x02)                                \
+        mmsxx_rx(REG(RG),   REG(RK),   0x03)
+
+#define mmlxx_rx(XG, XK, ln) /* not portable, do not use outside */         \
+        EMITW(0x0E043C00 | MRM(TMxx,    XK,      0x00) | (ln) << 19)        \
+        EMITW(0x34000060 | MRM(TMxx,    0x00,    0x00))                     \
+        EMITW(0xB9400000 | MRM(TIxx,    TPxx,    0x00) | (ln) << 10)        \
+        EMITW(0x4E041C00 | MRM(XG,      TIxx,    0x00) | (ln) << 19)
+
+#define mmsxx_rx(XG, XK, ln) /* not portable, do not use outside */         \
+        EMITW(0x0E043C00 | MRM(TMxx,    XK,      0x00) | (ln) << 19)        \
+        EMITW(0x34000060 | MRM(TMxx,    0x00,    0x00))                     \
+        EMITW(0x0E043C00 | MRM(TIxx,    XG,      0x00) | (ln) << 19)        \
+        EMITW(0xB9000000 | MRM(TIxx,    TPxx,    0x00) | (ln) << 10)
+
+/*************************   gather/scatter (NEON)   **************************/
+
+/*
+ * Lanes are loaded/stored at [base + DP + index*4] with base taken from
+ * the [base + DP] addressing form of RM (Mecx..Medi) and 32-bit element
+ * indices taken from RI (sign-extended), the emulation uses core temps.
+ * Scatter writes lanes in ascending order, later lanes win on collision.
+ */
+
+/* gat */
+
+#define gatpx_ld(RG, RI, RM, DP) /* RG may be the same as RI */             \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x91000000 | MPM(TPxx,    RM, DP, 0))                         \
+        gatxx_rx(Tmm1,      REG(RI),   0x00)                                \
+        gatxx_rx(Tmm1,      REG(RI),   0x01)                                \
+        gatxx_rx(Tmm1,      REG(RI),   0x02)                                \
+        gatxx_rx(Tmm1,      REG(RI),   0x03)                                \
+        EMITW(0x4EA01C00 | MRM(REG(RG), Tmm1,    Tmm1))
+
+#define gatxx_rx(XG, XI, ln) /* not portable, do not use outside */         \
+        EMITW(0x4E042C00 | MRM(TMxx,    XI,      0x00) | (ln) << 19)        \
+        EMITW(0xB8607800 | MRM(TIxx,    TPxx,    TMxx))                     \
+        EMITW(0x4E041C00 | MRM(XG,      TIxx,    0x00) | (ln) << 19)
+
+/* sca */
+
+#define scapx_st(RG, RI, RM, DP) /* RG must not be the same as RI */        \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0x91000000 | MPM(TPxx,    RM, DP, 0))                         \
+        scaxx_rx(REG(RG),   REG(RI),   0x00)                                \
+        scaxx_rx(REG(RG),   REG(RI),   0x01)                                \
+        scaxx_rx(REG(RG),   REG(RI),   0x02)                                \
+        scaxx_rx(REG(RG),   REG(RI),   0x03)
+
+#define scaxx_rx(XG, XI, ln) /* not portable, do not use outside */         \
+        EMITW(0x4E042C00 | MRM(TMxx,    XI,      0x00) | (ln) << 19)        \
+        EMITW(0x0E043C00 | MRM(TIxx,    XG,      0x00) | (ln) << 19)        \
+        EMITW(0xB8207800 | MRM(TIxx,    TPxx,    TMxx))
+
+/************************   fp16 conversions (NEON)   *************************/
+
+#if RT_SIMD_FP16
+
+/* cvh (S fp16 elements in memory <-> fp32) */
+
+#define cvhps_ld(RG, R1, R2, RM, DP) /* R1, R2 unused (fallback temps) */   \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xFD400000 | MPM(Tmm1,    RM, DP, 3))                         \
+        EMITW(0x0E217800 | MRM(REG(RG), Tmm1,    0x00))
+
+#define cvpsh_st(RG, R1, R2, RM, DP) /* R1, R2 unused (fallback temps) */   \
+        EMITW(0x0E216800 | MRM(Tmm1,    REG(RG), 0x00))                     \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xFD000000 | MPM(Tmm1,    RM, DP, 3))
+
+#endif /* RT_SIMD_FP16 */
+
+        /* cvh fallback defined in rtarch.h
+         * under "COMMON SIMD INSTRUCTIONS" section */
+
+/*****************************   helper macros   ******************************/
+
+/* simd mask */
+
+#define RT_SIMD_MASK_NONE       0x00    /* none satisfy the condition */
+#define RT_SIMD_MASK_FULL       0x01    /*  all satisfy the condition */
+
+#define movms_rr(RG, RM) /* not portable, do not use outside */             \
+        EMITW(0x0E612800 | MRM(Tmm1,    REG(RM), 0x00))                     \
+        EMITW(0x0E212800 | MRM(Tmm1,    Tmm1,    0x00))                     \
+        EMITW(0x0E043C00 | MRM(REG(RG), Tmm1,    0x00))
+
+#define CHECK_MASK(lb, mask, RG) /* destroys Reax */                        \
+        movms_rr(Reax, W(RG))                                               \
+        addxx_ri(Reax, IB(RT_SIMD_MASK_##mask))                             \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jeqxx_lb(lb)
+
+/* simd mode */
+
+#define RT_SIMD_MODE_ROUNDN     0x00    /* round to nearest */
+#define RT_SIMD_MODE_ROUNDM     0x02    /* round towards minus infinity */
+#define RT_SIMD_MODE_ROUNDP     0x01    /* round towards plus  infinity */
+#define RT_SIMD_MODE_ROUNDZ     0x03    /* round towards zero */
+
+#define fpcr_ld(RG) /* not portable, do not use outside */                  \
+        EMITW(0xD51B4400 | MRM(REG(RG), 0x00,    0x00))
+
+#define fpcr_st(RG) /* not portable, do not use outside */                  \
+        EMITW(0xD53B4400 | MRM(REG(RG), 0x00,    0x00))
+
+#define FCTRL_ENTER(mode) /* destroys Reax */                               \
+        fpcr_st(Reax)                                                       \
+        movxx_st(Reax, Mebp, inf_FCTRL)                                     \
+        orrxx_ri(Reax, IW(RT_SIMD_MODE_##mode << 22))                       \
+        fpcr_ld(Reax)
+
+#define FCTRL_LEAVE(mode) /* destroys Reax */                               \
+        movxx_ld(Reax, Mebp, inf_FCTRL)                                     \
+        fpcr_ld(Reax)
+
+#endif /* RT_RTARCH_A64_128_H */
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
@@ -7,6 +7,8 @@
 #ifndef RT_RTARCH_ARM_H
 #define RT_RTARCH_ARM_H
 
+#define RT_CORE_REGS        8
+
 /******************************************************************************/
 /*********************************   LEGEND   *********************************/
 /******************************************************************************/
@@ -51,6 +53,7 @@
  * cmdx*_** - applies [cmd] to core register/memory/immediate args
  * cmd*x_** - applies [cmd] to unsigned integer args, [x] - default
  * cmd*n_** - applies [cmd] to   signed integer args, [n] - negatable
+ * cmd*a_** - applies [cmd] to address-sized args, [a] - address
  *
  * Argument x-register is fixed by the implementation.
  * Some formal definitions are not given below to encourage
@@ -196,6 +199,12 @@
         EMITW(0xE5800000 | MRM(REG(RG), MOD(RM), 0x00) |                    \
              (0x00000FFF & VAL(DP)))
 
+#define movxa_ld(RG, RM, DP) /* address-sized load */                       \
+        movxx_ld(W(RG), W(RM), W(DP))
+
+#define movxa_st(RG, RM, DP) /* address-sized store */                      \
+        movxx_st(W(RG), W(RM), W(DP))
+
 #define adrxx_ld(RG, RM, DP) /* only 10-bit offsets and 4-byte alignment */ \
         AUX(SIB(RM), EMPTY,   EMPTY)                                        \
         EMITW(0xE2800F00 | MRM(REG(RG), MOD(RM), 0x00) |                    \
@@ -435,16 +444,96 @@
 
 /* div */
 
+#if RT_ARM_IDIV
+
+#define divxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xE5900000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP)))                                        \
+        EMITW(0xE730F010 | TMxx << 8)
+
+#define divxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xE5900000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP)))                                        \
+        EMITW(0xE710F010 | TMxx << 8)
+
+#else  /* RT_ARM_IDIV */
+
+#define divxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        AUX(SIB(RM), EMPTY,   EMPTY) /* destroys Xmm0, fallback to VFP */   \
+        EMITW(0xE5900000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP))) /* leftmost 0x00 in MRM is Reax */     \
+        EMITW(0xEC400B10 | MRM(0x00,    TMxx,    Tmm0+0))                   \
+        EMITW(0xEEB80B60 | MRM(Tmm0+1,  0x00,    Tmm0+0))                   \
+        EMITW(0xEEB80B40 | MRM(Tmm0+0,  0x00,    Tmm0+0))                   \
+        EMITW(0xEE800B00 | MRM(Tmm0+0,  Tmm0+0,  Tmm0+1)) /* <- fp div */   \
+        EMITW(0xEEBC0BC0 | MRM(Tmm0+0,  0x00,    Tmm0+0))                   \
+        EMITW(0xEE100B10 | MRM(0x00,    Tmm0+0,  0x00))
+
 #define divxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
         AUX(SIB(RM), EMPTY,   EMPTY) /* destroys Xmm0, fallback to VFP */   \
         EMITW(0xE5900000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
              (0x00000FFF & VAL(DP))) /* leftmost 0x00 in MRM is Reax */     \
-        EMITW(0xEC400B10 | MRM(0x00,    TMxx,    Tmm0+0)) /* limited */     \
-        EMITW(0xF3BB0600 | MRM(Tmm0+1,  0x00,    Tmm0+0)) /* precision */   \
-        EMITW(0xEE800A20 | MRM(Tmm0+1,  Tmm0+1,  Tmm0+1)) /* <- fp div */   \
-        EMITW(0xF3BB0700 | MRM(Tmm0+0,  0x00,    Tmm0+1))                   \
+        EMITW(0xEC400B10 | MRM(0x00,    TMxx,    Tmm0+0))                   \
+        EMITW(0xEEB80BE0 | MRM(Tmm0+1,  0x00,    Tmm0+0))                   \
+        EMITW(0xEEB80BC0 | MRM(Tmm0+0,  0x00,    Tmm0+0))                   \
+        EMITW(0xEE800B00 | MRM(Tmm0+0,  Tmm0+0,  Tmm0+1)) /* <- fp div */   \
+        EMITW(0xEEBD0BC0 | MRM(Tmm0+0,  0x00,    Tmm0+0))                   \
         EMITW(0xEE100B10 | MRM(0x00,    Tmm0+0,  0x00))
 
+#endif /* RT_ARM_IDIV */
+
+/* rem */
+
+#if RT_ARM_IDIV
+
+#define remxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xE5900000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP)))                                        \
+        EMITW(0xE730F010 | TIxx << 16 | TMxx << 8)                          \
+        EMITW(0xE0600090 | 0x02 << 16 | TMxx << 8 | TIxx) /* rem */         \
+        EMITW(0xE1A00000 | MRM(0x00,    0x00,    TIxx))
+
+#define remxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
+        AUX(SIB(RM), EMPTY,   EMPTY)                                        \
+        EMITW(0xE5900000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP)))                                        \
+        EMITW(0xE710F010 | TIxx << 16 | TMxx << 8)                          \
+        EMITW(0xE0600090 | 0x02 << 16 | TMxx << 8 | TIxx) /* rem */         \
+        EMITW(0xE1A00000 | MRM(0x00,    0x00,    TIxx))
+
+#else  /* RT_ARM_IDIV */
+
+#define remxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        AUX(SIB(RM), EMPTY,   EMPTY) /* destroys Xmm0, fallback to VFP */   \
+        EMITW(0xE5900000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP))) /* leftmost 0x00 in MRM is Reax */     \
+        EMITW(0xEC400B10 | MRM(0x00,    TMxx,    Tmm0+0))                   \
+        EMITW(0xEEB80B60 | MRM(Tmm0+1,  0x00,    Tmm0+0))                   \
+        EMITW(0xEEB80B40 | MRM(Tmm0+0,  0x00,    Tmm0+0))                   \
+        EMITW(0xEE800B00 | MRM(Tmm0+0,  Tmm0+0,  Tmm0+1)) /* <- fp div */   \
+        EMITW(0xEEBC0BC0 | MRM(Tmm0+0,  0x00,    Tmm0+0))                   \
+        EMITW(0xEE100B10 | MRM(TIxx,    Tmm0+0,  0x00))                     \
+        EMITW(0xE0600090 | 0x02 << 16 | TMxx << 8 | TIxx) /* rem */         \
+        EMITW(0xE1A00000 | MRM(0x00,    0x00,    TIxx))
+
+#define remxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
+        AUX(SIB(RM), EMPTY,   EMPTY) /* destroys Xmm0, fallback to VFP */   \
+        EMITW(0xE5900000 | MRM(TMxx,    MOD(RM), 0x00) |                    \
+             (0x00000FFF & VAL(DP))) /* leftmost 0x00 in MRM is Reax */     \
+        EMITW(0xEC400B10 | MRM(0x00,    TMxx,    Tmm0+0))                   \
+        EMITW(0xEEB80BE0 | MRM(Tmm0+1,  0x00,    Tmm0+0))                   \
+        EMITW(0xEEB80BC0 | MRM(Tmm0+0,  0x00,    Tmm0+0))                   \
+        EMITW(0xEE800B00 | MRM(Tmm0+0,  Tmm0+0,  Tmm0+1)) /* <- fp div */   \
+        EMITW(0xEEBD0BC0 | MRM(Tmm0+0,  0x00,    Tmm0+0))                   \
+        EMITW(0xEE100B10 | MRM(TIxx,    Tmm0+0,  0x00))                     \
+        EMITW(0xE0600090 | 0x02 << 16 | TMxx << 8 | TIxx) /* rem */         \
+        EMITW(0xE1A00000 | MRM(0x00,    0x00,    TIxx))
+
+#endif /* RT_ARM_IDIV */
+
 /* cmp */
 
 #define cmpxx_ri(RM, IM)                                                    \
@@ -9,10 +9,14 @@
 
 #include "rtarch_arm.h"
 
+#define RT_SIMD_REGS        8
 #define RT_SIMD_WIDTH       4
 #define RT_SIMD_ALIGN       16
 #define RT_SIMD_SET(s, v)   s[0]=s[1]=s[2]=s[3]=v
 
+#define RT_SIMD_WIDTH64     2
+#define RT_SIMD_SET64(s, v) s[0]=s[1]=v
+
 /******************************************************************************/
 /*********************************   LEGEND   *********************************/
 /******************************************************************************/
@@ -37,12 +41,23 @@
  * cmdpx_** - applies [cmd] to [p]acked unsigned integer args, [x] - default
  * cmdpn_** - applies [cmd] to [p]acked   signed integer args, [n] - negatable
  * cmdps_** - applies [cmd] to [p]acked floating point   args, [s] - scalable
+ * cmdpd_** - applies [cmd] to [p]acked double precision args, [d] - double
+ *
+ * cmdpb_** - applies [cmd] to [p]acked unsigned  8-bit integer args, [b]yte
+ * cmdph_** - applies [cmd] to [p]acked unsigned 16-bit integer args, [h]alf
  *
  * The cmdp*_** instructions are intended for SPMD programming model
  * and can potentially be configured per target to work with 32-bit/64-bit
  * data-elements (integers/pointers, floating point).
  * In this model data paths are fixed-width, core and SIMD data-elements are
  * width-compatible, code path divergence is handled via CHECK_MASK macro.
+ *
+ * The cmdpb_**, cmdph_** instructions are intended for pixel/image kernels
+ * and work with fixed-width 8-bit/16-bit data-elements regardless of target,
+ * thus a register holds 4*S bytes or 2*S halfwords respectively.
+ *
+ * The cmdpd_** instructions work with 64-bit floating point data-elements,
+ * thus a register holds RT_SIMD_WIDTH64 (S/2) doubles.
  */
 
 /******************************************************************************/
@@ -56,6 +71,28 @@
          ((ren) & 0x0F) << 16 | ((ren) & 0x10) <<  3 |                      \
          ((reg) & 0x0F) << 12 | ((reg) & 0x10) << 18 )
 
+/* TPxx address add is skipped for DP == 0 (base register used directly),
+ * PTR relies on GNU as evaluating true as -1 (all ones mask) */
+
+#define PRE(reg, mod, sib, val, typ, cmd)                                   \
+        ASM_IF((val) != 0)                                                  \
+        EMITW(0xE0800000 | MRM(TPxx,    mod,     0x00) | typ)               \
+        ASM_FI
+
+#define PTR(reg, mod, sib, val, typ, cmd)                                   \
+        ((mod) + (((val) != 0) & (TPxx - (mod))))
+
+/* VFP single-precision registers s0 - s31 alias SIMD registers q0 - q7,
+ * thus n-th element of a SIMD register is addressed as REG * 2 + n (MSM) */
+
+#define MSM(reg, ren, rem)                                                  \
+        (((rem) & 0x1E) >> 1 | ((rem) & 0x01) <<  5 |                       \
+         ((ren) & 0x1E) << 15 | ((ren) & 0x01) <<  7 |                      \
+         ((reg) & 0x1E) << 11 | ((reg) & 0x01) << 22 )
+
+#define VTM(reg, mod, sib) /* neighbouring SIMD register as VFP temp */     \
+        ((reg) ^ 0x02)
+
 /* registers    REG */
 
 #define Tmm0    0x00                    /* q0, for integer div VFP fallback */
@@ -91,21 +128,48 @@
 
 #define movpx_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(REG(RG), TPxx,    0x00))
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(REG(RG), PTR(RM, DP), 0x00))
 
 #define movpx_st(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4000AAF | MTM(REG(RG), TPxx,    0x00))
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4000AAF | MTM(REG(RG), PTR(RM, DP), 0x00))
 
 #define adrpx_ld(RG, RM, DP) /* RG is a core reg, DP is SIMD-aligned */     \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
         EMITW(0xE0800000 | MTM(REG(RG), MOD(RM), 0x00) |                    \
                            TYP(DP))
 
+#define movlx_ld(RG, RM, DP) /* lower half from memory, upper zeroed */     \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF420078F | MTM(REG(RG), PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3000110 | MTM(REG(RG)+1, REG(RG)+1, REG(RG)+1))
+
+#define movlx_st(RG, RM, DP) /* lower half to memory */                     \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF400078F | MTM(REG(RG), PTR(RM, DP), 0x00))
+
+#define movux_ld(RG, RM, DP) /* full vector from unaligned memory */        \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200A0F | MTM(REG(RG), PTR(RM, DP), 0x00))
+
+#define movnx_st(RG, RM, DP) /* regular store, vst1 has no NT hint */       \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4000AAF | MTM(REG(RG), PTR(RM, DP), 0x00))
+
+#define prfxx_ld(RM, DP) /* prefetch cache line into all levels */          \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF5D0F000 | MTM(0x00,    PTR(RM, DP), 0x00))
+
+#define fence_st() /* orders preceding non-temporal stores */               \
+        EMITW(0xF57FF05A)
+
 /* and */
 
 #define andpx_rr(RG, RM)                                                    \
@@ -113,9 +177,8 @@
 
 #define andpx_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF2000150 | MTM(REG(RG), REG(RG), Tmm1))
 
 /* ann */
@@ -125,9 +188,8 @@
 
 #define annpx_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF2100150 | MTM(REG(RG), Tmm1,    REG(RG)))
 
 /* orr */
@@ -137,9 +199,8 @@
 
 #define orrpx_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF2200150 | MTM(REG(RG), REG(RG), Tmm1))
 
 /* xor */
@@ -149,9 +210,8 @@
 
 #define xorpx_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3000150 | MTM(REG(RG), REG(RG), Tmm1))
 
 /**************   packed single precision floating point (MPE)   **************/
@@ -163,9 +223,8 @@
 
 #define addps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF2000D40 | MTM(REG(RG), REG(RG), Tmm1))
 
 /* sub */
@@ -175,9 +234,8 @@
 
 #define subps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF2200D40 | MTM(REG(RG), REG(RG), Tmm1))
 
 /* mul */
@@ -187,13 +245,50 @@
 
 #define mulps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3000D50 | MTM(REG(RG), REG(RG), Tmm1))
 
 /* div */
 
+#if   RT_SIMD_PREC == RT_SIMD_PREC_FAST
+
+#define divps_rr(RG, RM)                                                    \
+        EMITW(0xF3BB0540 | MTM(Tmm1,    0x00,    REG(RM))) /* estimate */   \
+        EMITW(0xF2000F50 | MTM(Tmm2,    Tmm1,    REG(RM))) /* 1st N-R */    \
+        EMITW(0xF3000D50 | MTM(Tmm1,    Tmm1,    Tmm2))    /* post-mul */   \
+        EMITW(0xF3000D50 | MTM(REG(RG), REG(RG), Tmm1))
+
+#define divps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm3,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3BB0540 | MTM(Tmm1,    0x00,    Tmm3))    /* estimate */   \
+        EMITW(0xF2000F50 | MTM(Tmm2,    Tmm1,    Tmm3))    /* 1st N-R */    \
+        EMITW(0xF3000D50 | MTM(Tmm1,    Tmm1,    Tmm2))    /* post-mul */   \
+        EMITW(0xF3000D50 | MTM(REG(RG), REG(RG), Tmm1))
+
+#elif RT_SIMD_PREC == RT_SIMD_PREC_FULL
+
+#define divps_rr(RG, RM)                                                    \
+        EMITW(0xEE800A00 | MSM(REG(RG)*2+0, REG(RG)*2+0, REG(RM)*2+0))      \
+        EMITW(0xEE800A00 | MSM(REG(RG)*2+1, REG(RG)*2+1, REG(RM)*2+1))      \
+        EMITW(0xEE800A00 | MSM(REG(RG)*2+2, REG(RG)*2+2, REG(RM)*2+2))      \
+        EMITW(0xEE800A00 | MSM(REG(RG)*2+3, REG(RG)*2+3, REG(RM)*2+3))
+
+#define divps_ld(RG, RM, DP) /* saves VTM(RG) in Tmm2 */                    \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF2200150 | MTM(Tmm2,    VTM(RG), VTM(RG)))                  \
+        EMITW(0xF4200AAF | MTM(VTM(RG), PTR(RM, DP), 0x00))                 \
+        EMITW(0xEE800A00 | MSM(REG(RG)*2+0, REG(RG)*2+0, VTM(RG)*2+0))      \
+        EMITW(0xEE800A00 | MSM(REG(RG)*2+1, REG(RG)*2+1, VTM(RG)*2+1))      \
+        EMITW(0xEE800A00 | MSM(REG(RG)*2+2, REG(RG)*2+2, VTM(RG)*2+2))      \
+        EMITW(0xEE800A00 | MSM(REG(RG)*2+3, REG(RG)*2+3, VTM(RG)*2+3))      \
+        EMITW(0xF2200150 | MTM(VTM(RG), Tmm2,    Tmm2))
+
+#else  /* RT_SIMD_PREC_NORM */
+
 #define divps_rr(RG, RM)                                                    \
         EMITW(0xF3BB0540 | MTM(Tmm1,    0x00,    REG(RM))) /* estimate */   \
         EMITW(0xF2000F50 | MTM(Tmm2,    Tmm1,    REG(RM))) /* 1st N-R */    \
@@ -204,9 +299,8 @@
 
 #define divps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm3,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm3,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3BB0540 | MTM(Tmm1,    0x00,    Tmm3))    /* estimate */   \
         EMITW(0xF2000F50 | MTM(Tmm2,    Tmm1,    Tmm3))    /* 1st N-R */    \
         EMITW(0xF3000D50 | MTM(Tmm1,    Tmm1,    Tmm2))    /* post-mul */   \
@@ -214,8 +308,48 @@
         EMITW(0xF3000D50 | MTM(Tmm1,    Tmm1,    Tmm2))    /* post-mul */   \
         EMITW(0xF3000D50 | MTM(REG(RG), REG(RG), Tmm1))
 
+#endif /* RT_SIMD_PREC */
+
 /* sqr */
 
+#if   RT_SIMD_PREC == RT_SIMD_PREC_FAST
+
+#define sqrps_rr(RG, RM)                                                    \
+        EMITW(0xF3BB05C0 | MTM(Tmm1,    0x00,    REG(RM))) /* estimate */   \
+        EMITW(0xF3000D50 | MTM(Tmm2,    Tmm1,    Tmm1))    /* pre-mul */    \
+        EMITW(0xF2200F50 | MTM(Tmm2,    Tmm2,    REG(RM))) /* 1st N-R */    \
+        EMITW(0xF3000D50 | MTM(Tmm1,    Tmm1,    Tmm2))    /* post-mul */   \
+        EMITW(0xF3000D50 | MTM(REG(RG), REG(RM), Tmm1))
+
+#define sqrps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm3,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3BB05C0 | MTM(Tmm1,    0x00,    Tmm3))    /* estimate */   \
+        EMITW(0xF3000D50 | MTM(Tmm2,    Tmm1,    Tmm1))    /* pre-mul */    \
+        EMITW(0xF2200F50 | MTM(Tmm2,    Tmm2,    Tmm3))    /* 1st N-R */    \
+        EMITW(0xF3000D50 | MTM(Tmm1,    Tmm1,    Tmm2))    /* post-mul */   \
+        EMITW(0xF3000D50 | MTM(REG(RG), Tmm3,    Tmm1))
+
+#elif RT_SIMD_PREC == RT_SIMD_PREC_FULL
+
+#define sqrps_rr(RG, RM)                                                    \
+        EMITW(0xEEB10AC0 | MSM(REG(RG)*2+0, 0x00,    REG(RM)*2+0))          \
+        EMITW(0xEEB10AC0 | MSM(REG(RG)*2+1, 0x00,    REG(RM)*2+1))          \
+        EMITW(0xEEB10AC0 | MSM(REG(RG)*2+2, 0x00,    REG(RM)*2+2))          \
+        EMITW(0xEEB10AC0 | MSM(REG(RG)*2+3, 0x00,    REG(RM)*2+3))
+
+#define sqrps_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(REG(RG), PTR(RM, DP), 0x00))                 \
+        EMITW(0xEEB10AC0 | MSM(REG(RG)*2+0, 0x00,    REG(RG)*2+0))          \
+        EMITW(0xEEB10AC0 | MSM(REG(RG)*2+1, 0x00,    REG(RG)*2+1))          \
+        EMITW(0xEEB10AC0 | MSM(REG(RG)*2+2, 0x00,    REG(RG)*2+2))          \
+        EMITW(0xEEB10AC0 | MSM(REG(RG)*2+3, 0x00,    REG(RG)*2+3))
+
+#else  /* RT_SIMD_PREC_NORM */
+
 #define sqrps_rr(RG, RM)                                                    \
         EMITW(0xF3BB05C0 | MTM(Tmm1,    0x00,    REG(RM))) /* estimate */   \
         EMITW(0xF3000D50 | MTM(Tmm2,    Tmm1,    Tmm1))    /* pre-mul */    \
@@ -228,9 +362,8 @@
 
 #define sqrps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm3,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm3,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3BB05C0 | MTM(Tmm1,    0x00,    Tmm3))    /* estimate */   \
         EMITW(0xF3000D50 | MTM(Tmm2,    Tmm1,    Tmm1))    /* pre-mul */    \
         EMITW(0xF2200F50 | MTM(Tmm2,    Tmm2,    Tmm3))    /* 1st N-R */    \
@@ -240,6 +373,8 @@
         EMITW(0xF3000D50 | MTM(Tmm1,    Tmm1,    Tmm2))    /* post-mul */   \
         EMITW(0xF3000D50 | MTM(REG(RG), Tmm3,    Tmm1))
 
+#endif /* RT_SIMD_PREC */
+
 /* cbr */
 
         /* cbe, cbs, cbr defined in rtarch.h
@@ -277,9 +412,8 @@
 
 #define minps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF2200F40 | MTM(REG(RG), REG(RG), Tmm1))
 
 /* max */
@@ -289,9 +423,8 @@
 
 #define maxps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF2000F40 | MTM(REG(RG), REG(RG), Tmm1))
 
 /* cmp */
@@ -301,9 +434,8 @@
 
 #define ceqps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF2000E40 | MTM(REG(RG), REG(RG), Tmm1))
 
 #define cneps_rr(RG, RM)                                                    \
@@ -312,9 +444,8 @@
 
 #define cneps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF2000E40 | MTM(REG(RG), REG(RG), Tmm1))                     \
         EMITW(0xF3B005C0 | MTM(REG(RG), 0x00,    REG(RG)))
 
@@ -323,9 +454,8 @@
 
 #define cltps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3200E40 | MTM(REG(RG), Tmm1,    REG(RG)))
 
 #define cleps_rr(RG, RM)                                                    \
@@ -333,9 +463,8 @@
 
 #define cleps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3000E40 | MTM(REG(RG), Tmm1,    REG(RG)))
 
 #define cgtps_rr(RG, RM)                                                    \
@@ -343,9 +472,8 @@
 
 #define cgtps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3200E40 | MTM(REG(RG), REG(RG), Tmm1))
 
 #define cgeps_rr(RG, RM)                                                    \
@@ -353,11 +481,195 @@
 
 #define cgeps_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3000E40 | MTM(REG(RG), REG(RG), Tmm1))
 
+/**************   packed double precision floating point (VFP)   **************/
+
+        /* ARMv7 NEON has no 64-bit floating point data paths,
+         * thus cmdpd_** instructions fallback to VFP per element */
+
+/* add */
+
+#define addpd_rr(RG, RM)                                                    \
+        EMITW(0xEE300B00 | MTM(REG(RG)+0, REG(RG)+0, REG(RM)+0))            \
+        EMITW(0xEE300B00 | MTM(REG(RG)+1, REG(RG)+1, REG(RM)+1))
+
+#define addpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xEE300B00 | MTM(REG(RG)+0, REG(RG)+0, Tmm1+0))               \
+        EMITW(0xEE300B00 | MTM(REG(RG)+1, REG(RG)+1, Tmm1+1))
+
+/* sub */
+
+#define subpd_rr(RG, RM)                                                    \
+        EMITW(0xEE300B40 | MTM(REG(RG)+0, REG(RG)+0, REG(RM)+0))            \
+        EMITW(0xEE300B40 | MTM(REG(RG)+1, REG(RG)+1, REG(RM)+1))
+
+#define subpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xEE300B40 | MTM(REG(RG)+0, REG(RG)+0, Tmm1+0))               \
+        EMITW(0xEE300B40 | MTM(REG(RG)+1, REG(RG)+1, Tmm1+1))
+
+/* mul */
+
+#define mulpd_rr(RG, RM)                                                    \
+        EMITW(0xEE200B00 | MTM(REG(RG)+0, REG(RG)+0, REG(RM)+0))            \
+        EMITW(0xEE200B00 | MTM(REG(RG)+1, REG(RG)+1, REG(RM)+1))
+
+#define mulpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xEE200B00 | MTM(REG(RG)+0, REG(RG)+0, Tmm1+0))               \
+        EMITW(0xEE200B00 | MTM(REG(RG)+1, REG(RG)+1, Tmm1+1))
+
+/* div */
+
+#define divpd_rr(RG, RM)                                                    \
+        EMITW(0xEE800B00 | MTM(REG(RG)+0, REG(RG)+0, REG(RM)+0))            \
+        EMITW(0xEE800B00 | MTM(REG(RG)+1, REG(RG)+1, REG(RM)+1))
+
+#define divpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xEE800B00 | MTM(REG(RG)+0, REG(RG)+0, Tmm1+0))               \
+        EMITW(0xEE800B00 | MTM(REG(RG)+1, REG(RG)+1, Tmm1+1))
+
+/* sqr */
+
+#define sqrpd_rr(RG, RM)                                                    \
+        EMITW(0xEEB10BC0 | MTM(REG(RG)+0, 0x00,  REG(RM)+0))                \
+        EMITW(0xEEB10BC0 | MTM(REG(RG)+1, 0x00,  REG(RM)+1))
+
+#define sqrpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xEEB10BC0 | MTM(REG(RG)+0, 0x00,  Tmm1+0))                   \
+        EMITW(0xEEB10BC0 | MTM(REG(RG)+1, 0x00,  Tmm1+1))
+
+/* min, max */
+
+#define mnmds_rx(DG, DM, cc) /* not portable, do not use outside */         \
+        EMITW(0xEEB40B40 | MTM(DG,      0x00,    DM))                       \
+        EMITW(0xEEF1FA10)                                                   \
+        EMITW(0x0EB00B40 | MTM(DG,      0x00,    DM) | (cc))
+
+#define minpd_rr(RG, RM)                                                    \
+        mnmds_rx(REG(RG)+0, REG(RM)+0, 0x50000000 /* pl */)                 \
+        mnmds_rx(REG(RG)+1, REG(RM)+1, 0x50000000 /* pl */)
+
+#define minpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        mnmds_rx(REG(RG)+0, Tmm1+0,    0x50000000 /* pl */)                 \
+        mnmds_rx(REG(RG)+1, Tmm1+1,    0x50000000 /* pl */)
+
+#define maxpd_rr(RG, RM)                                                    \
+        mnmds_rx(REG(RG)+0, REG(RM)+0, 0xD0000000 /* le */)                 \
+        mnmds_rx(REG(RG)+1, REG(RM)+1, 0xD0000000 /* le */)
+
+#define maxpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        mnmds_rx(REG(RG)+0, Tmm1+0,    0xD0000000 /* le */)                 \
+        mnmds_rx(REG(RG)+1, Tmm1+1,    0xD0000000 /* le */)
+
+/* cmp */
+
+#define cmpds_rx(DG, DM, cc) /* not portable, do not use outside */         \
+        EMITW(0xEEB40B40 | MTM(DG,      0x00,    DM))                       \
+        EMITW(0xEEF1FA10)                                                   \
+        EMITW(0xE3A00000 | MRM(TMxx,    0x00,    0x00))                     \
+        EMITW(0x03E00000 | MRM(TMxx,    0x00,    0x00) | (cc))              \
+        EMITW(0xEC400B10 | MRM(TMxx,    TMxx,    0x00) | MTM(0, 0, DG))
+
+#define ceqpd_rr(RG, RM)                                                    \
+        cmpds_rx(REG(RG)+0, REG(RM)+0, 0x00000000 /* eq */)                 \
+        cmpds_rx(REG(RG)+1, REG(RM)+1, 0x00000000 /* eq */)
+
+#define ceqpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        cmpds_rx(REG(RG)+0, Tmm1+0,    0x00000000 /* eq */)                 \
+        cmpds_rx(REG(RG)+1, Tmm1+1,    0x00000000 /* eq */)
+
+#define cnepd_rr(RG, RM)                                                    \
+        cmpds_rx(REG(RG)+0, REG(RM)+0, 0x10000000 /* ne */)                 \
+        cmpds_rx(REG(RG)+1, REG(RM)+1, 0x10000000 /* ne */)
+
+#define cnepd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        cmpds_rx(REG(RG)+0, Tmm1+0,    0x10000000 /* ne */)                 \
+        cmpds_rx(REG(RG)+1, Tmm1+1,    0x10000000 /* ne */)
+
+#define cltpd_rr(RG, RM)                                                    \
+        cmpds_rx(REG(RG)+0, REG(RM)+0, 0x40000000 /* mi */)                 \
+        cmpds_rx(REG(RG)+1, REG(RM)+1, 0x40000000 /* mi */)
+
+#define cltpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        cmpds_rx(REG(RG)+0, Tmm1+0,    0x40000000 /* mi */)                 \
+        cmpds_rx(REG(RG)+1, Tmm1+1,    0x40000000 /* mi */)
+
+#define clepd_rr(RG, RM)                                                    \
+        cmpds_rx(REG(RG)+0, REG(RM)+0, 0x90000000 /* ls */)                 \
+        cmpds_rx(REG(RG)+1, REG(RM)+1, 0x90000000 /* ls */)
+
+#define clepd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        cmpds_rx(REG(RG)+0, Tmm1+0,    0x90000000 /* ls */)                 \
+        cmpds_rx(REG(RG)+1, Tmm1+1,    0x90000000 /* ls */)
+
+#define cgtpd_rr(RG, RM)                                                    \
+        cmpds_rx(REG(RG)+0, REG(RM)+0, 0x80000000 /* hi */)                 \
+        cmpds_rx(REG(RG)+1, REG(RM)+1, 0x80000000 /* hi */)
+
+#define cgtpd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        cmpds_rx(REG(RG)+0, Tmm1+0,    0x80000000 /* hi */)                 \
+        cmpds_rx(REG(RG)+1, Tmm1+1,    0x80000000 /* hi */)
+
+#define cgepd_rr(RG, RM)                                                    \
+        cmpds_rx(REG(RG)+0, REG(RM)+0, 0x50000000 /* pl */)                 \
+        cmpds_rx(REG(RG)+1, REG(RM)+1, 0x50000000 /* pl */)
+
+#define cgepd_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        cmpds_rx(REG(RG)+0, Tmm1+0,    0x50000000 /* pl */)                 \
+        cmpds_rx(REG(RG)+1, Tmm1+1,    0x50000000 /* pl */)
+
+/* cvt (fp32 <-> fp64) */
+
+#define cvtsd_rr(RG, RM) /* lower S/2 fp32 elements to fp64 */              \
+        EMITW(0xEEB70AC0 | MTM(REG(RG)+1, 0x00,  REG(RM)) | 0x00000020)     \
+        EMITW(0xEEB70AC0 | MTM(REG(RG)+0, 0x00,  REG(RM)))
+
+#define cvtds_rr(RG, RM) /* fp64 elements to lower S/2 fp32, zero upper */  \
+        EMITW(0xEEB70BC0 | MTM(REG(RG),   0x00,  REG(RM)+0))                \
+        EMITW(0xEEB70BC0 | MTM(REG(RG),   0x00,  REG(RM)+1) | 0x00400000)   \
+        EMITW(0xF3000110 | MTM(REG(RG)+1, REG(RG)+1, REG(RG)+1))
+
 /**************************   packed integer (MPE)   **************************/
 
 /* cvt */
@@ -370,10 +682,9 @@
 
 #define cvtps_ld(RG, RM, DP) /* fallback to VFP for float-to-integer cvt */ \
         AUX(SIB(RM), CMD(DP), EMPTY)                         /* due to */   \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |     /* lack of */  \
-                           TYP(DP))                          /* rounding */ \
-        EMITW(0xF4200AAF | MTM(REG(RG), TPxx,    0x00))      /* modes */    \
-        EMITW(0xEEBD0A40 | MTM(REG(RG)+0, 0x00,  REG(RG)+0))                \
+        PRE(RM, DP)                                          /* lack of */  \
+        EMITW(0xF4200AAF | MTM(REG(RG), PTR(RM, DP), 0x00))  /* rounding */ \
+        EMITW(0xEEBD0A40 | MTM(REG(RG)+0, 0x00,  REG(RG)+0)) /* modes */    \
         EMITW(0xEEFD0A60 | MTM(REG(RG)+0, 0x00,  REG(RG)+0))                \
         EMITW(0xEEBD0A40 | MTM(REG(RG)+1, 0x00,  REG(RG)+1))                \
         EMITW(0xEEFD0A60 | MTM(REG(RG)+1, 0x00,  REG(RG)+1))
@@ -383,9 +694,8 @@
 
 #define cvtpn_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3BB0640 | MTM(REG(RG), 0x00,    Tmm1))
 
 /* add */
@@ -395,9 +705,8 @@
 
 #define addpx_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF2200840 | MTM(REG(RG), REG(RG), Tmm1))
 
 /* sub */
@@ -407,9 +716,8 @@
 
 #define subpx_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4200AAF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3200840 | MTM(REG(RG), REG(RG), Tmm1))
 
 /* shl */
@@ -420,9 +728,8 @@
 
 #define shlpx_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4A00CBF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4A00CBF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3200440 | MTM(REG(RG), Tmm1,    REG(RG)))
 
 /* shr */
@@ -436,9 +743,8 @@
 
 #define shrpx_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4A00CBF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4A00CBF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3B903C0 | MTM(Tmm1,    0x00,    Tmm1))                     \
         EMITW(0xF3200440 | MTM(REG(RG), Tmm1,    REG(RG)))
 
@@ -451,12 +757,301 @@
 
 #define shrpn_ld(RG, RM, DP)                                                \
         AUX(SIB(RM), CMD(DP), EMPTY)                                        \
-        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
-                           TYP(DP))                                         \
-        EMITW(0xF4A00CBF | MTM(Tmm1,    TPxx,    0x00))                     \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4A00CBF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
         EMITW(0xF3B903C0 | MTM(Tmm1,    0x00,    Tmm1))                     \
         EMITW(0xF2200440 | MTM(REG(RG), Tmm1,    REG(RG)))
 
+/* cgt (signed) */
+
+#define cgtpn_rr(RG, RM)                                                    \
+        EMITW(0xF2200340 | MTM(REG(RG), REG(RG), REG(RM)))
+
+#define cgtpn_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF2200340 | MTM(REG(RG), REG(RG), Tmm1))
+
+/***********************   packed byte/half integer (MPE)   *******************/
+
+/* add */
+
+#define addpb_rr(RG, RM)                                                    \
+        EMITW(0xF2000840 | MTM(REG(RG), REG(RG), REG(RM)))
+
+#define addpb_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF2000840 | MTM(REG(RG), REG(RG), Tmm1))
+
+#define addph_rr(RG, RM)                                                    \
+        EMITW(0xF2100840 | MTM(REG(RG), REG(RG), REG(RM)))
+
+#define addph_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF2100840 | MTM(REG(RG), REG(RG), Tmm1))
+
+/* ads (add with unsigned saturation) */
+
+#define adspb_rr(RG, RM)                                                    \
+        EMITW(0xF3000050 | MTM(REG(RG), REG(RG), REG(RM)))
+
+#define adspb_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3000050 | MTM(REG(RG), REG(RG), Tmm1))
+
+#define adsph_rr(RG, RM)                                                    \
+        EMITW(0xF3100050 | MTM(REG(RG), REG(RG), REG(RM)))
+
+#define adsph_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3100050 | MTM(REG(RG), REG(RG), Tmm1))
+
+/* sub */
+
+#define subpb_rr(RG, RM)                                                    \
+        EMITW(0xF3000840 | MTM(REG(RG), REG(RG), REG(RM)))
+
+#define subpb_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3000840 | MTM(REG(RG), REG(RG), Tmm1))
+
+#define subph_rr(RG, RM)                                                    \
+        EMITW(0xF3100840 | MTM(REG(RG), REG(RG), REG(RM)))
+
+#define subph_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3100840 | MTM(REG(RG), REG(RG), Tmm1))
+
+/* sbs (sub with unsigned saturation) */
+
+#define sbspb_rr(RG, RM)                                                    \
+        EMITW(0xF3000250 | MTM(REG(RG), REG(RG), REG(RM)))
+
+#define sbspb_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3000250 | MTM(REG(RG), REG(RG), Tmm1))
+
+#define sbsph_rr(RG, RM)                                                    \
+        EMITW(0xF3100250 | MTM(REG(RG), REG(RG), REG(RM)))
+
+#define sbsph_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3100250 | MTM(REG(RG), REG(RG), Tmm1))
+
+/* avg (rounded average, (a + b + 1) >> 1) */
+
+#define avgpb_rr(RG, RM)                                                    \
+        EMITW(0xF3000140 | MTM(REG(RG), REG(RG), REG(RM)))
+
+#define avgpb_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3000140 | MTM(REG(RG), REG(RG), Tmm1))
+
+#define avgph_rr(RG, RM)                                                    \
+        EMITW(0xF3100140 | MTM(REG(RG), REG(RG), REG(RM)))
+
+#define avgph_ld(RG, RM, DP)                                                \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4200AAF | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3100140 | MTM(REG(RG), REG(RG), Tmm1))
+
+/* unl, unh (widen lower/upper half with zero-extension) */
+
+#define unlpb_rr(RG, RM) /* bytes to halves */                              \
+        EMITW(0xF3880A10 | MTM(REG(RG), 0x00,    REG(RM)+0))
+
+#define unhpb_rr(RG, RM) /* bytes to halves */                              \
+        EMITW(0xF3880A10 | MTM(REG(RG), 0x00,    REG(RM)+1))
+
+#define unlph_rr(RG, RM) /* halves to words */                              \
+        EMITW(0xF3900A10 | MTM(REG(RG), 0x00,    REG(RM)+0))
+
+#define unhph_rr(RG, RM) /* halves to words */                              \
+        EMITW(0xF3900A10 | MTM(REG(RG), 0x00,    REG(RM)+1))
+
+/* pck (narrow RG into lower half, RM into upper half with saturation) */
+
+#define pckph_rr(RG, RM) /* signed halves to unsigned bytes */              \
+        EMITW(0xF3B20240 | MTM(Tmm1+0,  0x00,    REG(RG)))                  \
+        EMITW(0xF3B20240 | MTM(Tmm1+1,  0x00,    REG(RM)))                  \
+        EMITW(0xF2200150 | MTM(REG(RG), Tmm1,    Tmm1))
+
+#define pckpn_rr(RG, RM) /* signed words to signed halves */                \
+        EMITW(0xF3B60280 | MTM(Tmm1+0,  0x00,    REG(RG)))                  \
+        EMITW(0xF3B60280 | MTM(Tmm1+1,  0x00,    REG(RM)))                  \
+        EMITW(0xF2200150 | MTM(REG(RG), Tmm1,    Tmm1))
+
+/***********************   lane shift/broadcast (MPE)   ***********************/
+
+/*
+ * Lane shifts move 32-bit elements of RM up (towards higher lanes, sln)
+ * or down (srn) by IM lanes (1..S-1), vacated lanes are zeroed.
+ * Broadcasts copy element IM (0..S-1) of RM (splpx_ri) or 32-bit element
+ * at [RM + DP] (splpx_ld, DP is not required to be SIMD-aligned)
+ * to all lanes.
+ */
+
+/* sln */
+
+#define slnpx_ri(RM, IM) /* zero from Tmm1, lanes via vext */               \
+        EMITW(0xF3000150 | MTM(Tmm1,    Tmm1,    Tmm1))                     \
+        EMITW(0xF2B00040 | MTM(REG(RM), Tmm1,    REG(RM)) |                 \
+             (0x0000000F & (16 - VAL(IM) * 4)) << 8)
+
+/* srn */
+
+#define srnpx_ri(RM, IM) /* zero from Tmm1, lanes via vext */               \
+        EMITW(0xF3000150 | MTM(Tmm1,    Tmm1,    Tmm1))                     \
+        EMITW(0xF2B00040 | MTM(REG(RM), REG(RM), Tmm1) |                    \
+             (0x0000000F & (VAL(IM) * 4)) << 8)
+
+/* spl */
+
+#define splpx_ri(RM, IM) /* vdup from D-half holding the element */       \
+        EMITW(0xF3B40C40 | MTM(REG(RM), 0x00, REG(RM) + (VAL(IM) >> 1)) |   \
+             (0x00000001 & VAL(IM)) << 19)
+
+#define splpx_ld(RG, RM, DP) /* vld1 to all lanes */                        \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF4A00CAF | MTM(REG(RG), PTR(RM, DP), 0x00))
+
+/*************************   masked load/store (MPE)   ************************/
+
+/*
+ * Lanes with non-zero RK elements are loaded/stored at [base + DP],
+ * other lanes are zeroed in RG on load and left untouched in memory on store,
+ * memory behind masked-out lanes is never accessed (safe for array tails).
+ * RM is a [base + DP] addressing form (Mecx..Medi), the emulation uses
+ * conditional core loads/stores through core temps and Tmm1.
+ */
+
+/* msk */
+
+#define mskpx_rr(RG, RM) /* RM is a core reg, count of active lanes */      \
+        EMITW(0xEEA00B10 | MTM(REG(RM), REG(RG), 0x00))                     \
+        cgtpn_ld(W(RG), Mebp, inf_GPC15)
+
+/* mmv */
+
+#define mmvpx_ld(RG, RK, RM, DP) /* RG may be the same as RK */             \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
+                           TYP(DP))                                         \
+        mmlxx_rx(Tmm1+0, REG(RK)+0, 0x00)                                   \
+        mmlxx_rx(Tmm1+0, REG(RK)+0, 0x01)                                   \
+        mmlxx_rx(Tmm1+1, REG(RK)+1, 0x00)                                   \
+        mmlxx_rx(Tmm1+1, REG(RK)+1, 0x01)                                   \
+        EMITW(0xF2200150 | MTM(REG(RG), Tmm1,    Tmm1))
+
+#define mmvpx_st(RG, RK, RM, DP) /* RG must not be the same as RK */        \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
+                           TYP(DP))                                         \
+        mmsxx_rx(REG(RG)+0, REG(RK)+0, 0x00)                                \
+        mmsxx_rx(REG(RG)+0, REG(RK)+0, 0x01)                                \
+        mmsxx_rx(REG(RG)+1, REG(RK)+1, 0x00)                                \
+        mmsxx_rx(REG(RG)+1, REG(RK)+1, 0x01)
+
+#define mmlxx_rx(DG, DK, ln) /* not portable, do not use outside */         \
+        EMITW(0xEE100B10 | MTM(TMxx,    DK,      0x00) | (ln) << 21)        \
+        EMITW(0xE3500000 | MRM(0x00,    TMxx,    0x00))                     \
+        EMITW(0x15900000 | MRM(TMxx,    TPxx,    0x00) |                    \
+             (((DK) & 1) << 3 | (ln) << 2))                                 \
+        EMITW(0xEE000B10 | MTM(TMxx,    DG,      0x00) | (ln) << 21)
+
+#define mmsxx_rx(DG, DK, ln) /* not portable, do not use outside */         \
+        EMITW(0xEE100B10 | MTM(TMxx,    DK,      0x00) | (ln) << 21)        \
+        EMITW(0xE3500000 | MRM(0x00,    TMxx,    0x00))                     \
+        EMITW(0xEE100B10 | MTM(TIxx,    DG,      0x00) | (ln) << 21)        \
+        EMITW(0x15800000 | MRM(TIxx,    TPxx,    0x00) |                    \
+             (((DK) & 1) << 3 | (ln) << 2))
+
+/**************************   gather/scatter (MPE)   **************************/
+
+/*
+ * Lanes are loaded/stored at [base + DP + index*4] with base taken from
+ * the [base + DP] addressing form of RM (Mecx..Medi) and 32-bit element
+ * indices taken from RI, the emulation uses core temps and Tmm1.
+ * Scatter writes lanes in ascending order, later lanes win on collision.
+ */
+
+/* gat */
+
+#define gatpx_ld(RG, RI, RM, DP) /* RG may be the same as RI */             \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
+                           TYP(DP))                                         \
+        gatxx_rx(Tmm1+0, REG(RI)+0, 0x00)                                   \
+        gatxx_rx(Tmm1+0, REG(RI)+0, 0x01)                                   \
+        gatxx_rx(Tmm1+1, REG(RI)+1, 0x00)                                   \
+        gatxx_rx(Tmm1+1, REG(RI)+1, 0x01)                                   \
+        EMITW(0xF2200150 | MTM(REG(RG), Tmm1,    Tmm1))
+
+#define gatxx_rx(DG, DI, ln) /* not portable, do not use outside */         \
+        EMITW(0xEE100B10 | MTM(TMxx,    DI,      0x00) | (ln) << 21)        \
+        EMITW(0xE0800100 | MRM(TIxx,    TPxx,    TMxx))                     \
+        EMITW(0xF4A0080F | MTM(DG,      TIxx,    0x00) | (ln) << 7)
+
+/* sca */
+
+#define scapx_st(RG, RI, RM, DP) /* RG must not be the same as RI */        \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        EMITW(0xE0800000 | MRM(TPxx,    MOD(RM), 0x00) |                    \
+                           TYP(DP))                                         \
+        scaxx_rx(REG(RG)+0, REG(RI)+0, 0x00)                                \
+        scaxx_rx(REG(RG)+0, REG(RI)+0, 0x01)                                \
+        scaxx_rx(REG(RG)+1, REG(RI)+1, 0x00)                                \
+        scaxx_rx(REG(RG)+1, REG(RI)+1, 0x01)
+
+#define scaxx_rx(DG, DI, ln) /* not portable, do not use outside */         \
+        EMITW(0xEE100B10 | MTM(TMxx,    DI,      0x00) | (ln) << 21)        \
+        EMITW(0xE0800100 | MRM(TIxx,    TPxx,    TMxx))                     \
+        EMITW(0xF480080F | MTM(DG,      TIxx,    0x00) | (ln) << 7)
+
+/*************************   fp16 conversions (MPE)   *************************/
+
+#if RT_SIMD_FP16
+
+/* cvh (S fp16 elements in memory <-> fp32) */
+
+#define cvhps_ld(RG, R1, R2, RM, DP) /* R1, R2 unused (fallback temps) */   \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF420078F | MTM(Tmm1,    PTR(RM, DP), 0x00))                 \
+        EMITW(0xF3B60700 | MTM(REG(RG), 0x00,    Tmm1))
+
+#define cvpsh_st(RG, R1, R2, RM, DP) /* R1, R2 unused (fallback temps) */   \
+        EMITW(0xF3B60600 | MTM(Tmm1,    0x00,    REG(RG)))                  \
+        AUX(SIB(RM), CMD(DP), EMPTY)                                        \
+        PRE(RM, DP)                                                         \
+        EMITW(0xF400078F | MTM(Tmm1,    PTR(RM, DP), 0x00))
+
+#endif /* RT_SIMD_FP16 */
+
+        /* cvh fallback defined in rtarch.h
+         * under "COMMON SIMD INSTRUCTIONS" section */
+
 /*****************************   helper macros   ******************************/
 
 /* simd mask */
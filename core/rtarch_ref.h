@@ -0,0 +1,543 @@
+/******************************************************************************/
+/* Copyright (c) 2013-2015 VectorChief (at github, bitbucket, sourceforge)    */
+/* Distributed under the MIT software license, see the accompanying           */
+/* file COPYING or http://www.opensource.org/licenses/mit-license.php         */
+/******************************************************************************/
+
+#ifndef RT_RTARCH_REF_H
+#define RT_RTARCH_REF_H
+
+/* all 15 named core registers are emulated, build with -DRT_CORE_REGS=8
+ * to check kernel paths of 8-register targets (x86, ARM, A64) */
+#ifndef RT_CORE_REGS
+#define RT_CORE_REGS        15
+#endif /* RT_CORE_REGS */
+
+#include <string.h>
+
+/******************************************************************************/
+/*********************************   LEGEND   *********************************/
+/******************************************************************************/
+
+/*
+ * rtarch_ref.h: Implementation of reference core instructions.
+ *
+ * This file is a part of the unified SIMD assembler framework (rtarch.h)
+ * designed to be compatible with different processor architectures,
+ * while maintaining strictly defined common API.
+ *
+ * Recommended naming scheme for instructions:
+ *
+ * cmdxx_ri - applies [cmd] to [r]egister from [i]mmediate
+ * cmdxx_mi - applies [cmd] to [m]emory   from [i]mmediate
+ *
+ * cmdxx_rm - applies [cmd] to [r]egister from [m]emory
+ * cmdxx_ld - applies [cmd] as above
+ * cmdxx_mr - applies [cmd] to [m]emory   from [r]egister
+ * cmdxx_st - applies [cmd] as above (arg list as cmdxx_ld)
+ *
+ * cmdxx_rr - applies [cmd] to [r]egister from [r]egister
+ * cmdxx_mm - applies [cmd] to [m]emory   from [m]emory
+ * cmdxx_rr - applies [cmd] to [r]egister (one operand cmd)
+ * cmdxx_mm - applies [cmd] to [m]emory   (one operand cmd)
+ *
+ * cmdxx_rx - applies [cmd] to [r]egister from x-register
+ * cmdxx_mx - applies [cmd] to [m]emory   from x-register
+ * cmdxx_xr - applies [cmd] to x-register from [r]egister
+ * cmdxx_xm - applies [cmd] to x-register from [m]emory
+ *
+ * cmdxx_rl - applies [cmd] to [r]egister from [l]abel
+ * cmdxx_xl - applies [cmd] to x-register from [l]abel
+ * cmdxx_lb - applies [cmd] as above
+ * label_ld - applies [adr] as above
+ *
+ * stack_st - applies [mov] to stack from register (push)
+ * stack_ld - applies [mov] to register from stack (pop)
+ * stack_sa - applies [mov] to stack from all registers
+ * stack_la - applies [mov] to all registers from stack
+ *
+ * cmdx*_** - applies [cmd] to core register/memory/immediate args
+ * cmd*x_** - applies [cmd] to unsigned integer args, [x] - default
+ * cmd*n_** - applies [cmd] to   signed integer args, [n] - negatable
+ * cmd*a_** - applies [cmd] to address-sized args, [a] - address
+ *
+ * Argument x-register is fixed by the implementation.
+ * Some formal definitions are not given below to encourage
+ * use of friendly aliases for better code readability.
+ *
+ * Instructions are plain C statements working on an emulated register file
+ * declared by ASM_ENTER, labels are C labels, jumps are gotos (including
+ * GCC computed gotos for label_ld, jmpxx_mm), so the kernels run on any host
+ * and serve as a semantic reference for the native targets.
+ *
+ * Core registers are 64-bit wide and hold host pointers, while data-elements
+ * in memory are 32-bit wide. Thus mov, adr, add, sub, and, orr, not, jmp
+ * operate on full registers (32-bit operands are sign-extended),
+ * while load/store, shifts, mul, div and cmp operate on lower 32 bits
+ * (results are zero-extended). Integer division never traps: zero divisor
+ * produces zero quotient and Reax remainder, overflow wraps around.
+ * Condition flags are only guaranteed after cmpxx_** instructions.
+ */
+
+/******************************************************************************/
+/********************************   INTERNAL   ********************************/
+/******************************************************************************/
+
+/* emitters */
+
+#define EMPTY   /* no code */
+
+/* structural */
+
+#define ADR(reg, mod, sib, val, typ, cmd)                                   \
+        (ref.r[reg] + ref.r[mod] + (val))
+
+#define LDM(v, RM, DP) /* loads sizeof(v) bytes from memory to v */         \
+        memcpy(&(v), (rt_pntr)(rt_addr)ADR(RM, DP), sizeof(v));
+
+#define STM(v, RM, DP) /* stores sizeof(v) bytes to memory from v */        \
+        memcpy((rt_pntr)(rt_addr)ADR(RM, DP), &(v), sizeof(v));
+
+#define SXT(im) /* sign-extends 32-bit operand to full register */          \
+        ((rt_full)(rt_si64)(rt_si32)(im))
+
+/* selectors  */
+
+#define REG(reg, mod, sib)  reg
+#define MOD(reg, mod, sib)  mod
+#define SIB(reg, mod, sib)  sib
+
+#define VAL(val, typ, cmd)  val
+#define TYP(val, typ, cmd)  typ
+#define CMD(val, typ, cmd)  cmd
+
+#define GPR(reg, mod, sib)  ref.r[reg]
+
+/* register file */
+
+#define RT_REF_STACK        32  /* 64-bit stack slots */
+
+struct rt_REF_CORE
+{
+    rt_full r[16];          /* Reax - RegE, r[15] is always zero */
+    rt_word cl, cr;         /* operands of the last cmpxx_** */
+    rt_full stk[RT_REF_STACK];
+};
+
+/******************************************************************************/
+/********************************   EXTERNAL   ********************************/
+/******************************************************************************/
+
+/* registers    REG,  MOD,  SIB */
+
+#define Reax    0x00, 0x0F, EMPTY
+#define Recx    0x01, 0x0F, EMPTY
+#define Redx    0x02, 0x0F, EMPTY
+#define Rebx    0x03, 0x0F, EMPTY
+#define Resp    0x04, 0x0F, EMPTY
+#define Rebp    0x05, 0x0F, EMPTY
+#define Resi    0x06, 0x0F, EMPTY
+#define Redi    0x07, 0x0F, EMPTY
+#define Reg8    0x08, 0x0F, EMPTY
+#define Reg9    0x09, 0x0F, EMPTY
+#define RegA    0x0A, 0x0F, EMPTY
+#define RegB    0x0B, 0x0F, EMPTY
+#define RegC    0x0C, 0x0F, EMPTY
+#define RegD    0x0D, 0x0F, EMPTY
+#define RegE    0x0E, 0x0F, EMPTY
+
+/* addressing   REG,  MOD,  SIB */
+
+#define Oeax    0x00, 0x0F, EMPTY       /* [eax] */
+
+#define Mecx    0x01, 0x0F, EMPTY       /* [ecx + DP] */
+#define Medx    0x02, 0x0F, EMPTY       /* [edx + DP] */
+#define Mebx    0x03, 0x0F, EMPTY       /* [ebx + DP] */
+#define Mebp    0x05, 0x0F, EMPTY       /* [ebp + DP] */
+#define Mesi    0x06, 0x0F, EMPTY       /* [esi + DP] */
+#define Medi    0x07, 0x0F, EMPTY       /* [edi + DP] */
+#define Meg8    0x08, 0x0F, EMPTY       /* [r8d + DP] */
+#define Meg9    0x09, 0x0F, EMPTY       /* [r9d + DP] */
+#define MegA    0x0A, 0x0F, EMPTY       /* [r10d + DP] */
+#define MegB    0x0B, 0x0F, EMPTY       /* [r11d + DP] */
+#define MegC    0x0C, 0x0F, EMPTY       /* [r12d + DP] */
+#define MegD    0x0D, 0x0F, EMPTY       /* [r13d + DP] */
+#define MegE    0x0E, 0x0F, EMPTY       /* [r14d + DP] */
+
+#define Iecx    0x01, 0x00, EMPTY       /* [ecx + eax + DP] */
+#define Iedx    0x02, 0x00, EMPTY       /* [edx + eax + DP] */
+#define Iebx    0x03, 0x00, EMPTY       /* [ebx + eax + DP] */
+#define Iebp    0x05, 0x00, EMPTY       /* [ebp + eax + DP] */
+#define Iesi    0x06, 0x00, EMPTY       /* [esi + eax + DP] */
+#define Iedi    0x07, 0x00, EMPTY       /* [edi + eax + DP] */
+#define Ieg8    0x08, 0x00, EMPTY       /* [r8d + eax + DP] */
+#define Ieg9    0x09, 0x00, EMPTY       /* [r9d + eax + DP] */
+#define IegA    0x0A, 0x00, EMPTY       /* [r10d + eax + DP] */
+#define IegB    0x0B, 0x00, EMPTY       /* [r11d + eax + DP] */
+#define IegC    0x0C, 0x00, EMPTY       /* [r12d + eax + DP] */
+#define IegD    0x0D, 0x00, EMPTY       /* [r13d + eax + DP] */
+#define IegE    0x0E, 0x00, EMPTY       /* [r14d + eax + DP] */
+
+/* immediate    VAL,  TYP,  CMD */
+
+#define IB(im)  (im), 0x00, EMPTY
+#define IH(im)  (im), 0x00, EMPTY
+#define IW(im)  (im), 0x00, EMPTY
+
+/* displacement VAL,  TYP,  CMD */
+
+#define DP(im)  (im), 0x00, EMPTY
+#define DH(im)  (im), 0x00, EMPTY
+#define DW(im)  (im), 0x00, EMPTY
+
+#define PLAIN   DP(0)
+
+/* triplet pass-through wrapper */
+
+#define W(p1, p2, p3)       p1,  p2,  p3
+
+/******************************************************************************/
+/**********************************   REF   ***********************************/
+/******************************************************************************/
+
+/* mov */
+
+#define movxx_ri(RM, IM)                                                    \
+        GPR(RM) = SXT(VAL(IM));
+
+#define movxx_mi(RM, DP, IM)                                                \
+        {   rt_word m = (rt_word)VAL(IM);                                   \
+            STM(m, W(RM), W(DP))    }
+
+#define movxx_rr(RG, RM)                                                    \
+        GPR(RG) = GPR(RM);
+
+#define movxx_ld(RG, RM, DP)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            GPR(RG) = m;            }
+
+#define movxx_st(RG, RM, DP)                                                \
+        {   rt_word m = (rt_word)GPR(RG);                                   \
+            STM(m, W(RM), W(DP))    }
+
+#define movxa_ld(RG, RM, DP) /* address-sized load */                       \
+        {   rt_addr m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            GPR(RG) = m;            }
+
+#define movxa_st(RG, RM, DP) /* address-sized store */                      \
+        {   rt_addr m = (rt_addr)GPR(RG);                                   \
+            STM(m, W(RM), W(DP))    }
+
+#define adrxx_ld(RG, RM, DP)                                                \
+        GPR(RG) = ADR(RM, DP);
+
+#define adrxx_lb(lb) /* load label to Reax */                               \
+        label_ld(lb)
+
+#define stack_st(RM)                                                        \
+        ref.r[0x04] -= sizeof(rt_full);                                     \
+        STM(GPR(RM), W(0x04, 0x0F, EMPTY), PLAIN)
+
+#define stack_ld(RM)                                                        \
+        LDM(GPR(RM), W(0x04, 0x0F, EMPTY), PLAIN)                           \
+        ref.r[0x04] += sizeof(rt_full);
+
+#define stack_sa() /* save all [EAX - R14], 15 regs in total */             \
+        {   rt_full m = ref.r[0x04];                                        \
+            stack_st(Reax)                                                  \
+            stack_st(Recx)                                                  \
+            stack_st(Redx)                                                  \
+            stack_st(Rebx)                                                  \
+            ref.r[0x04] -= sizeof(rt_full); /* original Resp */             \
+            STM(m, W(0x04, 0x0F, EMPTY), PLAIN)                             \
+            stack_st(Rebp)                                                  \
+            stack_st(Resi)                                                  \
+            stack_st(Redi)                                                  \
+            stack_st(Reg8)                                                  \
+            stack_st(Reg9)                                                  \
+            stack_st(RegA)                                                  \
+            stack_st(RegB)                                                  \
+            stack_st(RegC)                                                  \
+            stack_st(RegD)                                                  \
+            stack_st(RegE)          }
+
+#define stack_la() /* load all [R14 - EAX], 15 regs in total */             \
+        stack_ld(RegE)                                                      \
+        stack_ld(RegD)                                                      \
+        stack_ld(RegC)                                                      \
+        stack_ld(RegB)                                                      \
+        stack_ld(RegA)                                                      \
+        stack_ld(Reg9)                                                      \
+        stack_ld(Reg8)                                                      \
+        stack_ld(Redi)                                                      \
+        stack_ld(Resi)                                                      \
+        stack_ld(Rebp)                                                      \
+        ref.r[0x04] += sizeof(rt_full); /* skip saved Resp */               \
+        stack_ld(Rebx)                                                      \
+        stack_ld(Redx)                                                      \
+        stack_ld(Recx)                                                      \
+        stack_ld(Reax)
+
+/* and */
+
+#define andxx_ri(RM, IM)                                                    \
+        GPR(RM) &= SXT(VAL(IM));
+
+#define andxx_mi(RM, DP, IM)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m &= (rt_word)VAL(IM);                                          \
+            STM(m, W(RM), W(DP))    }
+
+#define andxx_rr(RG, RM)                                                    \
+        GPR(RG) &= GPR(RM);
+
+#define andxx_ld(RG, RM, DP)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            GPR(RG) &= SXT(m);      }
+
+#define andxx_st(RG, RM, DP)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m &= (rt_word)GPR(RG);                                          \
+            STM(m, W(RM), W(DP))    }
+
+/* orr */
+
+#define orrxx_ri(RM, IM)                                                    \
+        GPR(RM) |= SXT(VAL(IM));
+
+#define orrxx_mi(RM, DP, IM)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m |= (rt_word)VAL(IM);                                          \
+            STM(m, W(RM), W(DP))    }
+
+#define orrxx_rr(RG, RM)                                                    \
+        GPR(RG) |= GPR(RM);
+
+#define orrxx_ld(RG, RM, DP)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            GPR(RG) |= SXT(m);      }
+
+#define orrxx_st(RG, RM, DP)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m |= (rt_word)GPR(RG);                                          \
+            STM(m, W(RM), W(DP))    }
+
+/* not */
+
+#define notxx_rr(RM)                                                        \
+        GPR(RM) = ~GPR(RM);
+
+#define notxx_mm(RM, DP)                                                    \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m = ~m;                                                         \
+            STM(m, W(RM), W(DP))    }
+
+/* add */
+
+#define addxx_ri(RM, IM)                                                    \
+        GPR(RM) += SXT(VAL(IM));
+
+#define addxx_mi(RM, DP, IM)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m += (rt_word)VAL(IM);                                          \
+            STM(m, W(RM), W(DP))    }
+
+#define addxx_rr(RG, RM)                                                    \
+        GPR(RG) += GPR(RM);
+
+#define addxx_ld(RG, RM, DP)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            GPR(RG) += SXT(m);      }
+
+#define addxx_st(RG, RM, DP)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m += (rt_word)GPR(RG);                                          \
+            STM(m, W(RM), W(DP))    }
+
+/* sub */
+
+#define subxx_ri(RM, IM)                                                    \
+        GPR(RM) -= SXT(VAL(IM));
+
+#define subxx_mi(RM, DP, IM)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m -= (rt_word)VAL(IM);                                          \
+            STM(m, W(RM), W(DP))    }
+
+#define subxx_rr(RG, RM)                                                    \
+        GPR(RG) -= GPR(RM);
+
+#define subxx_ld(RG, RM, DP)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            GPR(RG) -= SXT(m);      }
+
+#define subxx_st(RG, RM, DP)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m -= (rt_word)GPR(RG);                                          \
+            STM(m, W(RM), W(DP))    }
+
+#define subxx_mr(RM, DP, RG)                                                \
+        subxx_st(W(RG), W(RM), W(DP))
+
+/* shl */
+
+#define shlxx_ri(RM, IM)                                                    \
+        GPR(RM) = (rt_word)((rt_word)GPR(RM) << (VAL(IM) & 0x1F));
+
+#define shlxx_mi(RM, DP, IM)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m <<= VAL(IM) & 0x1F;                                           \
+            STM(m, W(RM), W(DP))    }
+
+/* shr */
+
+#define shrxx_ri(RM, IM)                                                    \
+        GPR(RM) = (rt_word)((rt_word)GPR(RM) >> (VAL(IM) & 0x1F));
+
+#define shrxx_mi(RM, DP, IM)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m >>= VAL(IM) & 0x1F;                                           \
+            STM(m, W(RM), W(DP))    }
+
+#define shrxn_ri(RM, IM)                                                    \
+        GPR(RM) = (rt_word)((rt_cell)GPR(RM) >> (VAL(IM) & 0x1F));
+
+#define shrxn_mi(RM, DP, IM)                                                \
+        {   rt_cell m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            m >>= VAL(IM) & 0x1F;                                           \
+            STM(m, W(RM), W(DP))    }
+
+/* mul */
+
+#define mulxn_ri(RM, IM)                                                    \
+        GPR(RM) = (rt_word)((rt_word)GPR(RM) * (rt_word)VAL(IM));
+
+#define mulxn_rr(RG, RM)                                                    \
+        GPR(RG) = (rt_word)((rt_word)GPR(RG) * (rt_word)GPR(RM));
+
+#define mulxn_ld(RG, RM, DP)                                                \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            GPR(RG) = (rt_word)((rt_word)GPR(RG) * m);                      }
+
+#define mulxn_xm(RM, DP) /* Reax is in/out, destroys Redx */                \
+        {   rt_cell m; rt_si64 p;                                           \
+            LDM(m, W(RM), W(DP))                                            \
+            p = (rt_si64)(rt_cell)ref.r[0x00] * m;                          \
+            ref.r[0x00] = (rt_word)(p >> 0x00);                             \
+            ref.r[0x02] = (rt_word)(p >> 0x20);                             }
+
+/* div */
+
+#define divxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        {   rt_word m, a = (rt_word)ref.r[0x00];                            \
+            LDM(m, W(RM), W(DP))                                            \
+            ref.r[0x00] = m != 0 ? a / m : 0;                               \
+            ref.r[0x02] = m != 0 ? a % m : a;                               }
+
+#define divxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
+        {   rt_cell m, a = (rt_cell)ref.r[0x00];                            \
+            LDM(m, W(RM), W(DP))                                            \
+            m = a == (rt_cell)0x80000000 && m == -1 ? 1 : m;                \
+            ref.r[0x00] = (rt_word)(m != 0 ? a / m : 0);                    \
+            ref.r[0x02] = (rt_word)(m != 0 ? a % m : a);                    }
+
+/* rem */
+
+#define remxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        divxx_xm(W(RM), W(DP)) /* remainder in Redx */
+
+#define remxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
+        divxn_xm(W(RM), W(DP)) /* remainder in Redx */
+
+/* cmp */
+
+#define cmpxx_ri(RM, IM)                                                    \
+        ref.cl = (rt_word)GPR(RM);                                          \
+        ref.cr = (rt_word)VAL(IM);
+
+#define cmpxx_mi(RM, DP, IM)                                                \
+        LDM(ref.cl, W(RM), W(DP))                                           \
+        ref.cr = (rt_word)VAL(IM);
+
+#define cmpxx_rr(RG, RM)                                                    \
+        ref.cl = (rt_word)GPR(RG);                                          \
+        ref.cr = (rt_word)GPR(RM);
+
+#define cmpxx_rm(RG, RM, DP)                                                \
+        ref.cl = (rt_word)GPR(RG);                                          \
+        LDM(ref.cr, W(RM), W(DP))
+
+#define cmpxx_mr(RM, DP, RG)                                                \
+        LDM(ref.cl, W(RM), W(DP))                                           \
+        ref.cr = (rt_word)GPR(RG);
+
+/* jmp */
+
+#define jmpxx_mm(RM, DP)                                                    \
+        {   rt_pntr m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            goto *m;                }
+
+#define jmpxx_lb(lb)                                                        \
+        goto lb;
+
+#define jeqxx_lb(lb)                                                        \
+        if (ref.cl == ref.cr) goto lb;
+
+#define jnexx_lb(lb)                                                        \
+        if (ref.cl != ref.cr) goto lb;
+
+#define jnzxx_lb(lb)                                                        \
+        if (ref.cl != ref.cr) goto lb;
+
+#define jltxx_lb(lb)                                                        \
+        if (ref.cl <  ref.cr) goto lb;
+
+#define jlexx_lb(lb)                                                        \
+        if (ref.cl <= ref.cr) goto lb;
+
+#define jgtxx_lb(lb)                                                        \
+        if (ref.cl >  ref.cr) goto lb;
+
+#define jgexx_lb(lb)                                                        \
+        if (ref.cl >= ref.cr) goto lb;
+
+#define jltxn_lb(lb)                                                        \
+        if ((rt_cell)ref.cl <  (rt_cell)ref.cr) goto lb;
+
+#define jlexn_lb(lb)                                                        \
+        if ((rt_cell)ref.cl <= (rt_cell)ref.cr) goto lb;
+
+#define jgtxn_lb(lb)                                                        \
+        if ((rt_cell)ref.cl >  (rt_cell)ref.cr) goto lb;
+
+#define jgexn_lb(lb)                                                        \
+        if ((rt_cell)ref.cl >= (rt_cell)ref.cr) goto lb;
+
+#define LBL(lb)                                                             \
+        lb: ;
+
+#endif /* RT_RTARCH_REF_H */
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
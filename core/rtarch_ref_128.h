@@ -0,0 +1,859 @@
+/******************************************************************************/
+/* Copyright (c) 2013-2015 VectorChief (at github, bitbucket, sourceforge)    */
+/* Distributed under the MIT software license, see the accompanying           */
+/* file COPYING or http://www.opensource.org/licenses/mit-license.php         */
+/******************************************************************************/
+
+#ifndef RT_RTARCH_REF_128_H
+#define RT_RTARCH_REF_128_H
+
+#include <fenv.h>
+
+#include "rtarch_ref.h"
+
+/* all 16 SIMD registers are emulated, build with -DRT_SIMD_REGS=8
+ * to check kernel paths of 8-register targets (x86, ARM) */
+#ifndef RT_SIMD_REGS
+#define RT_SIMD_REGS        16
+#endif /* RT_SIMD_REGS */
+
+#define RT_SIMD_WIDTH       4
+#define RT_SIMD_ALIGN       16
+#define RT_SIMD_SET(s, v)   s[0]=s[1]=s[2]=s[3]=v
+
+#define RT_SIMD_WIDTH64     2
+#define RT_SIMD_SET64(s, v) s[0]=s[1]=v
+
+/******************************************************************************/
+/*********************************   LEGEND   *********************************/
+/******************************************************************************/
+
+/*
+ * rtarch_ref_128.h: Implementation of reference 128-bit SIMD instructions.
+ *
+ * This file is a part of the unified SIMD assembler framework (rtarch.h)
+ * designed to be compatible with different processor architectures,
+ * while maintaining strictly defined common API.
+ *
+ * Recommended naming scheme for instructions:
+ *
+ * cmdp*_ri - applies [cmd] to [p]acked: [r]egister from [i]mmediate
+ * cmdp*_rr - applies [cmd] to [p]acked: [r]egister from [r]egister
+ *
+ * cmdp*_rm - applies [cmd] to [p]acked: [r]egister from [m]emory
+ * cmdp*_ld - applies [cmd] to [p]acked: as above
+ * cmdp*_mr - applies [cmd] to [p]acked: [m]emory   from [r]egister
+ * cmdp*_st - applies [cmd] to [p]acked: as above (arg list as cmdxx_ld)
+ *
+ * cmdpx_** - applies [cmd] to [p]acked unsigned integer args, [x] - default
+ * cmdpn_** - applies [cmd] to [p]acked   signed integer args, [n] - negatable
+ * cmdps_** - applies [cmd] to [p]acked floating point   args, [s] - scalable
+ * cmdpd_** - applies [cmd] to [p]acked double precision args, [d] - double
+ *
+ * cmdpb_** - applies [cmd] to [p]acked unsigned  8-bit integer args, [b]yte
+ * cmdph_** - applies [cmd] to [p]acked unsigned 16-bit integer args, [h]alf
+ *
+ * The cmdp*_** instructions are intended for SPMD programming model
+ * and can potentially be configured per target to work with 32-bit/64-bit
+ * data-elements (integers/pointers, floating point).
+ * In this model data paths are fixed-width, core and SIMD data-elements are
+ * width-compatible, code path divergence is handled via CHECK_MASK macro.
+ *
+ * The cmdpb_**, cmdph_** instructions are intended for pixel/image kernels
+ * and work with fixed-width 8-bit/16-bit data-elements regardless of target,
+ * thus a register holds 4*S bytes or 2*S halfwords respectively.
+ *
+ * The cmdpd_** instructions work with 64-bit floating point data-elements,
+ * thus a register holds RT_SIMD_WIDTH64 (S/2) doubles.
+ *
+ * Floating point instructions produce IEEE results of the host's C compiler
+ * in the current rounding mode (build with -frounding-math), no denormals
+ * are flushed, rceps/rseps return exact reciprocals instead of estimates.
+ * Comparisons are ordered (false for NaNs) except cne, min/max return
+ * the second operand if either is NaN (as x86), out-of-range and NaN inputs
+ * of cvtps produce 0x80000000 (as x86), integer ops wrap around.
+ */
+
+/******************************************************************************/
+/********************************   INTERNAL   ********************************/
+/******************************************************************************/
+
+/* structural */
+
+#define VEC(reg, mod, sib)  ref.x[reg]
+
+#define FOR(n, op) /* applies op to lanes 0 .. n-1 indexed by i */          \
+        {   rt_cell i;                                                      \
+            for (i = 0; i < (n); i++) { op; }                               }
+
+/* registers    REG,  MOD,  SIB */
+
+#define Tmm1    0x10, 0x08, EMPTY       /* temp for memory operands */
+#define Tmm2    0x11, 0x08, EMPTY       /* temp for cross-lane ops */
+
+/* register file */
+
+union rt_REF_SIMD
+{
+    rt_word word[RT_SIMD_WIDTH];
+    rt_cell cell[RT_SIMD_WIDTH];
+    rt_fp32 fp32[RT_SIMD_WIDTH];
+    rt_full full[RT_SIMD_WIDTH/2];
+    rt_fp64 fp64[RT_SIMD_WIDTH/2];
+    rt_half half[RT_SIMD_WIDTH*2];
+    rt_shrt shrt[RT_SIMD_WIDTH*2];
+    rt_byte byte[RT_SIMD_WIDTH*4];
+};
+
+struct rt_REF_REGS : public rt_REF_CORE
+{
+    rt_REF_SIMD x[18];      /* Xmm0 - XmmF, Tmm1, Tmm2 */
+};
+
+/******************************************************************************/
+/********************************   EXTERNAL   ********************************/
+/******************************************************************************/
+
+/* registers    REG,  MOD,  SIB */
+
+#define Xmm0    0x00, 0x08, EMPTY
+#define Xmm1    0x01, 0x08, EMPTY
+#define Xmm2    0x02, 0x08, EMPTY
+#define Xmm3    0x03, 0x08, EMPTY
+#define Xmm4    0x04, 0x08, EMPTY
+#define Xmm5    0x05, 0x08, EMPTY
+#define Xmm6    0x06, 0x08, EMPTY
+#define Xmm7    0x07, 0x08, EMPTY
+#define Xmm8    0x08, 0x08, EMPTY
+#define Xmm9    0x09, 0x08, EMPTY
+#define XmmA    0x0A, 0x08, EMPTY
+#define XmmB    0x0B, 0x08, EMPTY
+#define XmmC    0x0C, 0x08, EMPTY
+#define XmmD    0x0D, 0x08, EMPTY
+#define XmmE    0x0E, 0x08, EMPTY
+#define XmmF    0x0F, 0x08, EMPTY
+
+/******************************************************************************/
+/**********************************   REF   ***********************************/
+/******************************************************************************/
+
+/**************************   packed generic (SIMD)   *************************/
+
+/* mov */
+
+#define movpx_rr(RG, RM)                                                    \
+        VEC(RG) = VEC(RM);
+
+#define movpx_ld(RG, RM, DP)                                                \
+        LDM(VEC(RG), W(RM), W(DP))
+
+#define movpx_st(RG, RM, DP)                                                \
+        STM(VEC(RG), W(RM), W(DP))
+
+#define adrpx_ld(RG, RM, DP) /* RG is a core reg, DP is SIMD-aligned */     \
+        GPR(RG) = ADR(W(RM), VAL(DP) & ~(RT_SIMD_ALIGN - 1), 0x00, EMPTY);
+
+#define movlx_ld(RG, RM, DP) /* lower half from memory, upper zeroed */     \
+        memset(&VEC(RG), 0, sizeof(rt_REF_SIMD));                           \
+        LDM(VEC(RG).full[0], W(RM), W(DP))
+
+#define movlx_st(RG, RM, DP) /* lower half to memory */                     \
+        STM(VEC(RG).full[0], W(RM), W(DP))
+
+#define movux_ld(RG, RM, DP) /* full vector from unaligned memory */        \
+        LDM(VEC(RG), W(RM), W(DP))
+
+#define movnx_st(RG, RM, DP) /* non-temporal, bypasses caches */            \
+        STM(VEC(RG), W(RM), W(DP))
+
+#define prfxx_ld(RM, DP) /* prefetch cache line into all levels */          \
+        EMPTY
+
+#define fence_st() /* orders preceding non-temporal stores */               \
+        EMPTY
+
+/* and */
+
+#define andpx_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).word[i] &= VEC(RM).word[i])
+
+#define andpx_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        andpx_rr(W(RG), Tmm1)
+
+/* ann */
+
+#define annpx_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).word[i] = ~VEC(RG).word[i] & VEC(RM).word[i])
+
+#define annpx_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        annpx_rr(W(RG), Tmm1)
+
+/* orr */
+
+#define orrpx_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).word[i] |= VEC(RM).word[i])
+
+#define orrpx_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        orrpx_rr(W(RG), Tmm1)
+
+/* xor */
+
+#define xorpx_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).word[i] ^= VEC(RM).word[i])
+
+#define xorpx_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        xorpx_rr(W(RG), Tmm1)
+
+/**************   packed single precision floating point (SIMD)   *************/
+
+/* add */
+
+#define addps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).fp32[i] += VEC(RM).fp32[i])
+
+#define addps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        addps_rr(W(RG), Tmm1)
+
+/* sub */
+
+#define subps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).fp32[i] -= VEC(RM).fp32[i])
+
+#define subps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        subps_rr(W(RG), Tmm1)
+
+/* mul */
+
+#define mulps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).fp32[i] *= VEC(RM).fp32[i])
+
+#define mulps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        mulps_rr(W(RG), Tmm1)
+
+/* div */
+
+#define divps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).fp32[i] /= VEC(RM).fp32[i])
+
+#define divps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        divps_rr(W(RG), Tmm1)
+
+/* sqr */
+
+#define sqrps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).fp32[i] = sqrtf(VEC(RM).fp32[i]))
+
+#define sqrps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        sqrps_rr(W(RG), Tmm1)
+
+/* cbr */
+
+        /* cbe, cbs, cbr defined in rtarch.h
+         * under "COMMON SIMD INSTRUCTIONS" section */
+
+/* rcp */
+
+#define rceps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).fp32[i] = 1.0f / VEC(RM).fp32[i])
+
+#define rcsps_rr(RG, RM) /* destroys RM */                                  \
+        mulps_rr(W(RM), W(RG))                                              \
+        mulps_rr(W(RM), W(RG))                                              \
+        addps_rr(W(RG), W(RG))                                              \
+        subps_rr(W(RG), W(RM))
+
+        /* rcp defined in rtarch.h
+         * under "COMMON SIMD INSTRUCTIONS" section */
+
+/* rsq */
+
+#define rseps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).fp32[i] = 1.0f / sqrtf(VEC(RM).fp32[i]))
+
+#define rssps_rr(RG, RM) /* destroys RM */                                  \
+        mulps_rr(W(RM), W(RG))                                              \
+        mulps_rr(W(RM), W(RG))                                              \
+        subps_ld(W(RM), Mebp, inf_GPC03)                                    \
+        mulps_ld(W(RM), Mebp, inf_GPC02)                                    \
+        mulps_rr(W(RG), W(RM))
+
+        /* rsq defined in rtarch.h
+         * under "COMMON SIMD INSTRUCTIONS" section */
+
+/* min */
+
+#define minps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).fp32[i] = VEC(RG).fp32[i] < VEC(RM).fp32[i] ?        \
+                                 VEC(RG).fp32[i] : VEC(RM).fp32[i])
+
+#define minps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        minps_rr(W(RG), Tmm1)
+
+/* max */
+
+#define maxps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).fp32[i] = VEC(RG).fp32[i] > VEC(RM).fp32[i] ?        \
+                                 VEC(RG).fp32[i] : VEC(RM).fp32[i])
+
+#define maxps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        maxps_rr(W(RG), Tmm1)
+
+/* cmp */
+
+#define ceqps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).cell[i] = -(VEC(RG).fp32[i] == VEC(RM).fp32[i]))
+
+#define ceqps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        ceqps_rr(W(RG), Tmm1)
+
+#define cneps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).cell[i] = -(VEC(RG).fp32[i] != VEC(RM).fp32[i]))
+
+#define cneps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cneps_rr(W(RG), Tmm1)
+
+#define cltps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).cell[i] = -(VEC(RG).fp32[i] <  VEC(RM).fp32[i]))
+
+#define cltps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cltps_rr(W(RG), Tmm1)
+
+#define cleps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).cell[i] = -(VEC(RG).fp32[i] <= VEC(RM).fp32[i]))
+
+#define cleps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cleps_rr(W(RG), Tmm1)
+
+#define cgtps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).cell[i] = -(VEC(RG).fp32[i] >  VEC(RM).fp32[i]))
+
+#define cgtps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cgtps_rr(W(RG), Tmm1)
+
+#define cgeps_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).cell[i] = -(VEC(RG).fp32[i] >= VEC(RM).fp32[i]))
+
+#define cgeps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cgeps_rr(W(RG), Tmm1)
+
+/**************   packed double precision floating point (SIMD)   *************/
+
+/* add */
+
+#define addpd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).fp64[i] += VEC(RM).fp64[i])
+
+#define addpd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        addpd_rr(W(RG), Tmm1)
+
+/* sub */
+
+#define subpd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).fp64[i] -= VEC(RM).fp64[i])
+
+#define subpd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        subpd_rr(W(RG), Tmm1)
+
+/* mul */
+
+#define mulpd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).fp64[i] *= VEC(RM).fp64[i])
+
+#define mulpd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        mulpd_rr(W(RG), Tmm1)
+
+/* div */
+
+#define divpd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).fp64[i] /= VEC(RM).fp64[i])
+
+#define divpd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        divpd_rr(W(RG), Tmm1)
+
+/* sqr */
+
+#define sqrpd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).fp64[i] = sqrt(VEC(RM).fp64[i]))
+
+#define sqrpd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        sqrpd_rr(W(RG), Tmm1)
+
+/* min */
+
+#define minpd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).fp64[i] = VEC(RG).fp64[i] < VEC(RM).fp64[i] ?      \
+                                   VEC(RG).fp64[i] : VEC(RM).fp64[i])
+
+#define minpd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        minpd_rr(W(RG), Tmm1)
+
+/* max */
+
+#define maxpd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).fp64[i] = VEC(RG).fp64[i] > VEC(RM).fp64[i] ?      \
+                                   VEC(RG).fp64[i] : VEC(RM).fp64[i])
+
+#define maxpd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        maxpd_rr(W(RG), Tmm1)
+
+/* cmp */
+
+#define ceqpd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).full[i] = -(rt_full)(VEC(RG).fp64[i] ==            \
+                                              VEC(RM).fp64[i]))
+
+#define ceqpd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        ceqpd_rr(W(RG), Tmm1)
+
+#define cnepd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).full[i] = -(rt_full)(VEC(RG).fp64[i] !=            \
+                                              VEC(RM).fp64[i]))
+
+#define cnepd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cnepd_rr(W(RG), Tmm1)
+
+#define cltpd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).full[i] = -(rt_full)(VEC(RG).fp64[i] <             \
+                                              VEC(RM).fp64[i]))
+
+#define cltpd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cltpd_rr(W(RG), Tmm1)
+
+#define clepd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).full[i] = -(rt_full)(VEC(RG).fp64[i] <=            \
+                                              VEC(RM).fp64[i]))
+
+#define clepd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        clepd_rr(W(RG), Tmm1)
+
+#define cgtpd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).full[i] = -(rt_full)(VEC(RG).fp64[i] >             \
+                                              VEC(RM).fp64[i]))
+
+#define cgtpd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cgtpd_rr(W(RG), Tmm1)
+
+#define cgepd_rr(RG, RM)                                                    \
+        FOR(S/2, VEC(RG).full[i] = -(rt_full)(VEC(RG).fp64[i] >=            \
+                                              VEC(RM).fp64[i]))
+
+#define cgepd_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cgepd_rr(W(RG), Tmm1)
+
+/* cvt (fp32 <-> fp64) */
+
+#define cvtsd_rr(RG, RM) /* lower S/2 fp32 elements to fp64 */              \
+        movpx_rr(Tmm2, W(RM))                                               \
+        FOR(S/2, VEC(RG).fp64[i] = ref.x[0x11].fp32[i])
+
+#define cvtds_rr(RG, RM) /* fp64 elements to lower S/2 fp32, zero upper */  \
+        movpx_rr(Tmm2, W(RM))                                               \
+        FOR(S/2, VEC(RG).fp32[i] = (rt_fp32)ref.x[0x11].fp64[i])            \
+        FOR(S/2, VEC(RG).word[i + S/2] = 0)
+
+/**************************   packed integer (SIMD)   *************************/
+
+/* cvt */
+
+#define cvtps_rr(RG, RM) /* rounds in the current mode */                   \
+        FOR(S, VEC(RG).cell[i] = VEC(RM).fp32[i] > -2147483648.0f &&        \
+                                 VEC(RM).fp32[i] <  2147483648.0f ?         \
+                        (rt_cell)rintf(VEC(RM).fp32[i]) : (rt_cell)0x80000000)
+
+#define cvtps_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cvtps_rr(W(RG), Tmm1)
+
+#define cvtpn_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).fp32[i] = (rt_fp32)VEC(RM).cell[i])
+
+#define cvtpn_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cvtpn_rr(W(RG), Tmm1)
+
+/* add */
+
+#define addpx_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).word[i] += VEC(RM).word[i])
+
+#define addpx_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        addpx_rr(W(RG), Tmm1)
+
+/* sub */
+
+#define subpx_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).word[i] -= VEC(RM).word[i])
+
+#define subpx_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        subpx_rr(W(RG), Tmm1)
+
+/* shl */
+
+#define shlpx_ri(RM, IM)                                                    \
+        FOR(S, VEC(RM).word[i] <<= VAL(IM) & 0x1F)
+
+#define shlpx_ld(RG, RM, DP) /* loads SIMD, uses 1 elem at given address */ \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        FOR(S, VEC(RG).word[i] = ref.x[0x10].word[0] > 0x1F ? 0 :           \
+                                 VEC(RG).word[i] << ref.x[0x10].word[0])
+
+/* shr */
+
+#define shrpx_ri(RM, IM)                                                    \
+        FOR(S, VEC(RM).word[i] >>= VAL(IM) & 0x1F)
+
+#define shrpx_ld(RG, RM, DP) /* loads SIMD, uses 1 elem at given address */ \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        FOR(S, VEC(RG).word[i] = ref.x[0x10].word[0] > 0x1F ? 0 :           \
+                                 VEC(RG).word[i] >> ref.x[0x10].word[0])
+
+#define shrpn_ri(RM, IM)                                                    \
+        FOR(S, VEC(RM).cell[i] >>= VAL(IM) & 0x1F)
+
+#define shrpn_ld(RG, RM, DP) /* loads SIMD, uses 1 elem at given address */ \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        FOR(S, VEC(RG).cell[i] >>= RT_MIN(ref.x[0x10].word[0], 0x1F))
+
+/* cgt (signed) */
+
+#define cgtpn_rr(RG, RM)                                                    \
+        FOR(S, VEC(RG).cell[i] = -(VEC(RG).cell[i] >  VEC(RM).cell[i]))
+
+#define cgtpn_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        cgtpn_rr(W(RG), Tmm1)
+
+/***********************   packed byte/half integer (SIMD)   ******************/
+
+/* add */
+
+#define addpb_rr(RG, RM)                                                    \
+        FOR(S*4, VEC(RG).byte[i] += VEC(RM).byte[i])
+
+#define addpb_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        addpb_rr(W(RG), Tmm1)
+
+#define addph_rr(RG, RM)                                                    \
+        FOR(S*2, VEC(RG).half[i] += VEC(RM).half[i])
+
+#define addph_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        addph_rr(W(RG), Tmm1)
+
+/* ads (add with unsigned saturation) */
+
+#define adspb_rr(RG, RM)                                                    \
+        FOR(S*4, VEC(RG).byte[i] = RT_MIN(VEC(RG).byte[i] +                 \
+                                          VEC(RM).byte[i], 0xFF))
+
+#define adspb_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        adspb_rr(W(RG), Tmm1)
+
+#define adsph_rr(RG, RM)                                                    \
+        FOR(S*2, VEC(RG).half[i] = RT_MIN(VEC(RG).half[i] +                 \
+                                          VEC(RM).half[i], 0xFFFF))
+
+#define adsph_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        adsph_rr(W(RG), Tmm1)
+
+/* sub */
+
+#define subpb_rr(RG, RM)                                                    \
+        FOR(S*4, VEC(RG).byte[i] -= VEC(RM).byte[i])
+
+#define subpb_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        subpb_rr(W(RG), Tmm1)
+
+#define subph_rr(RG, RM)                                                    \
+        FOR(S*2, VEC(RG).half[i] -= VEC(RM).half[i])
+
+#define subph_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        subph_rr(W(RG), Tmm1)
+
+/* sbs (sub with unsigned saturation) */
+
+#define sbspb_rr(RG, RM)                                                    \
+        FOR(S*4, VEC(RG).byte[i] = RT_MAX(VEC(RG).byte[i] -                 \
+                                          VEC(RM).byte[i], 0x00))
+
+#define sbspb_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        sbspb_rr(W(RG), Tmm1)
+
+#define sbsph_rr(RG, RM)                                                    \
+        FOR(S*2, VEC(RG).half[i] = RT_MAX(VEC(RG).half[i] -                 \
+                                          VEC(RM).half[i], 0x0000))
+
+#define sbsph_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        sbsph_rr(W(RG), Tmm1)
+
+/* avg (rounded average, (a + b + 1) >> 1) */
+
+#define avgpb_rr(RG, RM)                                                    \
+        FOR(S*4, VEC(RG).byte[i] = (VEC(RG).byte[i] +                       \
+                                    VEC(RM).byte[i] + 1) >> 1)
+
+#define avgpb_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        avgpb_rr(W(RG), Tmm1)
+
+#define avgph_rr(RG, RM)                                                    \
+        FOR(S*2, VEC(RG).half[i] = (VEC(RG).half[i] +                       \
+                                    VEC(RM).half[i] + 1) >> 1)
+
+#define avgph_ld(RG, RM, DP)                                                \
+        movpx_ld(Tmm1, W(RM), W(DP))                                        \
+        avgph_rr(W(RG), Tmm1)
+
+/* unl, unh (widen lower/upper half with zero-extension) */
+
+#define unlpb_rr(RG, RM) /* bytes to halves */                              \
+        movpx_rr(Tmm2, W(RM))                                               \
+        FOR(S*2, VEC(RG).half[i] = ref.x[0x11].byte[i])
+
+#define unhpb_rr(RG, RM) /* bytes to halves */                              \
+        movpx_rr(Tmm2, W(RM))                                               \
+        FOR(S*2, VEC(RG).half[i] = ref.x[0x11].byte[i + S*2])
+
+#define unlph_rr(RG, RM) /* halves to words */                              \
+        movpx_rr(Tmm2, W(RM))                                               \
+        FOR(S, VEC(RG).word[i] = ref.x[0x11].half[i])
+
+#define unhph_rr(RG, RM) /* halves to words */                              \
+        movpx_rr(Tmm2, W(RM))                                               \
+        FOR(S, VEC(RG).word[i] = ref.x[0x11].half[i + S])
+
+/* pck (narrow RG into lower half, RM into upper half with saturation) */
+
+#define pckph_rr(RG, RM) /* signed halves to unsigned bytes */              \
+        movpx_rr(Tmm1, W(RG))                                               \
+        movpx_rr(Tmm2, W(RM))                                               \
+        FOR(S*2, VEC(RG).byte[i] =                                          \
+            RT_MIN(RT_MAX(ref.x[0x10].shrt[i], 0x00), 0xFF))                \
+        FOR(S*2, VEC(RG).byte[i + S*2] =                                    \
+            RT_MIN(RT_MAX(ref.x[0x11].shrt[i], 0x00), 0xFF))
+
+#define pckpn_rr(RG, RM) /* signed words to signed halves */                \
+        movpx_rr(Tmm1, W(RG))                                               \
+        movpx_rr(Tmm2, W(RM))                                               \
+        FOR(S, VEC(RG).shrt[i] =                                            \
+            RT_MIN(RT_MAX(ref.x[0x10].cell[i], -0x8000), 0x7FFF))           \
+        FOR(S, VEC(RG).shrt[i + S] =                                        \
+            RT_MIN(RT_MAX(ref.x[0x11].cell[i], -0x8000), 0x7FFF))
+
+/**********************   lane shift/broadcast (SIMD)   ***********************/
+
+/*
+ * Lane shifts move 32-bit elements of RM up (towards higher lanes, sln)
+ * or down (srn) by IM lanes (1..S-1), vacated lanes are zeroed.
+ * Broadcasts copy element IM (0..S-1) of RM (splpx_ri) or 32-bit element
+ * at [RM + DP] (splpx_ld, DP is not required to be SIMD-aligned)
+ * to all lanes.
+ */
+
+/* sln */
+
+#define slnpx_ri(RM, IM)                                                    \
+        movpx_rr(Tmm1, W(RM))                                               \
+        FOR(S, VEC(RM).word[i] = i < VAL(IM) ? 0 :                          \
+                                 ref.x[0x10].word[i - VAL(IM)])
+
+/* srn */
+
+#define srnpx_ri(RM, IM)                                                    \
+        movpx_rr(Tmm1, W(RM))                                               \
+        FOR(S, VEC(RM).word[i] = i + VAL(IM) >= S ? 0 :                     \
+                                 ref.x[0x10].word[i + VAL(IM)])
+
+/* spl */
+
+#define splpx_ri(RM, IM)                                                    \
+        movpx_rr(Tmm1, W(RM))                                               \
+        FOR(S, VEC(RM).word[i] = ref.x[0x10].word[VAL(IM) & (S - 1)])
+
+#define splpx_ld(RG, RM, DP)                                                \
+        LDM(ref.x[0x10].word[0], W(RM), W(DP))                              \
+        FOR(S, VEC(RG).word[i] = ref.x[0x10].word[0])
+
+/*************************   masked load/store (SIMD)   ***********************/
+
+/*
+ * Lanes with non-zero RK elements are loaded/stored at [base + DP],
+ * other lanes are zeroed in RG on load and left untouched in memory on store,
+ * memory behind masked-out lanes is never accessed (safe for array tails).
+ * RM is a [base + DP] addressing form (Mecx..Medi), RK is not changed.
+ */
+
+/* msk */
+
+#define mskpx_rr(RG, RM) /* RM is a core reg, count of active lanes */      \
+        FOR(S, VEC(RG).cell[i] = -((rt_cell)GPR(RM) > i))
+
+/* mmv */
+
+#define mmvpx_ld(RG, RK, RM, DP) /* RG may be the same as RK */             \
+        FOR(S, ref.x[0x10].word[i] = 0;                                     \
+            if (VEC(RK).word[i] != 0)                                       \
+            LDM(ref.x[0x10].word[i], W(RM),                                 \
+                W(VAL(DP) + i * 4, 0x00, EMPTY)))                           \
+        movpx_rr(W(RG), Tmm1)
+
+#define mmvpx_st(RG, RK, RM, DP) /* RG must not be the same as RK */        \
+        FOR(S, if (VEC(RK).word[i] != 0)                                    \
+            STM(VEC(RG).word[i], W(RM), W(VAL(DP) + i * 4, 0x00, EMPTY)))
+
+/*************************   gather/scatter (SIMD)   **************************/
+
+/*
+ * Lanes are loaded/stored at [base + DP + index*4] with base taken from
+ * the [base + DP] addressing form of RM (Mecx..Medi) and 32-bit element
+ * indices taken from RI, RI is not changed.
+ * Scatter writes lanes in ascending order, later lanes win on collision.
+ */
+
+/* gat */
+
+#define gatpx_ld(RG, RI, RM, DP) /* RG may be the same as RI */             \
+        FOR(S, LDM(ref.x[0x10].word[i], W(RM),                              \
+                   W(VAL(DP) + (rt_si64)VEC(RI).cell[i] * 4, 0x00, EMPTY))) \
+        movpx_rr(W(RG), Tmm1)
+
+/* sca */
+
+#define scapx_st(RG, RI, RM, DP) /* RG must not be the same as RI */        \
+        FOR(S, STM(VEC(RG).word[i], W(RM),                                  \
+                   W(VAL(DP) + (rt_si64)VEC(RI).cell[i] * 4, 0x00, EMPTY)))
+
+/*************************   fp16 conversions (SIMD)   ************************/
+
+#if RT_SIMD_FP16
+
+/*
+ * Conversions are exact (fp16 to fp32) or round to nearest even (fp32 to fp16)
+ * with denormals kept and NaNs converted to the default quiet NaN,
+ * based on the ideas by Fabian Giesen, converted to S-way version.
+ */
+
+/* cvh (S fp16 elements in memory <-> fp32) */
+
+#define cvhps_ld(RG, R1, R2, RM, DP) /* R1, R2 unused (fallback temps) */   \
+        movlx_ld(Tmm1, W(RM), W(DP))                                        \
+        FOR(S, ref.x[0x11].word[i] = (ref.x[0x10].half[i] & 0x7FFF) << 13)  \
+        FOR(S, VEC(RG).word[i] = ref.x[0x11].word[i] + 0x38000000)          \
+        FOR(S, if ((ref.x[0x11].word[i] & 0x0F800000) == 0x0F800000)        \
+               {   VEC(RG).word[i] += 0x38000000; /* inf/nan */             \
+               }                                                            \
+               if ((ref.x[0x11].word[i] & 0x0F800000) == 0x00000000)        \
+               {   VEC(RG).word[i] += 0x00800000; /* zero/denormal */       \
+                   VEC(RG).fp32[i] -= 6.103515625e-05f;                     \
+               })                                                           \
+        FOR(S, VEC(RG).word[i] |= (rt_word)(ref.x[0x10].half[i] & 0x8000) << 16)
+
+#define cvpsh_st(RG, R1, R2, RM, DP) /* R1, R2 unused (fallback temps) */   \
+        movpx_rr(Tmm1, W(RG))                                               \
+        FOR(S, ref.x[0x11].word[i] = ref.x[0x10].word[i] & 0x7FFFFFFF)      \
+        FOR(S, ref.x[0x10].word[i] = ref.x[0x10].word[i] >> 16 & 0x8000)    \
+        FOR(S, if (ref.x[0x11].word[i] >= 0x47800000) /* inf/nan */         \
+               {   ref.x[0x10].word[i] |= ref.x[0x11].word[i] >             \
+                                    0x7F800000 ? 0x7E00 : 0x7C00;           \
+               }                                                            \
+               else                                                         \
+               if (ref.x[0x11].word[i] <  0x38800000) /* zero/denormal */   \
+               {   ref.x[0x11].fp32[i] += 0.5f;                             \
+                   ref.x[0x10].word[i] |= ref.x[0x11].word[i] - 0x3F000000; \
+               }                                                            \
+               else                                                         \
+               {   ref.x[0x11].word[i] += 0xC8000FFF +                      \
+                                       (ref.x[0x11].word[i] >> 13 & 1);     \
+                   ref.x[0x10].word[i] |= ref.x[0x11].word[i] >> 13;        \
+               })                                                           \
+        FOR(S, ref.x[0x11].half[i] = (rt_half)ref.x[0x10].word[i])          \
+        movlx_st(Tmm2, W(RM), W(DP))
+
+#endif /* RT_SIMD_FP16 */
+
+        /* cvh fallback defined in rtarch.h
+         * under "COMMON SIMD INSTRUCTIONS" section */
+
+/*****************************   helper macros   ******************************/
+
+/* simd mask */
+
+#define RT_SIMD_MASK_NONE       0x00    /* none satisfy the condition */
+#define RT_SIMD_MASK_FULL       0x0F    /*  all satisfy the condition */
+
+#define movsn_rr(RG, RM) /* not portable, do not use outside */             \
+        GPR(RG) = 0;                                                        \
+        FOR(S, GPR(RG) |= (VEC(RM).word[i] >> 31) << i)
+
+#define CHECK_MASK(lb, mask, RG) /* destroys Reax */                        \
+        movsn_rr(Reax, W(RG))                                               \
+        cmpxx_ri(Reax, IB(RT_SIMD_MASK_##mask))                             \
+        jeqxx_lb(lb)
+
+/* simd mode */
+
+#define RT_SIMD_MODE_ROUNDN     FE_TONEAREST  /* round to nearest */
+#define RT_SIMD_MODE_ROUNDM     FE_DOWNWARD   /* round towards minus infinity */
+#define RT_SIMD_MODE_ROUNDP     FE_UPWARD     /* round towards plus  infinity */
+#define RT_SIMD_MODE_ROUNDZ     FE_TOWARDZERO /* round towards zero */
+
+#define fctrl_ld(RM, DP) /* not portable, do not use outside */             \
+        {   rt_word m;                                                      \
+            LDM(m, W(RM), W(DP))                                            \
+            fesetround((rt_cell)m); }
+
+#define fctrl_st(RM, DP) /* not portable, do not use outside */             \
+        {   rt_word m = (rt_word)fegetround();                              \
+            STM(m, W(RM), W(DP))    }
+
+#define FCTRL_ENTER(mode) /* destroys Reax */                               \
+        fctrl_st(Mebp, inf_FCTRL)                                           \
+        fesetround(RT_SIMD_MODE_##mode);
+
+#define FCTRL_LEAVE(mode) /* destroys Reax (in ARM) */                      \
+        fctrl_ld(Mebp, inf_FCTRL)
+
+#endif /* RT_RTARCH_REF_128_H */
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
@@ -0,0 +1,527 @@
+/******************************************************************************/
+/* Copyright (c) 2013-2015 VectorChief (at github, bitbucket, sourceforge)    */
+/* Distributed under the MIT software license, see the accompanying           */
+/* file COPYING or http://www.opensource.org/licenses/mit-license.php         */
+/******************************************************************************/
+
+#ifndef RT_RTARCH_X32_H
+#define RT_RTARCH_X32_H
+
+#define RT_CORE_REGS        15
+
+/******************************************************************************/
+/*********************************   LEGEND   *********************************/
+/******************************************************************************/
+
+/*
+ * rtarch_x32.h: Implementation of x86_64 x32 ABI core instructions.
+ *
+ * This file is a part of the unified SIMD assembler framework (rtarch.h)
+ * designed to be compatible with different processor architectures,
+ * while maintaining strictly defined common API.
+ *
+ * Recommended naming scheme for instructions:
+ *
+ * cmdxx_ri - applies [cmd] to [r]egister from [i]mmediate
+ * cmdxx_mi - applies [cmd] to [m]emory   from [i]mmediate
+ *
+ * cmdxx_rm - applies [cmd] to [r]egister from [m]emory
+ * cmdxx_ld - applies [cmd] as above
+ * cmdxx_mr - applies [cmd] to [m]emory   from [r]egister
+ * cmdxx_st - applies [cmd] as above (arg list as cmdxx_ld)
+ *
+ * cmdxx_rr - applies [cmd] to [r]egister from [r]egister
+ * cmdxx_mm - applies [cmd] to [m]emory   from [m]emory
+ * cmdxx_rr - applies [cmd] to [r]egister (one operand cmd)
+ * cmdxx_mm - applies [cmd] to [m]emory   (one operand cmd)
+ *
+ * cmdxx_rx - applies [cmd] to [r]egister from x-register
+ * cmdxx_mx - applies [cmd] to [m]emory   from x-register
+ * cmdxx_xr - applies [cmd] to x-register from [r]egister
+ * cmdxx_xm - applies [cmd] to x-register from [m]emory
+ *
+ * cmdxx_rl - applies [cmd] to [r]egister from [l]abel
+ * cmdxx_xl - applies [cmd] to x-register from [l]abel
+ * cmdxx_lb - applies [cmd] as above
+ * label_ld - applies [adr] as above
+ *
+ * stack_st - applies [mov] to stack from register (push)
+ * stack_ld - applies [mov] to register from stack (pop)
+ * stack_sa - applies [mov] to stack from all registers
+ * stack_la - applies [mov] to all registers from stack
+ *
+ * cmdx*_** - applies [cmd] to core register/memory/immediate args
+ * cmd*x_** - applies [cmd] to unsigned integer args, [x] - default
+ * cmd*n_** - applies [cmd] to   signed integer args, [n] - negatable
+ * cmd*a_** - applies [cmd] to address-sized args, [a] - address
+ *
+ * Argument x-register is fixed by the implementation.
+ * Some formal definitions are not given below to encourage
+ * use of friendly aliases for better code readability.
+ *
+ * Core registers are 64-bit wide in hardware, while pointers are 32-bit
+ * in x32 ABI. Thus all instructions operate on lower 32 bits (zero-extended
+ * into upper 32 bits by hardware), which keeps data-structures containing
+ * pointers laid out exactly as in 32-bit x86 (movxa_** are 32-bit as well).
+ * Registers r8 - r14 are available as Reg8 - RegE, r15 is reserved as temp.
+ */
+
+/******************************************************************************/
+/********************************   INTERNAL   ********************************/
+/******************************************************************************/
+
+/* emitters */
+
+#define EMPTY   ASM_BEG ASM_END
+
+#define EMITW(w) /* little endian */                                        \
+        EMITB((w) >> 0x00 & 0xFF)                                           \
+        EMITB((w) >> 0x08 & 0xFF)                                           \
+        EMITB((w) >> 0x10 & 0xFF)                                           \
+        EMITB((w) >> 0x18 & 0xFF)
+
+/* structural */
+
+#define MRM(reg, mod, rem)                                                  \
+        EMITB((mod) << 6 | ((reg) & 0x07) << 3 | ((rem) & 0x07))
+
+#define REX(rxg, rxm) /* emitted only for upper 8 registers, W = 0 */       \
+        ASM_IF((rxg) | (rxm))                                               \
+        EMITB(0x40 | (rxg) << 2 | (rxm))                                    \
+        ASM_FI
+
+#define AUX(sib, cdp, cim)  sib  cdp  cim
+
+/* selectors  */
+
+#define REG(reg, mod, sib)  reg
+#define MOD(reg, mod, sib)  mod
+#define SIB(reg, mod, sib)  sib
+#define RXB(reg, mod, sib)  ((reg) >> 3 & 0x01)
+
+#define VAL(val, typ, cmd)  val
+#define TYP(val, typ, cmd)  typ
+#define CMD(val, typ, cmd)  cmd
+
+/* registers    REG */
+
+#define TMxx    0x0F                    /* r15 */
+
+/******************************************************************************/
+/********************************   EXTERNAL   ********************************/
+/******************************************************************************/
+
+/* registers    REG,  MOD,  SIB */
+
+#define Reax    0x00, 0x03, EMPTY
+#define Recx    0x01, 0x03, EMPTY
+#define Redx    0x02, 0x03, EMPTY
+#define Rebx    0x03, 0x03, EMPTY
+#define Resp    0x04, 0x03, EMPTY
+#define Rebp    0x05, 0x03, EMPTY
+#define Resi    0x06, 0x03, EMPTY
+#define Redi    0x07, 0x03, EMPTY
+#define Reg8    0x08, 0x03, EMPTY
+#define Reg9    0x09, 0x03, EMPTY
+#define RegA    0x0A, 0x03, EMPTY
+#define RegB    0x0B, 0x03, EMPTY
+#define RegC    0x0C, 0x03, EMPTY
+#define RegD    0x0D, 0x03, EMPTY
+#define RegE    0x0E, 0x03, EMPTY
+
+/* addressing   REG,  MOD,  SIB */
+
+#define Oeax    0x00, 0x00, EMPTY       /* [eax] */
+
+#define Mecx    0x01, 0x02, EMPTY       /* [ecx + DP] */
+#define Medx    0x02, 0x02, EMPTY       /* [edx + DP] */
+#define Mebx    0x03, 0x02, EMPTY       /* [ebx + DP] */
+#define Mebp    0x05, 0x02, EMPTY       /* [ebp + DP] */
+#define Mesi    0x06, 0x02, EMPTY       /* [esi + DP] */
+#define Medi    0x07, 0x02, EMPTY       /* [edi + DP] */
+#define Meg8    0x08, 0x02, EMPTY       /* [r8d + DP] */
+#define Meg9    0x09, 0x02, EMPTY       /* [r9d + DP] */
+#define MegA    0x0A, 0x02, EMPTY       /* [r10d + DP] */
+#define MegB    0x0B, 0x02, EMPTY       /* [r11d + DP] */
+#define MegC    0x0C, 0x02, EMITB(0x24) /* [r12d + DP] */
+#define MegD    0x0D, 0x02, EMPTY       /* [r13d + DP] */
+#define MegE    0x0E, 0x02, EMPTY       /* [r14d + DP] */
+
+#define Iecx    0x04, 0x02, EMITB(0x01) /* [ecx + eax + DP] */
+#define Iedx    0x04, 0x02, EMITB(0x02) /* [edx + eax + DP] */
+#define Iebx    0x04, 0x02, EMITB(0x03) /* [ebx + eax + DP] */
+#define Iebp    0x04, 0x02, EMITB(0x05) /* [ebp + eax + DP] */
+#define Iesi    0x04, 0x02, EMITB(0x06) /* [esi + eax + DP] */
+#define Iedi    0x04, 0x02, EMITB(0x07) /* [edi + eax + DP] */
+#define Ieg8    0x0C, 0x02, EMITB(0x00) /* [r8d + eax + DP] */
+#define Ieg9    0x0C, 0x02, EMITB(0x01) /* [r9d + eax + DP] */
+#define IegA    0x0C, 0x02, EMITB(0x02) /* [r10d + eax + DP] */
+#define IegB    0x0C, 0x02, EMITB(0x03) /* [r11d + eax + DP] */
+#define IegC    0x0C, 0x02, EMITB(0x04) /* [r12d + eax + DP] */
+#define IegD    0x0C, 0x02, EMITB(0x05) /* [r13d + eax + DP] */
+#define IegE    0x0C, 0x02, EMITB(0x06) /* [r14d + eax + DP] */
+
+/* immediate    VAL,  TYP,  CMD */
+
+#define IB(im)  (im), 0x02, EMITB((im) & 0x7F) /* drop sign-ext (zero in ARM) */
+#define IH(im)  (im), 0x00, EMITW((im) & 0xFFFF)
+#define IW(im)  (im), 0x00, EMITW((im) & 0xFFFFFFFF)
+
+/* displacement VAL,  TYP,  CMD */
+
+#define DP(im)  (im), 0x00, EMITW((im) & 0xFFF)
+#define DH(im)  (im), 0x00, EMITW((im) & 0xFFFF)        /* SIMD-only (in ARM) */
+#define DW(im)  (im), 0x00, EMITW((im) & 0xFFFFFFFF)    /* SIMD-only (in ARM) */
+
+#define PLAIN   0x00, 0x00, EMPTY
+
+/* triplet pass-through wrapper */
+
+#define W(p1, p2, p3)       p1,  p2,  p3
+
+/******************************************************************************/
+/**********************************   X32   ***********************************/
+/******************************************************************************/
+
+/* mov */
+
+#define movxx_ri(RM, IM)                                                    \
+        REX(0, RXB(RM)) EMITB(0xC7)                                         \
+            MRM(0x00,    MOD(RM), REG(RM)) /* truncate IB with TYP below */ \
+            AUX(EMPTY,   EMPTY,   EMITW(VAL(IM) & ((TYP(IM) << 6) - 1)))
+
+#define movxx_mi(RM, DP, IM)                                                \
+        REX(0, RXB(RM)) EMITB(0xC7)                                         \
+            MRM(0x00,    MOD(RM), REG(RM)) /* truncate IB with TYP below */ \
+            AUX(SIB(RM), CMD(DP), EMITW(VAL(IM) & ((TYP(IM) << 6) - 1)))
+
+#define movxx_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x8B)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define movxx_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x8B)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define movxx_st(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x89)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define movxa_ld(RG, RM, DP) /* address-sized load */                       \
+        movxx_ld(W(RG), W(RM), W(DP))
+
+#define movxa_st(RG, RM, DP) /* address-sized store */                      \
+        movxx_st(W(RG), W(RM), W(DP))
+
+#define adrxx_ld(RG, RM, DP) /* only 10-bit offsets and 4-byte alignment */ \
+        REX(RXB(RG), RXB(RM)) EMITB(0x8D)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), EMITW(VAL(DP) & 0x3FC), EMPTY)
+
+#define adrxx_lb(lb) /* load label to Reax */                               \
+        label_ld(lb)
+
+#define stack_st(RM)                                                        \
+        REX(0, RXB(RM)) EMITB(0xFF)                                         \
+            MRM(0x06,    MOD(RM), REG(RM))
+
+#define stack_ld(RM)                                                        \
+        REX(0, RXB(RM)) EMITB(0x8F)                                         \
+            MRM(0x00,    MOD(RM), REG(RM))
+
+#define stack_sa() /* save all [RAX - R15], 15 regs in total, skip RSP */   \
+        EMITB(0x48) EMITB(0x8D) /* skip red zone */                         \
+            MRM(0x04,    0x01,    0x04)                                     \
+            AUX(EMITB(0x24), EMITB(0x80), EMPTY)                            \
+        EMITB(0x50) EMITB(0x51) EMITB(0x52) EMITB(0x53)                     \
+        EMITB(0x55) EMITB(0x56) EMITB(0x57)                                 \
+        EMITB(0x41) EMITB(0x50) EMITB(0x41) EMITB(0x51)                     \
+        EMITB(0x41) EMITB(0x52) EMITB(0x41) EMITB(0x53)                     \
+        EMITB(0x41) EMITB(0x54) EMITB(0x41) EMITB(0x55)                     \
+        EMITB(0x41) EMITB(0x56) EMITB(0x41) EMITB(0x57)
+
+#define stack_la() /* load all [R15 - RAX], 15 regs in total, skip RSP */   \
+        EMITB(0x41) EMITB(0x5F) EMITB(0x41) EMITB(0x5E)                     \
+        EMITB(0x41) EMITB(0x5D) EMITB(0x41) EMITB(0x5C)                     \
+        EMITB(0x41) EMITB(0x5B) EMITB(0x41) EMITB(0x5A)                     \
+        EMITB(0x41) EMITB(0x59) EMITB(0x41) EMITB(0x58)                     \
+        EMITB(0x5F) EMITB(0x5E) EMITB(0x5D)                                 \
+        EMITB(0x5B) EMITB(0x5A) EMITB(0x59) EMITB(0x58)                     \
+        EMITB(0x48) EMITB(0x8D) /* skip red zone */                         \
+            MRM(0x04,    0x02,    0x04)                                     \
+            AUX(EMITB(0x24), EMITW(0x00000080), EMPTY)
+
+/* and */
+
+#define andxx_ri(RM, IM)                                                    \
+        REX(0, RXB(RM)) EMITB(0x81 | TYP(IM))                               \
+            MRM(0x04,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   CMD(IM))
+
+#define andxx_mi(RM, DP, IM)                                                \
+        REX(0, RXB(RM)) EMITB(0x81 | TYP(IM))                               \
+            MRM(0x04,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), CMD(IM))
+
+#define andxx_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x23)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define andxx_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x23)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define andxx_st(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x21)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* orr */
+
+#define orrxx_ri(RM, IM)                                                    \
+        REX(0, RXB(RM)) EMITB(0x81 | TYP(IM))                               \
+            MRM(0x01,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   CMD(IM))
+
+#define orrxx_mi(RM, DP, IM)                                                \
+        REX(0, RXB(RM)) EMITB(0x81 | TYP(IM))                               \
+            MRM(0x01,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), CMD(IM))
+
+#define orrxx_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0B)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define orrxx_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0B)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define orrxx_st(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x09)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* not */
+
+#define notxx_rr(RM)                                                        \
+        REX(0, RXB(RM)) EMITB(0xF7)                                         \
+            MRM(0x02,    MOD(RM), REG(RM))
+
+#define notxx_mm(RM, DP)                                                    \
+        REX(0, RXB(RM)) EMITB(0xF7)                                         \
+            MRM(0x02,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* add */
+
+#define addxx_ri(RM, IM)                                                    \
+        REX(0, RXB(RM)) EMITB(0x81 | TYP(IM))                               \
+            MRM(0x00,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   CMD(IM))
+
+#define addxx_mi(RM, DP, IM)                                                \
+        REX(0, RXB(RM)) EMITB(0x81 | TYP(IM))                               \
+            MRM(0x00,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), CMD(IM))
+
+#define addxx_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x03)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define addxx_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x03)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define addxx_st(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x01)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* sub */
+
+#define subxx_ri(RM, IM)                                                    \
+        REX(0, RXB(RM)) EMITB(0x81 | TYP(IM))                               \
+            MRM(0x05,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   CMD(IM))
+
+#define subxx_mi(RM, DP, IM)                                                \
+        REX(0, RXB(RM)) EMITB(0x81 | TYP(IM))                               \
+            MRM(0x05,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), CMD(IM))
+
+#define subxx_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x2B)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define subxx_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x2B)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define subxx_st(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x29)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define subxx_mr(RM, DP, RG)                                                \
+        subxx_st(W(RG), W(RM), W(DP))
+
+/* shl */
+
+#define shlxx_ri(RM, IM)                                                    \
+        REX(0, RXB(RM)) EMITB(0xC1)                                         \
+            MRM(0x04,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(VAL(IM) & 0x1F))
+
+#define shlxx_mi(RM, DP, IM)                                                \
+        REX(0, RXB(RM)) EMITB(0xC1)                                         \
+            MRM(0x04,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(VAL(IM) & 0x1F))
+
+/* shr */
+
+#define shrxx_ri(RM, IM)                                                    \
+        REX(0, RXB(RM)) EMITB(0xC1)                                         \
+            MRM(0x05,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(VAL(IM) & 0x1F))
+
+#define shrxx_mi(RM, DP, IM)                                                \
+        REX(0, RXB(RM)) EMITB(0xC1)                                         \
+            MRM(0x05,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(VAL(IM) & 0x1F))
+
+#define shrxn_ri(RM, IM)                                                    \
+        REX(0, RXB(RM)) EMITB(0xC1)                                         \
+            MRM(0x07,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(VAL(IM) & 0x1F))
+
+#define shrxn_mi(RM, DP, IM)                                                \
+        REX(0, RXB(RM)) EMITB(0xC1)                                         \
+            MRM(0x07,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(VAL(IM) & 0x1F))
+
+/* mul */
+
+#define mulxn_ri(RM, IM)                                                    \
+        REX(RXB(RM), RXB(RM)) EMITB(0x69 | TYP(IM))                         \
+            MRM(REG(RM), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   CMD(IM))
+
+#define mulxn_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xAF)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define mulxn_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xAF)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define mulxn_xm(RM, DP) /* Reax is in/out, destroys Redx */                \
+        REX(0, RXB(RM)) EMITB(0xF7)                                         \
+            MRM(0x05,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* div */
+
+#define divxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        REX(0, RXB(RM)) EMITB(0xF7)      /* destroys Xmm0 (in ARM) */       \
+            MRM(0x06,    MOD(RM), REG(RM)) /* fp div (in ARM) */            \
+            AUX(SIB(RM), CMD(DP), EMPTY)   /* without RT_ARM_IDIV */
+
+#define divxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
+        REX(0, RXB(RM)) EMITB(0xF7)      /* destroys Xmm0 (in ARM) */       \
+            MRM(0x07,    MOD(RM), REG(RM)) /* fp div (in ARM) */            \
+            AUX(SIB(RM), CMD(DP), EMPTY)   /* without RT_ARM_IDIV */
+
+/* rem */
+
+#define remxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        divxx_xm(W(RM), W(DP)) /* remainder in Redx */
+
+#define remxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
+        divxn_xm(W(RM), W(DP)) /* remainder in Redx */
+
+/* cmp */
+
+#define cmpxx_ri(RM, IM)                                                    \
+        REX(0, RXB(RM)) EMITB(0x81 | TYP(IM))                               \
+            MRM(0x07,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   CMD(IM))
+
+#define cmpxx_mi(RM, DP, IM)                                                \
+        REX(0, RXB(RM)) EMITB(0x81 | TYP(IM))                               \
+            MRM(0x07,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), CMD(IM))
+
+#define cmpxx_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x3B)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define cmpxx_rm(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x3B)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define cmpxx_mr(RM, DP, RG)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x39)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* jmp */
+
+#define jmpxx_mm(RM, DP) /* 32-bit pointer in memory, loaded to TMxx */     \
+        REX(1,       RXB(RM)) EMITB(0x8B)                                   \
+            MRM(TMxx,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)                                    \
+        REX(0,             1) EMITB(0xFF)                                   \
+            MRM(0x04,    0x03,    TMxx)
+
+#define jmpxx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(jmp, lb) ASM_END
+
+#define jeqxx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(je,  lb) ASM_END
+
+#define jnexx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(jne, lb) ASM_END
+
+#define jnzxx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(jnz, lb) ASM_END
+
+#define jltxx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(jb,  lb) ASM_END
+
+#define jlexx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(jbe, lb) ASM_END
+
+#define jgtxx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(ja,  lb) ASM_END
+
+#define jgexx_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(jae, lb) ASM_END
+
+#define jltxn_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(jl,  lb) ASM_END
+
+#define jlexn_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(jle, lb) ASM_END
+
+#define jgtxn_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(jg,  lb) ASM_END
+
+#define jgexn_lb(lb)                                                        \
+        ASM_BEG ASM_OP1(jge, lb) ASM_END
+
+#define LBL(lb)                                                             \
+        ASM_BEG ASM_OP0(lb:) ASM_END
+
+#endif /* RT_RTARCH_X32_H */
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
@@ -0,0 +1,1006 @@
+/******************************************************************************/
+/* Copyright (c) 2013-2015 VectorChief (at github, bitbucket, sourceforge)    */
+/* Distributed under the MIT software license, see the accompanying           */
+/* file COPYING or http://www.opensource.org/licenses/mit-license.php         */
+/******************************************************************************/
+
+#ifndef RT_RTARCH_X32_128_H
+#define RT_RTARCH_X32_128_H
+
+#include "rtarch_x32.h"
+
+#define RT_SIMD_REGS        16
+#define RT_SIMD_WIDTH       4
+#define RT_SIMD_ALIGN       16
+#define RT_SIMD_SET(s, v)   s[0]=s[1]=s[2]=s[3]=v
+
+#define RT_SIMD_WIDTH64     2
+#define RT_SIMD_SET64(s, v) s[0]=s[1]=v
+
+/******************************************************************************/
+/*********************************   LEGEND   *********************************/
+/******************************************************************************/
+
+/*
+ * rtarch_x32_128.h: Implementation of x86_64 x32 ABI SSE instructions.
+ *
+ * This file is a part of the unified SIMD assembler framework (rtarch.h)
+ * designed to be compatible with different processor architectures,
+ * while maintaining strictly defined common API.
+ *
+ * Recommended naming scheme for instructions:
+ *
+ * cmdp*_ri - applies [cmd] to [p]acked: [r]egister from [i]mmediate
+ * cmdp*_rr - applies [cmd] to [p]acked: [r]egister from [r]egister
+ *
+ * cmdp*_rm - applies [cmd] to [p]acked: [r]egister from [m]emory
+ * cmdp*_ld - applies [cmd] to [p]acked: as above
+ * cmdp*_mr - applies [cmd] to [p]acked: [m]emory   from [r]egister
+ * cmdp*_st - applies [cmd] to [p]acked: as above (arg list as cmdxx_ld)
+ *
+ * cmdpx_** - applies [cmd] to [p]acked unsigned integer args, [x] - default
+ * cmdpn_** - applies [cmd] to [p]acked   signed integer args, [n] - negatable
+ * cmdps_** - applies [cmd] to [p]acked floating point   args, [s] - scalable
+ * cmdpd_** - applies [cmd] to [p]acked double precision args, [d] - double
+ *
+ * cmdpb_** - applies [cmd] to [p]acked unsigned  8-bit integer args, [b]yte
+ * cmdph_** - applies [cmd] to [p]acked unsigned 16-bit integer args, [h]alf
+ *
+ * The cmdp*_** instructions are intended for SPMD programming model
+ * and can potentially be configured per target to work with 32-bit/64-bit
+ * data-elements (integers/pointers, floating point).
+ * In this model data paths are fixed-width, core and SIMD data-elements are
+ * width-compatible, code path divergence is handled via CHECK_MASK macro.
+ *
+ * The cmdpb_**, cmdph_** instructions are intended for pixel/image kernels
+ * and work with fixed-width 8-bit/16-bit data-elements regardless of target,
+ * thus a register holds 4*S bytes or 2*S halfwords respectively.
+ *
+ * The cmdpd_** instructions work with 64-bit floating point data-elements,
+ * thus a register holds RT_SIMD_WIDTH64 (S/2) doubles.
+ */
+
+/******************************************************************************/
+/********************************   INTERNAL   ********************************/
+/******************************************************************************/
+
+/******************************************************************************/
+/********************************   EXTERNAL   ********************************/
+/******************************************************************************/
+
+/* registers    REG,  MOD,  SIB */
+
+#define Xmm0    0x00, 0x03, EMPTY
+#define Xmm1    0x01, 0x03, EMPTY
+#define Xmm2    0x02, 0x03, EMPTY
+#define Xmm3    0x03, 0x03, EMPTY
+#define Xmm4    0x04, 0x03, EMPTY
+#define Xmm5    0x05, 0x03, EMPTY
+#define Xmm6    0x06, 0x03, EMPTY
+#define Xmm7    0x07, 0x03, EMPTY
+#define Xmm8    0x08, 0x03, EMPTY
+#define Xmm9    0x09, 0x03, EMPTY
+#define XmmA    0x0A, 0x03, EMPTY
+#define XmmB    0x0B, 0x03, EMPTY
+#define XmmC    0x0C, 0x03, EMPTY
+#define XmmD    0x0D, 0x03, EMPTY
+#define XmmE    0x0E, 0x03, EMPTY
+#define XmmF    0x0F, 0x03, EMPTY
+
+/******************************************************************************/
+/**********************************   SSE   ***********************************/
+/******************************************************************************/
+
+/**************************   packed generic (SSE1)   *************************/
+
+/* mov */
+
+#define movpx_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x28)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define movpx_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x28)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define movpx_st(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x29)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define adrpx_ld(RG, RM, DP) /* RG is a core reg, DP is SIMD-aligned */     \
+        REX(RXB(RG), RXB(RM)) EMITB(0x8D)                                   \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), EMITW(VAL(DP) & ~(RT_SIMD_ALIGN - 1)), EMPTY)
+
+#define movlx_ld(RG, RM, DP) /* lower half from memory, upper zeroed */     \
+        EMITB(0xF3) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x7E)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define movlx_st(RG, RM, DP) /* lower half to memory */                     \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xD6)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define movux_ld(RG, RM, DP) /* full vector from unaligned memory */        \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x10)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define movnx_st(RG, RM, DP) /* non-temporal, bypasses caches */            \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x2B)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define prfxx_ld(RM, DP) /* prefetch cache line into all levels */          \
+        REX(0,       RXB(RM)) EMITB(0x0F) EMITB(0x18)                       \
+            MRM(0x01,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define fence_st() /* orders preceding non-temporal stores */               \
+        EMITB(0x0F) EMITB(0xAE) EMITB(0xF8)
+
+/* and */
+
+#define andpx_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x54)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define andpx_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x54)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* ann */
+
+#define annpx_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x55)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define annpx_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x55)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* orr */
+
+#define orrpx_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x56)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define orrpx_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x56)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* xor */
+
+#define xorpx_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x57)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define xorpx_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x57)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/**************   packed single precision floating point (SSE1)   *************/
+
+/* add */
+
+#define addps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x58)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define addps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x58)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* sub */
+
+#define subps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5C)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define subps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5C)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* mul */
+
+#define mulps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x59)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define mulps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x59)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* div */
+
+#define divps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5E)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define divps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5E)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* sqr */
+
+#define sqrps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x51)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define sqrps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x51)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* cbr */
+
+        /* cbe, cbs, cbr defined in rtarch.h
+         * under "COMMON SIMD INSTRUCTIONS" section */
+
+/* rcp */
+
+#define rceps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x53)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define rcsps_rr(RG, RM) /* destroys RM */                                  \
+        mulps_rr(W(RM), W(RG))                                              \
+        mulps_rr(W(RM), W(RG))                                              \
+        addps_rr(W(RG), W(RG))                                              \
+        subps_rr(W(RG), W(RM))
+
+        /* rcp defined in rtarch.h
+         * under "COMMON SIMD INSTRUCTIONS" section */
+
+/* rsq */
+
+#define rseps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x52)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define rssps_rr(RG, RM) /* destroys RM */                                  \
+        mulps_rr(W(RM), W(RG))                                              \
+        mulps_rr(W(RM), W(RG))                                              \
+        subps_ld(W(RM), Mebp, inf_GPC03)                                    \
+        mulps_ld(W(RM), Mebp, inf_GPC02)                                    \
+        mulps_rr(W(RG), W(RM))
+
+        /* rsq defined in rtarch.h
+         * under "COMMON SIMD INSTRUCTIONS" section */
+
+/* min */
+
+#define minps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5D)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define minps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5D)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* max */
+
+#define maxps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5F)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define maxps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5F)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* cmp */
+
+#define ceqps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x00))
+
+#define ceqps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x00))
+
+#define cneps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x04))
+
+#define cneps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x04))
+
+#define cltps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x01))
+
+#define cltps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x01))
+
+#define cleps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x02))
+
+#define cleps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x02))
+
+#define cgtps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x06))
+
+#define cgtps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x06))
+
+#define cgeps_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x05))
+
+#define cgeps_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x05))
+
+/**************   packed double precision floating point (SSE2)   *************/
+
+/* add */
+
+#define addpd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x58)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define addpd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x58)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* sub */
+
+#define subpd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5C)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define subpd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5C)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* mul */
+
+#define mulpd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x59)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define mulpd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x59)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* div */
+
+#define divpd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5E)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define divpd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5E)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* sqr */
+
+#define sqrpd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x51)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define sqrpd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x51)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* min */
+
+#define minpd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5D)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define minpd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5D)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* max */
+
+#define maxpd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5F)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define maxpd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5F)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* cmp */
+
+#define ceqpd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x00))
+
+#define ceqpd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x00))
+
+#define cnepd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x04))
+
+#define cnepd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x04))
+
+#define cltpd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x01))
+
+#define cltpd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x01))
+
+#define clepd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x02))
+
+#define clepd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x02))
+
+#define cgtpd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x06))
+
+#define cgtpd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x06))
+
+#define cgepd_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x05))
+
+#define cgepd_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xC2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x05))
+
+/* cvt (fp32 <-> fp64) */
+
+#define cvtsd_rr(RG, RM) /* lower S/2 fp32 elements to fp64 */              \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5A)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define cvtds_rr(RG, RM) /* fp64 elements to lower S/2 fp32, zero upper */  \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5A)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+/**************************   packed integer (SSE2)   *************************/
+
+/* cvt */
+
+#define cvtps_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5B)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define cvtps_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5B)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define cvtpn_rr(RG, RM)                                                    \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5B)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define cvtpn_ld(RG, RM, DP)                                                \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x5B)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* add */
+
+#define addpx_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xFE)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define addpx_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xFE)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* sub */
+
+#define subpx_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xFA)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define subpx_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xFA)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* shl */
+
+#define shlpx_ri(RM, IM)                                                    \
+        EMITB(0x66) REX(0, RXB(RM)) EMITB(0x0F) EMITB(0x72)                 \
+            MRM(0x06,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(VAL(IM) & 0x1F))
+
+#define shlpx_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xF2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* shr */
+
+#define shrpx_ri(RM, IM)                                                    \
+        EMITB(0x66) REX(0, RXB(RM)) EMITB(0x0F) EMITB(0x72)                 \
+            MRM(0x02,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(VAL(IM) & 0x1F))
+
+#define shrpx_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xD2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define shrpn_ri(RM, IM)                                                    \
+        EMITB(0x66) REX(0, RXB(RM)) EMITB(0x0F) EMITB(0x72)                 \
+            MRM(0x04,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(VAL(IM) & 0x1F))
+
+#define shrpn_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xE2)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* cgt (signed) */
+
+#define cgtpn_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x66)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define cgtpn_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x66)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/***********************   packed byte/half integer (SSE2)   ******************/
+
+/* add */
+
+#define addpb_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xFC)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define addpb_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xFC)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define addph_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xFD)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define addph_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xFD)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* ads (add with unsigned saturation) */
+
+#define adspb_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xDC)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define adspb_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xDC)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define adsph_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xDD)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define adsph_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xDD)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* sub */
+
+#define subpb_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xF8)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define subpb_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xF8)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define subph_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xF9)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define subph_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xF9)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* sbs (sub with unsigned saturation) */
+
+#define sbspb_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xD8)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define sbspb_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xD8)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define sbsph_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xD9)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define sbsph_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xD9)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* avg (rounded average, (a + b + 1) >> 1) */
+
+#define avgpb_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xE0)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define avgpb_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xE0)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define avgph_rr(RG, RM)                                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xE3)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define avgph_ld(RG, RM, DP)                                                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0xE3)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+/* unl, unh (widen lower/upper half with zero-extension) */
+
+#define unlpb_rr(RG, RM) /* bytes to halves */                              \
+        movpx_rr(W(RG), W(RM))                                              \
+        EMITB(0x66) REX(RXB(RG), RXB(RG)) EMITB(0x0F) EMITB(0x60)           \
+            MRM(REG(RG), MOD(RG), REG(RG))                                  \
+        EMITB(0x66) REX(0, RXB(RG)) EMITB(0x0F) EMITB(0x71)                 \
+            MRM(0x02,    MOD(RG), REG(RG))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x08))
+
+#define unhpb_rr(RG, RM) /* bytes to halves */                              \
+        movpx_rr(W(RG), W(RM))                                              \
+        EMITB(0x66) REX(RXB(RG), RXB(RG)) EMITB(0x0F) EMITB(0x68)           \
+            MRM(REG(RG), MOD(RG), REG(RG))                                  \
+        EMITB(0x66) REX(0, RXB(RG)) EMITB(0x0F) EMITB(0x71)                 \
+            MRM(0x02,    MOD(RG), REG(RG))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x08))
+
+#define unlph_rr(RG, RM) /* halves to words */                              \
+        movpx_rr(W(RG), W(RM))                                              \
+        EMITB(0x66) REX(RXB(RG), RXB(RG)) EMITB(0x0F) EMITB(0x61)           \
+            MRM(REG(RG), MOD(RG), REG(RG))                                  \
+        EMITB(0x66) REX(0, RXB(RG)) EMITB(0x0F) EMITB(0x72)                 \
+            MRM(0x02,    MOD(RG), REG(RG))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x10))
+
+#define unhph_rr(RG, RM) /* halves to words */                              \
+        movpx_rr(W(RG), W(RM))                                              \
+        EMITB(0x66) REX(RXB(RG), RXB(RG)) EMITB(0x0F) EMITB(0x69)           \
+            MRM(REG(RG), MOD(RG), REG(RG))                                  \
+        EMITB(0x66) REX(0, RXB(RG)) EMITB(0x0F) EMITB(0x72)                 \
+            MRM(0x02,    MOD(RG), REG(RG))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x10))
+
+/* pck (narrow RG into lower half, RM into upper half with saturation) */
+
+#define pckph_rr(RG, RM) /* signed halves to unsigned bytes */              \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x67)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define pckpn_rr(RG, RM) /* signed words to signed halves */                \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x6B)           \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+/**********************   lane shift/broadcast (SSE2)   ***********************/
+
+/*
+ * Lane shifts move 32-bit elements of RM up (towards higher lanes, sln)
+ * or down (srn) by IM lanes (1..S-1), vacated lanes are zeroed.
+ * Broadcasts copy element IM (0..S-1) of RM (splpx_ri) or 32-bit element
+ * at [RM + DP] (splpx_ld, DP is not required to be SIMD-aligned)
+ * to all lanes.
+ */
+
+/* sln */
+
+#define slnpx_ri(RM, IM)                                                    \
+        EMITB(0x66) REX(0, RXB(RM)) EMITB(0x0F) EMITB(0x73)                 \
+            MRM(0x07,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB((VAL(IM) * 4) & 0x0F))
+
+/* srn */
+
+#define srnpx_ri(RM, IM)                                                    \
+        EMITB(0x66) REX(0, RXB(RM)) EMITB(0x0F) EMITB(0x73)                 \
+            MRM(0x03,    MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB((VAL(IM) * 4) & 0x0F))
+
+/* spl */
+
+#define splpx_ri(RM, IM)                                                    \
+        EMITB(0x66) REX(RXB(RM), RXB(RM)) EMITB(0x0F) EMITB(0x70)           \
+            MRM(REG(RM), MOD(RM), REG(RM))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB((VAL(IM) & 0x03) * 0x55))
+
+#define splpx_ld(RG, RM, DP)                                                \
+        EMITB(0xF3) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x10)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)                                    \
+        EMITB(0x66) REX(RXB(RG), RXB(RG)) EMITB(0x0F) EMITB(0x70)           \
+            MRM(REG(RG), MOD(RG), REG(RG))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x00))
+
+/*************************   masked load/store (SSE2)   ***********************/
+
+/*
+ * Lanes with non-zero RK elements are loaded/stored at [base + DP],
+ * other lanes are zeroed in RG on load and left untouched in memory on store,
+ * memory behind masked-out lanes is never accessed (safe for array tails).
+ * RM is a [base + DP] addressing form without SIB byte (all except Mesp,
+ * MegC), the emulation uses TMxx and 16 bytes below the stack pointer,
+ * RK is not changed.
+ */
+
+/* msk */
+
+#define mskpx_rr(RG, RM) /* RM is a core reg, count of active lanes */      \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x6E)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+        EMITB(0x66) REX(RXB(RG), RXB(RG)) EMITB(0x0F) EMITB(0x70)           \
+            MRM(REG(RG), MOD(RG), REG(RG))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x00))                              \
+        cgtpn_ld(W(RG), Mebp, inf_GPC15)
+
+/* mmv */
+
+#define mmvpx_ld(RG, RK, RM, DP) /* RG may be the same as RK */             \
+        EMITB(0x48) EMITB(0x83) /* REX.W for RSP */                         \
+            MRM(0x05,    0x03,    0x04)                                     \
+            AUX(EMPTY,   EMPTY,   EMITB(0x10))                              \
+        mmlxx_rx(W(RK), W(RM), W(DP), 0x00)                                 \
+        mmlxx_rx(W(RK), W(RM), W(DP), 0x01)                                 \
+        mmlxx_rx(W(RK), W(RM), W(DP), 0x02)                                 \
+        mmlxx_rx(W(RK), W(RM), W(DP), 0x03)                                 \
+        REX(RXB(RG), 0) EMITB(0x0F) EMITB(0x10)                             \
+            MRM(REG(RG), 0x00,    0x04)                                     \
+            AUX(EMITB(0x24), EMPTY, EMPTY)                                  \
+        EMITB(0x48) EMITB(0x83) /* REX.W for RSP */                         \
+            MRM(0x00,    0x03,    0x04)                                     \
+            AUX(EMPTY,   EMPTY,   EMITB(0x10))
+
+#define mmvpx_st(RG, RK, RM, DP) /* RG must not be the same as RK */        \
+        mmsxx_rx(W(RG), W(RK), W(RM), W(DP), 0x00)                          \
+        mmsxx_rx(W(RG), W(RK), W(RM), W(DP), 0x01)                          \
+        mmsxx_rx(W(RG), W(RK), W(RM), W(DP), 0x02)                          \
+        mmsxx_rx(W(RG), W(RK), W(RM), W(DP), 0x03)
+
+#define mmlxx_rx(RK, RM, DP, ln) /* not portable, do not use outside */     \
+        EMITB(0x66) REX(RXB(RK), 1) EMITB(0x0F) EMITB(0x7E)                 \
+            MRM(REG(RK), 0x03,    TMxx)                                     \
+        REX(1,             1) EMITB(0x85)                                   \
+            MRM(TMxx,    0x03,    TMxx)                                     \
+        EMITB(0x74) EMITB(0x07)  /* jz over mov r32, m32 */                 \
+        REX(1,       RXB(RM)) EMITB(0x8B)                                   \
+            MRM(TMxx,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), EMITW(VAL(DP) + (ln) * 4), EMPTY)                  \
+        REX(1,             0) EMITB(0x89)                                   \
+            MRM(TMxx,    0x01,    0x04)                                     \
+            AUX(EMITB(0x24), EMITB((ln) * 4), EMPTY)                        \
+        EMITB(0x66) REX(RXB(RK), RXB(RK)) EMITB(0x0F) EMITB(0x70)           \
+            MRM(REG(RK), MOD(RK), REG(RK))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x39))
+
+#define mmsxx_rx(RG, RK, RM, DP, ln) /* not portable, do not use outside */ \
+        EMITB(0x66) REX(RXB(RK), 1) EMITB(0x0F) EMITB(0x7E)                 \
+            MRM(REG(RK), 0x03,    TMxx)                                     \
+        REX(1,             1) EMITB(0x85)                                   \
+            MRM(TMxx,    0x03,    TMxx)                                     \
+        EMITB(0x74)  /* jz over movd m32, REX is optional */                \
+        EMITB(0x08 + (RXB(RG) | RXB(RM)))                                   \
+        EMITB(0x66) REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x7E)           \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), EMITW(VAL(DP) + (ln) * 4), EMPTY)                  \
+        EMITB(0x66) REX(RXB(RK), RXB(RK)) EMITB(0x0F) EMITB(0x70)           \
+            MRM(REG(RK), MOD(RK), REG(RK))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x39))                              \
+        EMITB(0x66) REX(RXB(RG), RXB(RG)) EMITB(0x0F) EMITB(0x70)           \
+            MRM(REG(RG), MOD(RG), REG(RG))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x39))
+
+/*************************   gather/scatter (SSE2)   **************************/
+
+/*
+ * Lanes are loaded/stored at [base + DP + index*4] with base taken from
+ * the [base + DP] addressing form of RM (Meax..MegE) and 32-bit element
+ * indices taken from RI (sign-extended), the emulation uses TMxx as index
+ * register and 16 bytes below the stack pointer (gather), RI is unchanged.
+ * Scatter writes lanes in ascending order, later lanes win on collision.
+ */
+
+/* gat */
+
+#define gatpx_ld(RG, RI, RM, DP) /* RG may be the same as RI */             \
+        EMITB(0x48) EMITB(0x83) /* REX.W for RSP */                         \
+            MRM(0x05,    0x03,    0x04)                                     \
+            AUX(EMPTY,   EMPTY,   EMITB(0x10))                              \
+        gatxx_rx(W(RI), W(RM), W(DP), 0x00)                                 \
+        gatxx_rx(W(RI), W(RM), W(DP), 0x01)                                 \
+        gatxx_rx(W(RI), W(RM), W(DP), 0x02)                                 \
+        gatxx_rx(W(RI), W(RM), W(DP), 0x03)                                 \
+        REX(RXB(RG), 0) EMITB(0x0F) EMITB(0x10)                             \
+            MRM(REG(RG), 0x00,    0x04)                                     \
+            AUX(EMITB(0x24), EMPTY, EMPTY)                                  \
+        EMITB(0x48) EMITB(0x83) /* REX.W for RSP */                         \
+            MRM(0x00,    0x03,    0x04)                                     \
+            AUX(EMPTY,   EMPTY,   EMITB(0x10))
+
+#define gatxx_rx(RI, RM, DP, ln) /* not portable, do not use outside */     \
+        EMITB(0x66) REX(RXB(RI), 1) EMITB(0x0F) EMITB(0x7E)                 \
+            MRM(REG(RI), 0x03,    TMxx)                                     \
+        EMITB(0x4D) EMITB(0x63) /* movsxd TMxx, sign-extend index */        \
+            MRM(TMxx,    0x03,    TMxx)                                     \
+        EMITB(0x46 | RXB(RM)) EMITB(0x8B) /* REX.X for TMxx index */        \
+            MRM(TMxx,    MOD(RM), 0x04)                                     \
+            AUX(EMITB(0x80 | (TMxx & 0x07) << 3 | (REG(RM) & 0x07)),        \
+                         CMD(DP), EMPTY)                                    \
+        REX(1,             0) EMITB(0x89)                                   \
+            MRM(TMxx,    0x01,    0x04)                                     \
+            AUX(EMITB(0x24), EMITB((ln) * 4), EMPTY)                        \
+        EMITB(0x66) REX(RXB(RI), RXB(RI)) EMITB(0x0F) EMITB(0x70)           \
+            MRM(REG(RI), MOD(RI), REG(RI))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x39))
+
+/* sca */
+
+#define scapx_st(RG, RI, RM, DP) /* RG must not be the same as RI */        \
+        scaxx_rx(W(RG), W(RI), W(RM), W(DP))                                \
+        scaxx_rx(W(RG), W(RI), W(RM), W(DP))                                \
+        scaxx_rx(W(RG), W(RI), W(RM), W(DP))                                \
+        scaxx_rx(W(RG), W(RI), W(RM), W(DP))
+
+#define scaxx_rx(RG, RI, RM, DP) /* not portable, do not use outside */     \
+        EMITB(0x66) REX(RXB(RI), 1) EMITB(0x0F) EMITB(0x7E)                 \
+            MRM(REG(RI), 0x03,    TMxx)                                     \
+        EMITB(0x4D) EMITB(0x63) /* movsxd TMxx, sign-extend index */        \
+            MRM(TMxx,    0x03,    TMxx)                                     \
+        EMITB(0x66) EMITB(0x42 | RXB(RG) << 2 | RXB(RM))                    \
+        EMITB(0x0F) EMITB(0x7E) /* REX.X for TMxx index */                  \
+            MRM(REG(RG), MOD(RM), 0x04)                                     \
+            AUX(EMITB(0x80 | (TMxx & 0x07) << 3 | (REG(RM) & 0x07)),        \
+                         CMD(DP), EMPTY)                                    \
+        EMITB(0x66) REX(RXB(RI), RXB(RI)) EMITB(0x0F) EMITB(0x70)           \
+            MRM(REG(RI), MOD(RI), REG(RI))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x39))                              \
+        EMITB(0x66) REX(RXB(RG), RXB(RG)) EMITB(0x0F) EMITB(0x70)           \
+            MRM(REG(RG), MOD(RG), REG(RG))                                  \
+            AUX(EMPTY,   EMPTY,   EMITB(0x39))
+
+/*************************   fp16 conversions (F16C)   ************************/
+
+#if RT_SIMD_FP16
+
+/* cvh (S fp16 elements in memory <-> fp32) */
+
+#define cvhps_ld(RG, R1, R2, RM, DP) /* R1, R2 unused (fallback temps) */   \
+        EMITB(0xC4) EMITB(0xE2 ^ RXB(RG) << 7 ^ RXB(RM) << 5)               \
+        EMITB(0x79) EMITB(0x13)                                             \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define cvpsh_st(RG, R1, R2, RM, DP) /* R1, R2 unused (fallback temps) */   \
+        EMITB(0xC4) EMITB(0xE3 ^ RXB(RG) << 7 ^ RXB(RM) << 5)               \
+        EMITB(0x79) EMITB(0x1D)                                             \
+            MRM(REG(RG), MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMITB(0x00))
+
+#endif /* RT_SIMD_FP16 */
+
+        /* cvh fallback defined in rtarch.h
+         * under "COMMON SIMD INSTRUCTIONS" section */
+
+/*****************************   helper macros   ******************************/
+
+/* simd mask */
+
+#define RT_SIMD_MASK_NONE       0x00    /* none satisfy the condition */
+#define RT_SIMD_MASK_FULL       0x0F    /*  all satisfy the condition */
+
+#define movsn_rr(RG, RM) /* not portable, do not use outside */             \
+        REX(RXB(RG), RXB(RM)) EMITB(0x0F) EMITB(0x50)                       \
+            MRM(REG(RG), MOD(RM), REG(RM))
+
+#define CHECK_MASK(lb, mask, RG) /* destroys Reax */                        \
+        movsn_rr(Reax, W(RG))                                               \
+        cmpxx_ri(Reax, IB(RT_SIMD_MASK_##mask))                             \
+        jeqxx_lb(lb)
+
+/* simd mode */
+
+#define RT_SIMD_MODE_ROUNDN     0x00    /* round to nearest */
+#define RT_SIMD_MODE_ROUNDM     0x01    /* round towards minus infinity */
+#define RT_SIMD_MODE_ROUNDP     0x02    /* round towards plus  infinity */
+#define RT_SIMD_MODE_ROUNDZ     0x03    /* round towards zero */
+
+#define mxcsr_ld(RM, DP) /* not portable, do not use outside */             \
+        REX(0, RXB(RM)) EMITB(0x0F) EMITB(0xAE)                             \
+            MRM(0x02,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define mxcsr_st(RM, DP) /* not portable, do not use outside */             \
+        REX(0, RXB(RM)) EMITB(0x0F) EMITB(0xAE)                             \
+            MRM(0x03,    MOD(RM), REG(RM))                                  \
+            AUX(SIB(RM), CMD(DP), EMPTY)
+
+#define FCTRL_ENTER(mode) /* destroys Reax */                               \
+        mxcsr_st(Mebp, inf_FCTRL)                                           \
+        movxx_ld(Reax, Mebp, inf_FCTRL)                                     \
+        orrxx_mi(Mebp, inf_FCTRL, IH(RT_SIMD_MODE_##mode << 13))            \
+        mxcsr_ld(Mebp, inf_FCTRL)                                           \
+        movxx_st(Reax, Mebp, inf_FCTRL)
+
+#define FCTRL_LEAVE(mode) /* destroys Reax (in ARM) */                      \
+        mxcsr_ld(Mebp, inf_FCTRL)
+
+#endif /* RT_RTARCH_X32_128_H */
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
@@ -7,6 +7,8 @@
 #ifndef RT_RTARCH_X86_H
 #define RT_RTARCH_X86_H
 
+#define RT_CORE_REGS        8
+
 /******************************************************************************/
 /*********************************   LEGEND   *********************************/
 /******************************************************************************/
@@ -51,6 +53,7 @@
  * cmdx*_** - applies [cmd] to core register/memory/immediate args
  * cmd*x_** - applies [cmd] to unsigned integer args, [x] - default
  * cmd*n_** - applies [cmd] to   signed integer args, [n] - negatable
+ * cmd*a_** - applies [cmd] to address-sized args, [a] - address
  *
  * Argument x-register is fixed by the implementation.
  * Some formal definitions are not given below to encourage
@@ -169,6 +172,12 @@
             MRM(REG(RG), MOD(RM), REG(RM))                                  \
             AUX(SIB(RM), CMD(DP), EMPTY)
 
+#define movxa_ld(RG, RM, DP) /* address-sized load */                       \
+        movxx_ld(W(RG), W(RM), W(DP))
+
+#define movxa_st(RG, RM, DP) /* address-sized store */                      \
+        movxx_st(W(RG), W(RM), W(DP))
+
 #define adrxx_ld(RG, RM, DP) /* only 10-bit offsets and 4-byte alignment */ \
         EMITB(0x8D)                                                         \
             MRM(REG(RG), MOD(RM), REG(RM))                                  \
@@ -347,7 +356,7 @@
 
 #define mulxn_ri(RM, IM)                                                    \
         EMITB(0x69 | TYP(IM))                                               \
-            MRM(0x00,    MOD(RM), REG(RM))                                  \
+            MRM(REG(RM), MOD(RM), REG(RM))                                  \
             AUX(EMPTY,   EMPTY,   CMD(IM))
 
 #define mulxn_rr(RG, RM)                                                    \
@@ -366,10 +375,23 @@
 
 /* div */
 
+#define divxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        EMITB(0xF7)      /* destroys Xmm0 (in ARM) */                       \
+            MRM(0x06,    MOD(RM), REG(RM)) /* fp div (in ARM) */            \
+            AUX(SIB(RM), CMD(DP), EMPTY)   /* without RT_ARM_IDIV */
+
 #define divxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
         EMITB(0xF7)      /* destroys Xmm0 (in ARM) */                       \
-            MRM(0x07,    MOD(RM), REG(RM)) /* limited precision */          \
-            AUX(SIB(RM), CMD(DP), EMPTY)   /* fp div (in ARM) */
+            MRM(0x07,    MOD(RM), REG(RM)) /* fp div (in ARM) */            \
+            AUX(SIB(RM), CMD(DP), EMPTY)   /* without RT_ARM_IDIV */
+
+/* rem */
+
+#define remxx_xm(RM, DP) /* Reax is in/out, Redx is zero-extended */        \
+        divxx_xm(W(RM), W(DP)) /* remainder in Redx */
+
+#define remxn_xm(RM, DP) /* Reax is in/out, Redx is Reax-sign-extended */   \
+        divxn_xm(W(RM), W(DP)) /* remainder in Redx */
 
 /* cmp */
 
@@ -0,0 +1,377 @@
+/******************************************************************************/
+/* Copyright (c) 2013-2015 VectorChief (at github, bitbucket, sourceforge)    */
+/* Distributed under the MIT software license, see the accompanying           */
+/* file COPYING or http://www.opensource.org/licenses/mit-license.php         */
+/******************************************************************************/
+
+#ifndef RT_RTARENA_H
+#define RT_RTARENA_H
+
+#include "rtarch.h"
+
+/******************************************************************************/
+/*********************************   LEGEND   *********************************/
+/******************************************************************************/
+
+/*
+ * rtarena.h: SIMD-aligned arena allocator.
+ *
+ * rt_Arena hands out memory by bumping a pointer within large chunks
+ * obtained from the application via rt_FUNC_ALLOC/rt_FUNC_FREE pair
+ * (malloc/free if not provided). rt_Arena::page_alloc/page_free pair
+ * maps chunks directly from the system instead (mmap, VirtualAlloc),
+ * chunks of RT_HUGE_PAGE size or larger are advised to use huge pages.
+ *
+ * Each allocation is aligned to RT_ARENA_ALIGN (cache line, which also
+ * satisfies RT_SIMD_ALIGN) or to a larger power of two if requested.
+ * There is no per-allocation free, reset() rewinds the whole arena at once
+ * keeping its chunks for reuse, release() returns them to the application.
+ *
+ * Arenas are not thread-safe, each thread is supposed to own its arena(s).
+ * rt_ArenaSet<N> keeps N arenas for N threads, thread k (as indexed by
+ * sys_para in simd_test) allocates from arena(k) without locking.
+ * As chunks never share cache lines, separate arenas don't false-share.
+ * Pointers are aligned by their low bits only, which are taken from
+ * a pointer-sized integer (size_t) to avoid truncation on 64-bit hosts.
+ */
+
+/******************************************************************************/
+/*******************************   DEFINITIONS   ******************************/
+/******************************************************************************/
+
+#define RT_CACHE_LINE       64
+#define RT_ARENA_ALIGN      RT_MAX(RT_SIMD_ALIGN, RT_CACHE_LINE)
+#define RT_ARENA_CHUNK      (256 * 1024) /* default chunk size */
+#define RT_HUGE_PAGE        (2 * 1024 * 1024) /* min chunk for huge pages */
+
+/* padding to advance pointer p to the next multiple of a (power of 2) */
+#define RT_ALIGN_PAD(p, a)  ((rt_word)(0 - (size_t)(p)) & (rt_word)((a) - 1))
+
+typedef rt_pntr (*rt_FUNC_ALLOC)(rt_size size);
+typedef rt_void (*rt_FUNC_FREE)(rt_pntr ptr, rt_size size);
+
+/*
+ * Chunk header is placed at the beginning of each chunk,
+ * chunks are kept in a list in the order of their allocation.
+ */
+struct rt_CHUNK
+{
+    rt_CHUNK   *next;
+    rt_size     size;               /* size as passed to f_alloc */
+    rt_byte    *ptr;                /* first free byte */
+    rt_byte    *end;                /* end of the chunk */
+};
+
+/******************************************************************************/
+/*********************************   PAGES   **********************************/
+/******************************************************************************/
+
+#if   defined (RT_WIN32) /* Win32, MSVC ------------------------------------- */
+
+#include <windows.h>
+
+#elif defined (RT_LINUX) /* Linux, GCC -------------------------------------- */
+
+#include <sys/mman.h>
+
+#endif /* ------------- OS specific ----------------------------------------- */
+
+/******************************************************************************/
+/*********************************   ARENA   **********************************/
+/******************************************************************************/
+
+class rt_Arena
+{
+/*  fields */
+
+    private:
+
+    rt_FUNC_ALLOC       f_alloc;
+    rt_FUNC_FREE        f_free;
+
+    /* minimal size of new chunks */
+    rt_size             chunk;
+
+    /* first chunk in the list */
+    rt_CHUNK           *head;
+    /* chunk being bumped */
+    rt_CHUNK           *curr;
+
+    /* default chunk allocator */
+    static
+    rt_pntr sys_alloc(rt_size size)
+    {
+        return malloc((size_t)size);
+    }
+
+    /* default chunk deallocator */
+    static
+    rt_void sys_free(rt_pntr ptr, rt_size /* size */)
+    {
+        free(ptr);
+    }
+
+    public:
+
+    /*
+     * Chunk allocator mapping pages directly (page-aligned, zero-filled),
+     * chunks of RT_HUGE_PAGE size or larger are advised to use huge pages
+     * on Linux (transparent huge pages), falls back to malloc elsewhere.
+     */
+    static
+    rt_pntr page_alloc(rt_size size)
+    {
+#if   defined (RT_WIN32) /* Win32, MSVC ------------------------------------- */
+
+        return VirtualAlloc(NULL, (SIZE_T)size,
+                            MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+
+#elif defined (RT_LINUX) /* Linux, GCC -------------------------------------- */
+
+        rt_pntr ptr = mmap(NULL, (size_t)size, PROT_READ | PROT_WRITE,
+                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (ptr == MAP_FAILED)
+        {
+            return RT_NULL;
+        }
+
+#if defined (MADV_HUGEPAGE)
+        if (size >= RT_HUGE_PAGE)
+        {
+            madvise(ptr, (size_t)size, MADV_HUGEPAGE);
+        }
+#endif /* MADV_HUGEPAGE */
+
+        return ptr;
+
+#else  /* ------------- OS specific ----------------------------------------- */
+
+        return sys_alloc(size);
+
+#endif /* ------------- OS specific ----------------------------------------- */
+    }
+
+    /* chunk deallocator for page_alloc */
+    static
+    rt_void page_free(rt_pntr ptr, rt_size size)
+    {
+#if   defined (RT_WIN32) /* Win32, MSVC ------------------------------------- */
+
+        VirtualFree(ptr, 0, MEM_RELEASE);
+
+#elif defined (RT_LINUX) /* Linux, GCC -------------------------------------- */
+
+        munmap(ptr, (size_t)size);
+
+#else  /* ------------- OS specific ----------------------------------------- */
+
+        sys_free(ptr, size);
+
+#endif /* ------------- OS specific ----------------------------------------- */
+    }
+
+    private:
+
+    /* start usable area past the header of chunk c */
+    static
+    rt_void rewind(rt_CHUNK *c)
+    {
+        c->ptr = (rt_byte *)(c + 1);
+        c->ptr += RT_ALIGN_PAD(c->ptr, RT_ARENA_ALIGN);
+    }
+
+/*  methods */
+
+    public:
+
+    rt_Arena(rt_size chunk = RT_ARENA_CHUNK,
+             rt_FUNC_ALLOC f_alloc = RT_NULL, rt_FUNC_FREE f_free = RT_NULL)
+    {
+        head = RT_NULL;
+        curr = RT_NULL;
+
+        setup(chunk, f_alloc, f_free);
+    }
+
+    /*
+     * Set chunk size and allocator pair for chunks allocated from now on,
+     * must be called before the first alloc() if allocator pair changes.
+     */
+    rt_void setup(rt_size chunk = RT_ARENA_CHUNK,
+                  rt_FUNC_ALLOC f_alloc = RT_NULL,
+                  rt_FUNC_FREE  f_free  = RT_NULL)
+    {
+        this->f_alloc = f_alloc != RT_NULL ? f_alloc : sys_alloc;
+        this->f_free  = f_free  != RT_NULL ? f_free  : sys_free;
+        this->chunk   = chunk;
+    }
+
+   ~rt_Arena()
+    {
+        release();
+    }
+
+    /*
+     * Allocate size bytes aligned to align (power of 2),
+     * which is raised to RT_ARENA_ALIGN if smaller.
+     * Returns RT_NULL if chunk allocation fails.
+     */
+    rt_pntr alloc(rt_size size, rt_size align = RT_ARENA_ALIGN)
+    {
+        rt_CHUNK *c;
+        rt_byte *p;
+
+        align = RT_MAX(align, RT_ARENA_ALIGN);
+
+        for (c = curr; c != RT_NULL; c = c->next)
+        {
+            p = c->ptr + RT_ALIGN_PAD(c->ptr, align);
+
+            if (size <= c->end - p)
+            {
+                c->ptr = p + size;
+                curr = c;
+                return p;
+            }
+        }
+
+        /* header, alignment slack for base and block, block itself */
+        rt_size need = sizeof(rt_CHUNK) + RT_ARENA_ALIGN + align + size;
+        rt_size n = RT_MAX(chunk, need);
+
+        c = (rt_CHUNK *)f_alloc(n);
+
+        if (c == RT_NULL)
+        {
+            return RT_NULL;
+        }
+
+        c->size = n;
+        c->end  = (rt_byte *)c + n;
+        rewind(c);
+
+        /* keep chunks allocated after curr (reused after reset) in order */
+        if (curr == RT_NULL)
+        {
+            c->next = head;
+            head = c;
+        }
+        else
+        {
+            c->next = curr->next;
+            curr->next = c;
+        }
+
+        curr = c;
+
+        p = c->ptr + RT_ALIGN_PAD(c->ptr, align);
+        c->ptr = p + size;
+        return p;
+    }
+
+    /*
+     * Rewind all chunks, previously allocated memory is no longer valid.
+     */
+    rt_void reset()
+    {
+        rt_CHUNK *c;
+
+        for (c = head; c != RT_NULL; c = c->next)
+        {
+            rewind(c);
+        }
+
+        curr = head;
+    }
+
+    /*
+     * Return all chunks to the application.
+     */
+    rt_void release()
+    {
+        rt_CHUNK *c, *n;
+
+        for (c = head; c != RT_NULL; c = n)
+        {
+            n = c->next;
+            f_free(c, c->size);
+        }
+
+        head = RT_NULL;
+        curr = RT_NULL;
+    }
+};
+
+/******************************************************************************/
+/*******************************   ARENA SET   ********************************/
+/******************************************************************************/
+
+/*
+ * N arenas for N threads, arena k is only accessed by thread k.
+ * Arena objects are cache-line padded, as arena(k).alloc() updates them.
+ */
+template <rt_cell N>
+class rt_ArenaSet
+{
+/*  fields */
+
+    private:
+
+    struct rt_ARENA_SLOT
+    {
+        rt_Arena        heap;
+        rt_byte         pad[RT_CACHE_LINE];
+    };
+
+    rt_ARENA_SLOT       slot[N];
+
+/*  methods */
+
+    public:
+
+    rt_ArenaSet(rt_size chunk = RT_ARENA_CHUNK,
+                rt_FUNC_ALLOC f_alloc = RT_NULL, rt_FUNC_FREE f_free = RT_NULL)
+    {
+        rt_cell k;
+
+        for (k = 0; k < N; k++)
+        {
+            slot[k].heap.setup(chunk, f_alloc, f_free);
+        }
+    }
+
+    /* arena of thread k */
+    rt_Arena *arena(rt_cell k)
+    {
+        return &slot[k].heap;
+    }
+
+    /* rewind arenas of all threads, call when threads are joined */
+    rt_void reset()
+    {
+        rt_cell k;
+
+        for (k = 0; k < N; k++)
+        {
+            slot[k].heap.reset();
+        }
+    }
+
+    /* release arenas of all threads, call when threads are joined */
+    rt_void release()
+    {
+        rt_cell k;
+
+        for (k = 0; k < N; k++)
+        {
+            slot[k].heap.release();
+        }
+    }
+};
+
+#endif /* RT_RTARENA_H */
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
@@ -111,6 +111,21 @@ typedef rt_ui64             rt_full;
 typedef void                rt_void;
 typedef void               *rt_pntr;
 
+/* pointer-sized integer type */
+#if   defined (RT_A64) || defined (RT_REF) && defined (__LP64__) /* 64-bit -- */
+
+typedef rt_ui64             rt_addr;
+
+#define RT_POINTER          64
+
+#else  /* RT_X86, RT_X32, RT_ARM, RT_REF -- 32-bit addressing --------------- */
+
+typedef rt_ui32             rt_addr;
+
+#define RT_POINTER          32
+
+#endif /* ------------- ARCH specific --------------------------------------- */
+
 typedef const char          rt_astr[];
 typedef const char         *rt_pstr;
 
@@ -0,0 +1,508 @@
+/******************************************************************************/
+/* Copyright (c) 2013-2015 VectorChief (at github, bitbucket, sourceforge)    */
+/* Distributed under the MIT software license, see the accompanying           */
+/* file COPYING or http://www.opensource.org/licenses/mit-license.php         */
+/******************************************************************************/
+
+#ifndef RT_RTMEM_H
+#define RT_RTMEM_H
+
+#include "rtarena.h"
+
+/******************************************************************************/
+/*********************************   LEGEND   *********************************/
+/******************************************************************************/
+
+/*
+ * rtmem.h: SIMD memory routines.
+ *
+ * rt_memcpy, rt_memset, rt_memcmp take the same arguments and return
+ * the same results as their libc counterparts, rt_memcpy_nt, rt_memset_nt
+ * always use non-temporal stores (rt_memcpy, rt_memset do so from
+ * RT_MEM_NTS bytes up, where the destination would only evict useful data
+ * from caches, ARM targets have no such hint and store as usual).
+ *
+ * Bulk memory kernels work on mlen 32-bit words at mdst (word-aligned)
+ * and msrc (any alignment), as there are no byte loads/stores in the
+ * instruction subset, bytes before and after the words are done in C.
+ * Kernels take at most RT_MEM_MAX words per call (mlen is rt_cell),
+ * larger sizes are split into as many calls as needed.
+ * Copy and fill kernels store single words until mdst is SIMD-aligned,
+ * then 4 SIMD vectors per iteration (prefetching msrc RT_MEM_PFD bytes
+ * ahead), then single vectors and remaining words. Source vectors are
+ * loaded with movux_ld regardless of their alignment. Non-temporal kernels
+ * (nt = 1) store vectors with movnx_st followed by a store fence.
+ * Compare kernel counts equal words of msrc and mdst from the start to mres,
+ * the order of the first differing bytes is then found in C.
+ *
+ * Arguments are passed to the kernels in rt_MEM_ARGS on the caller's stack,
+ * thus the routines can be called from any thread. Kernels are never inlined
+ * (RT_NOINLINE), as every copy of an asm block would repeat its labels.
+ */
+
+/******************************************************************************/
+/*******************************   DEFINITIONS   ******************************/
+/******************************************************************************/
+
+#define RT_MEM_NTS          (1 << 20) /* min bytes for non-temporal stores */
+#define RT_MEM_PFD          DP(Q*0x200) /* prefetch distance */
+#define RT_MEM_MAX          (1 << 30) /* max words per kernel call */
+
+#if   defined (RT_WIN32) /* Win32, MSVC ------------------------------------- */
+
+#define RT_NOINLINE         __declspec(noinline)
+
+#elif defined (RT_LINUX) /* Linux, GCC -------------------------------------- */
+
+#define RT_NOINLINE         __attribute__((noinline, noclone))
+
+#endif /* ------------- OS specific ----------------------------------------- */
+
+/*
+ * Kernel arguments, offsets are used in asm sections.
+ */
+struct rt_MEM_ARGS
+{
+    rt_byte*mdst;
+#define mem_MDST            DP(0x000*P)
+
+    rt_byte*msrc;
+#define mem_MSRC            DP(0x004*P)
+
+    rt_cell mlen;
+#define mem_MLEN            DP(0x008*P)
+
+    rt_word mval;
+#define mem_MVAL            DP(0x008*P+0x004)
+
+    rt_cell mres;
+#define mem_MRES            DP(0x008*P+0x008)
+
+};
+
+/******************************************************************************/
+/*********************************   MACROS   *********************************/
+/******************************************************************************/
+
+/*
+ * Vector stores and fence of regular (nt = 0)
+ * and non-temporal (nt = 1) kernels.
+ */
+#define RT_MEM_VST0(RG, RM, DP)                                             \
+        movpx_st(W(RG), W(RM), W(DP))
+#define RT_MEM_VST1(RG, RM, DP)                                             \
+        movnx_st(W(RG), W(RM), W(DP))
+
+#define RT_MEM_FEN0()
+#define RT_MEM_FEN1()                                                       \
+        fence_st()
+
+/*
+ * Nonzero lanes of Xmm0 to all ones (either x or -x is negative).
+ * Destroys Xmm1.
+ */
+#define RT_MEM_NEZ()                                                        \
+        xorpx_rr(Xmm1, Xmm1)                                                \
+        subpx_rr(Xmm1, Xmm0)                                                \
+        orrpx_rr(Xmm0, Xmm1)                                                \
+        shrpn_ri(Xmm0, IB(31))
+
+/*
+ * Copy mlen words from msrc to mdst.
+ */
+#define RT_MEM_CPY(nt, lb)                                                  \
+        movxa_ld(Redx, Mebp, mem_MDST)                                      \
+        movxa_ld(Recx, Mebp, mem_MSRC)                                      \
+        movxx_ld(Reax, Mebp, mem_MLEN)                                      \
+    LBL(lb##_hd)                                                            \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jeqxx_lb(lb##_end)                                                  \
+        movxx_rr(Rebx, Redx)                                                \
+        andxx_ri(Rebx, IB(RT_SIMD_ALIGN - 1))                               \
+        cmpxx_ri(Rebx, IB(0))                                               \
+        jeqxx_lb(lb##_blk)                                                  \
+        movxx_ld(Rebx, Mecx, DP(0x000))                                     \
+        movxx_st(Rebx, Medx, DP(0x000))                                     \
+        addxx_ri(Recx, IB(4))                                               \
+        addxx_ri(Redx, IB(4))                                               \
+        subxx_ri(Reax, IB(1))                                               \
+        jmpxx_lb(lb##_hd)                                                   \
+    LBL(lb##_blk)                                                           \
+        cmpxx_ri(Reax, IB(S*4))                                             \
+        jltxx_lb(lb##_vec)                                                  \
+        prfxx_ld(Mecx, RT_MEM_PFD)                                          \
+        movux_ld(Xmm0, Mecx, DP(Q*0x000))                                   \
+        movux_ld(Xmm1, Mecx, DP(Q*0x010))                                   \
+        movux_ld(Xmm2, Mecx, DP(Q*0x020))                                   \
+        movux_ld(Xmm3, Mecx, DP(Q*0x030))                                   \
+        RT_MEM_VST##nt(Xmm0, Medx, DP(Q*0x000))                             \
+        RT_MEM_VST##nt(Xmm1, Medx, DP(Q*0x010))                             \
+        RT_MEM_VST##nt(Xmm2, Medx, DP(Q*0x020))                             \
+        RT_MEM_VST##nt(Xmm3, Medx, DP(Q*0x030))                             \
+        addxx_ri(Recx, IB(Q*0x040))                                         \
+        addxx_ri(Redx, IB(Q*0x040))                                         \
+        subxx_ri(Reax, IB(S*4))                                             \
+        jmpxx_lb(lb##_blk)                                                  \
+    LBL(lb##_vec)                                                           \
+        cmpxx_ri(Reax, IB(S))                                               \
+        jltxx_lb(lb##_tl1)                                                  \
+        movux_ld(Xmm0, Mecx, DP(0x000))                                     \
+        RT_MEM_VST##nt(Xmm0, Medx, DP(0x000))                               \
+        addxx_ri(Recx, IB(Q*0x010))                                         \
+        addxx_ri(Redx, IB(Q*0x010))                                         \
+        subxx_ri(Reax, IB(S))                                               \
+        jmpxx_lb(lb##_vec)                                                  \
+    LBL(lb##_tl1)                                                           \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jeqxx_lb(lb##_end)                                                  \
+        movxx_ld(Rebx, Mecx, DP(0x000))                                     \
+        movxx_st(Rebx, Medx, DP(0x000))                                     \
+        addxx_ri(Recx, IB(4))                                               \
+        addxx_ri(Redx, IB(4))                                               \
+        subxx_ri(Reax, IB(1))                                               \
+        jmpxx_lb(lb##_tl1)                                                  \
+    LBL(lb##_end)                                                           \
+        RT_MEM_FEN##nt()
+
+/*
+ * Fill mlen words at mdst with mval.
+ */
+#define RT_MEM_SET(nt, lb)                                                  \
+        splpx_ld(Xmm0, Mebp, mem_MVAL)                                      \
+        movxa_ld(Redx, Mebp, mem_MDST)                                      \
+        movxx_ld(Recx, Mebp, mem_MVAL)                                      \
+        movxx_ld(Reax, Mebp, mem_MLEN)                                      \
+    LBL(lb##_hd)                                                            \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jeqxx_lb(lb##_end)                                                  \
+        movxx_rr(Rebx, Redx)                                                \
+        andxx_ri(Rebx, IB(RT_SIMD_ALIGN - 1))                               \
+        cmpxx_ri(Rebx, IB(0))                                               \
+        jeqxx_lb(lb##_blk)                                                  \
+        movxx_st(Recx, Medx, DP(0x000))                                     \
+        addxx_ri(Redx, IB(4))                                               \
+        subxx_ri(Reax, IB(1))                                               \
+        jmpxx_lb(lb##_hd)                                                   \
+    LBL(lb##_blk)                                                           \
+        cmpxx_ri(Reax, IB(S*4))                                             \
+        jltxx_lb(lb##_vec)                                                  \
+        RT_MEM_VST##nt(Xmm0, Medx, DP(Q*0x000))                             \
+        RT_MEM_VST##nt(Xmm0, Medx, DP(Q*0x010))                             \
+        RT_MEM_VST##nt(Xmm0, Medx, DP(Q*0x020))                             \
+        RT_MEM_VST##nt(Xmm0, Medx, DP(Q*0x030))                             \
+        addxx_ri(Redx, IB(Q*0x040))                                         \
+        subxx_ri(Reax, IB(S*4))                                             \
+        jmpxx_lb(lb##_blk)                                                  \
+    LBL(lb##_vec)                                                           \
+        cmpxx_ri(Reax, IB(S))                                               \
+        jltxx_lb(lb##_tl1)                                                  \
+        RT_MEM_VST##nt(Xmm0, Medx, DP(0x000))                               \
+        addxx_ri(Redx, IB(Q*0x010))                                         \
+        subxx_ri(Reax, IB(S))                                               \
+        jmpxx_lb(lb##_vec)                                                  \
+    LBL(lb##_tl1)                                                           \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jeqxx_lb(lb##_end)                                                  \
+        movxx_st(Recx, Medx, DP(0x000))                                     \
+        addxx_ri(Redx, IB(4))                                               \
+        subxx_ri(Reax, IB(1))                                               \
+        jmpxx_lb(lb##_tl1)                                                  \
+    LBL(lb##_end)                                                           \
+        RT_MEM_FEN##nt()
+
+/*
+ * Count equal words of msrc and mdst from the start (up to mlen) to mres,
+ * a differing block of vectors is rescanned word by word.
+ */
+#define RT_MEM_CMP(lb)                                                      \
+        movxa_ld(Recx, Mebp, mem_MSRC)                                      \
+        movxa_ld(Redx, Mebp, mem_MDST)                                      \
+        movxx_ld(Rebx, Mebp, mem_MLEN)                                      \
+    LBL(lb##_blk)                                                           \
+        cmpxx_ri(Rebx, IB(S*4))                                             \
+        jltxx_lb(lb##_vec)                                                  \
+        prfxx_ld(Mecx, RT_MEM_PFD)                                          \
+        prfxx_ld(Medx, RT_MEM_PFD)                                          \
+        movux_ld(Xmm0, Mecx, DP(Q*0x000))                                   \
+        movux_ld(Xmm4, Medx, DP(Q*0x000))                                   \
+        xorpx_rr(Xmm0, Xmm4)                                                \
+        movux_ld(Xmm1, Mecx, DP(Q*0x010))                                   \
+        movux_ld(Xmm5, Medx, DP(Q*0x010))                                   \
+        xorpx_rr(Xmm1, Xmm5)                                                \
+        movux_ld(Xmm2, Mecx, DP(Q*0x020))                                   \
+        movux_ld(Xmm6, Medx, DP(Q*0x020))                                   \
+        xorpx_rr(Xmm2, Xmm6)                                                \
+        movux_ld(Xmm3, Mecx, DP(Q*0x030))                                   \
+        movux_ld(Xmm7, Medx, DP(Q*0x030))                                   \
+        xorpx_rr(Xmm3, Xmm7)                                                \
+        orrpx_rr(Xmm0, Xmm1)                                                \
+        orrpx_rr(Xmm2, Xmm3)                                                \
+        orrpx_rr(Xmm0, Xmm2)                                                \
+        RT_MEM_NEZ()                                                        \
+        CHECK_MASK(lb##_bnx, NONE, Xmm0)                                    \
+        jmpxx_lb(lb##_tl1)                                                  \
+    LBL(lb##_bnx)                                                           \
+        addxx_ri(Recx, IB(Q*0x040))                                         \
+        addxx_ri(Redx, IB(Q*0x040))                                         \
+        subxx_ri(Rebx, IB(S*4))                                             \
+        jmpxx_lb(lb##_blk)                                                  \
+    LBL(lb##_vec)                                                           \
+        cmpxx_ri(Rebx, IB(S))                                               \
+        jltxx_lb(lb##_tl1)                                                  \
+        movux_ld(Xmm0, Mecx, DP(0x000))                                     \
+        movux_ld(Xmm4, Medx, DP(0x000))                                     \
+        xorpx_rr(Xmm0, Xmm4)                                                \
+        RT_MEM_NEZ()                                                        \
+        CHECK_MASK(lb##_vnx, NONE, Xmm0)                                    \
+        jmpxx_lb(lb##_tl1)                                                  \
+    LBL(lb##_vnx)                                                           \
+        addxx_ri(Recx, IB(Q*0x010))                                         \
+        addxx_ri(Redx, IB(Q*0x010))                                         \
+        subxx_ri(Rebx, IB(S))                                               \
+        jmpxx_lb(lb##_vec)                                                  \
+    LBL(lb##_tl1)                                                           \
+        cmpxx_ri(Rebx, IB(0))                                               \
+        jeqxx_lb(lb##_end)                                                  \
+        movxx_ld(Reax, Mecx, DP(0x000))                                     \
+        cmpxx_rm(Reax, Medx, DP(0x000))                                     \
+        jnexx_lb(lb##_end)                                                  \
+        addxx_ri(Recx, IB(4))                                               \
+        addxx_ri(Redx, IB(4))                                               \
+        subxx_ri(Rebx, IB(1))                                               \
+        jmpxx_lb(lb##_tl1)                                                  \
+    LBL(lb##_end)                                                           \
+        movxx_ld(Reax, Mebp, mem_MLEN)                                      \
+        subxx_rr(Reax, Rebx)                                                \
+        movxx_st(Reax, Mebp, mem_MRES)
+
+/******************************************************************************/
+/*********************************   KERNELS   ********************************/
+/******************************************************************************/
+
+inline RT_NOINLINE
+rt_void mem_cpy(rt_MEM_ARGS *args)
+{
+    ASM_ENTER(args)
+        RT_MEM_CPY(0, mcp)
+    ASM_LEAVE(args)
+}
+
+inline RT_NOINLINE
+rt_void mem_cpy_nt(rt_MEM_ARGS *args)
+{
+    ASM_ENTER(args)
+        RT_MEM_CPY(1, mcn)
+    ASM_LEAVE(args)
+}
+
+inline RT_NOINLINE
+rt_void mem_set(rt_MEM_ARGS *args)
+{
+    ASM_ENTER(args)
+        RT_MEM_SET(0, msp)
+    ASM_LEAVE(args)
+}
+
+inline RT_NOINLINE
+rt_void mem_set_nt(rt_MEM_ARGS *args)
+{
+    ASM_ENTER(args)
+        RT_MEM_SET(1, msn)
+    ASM_LEAVE(args)
+}
+
+inline RT_NOINLINE
+rt_void mem_cmp(rt_MEM_ARGS *args)
+{
+    ASM_ENTER(args)
+        RT_MEM_CMP(mcm)
+    ASM_LEAVE(args)
+}
+
+/******************************************************************************/
+/*********************************   ROUTINES   *******************************/
+/******************************************************************************/
+
+/*
+ * Copy size bytes from src to dst (not overlapping),
+ * with non-temporal stores if nt is set.
+ */
+inline
+rt_void mem_copy(rt_byte *dst, rt_byte *src, rt_size size, rt_bool nt)
+{
+    rt_MEM_ARGS args;
+    rt_size j, k = RT_MIN(size, (rt_size)RT_ALIGN_PAD(dst, 4));
+    rt_size n = (size - k) / 4;
+
+    for (j = 0; j < k; j++)
+    {
+        dst[j] = src[j];
+    }
+
+    args.mdst = dst + k;
+    args.msrc = src + k;
+
+    while (n > 0)
+    {
+        args.mlen = (rt_cell)RT_MIN(n, (rt_size)RT_MEM_MAX);
+
+        if (nt)
+        {
+            mem_cpy_nt(&args);
+        }
+        else
+        {
+            mem_cpy(&args);
+        }
+
+        args.mdst += (rt_size)args.mlen * 4;
+        args.msrc += (rt_size)args.mlen * 4;
+        n -= (rt_size)args.mlen;
+    }
+
+    for (j = (rt_size)(args.mdst - dst); j < size; j++)
+    {
+        dst[j] = src[j];
+    }
+}
+
+/*
+ * Fill size bytes at dst with byte c,
+ * with non-temporal stores if nt is set.
+ */
+inline
+rt_void mem_fill(rt_byte *dst, rt_byte c, rt_size size, rt_bool nt)
+{
+    rt_MEM_ARGS args;
+    rt_size j, k = RT_MIN(size, (rt_size)RT_ALIGN_PAD(dst, 4));
+    rt_size n = (size - k) / 4;
+
+    for (j = 0; j < k; j++)
+    {
+        dst[j] = c;
+    }
+
+    args.mdst = dst + k;
+    args.mval = (rt_word)c * 0x01010101;
+
+    while (n > 0)
+    {
+        args.mlen = (rt_cell)RT_MIN(n, (rt_size)RT_MEM_MAX);
+
+        if (nt)
+        {
+            mem_set_nt(&args);
+        }
+        else
+        {
+            mem_set(&args);
+        }
+
+        args.mdst += (rt_size)args.mlen * 4;
+        n -= (rt_size)args.mlen;
+    }
+
+    for (j = (rt_size)(args.mdst - dst); j < size; j++)
+    {
+        dst[j] = c;
+    }
+}
+
+/*
+ * Copy size bytes from src to dst (not overlapping) as memcpy does,
+ * non-temporal stores are used from RT_MEM_NTS bytes up.
+ */
+inline
+rt_pntr rt_memcpy(rt_pntr dst, const rt_void *src, rt_size size)
+{
+    mem_copy((rt_byte *)dst, (rt_byte *)src, size, size >= RT_MEM_NTS);
+
+    return dst;
+}
+
+/*
+ * Copy size bytes from src to dst (not overlapping) as memcpy does,
+ * always with non-temporal stores.
+ */
+inline
+rt_pntr rt_memcpy_nt(rt_pntr dst, const rt_void *src, rt_size size)
+{
+    mem_copy((rt_byte *)dst, (rt_byte *)src, size, RT_TRUE);
+
+    return dst;
+}
+
+/*
+ * Fill size bytes at dst with (rt_byte)c as memset does,
+ * non-temporal stores are used from RT_MEM_NTS bytes up.
+ */
+inline
+rt_pntr rt_memset(rt_pntr dst, rt_cell c, rt_size size)
+{
+    mem_fill((rt_byte *)dst, (rt_byte)c, size, size >= RT_MEM_NTS);
+
+    return dst;
+}
+
+/*
+ * Fill size bytes at dst with (rt_byte)c as memset does,
+ * always with non-temporal stores.
+ */
+inline
+rt_pntr rt_memset_nt(rt_pntr dst, rt_cell c, rt_size size)
+{
+    mem_fill((rt_byte *)dst, (rt_byte)c, size, RT_TRUE);
+
+    return dst;
+}
+
+/*
+ * Compare size bytes at ptr1 and ptr2 as memcmp does, returns difference
+ * of the first differing bytes (as unsigned) or 0 if all are equal.
+ */
+inline
+rt_cell rt_memcmp(const rt_void *ptr1, const rt_void *ptr2, rt_size size)
+{
+    rt_MEM_ARGS args;
+    rt_byte *p1 = (rt_byte *)ptr1;
+    rt_byte *p2 = (rt_byte *)ptr2;
+    rt_size j = 0, n = size / 4;
+
+    args.msrc = p1;
+    args.mdst = p2;
+
+    while (n > 0)
+    {
+        args.mlen = (rt_cell)RT_MIN(n, (rt_size)RT_MEM_MAX);
+        args.mres = 0; /* scalar loop covers all if kernel isn't run */
+
+        mem_cmp(&args);
+
+        j += (rt_size)args.mres * 4;
+
+        if (args.mres < args.mlen)
+        {
+            break;
+        }
+
+        args.msrc += (rt_size)args.mlen * 4;
+        args.mdst += (rt_size)args.mlen * 4;
+        n -= (rt_size)args.mlen;
+    }
+
+    for (; j < size; j++)
+    {
+        if (p1[j] != p2[j])
+        {
+            return (rt_cell)p1[j] - (rt_cell)p2[j];
+        }
+    }
+
+    return 0;
+}
+
+#endif /* RT_RTMEM_H */
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
@@ -0,0 +1,488 @@
+/******************************************************************************/
+/* Copyright (c) 2013-2015 VectorChief (at github, bitbucket, sourceforge)    */
+/* Distributed under the MIT software license, see the accompanying           */
+/* file COPYING or http://www.opensource.org/licenses/mit-license.php         */
+/******************************************************************************/
+
+#ifndef RT_RTSOA_H
+#define RT_RTSOA_H
+
+#include "rtarena.h"
+#include "rtmem.h"
+
+/******************************************************************************/
+/*********************************   LEGEND   *********************************/
+/******************************************************************************/
+
+/*
+ * rtsoa.h: SIMD-friendly data layout containers.
+ *
+ * rt_SoA<N> keeps N fp32 components of each element (such as RT_X, RT_Y,
+ * RT_Z of rt_vec3) in N separate streams, so that a SIMD register loaded from
+ * a stream holds the same component of S consecutive elements.
+ * rt_AoSoA<N> interleaves the streams per block of S elements instead,
+ * so that all components of a block are kept within a few cache lines.
+ *
+ * Streams/blocks start at RT_SIMD_ALIGN boundary and are padded with zeros
+ * to a multiple of S elements, thus asm sections iterate in whole SIMD-width
+ * blocks without tails. Address of a block is passed to asm sections via
+ * inf_* pointer, then component c of the block is found at:
+ *  - rt_SoA:   c * stride() bytes from block (same offset for all blocks),
+ *  - rt_AoSoA: DP(Q*0x010*c) from block (blocks are N*Q*0x010 bytes apart).
+ *
+ * Containers either allocate their data from rt_Arena or are attached
+ * to existing SIMD-aligned memory (views), in which case they don't own it.
+ * Scalar from_aos/to_aos conversions serve as reference for SIMD versions,
+ * rt_soa_from_aos3, rt_soa_to_aos3 convert rt_vec3 arrays to rt_SoA<3>
+ * and back with gather/scatter kernels, which take their arguments
+ * in rt_SOA_ARGS on the caller's stack (as the kernels in rtmem.h do).
+ * Gather indices come first in rt_SOA_ARGS and are loaded with movux_ld,
+ * as the caller's stack isn't guaranteed to be SIMD-aligned.
+ */
+
+/******************************************************************************/
+/*******************************   DEFINITIONS   ******************************/
+/******************************************************************************/
+
+/* number of elements n rounded up to a multiple of SIMD width */
+#define RT_SOA_PAD(n)       (((n) + RT_SIMD_WIDTH - 1) & ~(RT_SIMD_WIDTH - 1))
+
+/*
+ * Kernel arguments, offsets are used in asm sections.
+ */
+struct rt_SOA_ARGS
+{
+    rt_cell sidx[S];
+#define soa_SIDX            DP(0x000)
+
+    rt_real*saos;
+#define soa_SAOS            DP(Q*0x010+0x000*P)
+
+    rt_real*ssoa;
+#define soa_SSOA            DP(Q*0x010+0x004*P)
+
+    rt_cell scnt;
+#define soa_SCNT            DP(Q*0x010+0x008*P)
+
+    rt_cell sstr;
+#define soa_SSTR            DP(Q*0x010+0x008*P+0x004)
+
+};
+
+/******************************************************************************/
+/**********************************   SOA   ***********************************/
+/******************************************************************************/
+
+template <rt_cell N>
+class rt_SoA
+{
+/*  fields */
+
+    public:
+
+    /* first stream */
+    rt_real            *base;
+
+    /* number of elements */
+    rt_cell             size;
+    /* stream length (elements), multiple of S */
+    rt_cell             pads;
+
+/*  methods */
+
+    public:
+
+    /* allocate streams for size elements from heap, zero padding */
+    rt_SoA(rt_Arena *heap, rt_cell size)
+    {
+        rt_cell c, i;
+
+        this->size = size;
+        this->pads = RT_SOA_PAD(size);
+
+        base = (rt_real *)heap->alloc(N * pads * sizeof(rt_real));
+
+        for (c = 0; base != RT_NULL && c < N; c++)
+        {
+            for (i = size; i < pads; i++)
+            {
+                base[c * pads + i] = 0.0f;
+            }
+        }
+    }
+
+    /* attach to N * RT_SOA_PAD(size) elements at SIMD-aligned base */
+    rt_SoA(rt_real *base, rt_cell size)
+    {
+        this->base = base;
+        this->size = size;
+        this->pads = RT_SOA_PAD(size);
+    }
+
+    /* stream c */
+    rt_real *stream(rt_cell c)
+    {
+        return base + c * pads;
+    }
+
+    /* distance between streams in bytes */
+    rt_cell stride()
+    {
+        return pads * sizeof(rt_real);
+    }
+
+    /* number of SIMD-width blocks */
+    rt_cell blocks()
+    {
+        return pads / RT_SIMD_WIDTH;
+    }
+
+    /* block b of stream 0 */
+    rt_real *block(rt_cell b)
+    {
+        return base + b * RT_SIMD_WIDTH;
+    }
+
+    /* gather from size elements of N components, zero padding */
+    rt_void from_aos(rt_real *aos)
+    {
+        rt_cell c, i;
+
+        for (c = 0; c < N; c++)
+        {
+            rt_real *s = stream(c);
+
+            for (i = 0; i < size; i++)
+            {
+                s[i] = aos[i * N + c];
+            }
+            for (; i < pads; i++)
+            {
+                s[i] = 0.0f;
+            }
+        }
+    }
+
+    /* scatter to size elements of N components */
+    rt_void to_aos(rt_real *aos)
+    {
+        rt_cell c, i;
+
+        for (c = 0; c < N; c++)
+        {
+            rt_real *s = stream(c);
+
+            for (i = 0; i < size; i++)
+            {
+                aos[i * N + c] = s[i];
+            }
+        }
+    }
+};
+
+/******************************************************************************/
+/*********************************   AOSOA   **********************************/
+/******************************************************************************/
+
+template <rt_cell N>
+class rt_AoSoA
+{
+/*  fields */
+
+    public:
+
+    /* first block */
+    rt_real            *base;
+
+    /* number of elements */
+    rt_cell             size;
+    /* number of elements in blocks, multiple of S */
+    rt_cell             pads;
+
+/*  methods */
+
+    public:
+
+    /* allocate blocks for size elements from heap, zero padding */
+    rt_AoSoA(rt_Arena *heap, rt_cell size)
+    {
+        rt_cell c, i;
+
+        this->size = size;
+        this->pads = RT_SOA_PAD(size);
+
+        base = (rt_real *)heap->alloc(N * pads * sizeof(rt_real));
+
+        for (c = 0; base != RT_NULL && c < N; c++)
+        {
+            for (i = size; i < pads; i++)
+            {
+                *elem(i, c) = 0.0f;
+            }
+        }
+    }
+
+    /* attach to N * RT_SOA_PAD(size) elements at SIMD-aligned base */
+    rt_AoSoA(rt_real *base, rt_cell size)
+    {
+        this->base = base;
+        this->size = size;
+        this->pads = RT_SOA_PAD(size);
+    }
+
+    /* number of SIMD-width blocks */
+    rt_cell blocks()
+    {
+        return pads / RT_SIMD_WIDTH;
+    }
+
+    /* block b, its component c is at DP(Q*0x010*c) */
+    rt_real *block(rt_cell b)
+    {
+        return base + b * N * RT_SIMD_WIDTH;
+    }
+
+    /* component c of element i */
+    rt_real *elem(rt_cell i, rt_cell c)
+    {
+        return block(i / RT_SIMD_WIDTH) +
+                     c * RT_SIMD_WIDTH + i % RT_SIMD_WIDTH;
+    }
+
+    /* gather from size elements of N components, zero padding */
+    rt_void from_aos(rt_real *aos)
+    {
+        rt_cell c, i;
+
+        for (c = 0; c < N; c++)
+        {
+            for (i = 0; i < size; i++)
+            {
+                *elem(i, c) = aos[i * N + c];
+            }
+            for (; i < pads; i++)
+            {
+                *elem(i, c) = 0.0f;
+            }
+        }
+    }
+
+    /* scatter to size elements of N components */
+    rt_void to_aos(rt_real *aos)
+    {
+        rt_cell c, i;
+
+        for (c = 0; c < N; c++)
+        {
+            for (i = 0; i < size; i++)
+            {
+                aos[i * N + c] = *elem(i, c);
+            }
+        }
+    }
+};
+
+/******************************************************************************/
+/*********************************   KERNELS   ********************************/
+/******************************************************************************/
+
+/*
+ * Gather scnt elements of 3 components at saos to streams at ssoa
+ * (sstr bytes apart), zero padding up to the next SIMD-aligned block.
+ */
+inline RT_NOINLINE
+rt_void soa_gat3(rt_SOA_ARGS *args)
+{
+    ASM_ENTER(args)
+
+        movux_ld(Xmm7, Mebp, soa_SIDX)
+
+        movxa_ld(Recx, Mebp, soa_SAOS)
+        movxa_ld(Rebx, Mebp, soa_SSOA)
+        movxx_rr(Resi, Rebx)
+        addxx_ld(Resi, Mebp, soa_SSTR)
+        movxx_rr(Redi, Resi)
+        addxx_ld(Redi, Mebp, soa_SSTR)
+        movxx_ld(Reax, Mebp, soa_SCNT)
+        cmpxx_ri(Reax, IB(S))
+        jltxx_lb(sg3_tl1)
+
+    LBL(sg3_blk)
+
+        gatpx_ld(Xmm0, Xmm7, Mecx, DP(0x000))
+        gatpx_ld(Xmm1, Xmm7, Mecx, DP(0x004))
+        gatpx_ld(Xmm2, Xmm7, Mecx, DP(0x008))
+        movpx_st(Xmm0, Mebx, DP(0x000))
+        movpx_st(Xmm1, Mesi, DP(0x000))
+        movpx_st(Xmm2, Medi, DP(0x000))
+
+        addxx_ri(Recx, IH(Q*0x030))
+        addxx_ri(Rebx, IB(Q*0x010))
+        addxx_ri(Resi, IB(Q*0x010))
+        addxx_ri(Redi, IB(Q*0x010))
+        subxx_ri(Reax, IB(S))
+        cmpxx_ri(Reax, IB(S))
+        jgexx_lb(sg3_blk)
+
+    LBL(sg3_tl1)
+
+        cmpxx_ri(Reax, IB(0))
+        jeqxx_lb(sg3_end)
+
+    LBL(sg3_tl2)
+
+        movxx_ld(Redx, Mecx, DP(0x000))
+        movxx_st(Redx, Mebx, DP(0x000))
+        movxx_ld(Redx, Mecx, DP(0x004))
+        movxx_st(Redx, Mesi, DP(0x000))
+        movxx_ld(Redx, Mecx, DP(0x008))
+        movxx_st(Redx, Medi, DP(0x000))
+
+        addxx_ri(Recx, IB(12))
+        addxx_ri(Rebx, IB(4))
+        addxx_ri(Resi, IB(4))
+        addxx_ri(Redi, IB(4))
+        subxx_ri(Reax, IB(1))
+        cmpxx_ri(Reax, IB(0))
+        jgtxx_lb(sg3_tl2)
+
+    LBL(sg3_tl3) /* zero padding up to the next SIMD-aligned block */
+
+        movxx_rr(Redx, Rebx)
+        andxx_ri(Redx, IB(Q*0x010-1))
+        cmpxx_ri(Redx, IB(0))
+        jeqxx_lb(sg3_end)
+
+        movxx_mi(Mebx, DP(0x000), IB(0))
+        movxx_mi(Mesi, DP(0x000), IB(0))
+        movxx_mi(Medi, DP(0x000), IB(0))
+
+        addxx_ri(Rebx, IB(4))
+        addxx_ri(Resi, IB(4))
+        addxx_ri(Redi, IB(4))
+        jmpxx_lb(sg3_tl3)
+
+    LBL(sg3_end)
+
+    ASM_LEAVE(args)
+}
+
+/*
+ * Scatter scnt elements of 3 components from streams at ssoa
+ * (sstr bytes apart) to saos.
+ */
+inline RT_NOINLINE
+rt_void soa_sca3(rt_SOA_ARGS *args)
+{
+    ASM_ENTER(args)
+
+        movux_ld(Xmm7, Mebp, soa_SIDX)
+
+        movxa_ld(Recx, Mebp, soa_SAOS)
+        movxa_ld(Rebx, Mebp, soa_SSOA)
+        movxx_rr(Resi, Rebx)
+        addxx_ld(Resi, Mebp, soa_SSTR)
+        movxx_rr(Redi, Resi)
+        addxx_ld(Redi, Mebp, soa_SSTR)
+        movxx_ld(Reax, Mebp, soa_SCNT)
+        cmpxx_ri(Reax, IB(S))
+        jltxx_lb(ss3_tl1)
+
+    LBL(ss3_blk)
+
+        movpx_ld(Xmm0, Mebx, DP(0x000))
+        movpx_ld(Xmm1, Mesi, DP(0x000))
+        movpx_ld(Xmm2, Medi, DP(0x000))
+        scapx_st(Xmm0, Xmm7, Mecx, DP(0x000))
+        scapx_st(Xmm1, Xmm7, Mecx, DP(0x004))
+        scapx_st(Xmm2, Xmm7, Mecx, DP(0x008))
+
+        addxx_ri(Recx, IH(Q*0x030))
+        addxx_ri(Rebx, IB(Q*0x010))
+        addxx_ri(Resi, IB(Q*0x010))
+        addxx_ri(Redi, IB(Q*0x010))
+        subxx_ri(Reax, IB(S))
+        cmpxx_ri(Reax, IB(S))
+        jgexx_lb(ss3_blk)
+
+    LBL(ss3_tl1)
+
+        cmpxx_ri(Reax, IB(0))
+        jeqxx_lb(ss3_end)
+
+    LBL(ss3_tl2)
+
+        movxx_ld(Redx, Mebx, DP(0x000))
+        movxx_st(Redx, Mecx, DP(0x000))
+        movxx_ld(Redx, Mesi, DP(0x000))
+        movxx_st(Redx, Mecx, DP(0x004))
+        movxx_ld(Redx, Medi, DP(0x000))
+        movxx_st(Redx, Mecx, DP(0x008))
+
+        addxx_ri(Recx, IB(12))
+        addxx_ri(Rebx, IB(4))
+        addxx_ri(Resi, IB(4))
+        addxx_ri(Redi, IB(4))
+        subxx_ri(Reax, IB(1))
+        cmpxx_ri(Reax, IB(0))
+        jgtxx_lb(ss3_tl2)
+
+    LBL(ss3_end)
+
+    ASM_LEAVE(args)
+}
+
+/******************************************************************************/
+/*********************************   ROUTINES   *******************************/
+/******************************************************************************/
+
+/*
+ * Kernel arguments for streams of soa and rt_vec3 array aos.
+ */
+inline
+rt_void soa_args3(rt_SOA_ARGS *args, rt_SoA<3> *soa, rt_real *aos)
+{
+    rt_cell i;
+
+    args->saos = aos;
+    args->ssoa = soa->base;
+    args->scnt = soa->size;
+    args->sstr = soa->stride();
+
+    for (i = 0; i < S; i++)
+    {
+        args->sidx[i] = i * 3;
+    }
+}
+
+/*
+ * Gather soa->size rt_vec3 elements from aos to streams of soa,
+ * zero padding, same result as soa->from_aos(aos).
+ */
+inline
+rt_void rt_soa_from_aos3(rt_SoA<3> *soa, rt_real *aos)
+{
+    rt_SOA_ARGS args;
+
+    soa_args3(&args, soa, aos);
+    soa_gat3(&args);
+}
+
+/*
+ * Scatter soa->size rt_vec3 elements from streams of soa to aos,
+ * same result as soa->to_aos(aos).
+ */
+inline
+rt_void rt_soa_to_aos3(rt_SoA<3> *soa, rt_real *aos)
+{
+    rt_SOA_ARGS args;
+
+    soa_args3(&args, soa, aos);
+    soa_sca3(&args);
+}
+
+#endif /* RT_RTSOA_H */
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
@@ -0,0 +1,1768 @@
+/******************************************************************************/
+/* Copyright (c) 2013-2015 VectorChief (at github, bitbucket, sourceforge)    */
+/* Distributed under the MIT software license, see the accompanying           */
+/* file COPYING or http://www.opensource.org/licenses/mit-license.php         */
+/******************************************************************************/
+
+#include <string.h>
+#include <stdio.h>
+
+#include "rtarch.h"
+#include "rtbase.h"
+
+/*
+ * Encoding verification tool for the instruction macros in rtarch_***.h.
+ *
+ * Every macro listed in the expected table below is instantiated with all
+ * combinations of registers and addressing modes applicable to its operands,
+ * the generated translation unit is compiled with the same flags as the tool,
+ * disassembled with objdump and fed back to the tool for comparison
+ * against the expected mnemonic, which is built from the table's template.
+ *
+ *  simd_encode -g > simd_encode_gen.cpp        generate instances
+ *  objdump -d -z simd_encode_gen.o | simd_encode -c    check disassembly
+ *
+ * Operand kinds in the signature string (one char per macro operand):
+ *  R - core register (Reax - Redi, Reg8 - RegE), all RT_CORE_REGS are tested
+ *  X - SIMD register (Xmm0 - XmmF), all RT_SIMD_REGS are tested
+ *  M - memory operand with DP (Mecx - MegE, Iecx - IegE), 3 displacements
+ *  B - byte immediate IB(0x1F), W - word immediate IW(0x12345678)
+ *  L - lane immediate IB(1), scaled per instruction in the template
+ *  T - unused fallback temp (Xmm7), not referenced in the template
+ *
+ * Template placeholders (N is the operand's position in the signature):
+ *  %N - operand in objdump syntax, instructions are separated by ';'
+ *  %% - literal '%' (fixed register in AT&T syntax)
+ *  ARM only:
+ *  %aN - index-form address setup (empty for Mecx - Medi)
+ *  %iN - IW immediate setup in TIxx (empty for IB)
+ *  %pN - SIMD address setup in TPxx (empty if DP is zero)
+ *  %tN - SIMD address register, %bN - base register, %dN - displacement
+ *  %lN, %hN - lower/upper d-register, %wN - %zN - s-registers 0 - 3 of qN
+ *  X32 only:
+ *  %qN - 64-bit name of core register
+ *  A64 only:
+ *  %aN - index-form address setup (empty for Mecx - Medi)
+ *  %iN - IB/IW immediate setup in TIxx
+ *  %rN - base register, %oN - displacement
+ *  %wN - 32-bit name of core register
+ *  %bN, %hN, %dN - SIMD register as 16b, 8h, 2d vector (4s by default)
+ *  %qN, %lN, %sN - SIMD register as q, d, s scalar, %vN - bare vN
+ *
+ * Emulated sequences which depend on constants or labels (stack_sa/la,
+ * jumps, masked load/store, gather/scatter, cbr/rcp/rsq, fp16 fallback)
+ * and full-precision divps_ld in ARM (uses a neighbouring register as temp)
+ * are not listed and are covered by simd_test at runtime instead.
+ */
+
+/******************************************************************************/
+/*******************************   DEFINITIONS   ******************************/
+/******************************************************************************/
+
+#define LINE_SIZE           1024
+#define TEXT_SIZE           4096
+#define OPND_SIZE           4
+
+#define RT_LOGI             printf
+#define RT_LOGE             printf
+
+/******************************************************************************/
+/***************************   VARS, FUNCS, TYPES   ***************************/
+/******************************************************************************/
+
+/*
+ * Operand instance,
+ * produced from its kind char and index within that kind.
+ */
+struct rt_OPND
+{
+    rt_char kind;
+    rt_char arg[32];
+    rt_cell reg;
+    rt_cell dsp;
+    rt_bool idx;
+};
+
+/*
+ * Expected table entry,
+ * macro name, operand signature and disassembly template.
+ */
+struct rt_ENCD
+{
+    const rt_char *mac;
+    const rt_char *sig;
+    const rt_char *exp;
+};
+
+#if RT_CORE_REGS >= 15
+static rt_cell s_base[13] = {1, 2, 3, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14};
+#else  /* RT_CORE_REGS < 15 */
+static rt_cell s_base[6] = {1, 2, 3, 5, 6, 7};
+#endif /* RT_CORE_REGS */
+static rt_cell s_disp[3] = {0x000, 0x010, 0x3F0};
+static const rt_char *s_name[15] =
+{
+    "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi",
+    "eg8", "eg9", "egA", "egB", "egC", "egD", "egE",
+};
+
+/******************************************************************************/
+/*********************************   TABLES   *********************************/
+/******************************************************************************/
+
+#if   defined (RT_X86)
+
+#define RT_COMMENT          "#"
+
+/* core register names in objdump syntax, as data and as address */
+static const rt_char **s_oreg = s_name;
+static const rt_char **s_oadr = s_name;
+
+static rt_ENCD s_encd[] =
+{
+    /* ------------------------   rtarch_x86.h   ------------------------ */
+
+    {"movxx_ri", "RB",  "mov %1,%0"},
+    {"movxx_ri", "RW",  "mov %1,%0"},
+    {"movxx_mi", "MB",  "movl %1,%0"},
+    {"movxx_mi", "MW",  "movl %1,%0"},
+    {"movxx_rr", "RR",  "mov %1,%0"},
+    {"movxx_ld", "RM",  "mov %1,%0"},
+    {"movxx_st", "RM",  "mov %0,%1"},
+    {"movxa_ld", "RM",  "mov %1,%0"},
+    {"movxa_st", "RM",  "mov %0,%1"},
+    {"adrxx_ld", "RM",  "lea %1,%0"},
+    {"stack_st", "R",   "push %0"},
+    {"stack_ld", "R",   "pop %0"},
+
+    {"andxx_ri", "RB",  "and %1,%0"},
+    {"andxx_ri", "RW",  "and %1,%0"},
+    {"andxx_mi", "MB",  "andl %1,%0"},
+    {"andxx_mi", "MW",  "andl %1,%0"},
+    {"andxx_rr", "RR",  "and %1,%0"},
+    {"andxx_ld", "RM",  "and %1,%0"},
+    {"andxx_st", "RM",  "and %0,%1"},
+
+    {"orrxx_ri", "RB",  "or %1,%0"},
+    {"orrxx_ri", "RW",  "or %1,%0"},
+    {"orrxx_mi", "MB",  "orl %1,%0"},
+    {"orrxx_mi", "MW",  "orl %1,%0"},
+    {"orrxx_rr", "RR",  "or %1,%0"},
+    {"orrxx_ld", "RM",  "or %1,%0"},
+    {"orrxx_st", "RM",  "or %0,%1"},
+
+    {"notxx_rr", "R",   "not %0"},
+    {"notxx_mm", "M",   "notl %0"},
+
+    {"addxx_ri", "RB",  "add %1,%0"},
+    {"addxx_ri", "RW",  "add %1,%0"},
+    {"addxx_mi", "MB",  "addl %1,%0"},
+    {"addxx_mi", "MW",  "addl %1,%0"},
+    {"addxx_rr", "RR",  "add %1,%0"},
+    {"addxx_ld", "RM",  "add %1,%0"},
+    {"addxx_st", "RM",  "add %0,%1"},
+
+    {"subxx_ri", "RB",  "sub %1,%0"},
+    {"subxx_ri", "RW",  "sub %1,%0"},
+    {"subxx_mi", "MB",  "subl %1,%0"},
+    {"subxx_mi", "MW",  "subl %1,%0"},
+    {"subxx_rr", "RR",  "sub %1,%0"},
+    {"subxx_ld", "RM",  "sub %1,%0"},
+    {"subxx_st", "RM",  "sub %0,%1"},
+    {"subxx_mr", "MR",  "sub %1,%0"},
+
+    {"shlxx_ri", "RB",  "shl %1,%0"},
+    {"shlxx_mi", "MB",  "shll %1,%0"},
+    {"shrxx_ri", "RB",  "shr %1,%0"},
+    {"shrxx_mi", "MB",  "shrl %1,%0"},
+    {"shrxn_ri", "RB",  "sar %1,%0"},
+    {"shrxn_mi", "MB",  "sarl %1,%0"},
+
+    {"mulxn_ri", "RB",  "imul %1,%0,%0"},
+    {"mulxn_ri", "RW",  "imul %1,%0,%0"},
+    {"mulxn_rr", "RR",  "imul %1,%0"},
+    {"mulxn_ld", "RM",  "imul %1,%0"},
+    {"mulxn_xm", "M",   "imull %0"},
+
+    {"divxx_xm", "M",   "divl %0"},
+    {"divxn_xm", "M",   "idivl %0"},
+    {"remxx_xm", "M",   "divl %0"},
+    {"remxn_xm", "M",   "idivl %0"},
+
+    {"cmpxx_ri", "RB",  "cmp %1,%0"},
+    {"cmpxx_ri", "RW",  "cmp %1,%0"},
+    {"cmpxx_mi", "MB",  "cmpl %1,%0"},
+    {"cmpxx_mi", "MW",  "cmpl %1,%0"},
+    {"cmpxx_rr", "RR",  "cmp %1,%0"},
+    {"cmpxx_rm", "RM",  "cmp %1,%0"},
+    {"cmpxx_mr", "MR",  "cmp %1,%0"},
+
+    {"jmpxx_mm", "M",   "jmp *%0"},
+
+    /* ----------------------   rtarch_x86_sse.h   ---------------------- */
+
+    {"movpx_rr", "XX",  "movaps %1,%0"},
+    {"movpx_ld", "XM",  "movaps %1,%0"},
+    {"movpx_st", "XM",  "movaps %0,%1"},
+    {"adrpx_ld", "RM",  "lea %1,%0"},
+    {"movlx_ld", "XM",  "movq %1,%0"},
+    {"movlx_st", "XM",  "movq %0,%1"},
+    {"movux_ld", "XM",  "movups %1,%0"},
+    {"movnx_st", "XM",  "movntps %0,%1"},
+    {"prfxx_ld", "M",   "prefetcht0 %0"},
+    {"fence_st", "",    "sfence"},
+
+    {"andpx_rr", "XX",  "andps %1,%0"},
+    {"andpx_ld", "XM",  "andps %1,%0"},
+    {"annpx_rr", "XX",  "andnps %1,%0"},
+    {"annpx_ld", "XM",  "andnps %1,%0"},
+    {"orrpx_rr", "XX",  "orps %1,%0"},
+    {"orrpx_ld", "XM",  "orps %1,%0"},
+    {"xorpx_rr", "XX",  "xorps %1,%0"},
+    {"xorpx_ld", "XM",  "xorps %1,%0"},
+
+    {"addps_rr", "XX",  "addps %1,%0"},
+    {"addps_ld", "XM",  "addps %1,%0"},
+    {"subps_rr", "XX",  "subps %1,%0"},
+    {"subps_ld", "XM",  "subps %1,%0"},
+    {"mulps_rr", "XX",  "mulps %1,%0"},
+    {"mulps_ld", "XM",  "mulps %1,%0"},
+    {"divps_rr", "XX",  "divps %1,%0"},
+    {"divps_ld", "XM",  "divps %1,%0"},
+    {"sqrps_rr", "XX",  "sqrtps %1,%0"},
+    {"sqrps_ld", "XM",  "sqrtps %1,%0"},
+
+    {"rceps_rr", "XX",  "rcpps %1,%0"},
+    {"rcsps_rr", "XX",  "mulps %0,%1; mulps %0,%1; addps %0,%0; subps %1,%0"},
+    {"rseps_rr", "XX",  "rsqrtps %1,%0"},
+
+    {"minps_rr", "XX",  "minps %1,%0"},
+    {"minps_ld", "XM",  "minps %1,%0"},
+    {"maxps_rr", "XX",  "maxps %1,%0"},
+    {"maxps_ld", "XM",  "maxps %1,%0"},
+
+    {"ceqps_rr", "XX",  "cmpeqps %1,%0"},
+    {"ceqps_ld", "XM",  "cmpeqps %1,%0"},
+    {"cneps_rr", "XX",  "cmpneqps %1,%0"},
+    {"cneps_ld", "XM",  "cmpneqps %1,%0"},
+    {"cltps_rr", "XX",  "cmpltps %1,%0"},
+    {"cltps_ld", "XM",  "cmpltps %1,%0"},
+    {"cleps_rr", "XX",  "cmpleps %1,%0"},
+    {"cleps_ld", "XM",  "cmpleps %1,%0"},
+    {"cgtps_rr", "XX",  "cmpnleps %1,%0"},
+    {"cgtps_ld", "XM",  "cmpnleps %1,%0"},
+    {"cgeps_rr", "XX",  "cmpnltps %1,%0"},
+    {"cgeps_ld", "XM",  "cmpnltps %1,%0"},
+
+    {"addpd_rr", "XX",  "addpd %1,%0"},
+    {"addpd_ld", "XM",  "addpd %1,%0"},
+    {"subpd_rr", "XX",  "subpd %1,%0"},
+    {"subpd_ld", "XM",  "subpd %1,%0"},
+    {"mulpd_rr", "XX",  "mulpd %1,%0"},
+    {"mulpd_ld", "XM",  "mulpd %1,%0"},
+    {"divpd_rr", "XX",  "divpd %1,%0"},
+    {"divpd_ld", "XM",  "divpd %1,%0"},
+    {"sqrpd_rr", "XX",  "sqrtpd %1,%0"},
+    {"sqrpd_ld", "XM",  "sqrtpd %1,%0"},
+    {"minpd_rr", "XX",  "minpd %1,%0"},
+    {"minpd_ld", "XM",  "minpd %1,%0"},
+    {"maxpd_rr", "XX",  "maxpd %1,%0"},
+    {"maxpd_ld", "XM",  "maxpd %1,%0"},
+
+    {"ceqpd_rr", "XX",  "cmpeqpd %1,%0"},
+    {"ceqpd_ld", "XM",  "cmpeqpd %1,%0"},
+    {"cnepd_rr", "XX",  "cmpneqpd %1,%0"},
+    {"cnepd_ld", "XM",  "cmpneqpd %1,%0"},
+    {"cltpd_rr", "XX",  "cmpltpd %1,%0"},
+    {"cltpd_ld", "XM",  "cmpltpd %1,%0"},
+    {"clepd_rr", "XX",  "cmplepd %1,%0"},
+    {"clepd_ld", "XM",  "cmplepd %1,%0"},
+    {"cgtpd_rr", "XX",  "cmpnlepd %1,%0"},
+    {"cgtpd_ld", "XM",  "cmpnlepd %1,%0"},
+    {"cgepd_rr", "XX",  "cmpnltpd %1,%0"},
+    {"cgepd_ld", "XM",  "cmpnltpd %1,%0"},
+
+    {"cvtsd_rr", "XX",  "cvtps2pd %1,%0"},
+    {"cvtds_rr", "XX",  "cvtpd2ps %1,%0"},
+    {"cvtps_rr", "XX",  "cvtps2dq %1,%0"},
+    {"cvtps_ld", "XM",  "cvtps2dq %1,%0"},
+    {"cvtpn_rr", "XX",  "cvtdq2ps %1,%0"},
+    {"cvtpn_ld", "XM",  "cvtdq2ps %1,%0"},
+
+    {"addpx_rr", "XX",  "paddd %1,%0"},
+    {"addpx_ld", "XM",  "paddd %1,%0"},
+    {"subpx_rr", "XX",  "psubd %1,%0"},
+    {"subpx_ld", "XM",  "psubd %1,%0"},
+    {"shlpx_ri", "XB",  "pslld %1,%0"},
+    {"shlpx_ld", "XM",  "pslld %1,%0"},
+    {"shrpx_ri", "XB",  "psrld %1,%0"},
+    {"shrpx_ld", "XM",  "psrld %1,%0"},
+    {"shrpn_ri", "XB",  "psrad %1,%0"},
+    {"shrpn_ld", "XM",  "psrad %1,%0"},
+    {"cgtpn_rr", "XX",  "pcmpgtd %1,%0"},
+    {"cgtpn_ld", "XM",  "pcmpgtd %1,%0"},
+
+    {"addpb_rr", "XX",  "paddb %1,%0"},
+    {"addpb_ld", "XM",  "paddb %1,%0"},
+    {"addph_rr", "XX",  "paddw %1,%0"},
+    {"addph_ld", "XM",  "paddw %1,%0"},
+    {"adspb_rr", "XX",  "paddusb %1,%0"},
+    {"adspb_ld", "XM",  "paddusb %1,%0"},
+    {"adsph_rr", "XX",  "paddusw %1,%0"},
+    {"adsph_ld", "XM",  "paddusw %1,%0"},
+    {"subpb_rr", "XX",  "psubb %1,%0"},
+    {"subpb_ld", "XM",  "psubb %1,%0"},
+    {"subph_rr", "XX",  "psubw %1,%0"},
+    {"subph_ld", "XM",  "psubw %1,%0"},
+    {"sbspb_rr", "XX",  "psubusb %1,%0"},
+    {"sbspb_ld", "XM",  "psubusb %1,%0"},
+    {"sbsph_rr", "XX",  "psubusw %1,%0"},
+    {"sbsph_ld", "XM",  "psubusw %1,%0"},
+    {"avgpb_rr", "XX",  "pavgb %1,%0"},
+    {"avgpb_ld", "XM",  "pavgb %1,%0"},
+    {"avgph_rr", "XX",  "pavgw %1,%0"},
+    {"avgph_ld", "XM",  "pavgw %1,%0"},
+
+    {"unlpb_rr", "XX",  "movaps %1,%0; punpcklbw %0,%0; psrlw $0x8,%0"},
+    {"unhpb_rr", "XX",  "movaps %1,%0; punpckhbw %0,%0; psrlw $0x8,%0"},
+    {"unlph_rr", "XX",  "movaps %1,%0; punpcklwd %0,%0; psrld $0x10,%0"},
+    {"unhph_rr", "XX",  "movaps %1,%0; punpckhwd %0,%0; psrld $0x10,%0"},
+    {"pckph_rr", "XX",  "packuswb %1,%0"},
+    {"pckpn_rr", "XX",  "packssdw %1,%0"},
+
+    {"slnpx_ri", "XL",  "pslldq $0x4,%0"},
+    {"srnpx_ri", "XL",  "psrldq $0x4,%0"},
+    {"splpx_ri", "XL",  "pshufd $0x55,%0,%0"},
+    {"splpx_ld", "XM",  "movss %1,%0; pshufd $0x0,%0,%0"},
+
+#if RT_SIMD_FP16
+
+    {"cvhps_ld", "XTTM", "vcvtph2ps %3,%0"},
+    {"cvpsh_st", "XTTM", "vcvtps2ph $0x0,%0,%3"},
+
+#endif /* RT_SIMD_FP16 */
+};
+
+#elif defined (RT_X32)
+
+#define RT_COMMENT          "#"
+
+/* core register names in objdump syntax, as data and as address */
+static const rt_char *s_oreg[15] =
+{
+    "eax", "ecx", "edx", "ebx", "esp", "ebp", "esi", "edi",
+    "r8d", "r9d", "r10d", "r11d", "r12d", "r13d", "r14d",
+};
+static const rt_char *s_oadr[15] =
+{
+    "rax", "rcx", "rdx", "rbx", "rsp", "rbp", "rsi", "rdi",
+    "r8", "r9", "r10", "r11", "r12", "r13", "r14",
+};
+
+static rt_ENCD s_encd[] =
+{
+    /* ------------------------   rtarch_x32.h   ------------------------ */
+
+    {"movxx_ri", "RB",  "mov %1,%0"},
+    {"movxx_ri", "RW",  "mov %1,%0"},
+    {"movxx_mi", "MB",  "movl %1,%0"},
+    {"movxx_mi", "MW",  "movl %1,%0"},
+    {"movxx_rr", "RR",  "mov %1,%0"},
+    {"movxx_ld", "RM",  "mov %1,%0"},
+    {"movxx_st", "RM",  "mov %0,%1"},
+    {"movxa_ld", "RM",  "mov %1,%0"},
+    {"movxa_st", "RM",  "mov %0,%1"},
+    {"adrxx_ld", "RM",  "lea %1,%0"},
+    {"stack_st", "R",   "push %q0"},
+    {"stack_ld", "R",   "pop %q0"},
+
+    {"andxx_ri", "RB",  "and %1,%0"},
+    {"andxx_ri", "RW",  "and %1,%0"},
+    {"andxx_mi", "MB",  "andl %1,%0"},
+    {"andxx_mi", "MW",  "andl %1,%0"},
+    {"andxx_rr", "RR",  "and %1,%0"},
+    {"andxx_ld", "RM",  "and %1,%0"},
+    {"andxx_st", "RM",  "and %0,%1"},
+
+    {"orrxx_ri", "RB",  "or %1,%0"},
+    {"orrxx_ri", "RW",  "or %1,%0"},
+    {"orrxx_mi", "MB",  "orl %1,%0"},
+    {"orrxx_mi", "MW",  "orl %1,%0"},
+    {"orrxx_rr", "RR",  "or %1,%0"},
+    {"orrxx_ld", "RM",  "or %1,%0"},
+    {"orrxx_st", "RM",  "or %0,%1"},
+
+    {"notxx_rr", "R",   "not %0"},
+    {"notxx_mm", "M",   "notl %0"},
+
+    {"addxx_ri", "RB",  "add %1,%0"},
+    {"addxx_ri", "RW",  "add %1,%0"},
+    {"addxx_mi", "MB",  "addl %1,%0"},
+    {"addxx_mi", "MW",  "addl %1,%0"},
+    {"addxx_rr", "RR",  "add %1,%0"},
+    {"addxx_ld", "RM",  "add %1,%0"},
+    {"addxx_st", "RM",  "add %0,%1"},
+
+    {"subxx_ri", "RB",  "sub %1,%0"},
+    {"subxx_ri", "RW",  "sub %1,%0"},
+    {"subxx_mi", "MB",  "subl %1,%0"},
+    {"subxx_mi", "MW",  "subl %1,%0"},
+    {"subxx_rr", "RR",  "sub %1,%0"},
+    {"subxx_ld", "RM",  "sub %1,%0"},
+    {"subxx_st", "RM",  "sub %0,%1"},
+    {"subxx_mr", "MR",  "sub %1,%0"},
+
+    {"shlxx_ri", "RB",  "shl %1,%0"},
+    {"shlxx_mi", "MB",  "shll %1,%0"},
+    {"shrxx_ri", "RB",  "shr %1,%0"},
+    {"shrxx_mi", "MB",  "shrl %1,%0"},
+    {"shrxn_ri", "RB",  "sar %1,%0"},
+    {"shrxn_mi", "MB",  "sarl %1,%0"},
+
+    {"mulxn_ri", "RB",  "imul %1,%0,%0"},
+    {"mulxn_ri", "RW",  "imul %1,%0,%0"},
+    {"mulxn_rr", "RR",  "imul %1,%0"},
+    {"mulxn_ld", "RM",  "imul %1,%0"},
+    {"mulxn_xm", "M",   "imull %0"},
+
+    {"divxx_xm", "M",   "divl %0"},
+    {"divxn_xm", "M",   "idivl %0"},
+    {"remxx_xm", "M",   "divl %0"},
+    {"remxn_xm", "M",   "idivl %0"},
+
+    {"cmpxx_ri", "RB",  "cmp %1,%0"},
+    {"cmpxx_ri", "RW",  "cmp %1,%0"},
+    {"cmpxx_mi", "MB",  "cmpl %1,%0"},
+    {"cmpxx_mi", "MW",  "cmpl %1,%0"},
+    {"cmpxx_rr", "RR",  "cmp %1,%0"},
+    {"cmpxx_rm", "RM",  "cmp %1,%0"},
+    {"cmpxx_mr", "MR",  "cmp %1,%0"},
+
+    {"jmpxx_mm", "M",   "mov %0,%%r15d; jmp *%%r15"},
+
+    /* ----------------------   rtarch_x32_128.h   ---------------------- */
+
+    {"movpx_rr", "XX",  "movaps %1,%0"},
+    {"movpx_ld", "XM",  "movaps %1,%0"},
+    {"movpx_st", "XM",  "movaps %0,%1"},
+    {"adrpx_ld", "RM",  "lea %1,%0"},
+    {"movlx_ld", "XM",  "movq %1,%0"},
+    {"movlx_st", "XM",  "movq %0,%1"},
+    {"movux_ld", "XM",  "movups %1,%0"},
+    {"movnx_st", "XM",  "movntps %0,%1"},
+    {"prfxx_ld", "M",   "prefetcht0 %0"},
+    {"fence_st", "",    "sfence"},
+
+    {"andpx_rr", "XX",  "andps %1,%0"},
+    {"andpx_ld", "XM",  "andps %1,%0"},
+    {"annpx_rr", "XX",  "andnps %1,%0"},
+    {"annpx_ld", "XM",  "andnps %1,%0"},
+    {"orrpx_rr", "XX",  "orps %1,%0"},
+    {"orrpx_ld", "XM",  "orps %1,%0"},
+    {"xorpx_rr", "XX",  "xorps %1,%0"},
+    {"xorpx_ld", "XM",  "xorps %1,%0"},
+
+    {"addps_rr", "XX",  "addps %1,%0"},
+    {"addps_ld", "XM",  "addps %1,%0"},
+    {"subps_rr", "XX",  "subps %1,%0"},
+    {"subps_ld", "XM",  "subps %1,%0"},
+    {"mulps_rr", "XX",  "mulps %1,%0"},
+    {"mulps_ld", "XM",  "mulps %1,%0"},
+    {"divps_rr", "XX",  "divps %1,%0"},
+    {"divps_ld", "XM",  "divps %1,%0"},
+    {"sqrps_rr", "XX",  "sqrtps %1,%0"},
+    {"sqrps_ld", "XM",  "sqrtps %1,%0"},
+
+    {"rceps_rr", "XX",  "rcpps %1,%0"},
+    {"rcsps_rr", "XX",  "mulps %0,%1; mulps %0,%1; addps %0,%0; subps %1,%0"},
+    {"rseps_rr", "XX",  "rsqrtps %1,%0"},
+
+    {"minps_rr", "XX",  "minps %1,%0"},
+    {"minps_ld", "XM",  "minps %1,%0"},
+    {"maxps_rr", "XX",  "maxps %1,%0"},
+    {"maxps_ld", "XM",  "maxps %1,%0"},
+
+    {"ceqps_rr", "XX",  "cmpeqps %1,%0"},
+    {"ceqps_ld", "XM",  "cmpeqps %1,%0"},
+    {"cneps_rr", "XX",  "cmpneqps %1,%0"},
+    {"cneps_ld", "XM",  "cmpneqps %1,%0"},
+    {"cltps_rr", "XX",  "cmpltps %1,%0"},
+    {"cltps_ld", "XM",  "cmpltps %1,%0"},
+    {"cleps_rr", "XX",  "cmpleps %1,%0"},
+    {"cleps_ld", "XM",  "cmpleps %1,%0"},
+    {"cgtps_rr", "XX",  "cmpnleps %1,%0"},
+    {"cgtps_ld", "XM",  "cmpnleps %1,%0"},
+    {"cgeps_rr", "XX",  "cmpnltps %1,%0"},
+    {"cgeps_ld", "XM",  "cmpnltps %1,%0"},
+
+    {"addpd_rr", "XX",  "addpd %1,%0"},
+    {"addpd_ld", "XM",  "addpd %1,%0"},
+    {"subpd_rr", "XX",  "subpd %1,%0"},
+    {"subpd_ld", "XM",  "subpd %1,%0"},
+    {"mulpd_rr", "XX",  "mulpd %1,%0"},
+    {"mulpd_ld", "XM",  "mulpd %1,%0"},
+    {"divpd_rr", "XX",  "divpd %1,%0"},
+    {"divpd_ld", "XM",  "divpd %1,%0"},
+    {"sqrpd_rr", "XX",  "sqrtpd %1,%0"},
+    {"sqrpd_ld", "XM",  "sqrtpd %1,%0"},
+    {"minpd_rr", "XX",  "minpd %1,%0"},
+    {"minpd_ld", "XM",  "minpd %1,%0"},
+    {"maxpd_rr", "XX",  "maxpd %1,%0"},
+    {"maxpd_ld", "XM",  "maxpd %1,%0"},
+
+    {"ceqpd_rr", "XX",  "cmpeqpd %1,%0"},
+    {"ceqpd_ld", "XM",  "cmpeqpd %1,%0"},
+    {"cnepd_rr", "XX",  "cmpneqpd %1,%0"},
+    {"cnepd_ld", "XM",  "cmpneqpd %1,%0"},
+    {"cltpd_rr", "XX",  "cmpltpd %1,%0"},
+    {"cltpd_ld", "XM",  "cmpltpd %1,%0"},
+    {"clepd_rr", "XX",  "cmplepd %1,%0"},
+    {"clepd_ld", "XM",  "cmplepd %1,%0"},
+    {"cgtpd_rr", "XX",  "cmpnlepd %1,%0"},
+    {"cgtpd_ld", "XM",  "cmpnlepd %1,%0"},
+    {"cgepd_rr", "XX",  "cmpnltpd %1,%0"},
+    {"cgepd_ld", "XM",  "cmpnltpd %1,%0"},
+
+    {"cvtsd_rr", "XX",  "cvtps2pd %1,%0"},
+    {"cvtds_rr", "XX",  "cvtpd2ps %1,%0"},
+    {"cvtps_rr", "XX",  "cvtps2dq %1,%0"},
+    {"cvtps_ld", "XM",  "cvtps2dq %1,%0"},
+    {"cvtpn_rr", "XX",  "cvtdq2ps %1,%0"},
+    {"cvtpn_ld", "XM",  "cvtdq2ps %1,%0"},
+
+    {"addpx_rr", "XX",  "paddd %1,%0"},
+    {"addpx_ld", "XM",  "paddd %1,%0"},
+    {"subpx_rr", "XX",  "psubd %1,%0"},
+    {"subpx_ld", "XM",  "psubd %1,%0"},
+    {"shlpx_ri", "XB",  "pslld %1,%0"},
+    {"shlpx_ld", "XM",  "pslld %1,%0"},
+    {"shrpx_ri", "XB",  "psrld %1,%0"},
+    {"shrpx_ld", "XM",  "psrld %1,%0"},
+    {"shrpn_ri", "XB",  "psrad %1,%0"},
+    {"shrpn_ld", "XM",  "psrad %1,%0"},
+    {"cgtpn_rr", "XX",  "pcmpgtd %1,%0"},
+    {"cgtpn_ld", "XM",  "pcmpgtd %1,%0"},
+
+    {"addpb_rr", "XX",  "paddb %1,%0"},
+    {"addpb_ld", "XM",  "paddb %1,%0"},
+    {"addph_rr", "XX",  "paddw %1,%0"},
+    {"addph_ld", "XM",  "paddw %1,%0"},
+    {"adspb_rr", "XX",  "paddusb %1,%0"},
+    {"adspb_ld", "XM",  "paddusb %1,%0"},
+    {"adsph_rr", "XX",  "paddusw %1,%0"},
+    {"adsph_ld", "XM",  "paddusw %1,%0"},
+    {"subpb_rr", "XX",  "psubb %1,%0"},
+    {"subpb_ld", "XM",  "psubb %1,%0"},
+    {"subph_rr", "XX",  "psubw %1,%0"},
+    {"subph_ld", "XM",  "psubw %1,%0"},
+    {"sbspb_rr", "XX",  "psubusb %1,%0"},
+    {"sbspb_ld", "XM",  "psubusb %1,%0"},
+    {"sbsph_rr", "XX",  "psubusw %1,%0"},
+    {"sbsph_ld", "XM",  "psubusw %1,%0"},
+    {"avgpb_rr", "XX",  "pavgb %1,%0"},
+    {"avgpb_ld", "XM",  "pavgb %1,%0"},
+    {"avgph_rr", "XX",  "pavgw %1,%0"},
+    {"avgph_ld", "XM",  "pavgw %1,%0"},
+
+    {"unlpb_rr", "XX",  "movaps %1,%0; punpcklbw %0,%0; psrlw $0x8,%0"},
+    {"unhpb_rr", "XX",  "movaps %1,%0; punpckhbw %0,%0; psrlw $0x8,%0"},
+    {"unlph_rr", "XX",  "movaps %1,%0; punpcklwd %0,%0; psrld $0x10,%0"},
+    {"unhph_rr", "XX",  "movaps %1,%0; punpckhwd %0,%0; psrld $0x10,%0"},
+    {"pckph_rr", "XX",  "packuswb %1,%0"},
+    {"pckpn_rr", "XX",  "packssdw %1,%0"},
+
+    {"slnpx_ri", "XL",  "pslldq $0x4,%0"},
+    {"srnpx_ri", "XL",  "psrldq $0x4,%0"},
+    {"splpx_ri", "XL",  "pshufd $0x55,%0,%0"},
+    {"splpx_ld", "XM",  "movss %1,%0; pshufd $0x0,%0,%0"},
+
+#if RT_SIMD_FP16
+
+    {"cvhps_ld", "XTTM", "vcvtph2ps %3,%0"},
+    {"cvpsh_st", "XTTM", "vcvtps2ph $0x0,%0,%3"},
+
+#endif /* RT_SIMD_FP16 */
+};
+
+#elif defined (RT_ARM)
+
+#define RT_COMMENT          ";@"
+
+/* load Tmm1 (q8) from SIMD memory operand 1 */
+#define LD1                 "%a1%p1vld1.32 {d16,d17},[%t1:128]; "
+/* load Tmm3 (q10) from SIMD memory operand 1 */
+#define LD3                 "%a1%p1vld1.32 {d20,d21},[%t1:128]; "
+/* load Tmm1 (q8) from SIMD memory operand 1, splat a single element */
+#define LDS                 "%a1%p1vld1.32 {d16[],d17[]},[%t1:32]; "
+
+/* 1st pass of divps (rcp estimate with N-R step) */
+#define DV1(r)              "vrecpe.f32 q8," r "; "                         \
+                            "vrecps.f32 q9,q8," r "; vmul.f32 q8,q8,q9; "
+/* 1st pass of sqrps (rsq estimate with N-R step) */
+#define SQ1(r)              "vrsqrte.f32 q8," r "; vmul.f32 q9,q8,q8; "     \
+                            "vrsqrts.f32 q9,q9," r "; vmul.f32 q8,q8,q9; "
+/* 2nd pass of sqrps (N-R step) */
+#define SQ2(r)              "vmul.f32 q9,q8,q8; "                           \
+                            "vrsqrts.f32 q9,q9," r "; vmul.f32 q8,q8,q9; "
+
+/* fp64 compare in one half of the SIMD register */
+#define CPD(c, g, m)        "vcmp.f64 " g "," m "; vmrs APSR_nzcv,fpscr; "  \
+                            "mov r8,#0; mvn" c " r8,#0; vmov " g ",r8,r8"
+/* fp64 min/max in one half of the SIMD register */
+#define MND(c, g, m)        "vcmp.f64 " g "," m "; vmrs APSR_nzcv,fpscr; "  \
+                            "vmov" c ".f64 " g "," m
+
+static rt_ENCD s_encd[] =
+{
+    /* ------------------------   rtarch_arm.h   ------------------------ */
+
+    {"movxx_ri", "RB",  "mov %0,%1"},
+    {"movxx_ri", "RW",  "%i1mov %0,%1"},
+    {"movxx_mi", "MB",  "mov r9,%1; %a0%i1str r9,%0"},
+    {"movxx_mi", "MW",  "mov r9,%1; %a0%i1str r9,%0"},
+    {"movxx_rr", "RR",  "mov %0,%1"},
+    {"movxx_ld", "RM",  "%a1ldr %0,%1"},
+    {"movxx_st", "RM",  "%a1str %0,%1"},
+    {"movxa_ld", "RM",  "%a1ldr %0,%1"},
+    {"movxa_st", "RM",  "%a1str %0,%1"},
+    {"adrxx_ld", "RM",  "%a1add %0,%b1,#%d1"},
+    {"stack_st", "R",   "push {%0}"},
+    {"stack_ld", "R",   "pop {%0}"},
+
+    {"andxx_ri", "RB",  "ands %0,%0,%1"},
+    {"andxx_ri", "RW",  "%i1ands %0,%0,%1"},
+    {"andxx_mi", "MB",  "%a0ldr r8,%0; ands r8,r8,%1; str r8,%0"},
+    {"andxx_mi", "MW",  "%a0%i1ldr r8,%0; ands r8,r8,%1; str r8,%0"},
+    {"andxx_rr", "RR",  "ands %0,%0,%1"},
+    {"andxx_ld", "RM",  "%a1ldr r8,%1; ands %0,%0,r8"},
+    {"andxx_st", "RM",  "%a1ldr r8,%1; ands r8,r8,%0; str r8,%1"},
+
+    {"orrxx_ri", "RB",  "orrs %0,%0,%1"},
+    {"orrxx_ri", "RW",  "%i1orrs %0,%0,%1"},
+    {"orrxx_mi", "MB",  "%a0ldr r8,%0; orrs r8,r8,%1; str r8,%0"},
+    {"orrxx_mi", "MW",  "%a0%i1ldr r8,%0; orrs r8,r8,%1; str r8,%0"},
+    {"orrxx_rr", "RR",  "orrs %0,%0,%1"},
+    {"orrxx_ld", "RM",  "%a1ldr r8,%1; orrs %0,%0,r8"},
+    {"orrxx_st", "RM",  "%a1ldr r8,%1; orrs r8,r8,%0; str r8,%1"},
+
+    {"notxx_rr", "R",   "mvns %0,%0"},
+    {"notxx_mm", "M",   "%a0ldr r8,%0; mvns r8,r8; str r8,%0"},
+
+    {"addxx_ri", "RB",  "adds %0,%0,%1"},
+    {"addxx_ri", "RW",  "%i1adds %0,%0,%1"},
+    {"addxx_mi", "MB",  "%a0ldr r8,%0; adds r8,r8,%1; str r8,%0"},
+    {"addxx_mi", "MW",  "%a0%i1ldr r8,%0; adds r8,r8,%1; str r8,%0"},
+    {"addxx_rr", "RR",  "adds %0,%0,%1"},
+    {"addxx_ld", "RM",  "%a1ldr r8,%1; adds %0,%0,r8"},
+    {"addxx_st", "RM",  "%a1ldr r8,%1; adds r8,r8,%0; str r8,%1"},
+
+    {"subxx_ri", "RB",  "subs %0,%0,%1"},
+    {"subxx_ri", "RW",  "%i1subs %0,%0,%1"},
+    {"subxx_mi", "MB",  "%a0ldr r8,%0; subs r8,r8,%1; str r8,%0"},
+    {"subxx_mi", "MW",  "%a0%i1ldr r8,%0; subs r8,r8,%1; str r8,%0"},
+    {"subxx_rr", "RR",  "subs %0,%0,%1"},
+    {"subxx_ld", "RM",  "%a1ldr r8,%1; subs %0,%0,r8"},
+    {"subxx_st", "RM",  "%a1ldr r8,%1; subs r8,r8,%0; str r8,%1"},
+    {"subxx_mr", "MR",  "%a0ldr r8,%0; subs r8,r8,%1; str r8,%0"},
+
+    {"shlxx_ri", "RB",  "lsls %0,%0,%1"},
+    {"shlxx_mi", "MB",  "%a0ldr r8,%0; lsls r8,r8,%1; str r8,%0"},
+    {"shrxx_ri", "RB",  "lsrs %0,%0,%1"},
+    {"shrxx_mi", "MB",  "%a0ldr r8,%0; lsrs r8,r8,%1; str r8,%0"},
+    {"shrxn_ri", "RB",  "asrs %0,%0,%1"},
+    {"shrxn_mi", "MB",  "%a0ldr r8,%0; asrs r8,r8,%1; str r8,%0"},
+
+    {"mulxn_ri", "RB",  "mov r9,%1; muls %0,r9,%0"},
+    {"mulxn_ri", "RW",  "mov r9,%1; %i1muls %0,r9,%0"},
+    {"mulxn_rr", "RR",  "muls %0,%1,%0"},
+    {"mulxn_ld", "RM",  "%a1ldr r8,%1; muls %0,r8,%0"},
+    {"mulxn_xm", "M",   "%a0ldr r8,%0; muls r0,r8,r0"},
+
+#if RT_ARM_IDIV
+
+    {"divxx_xm", "M",   "%a0ldr r8,%0; udiv r0,r0,r8"},
+    {"divxn_xm", "M",   "%a0ldr r8,%0; sdiv r0,r0,r8"},
+    {"remxx_xm", "M",   "%a0ldr r8,%0; udiv r9,r0,r8; "
+                        "mls r2,r9,r8,r0; mov r0,r9"},
+    {"remxn_xm", "M",   "%a0ldr r8,%0; sdiv r9,r0,r8; "
+                        "mls r2,r9,r8,r0; mov r0,r9"},
+
+#else  /* RT_ARM_IDIV */
+
+    {"divxx_xm", "M",   "%a0ldr r8,%0; vmov d0,r0,r8; "
+                        "vcvt.f64.u32 d1,s1; vcvt.f64.u32 d0,s0; "
+                        "vdiv.f64 d0,d0,d1; vcvt.u32.f64 s0,d0; "
+                        "vmov.32 r0,d0[0]"},
+    {"divxn_xm", "M",   "%a0ldr r8,%0; vmov d0,r0,r8; "
+                        "vcvt.f64.s32 d1,s1; vcvt.f64.s32 d0,s0; "
+                        "vdiv.f64 d0,d0,d1; vcvt.s32.f64 s0,d0; "
+                        "vmov.32 r0,d0[0]"},
+    {"remxx_xm", "M",   "%a0ldr r8,%0; vmov d0,r0,r8; "
+                        "vcvt.f64.u32 d1,s1; vcvt.f64.u32 d0,s0; "
+                        "vdiv.f64 d0,d0,d1; vcvt.u32.f64 s0,d0; "
+                        "vmov.32 r9,d0[0]; mls r2,r9,r8,r0; mov r0,r9"},
+    {"remxn_xm", "M",   "%a0ldr r8,%0; vmov d0,r0,r8; "
+                        "vcvt.f64.s32 d1,s1; vcvt.f64.s32 d0,s0; "
+                        "vdiv.f64 d0,d0,d1; vcvt.s32.f64 s0,d0; "
+                        "vmov.32 r9,d0[0]; mls r2,r9,r8,r0; mov r0,r9"},
+
+#endif /* RT_ARM_IDIV */
+
+    {"cmpxx_ri", "RB",  "cmp %0,%1"},
+    {"cmpxx_ri", "RW",  "%i1cmp %0,%1"},
+    {"cmpxx_mi", "MB",  "%a0ldr r8,%0; cmp r8,%1"},
+    {"cmpxx_mi", "MW",  "%a0%i1ldr r8,%0; cmp r8,%1"},
+    {"cmpxx_rr", "RR",  "cmp %0,%1"},
+    {"cmpxx_rm", "RM",  "%a1ldr r8,%1; cmp %0,r8"},
+    {"cmpxx_mr", "MR",  "%a0ldr r8,%0; cmp r8,%1"},
+
+    {"jmpxx_mm", "M",   "%a0ldr pc,%0"},
+
+    /* ----------------------   rtarch_arm_mpe.h   ---------------------- */
+
+    {"movpx_rr", "XX",  "vorr %0,%1,%1"},
+    {"movpx_ld", "XM",  "%a1%p1vld1.32 {%l0,%h0},[%t1:128]"},
+    {"movpx_st", "XM",  "%a1%p1vst1.32 {%l0,%h0},[%t1:128]"},
+    {"adrpx_ld", "RM",  "%a1add %0,%b1,#%d1"},
+    {"movlx_ld", "XM",  "%a1%p1vld1.32 {%l0},[%t1]; veor %h0,%h0,%h0"},
+    {"movlx_st", "XM",  "%a1%p1vst1.32 {%l0},[%t1]"},
+    {"movux_ld", "XM",  "%a1%p1vld1.8 {%l0,%h0},[%t1]"},
+    {"movnx_st", "XM",  "%a1%p1vst1.32 {%l0,%h0},[%t1:128]"},
+    {"prfxx_ld", "M",   "%a0%p0pld [%t0]"},
+    {"fence_st", "",    "dmb ishst"},
+
+    {"andpx_rr", "XX",  "vand %0,%0,%1"},
+    {"andpx_ld", "XM",  LD1 "vand %0,%0,q8"},
+    {"annpx_rr", "XX",  "vbic %0,%1,%0"},
+    {"annpx_ld", "XM",  LD1 "vbic %0,q8,%0"},
+    {"orrpx_rr", "XX",  "vorr %0,%0,%1"},
+    {"orrpx_ld", "XM",  LD1 "vorr %0,%0,q8"},
+    {"xorpx_rr", "XX",  "veor %0,%0,%1"},
+    {"xorpx_ld", "XM",  LD1 "veor %0,%0,q8"},
+
+    {"addps_rr", "XX",  "vadd.f32 %0,%0,%1"},
+    {"addps_ld", "XM",  LD1 "vadd.f32 %0,%0,q8"},
+    {"subps_rr", "XX",  "vsub.f32 %0,%0,%1"},
+    {"subps_ld", "XM",  LD1 "vsub.f32 %0,%0,q8"},
+    {"mulps_rr", "XX",  "vmul.f32 %0,%0,%1"},
+    {"mulps_ld", "XM",  LD1 "vmul.f32 %0,%0,q8"},
+
+#if   RT_SIMD_PREC == RT_SIMD_PREC_FAST
+
+    {"divps_rr", "XX",  DV1("%1") "vmul.f32 %0,%0,q8"},
+    {"divps_ld", "XM",  LD3 DV1("q10") "vmul.f32 %0,%0,q8"},
+    {"sqrps_rr", "XX",  SQ1("%1") "vmul.f32 %0,%1,q8"},
+    {"sqrps_ld", "XM",  LD3 SQ1("q10") "vmul.f32 %0,q10,q8"},
+
+#elif RT_SIMD_PREC == RT_SIMD_PREC_FULL
+
+    {"divps_rr", "XX",  "vdiv.f32 %w0,%w0,%w1; vdiv.f32 %x0,%x0,%x1; "
+                        "vdiv.f32 %y0,%y0,%y1; vdiv.f32 %z0,%z0,%z1"},
+    {"sqrps_rr", "XX",  "vsqrt.f32 %w0,%w1; vsqrt.f32 %x0,%x1; "
+                        "vsqrt.f32 %y0,%y1; vsqrt.f32 %z0,%z1"},
+    {"sqrps_ld", "XM",  "%a1%p1vld1.32 {%l0,%h0},[%t1:128]; "
+                        "vsqrt.f32 %w0,%w0; vsqrt.f32 %x0,%x0; "
+                        "vsqrt.f32 %y0,%y0; vsqrt.f32 %z0,%z0"},
+
+#else  /* RT_SIMD_PREC_NORM */
+
+    {"divps_rr", "XX",  DV1("%1") "vrecps.f32 q9,q8,%1; "
+                        "vmul.f32 q8,q8,q9; vmul.f32 %0,%0,q8"},
+    {"divps_ld", "XM",  LD3 DV1("q10") "vrecps.f32 q9,q8,q10; "
+                        "vmul.f32 q8,q8,q9; vmul.f32 %0,%0,q8"},
+    {"sqrps_rr", "XX",  SQ1("%1") SQ2("%1") "vmul.f32 %0,%1,q8"},
+    {"sqrps_ld", "XM",  LD3 SQ1("q10") SQ2("q10") "vmul.f32 %0,q10,q8"},
+
+#endif /* RT_SIMD_PREC */
+
+    {"rceps_rr", "XX",  "vrecpe.f32 %0,%1"},
+    {"rcsps_rr", "XX",  "vrecps.f32 %1,%1,%0; vmul.f32 %0,%0,%1"},
+    {"rseps_rr", "XX",  "vrsqrte.f32 %0,%1"},
+    {"rssps_rr", "XX",  "vmul.f32 %1,%1,%0; vrsqrts.f32 %1,%1,%0; "
+                        "vmul.f32 %0,%0,%1"},
+
+    {"minps_rr", "XX",  "vmin.f32 %0,%0,%1"},
+    {"minps_ld", "XM",  LD1 "vmin.f32 %0,%0,q8"},
+    {"maxps_rr", "XX",  "vmax.f32 %0,%0,%1"},
+    {"maxps_ld", "XM",  LD1 "vmax.f32 %0,%0,q8"},
+
+    {"ceqps_rr", "XX",  "vceq.f32 %0,%0,%1"},
+    {"ceqps_ld", "XM",  LD1 "vceq.f32 %0,%0,q8"},
+    {"cneps_rr", "XX",  "vceq.f32 %0,%0,%1; vmvn %0,%0"},
+    {"cneps_ld", "XM",  LD1 "vceq.f32 %0,%0,q8; vmvn %0,%0"},
+    {"cltps_rr", "XX",  "vcgt.f32 %0,%1,%0"},
+    {"cltps_ld", "XM",  LD1 "vcgt.f32 %0,q8,%0"},
+    {"cleps_rr", "XX",  "vcge.f32 %0,%1,%0"},
+    {"cleps_ld", "XM",  LD1 "vcge.f32 %0,q8,%0"},
+    {"cgtps_rr", "XX",  "vcgt.f32 %0,%0,%1"},
+    {"cgtps_ld", "XM",  LD1 "vcgt.f32 %0,%0,q8"},
+    {"cgeps_rr", "XX",  "vcge.f32 %0,%0,%1"},
+    {"cgeps_ld", "XM",  LD1 "vcge.f32 %0,%0,q8"},
+
+    {"addpd_rr", "XX",  "vadd.f64 %l0,%l0,%l1; vadd.f64 %h0,%h0,%h1"},
+    {"addpd_ld", "XM",  LD1 "vadd.f64 %l0,%l0,d16; vadd.f64 %h0,%h0,d17"},
+    {"subpd_rr", "XX",  "vsub.f64 %l0,%l0,%l1; vsub.f64 %h0,%h0,%h1"},
+    {"subpd_ld", "XM",  LD1 "vsub.f64 %l0,%l0,d16; vsub.f64 %h0,%h0,d17"},
+    {"mulpd_rr", "XX",  "vmul.f64 %l0,%l0,%l1; vmul.f64 %h0,%h0,%h1"},
+    {"mulpd_ld", "XM",  LD1 "vmul.f64 %l0,%l0,d16; vmul.f64 %h0,%h0,d17"},
+    {"divpd_rr", "XX",  "vdiv.f64 %l0,%l0,%l1; vdiv.f64 %h0,%h0,%h1"},
+    {"divpd_ld", "XM",  LD1 "vdiv.f64 %l0,%l0,d16; vdiv.f64 %h0,%h0,d17"},
+    {"sqrpd_rr", "XX",  "vsqrt.f64 %l0,%l1; vsqrt.f64 %h0,%h1"},
+    {"sqrpd_ld", "XM",  LD1 "vsqrt.f64 %l0,d16; vsqrt.f64 %h0,d17"},
+    {"minpd_rr", "XX",  MND("pl", "%l0", "%l1") "; " MND("pl", "%h0", "%h1")},
+    {"minpd_ld", "XM",  LD1 MND("pl", "%l0", "d16") "; "
+                            MND("pl", "%h0", "d17")},
+    {"maxpd_rr", "XX",  MND("le", "%l0", "%l1") "; " MND("le", "%h0", "%h1")},
+    {"maxpd_ld", "XM",  LD1 MND("le", "%l0", "d16") "; "
+                            MND("le", "%h0", "d17")},
+
+    {"ceqpd_rr", "XX",  CPD("eq", "%l0", "%l1") "; " CPD("eq", "%h0", "%h1")},
+    {"ceqpd_ld", "XM",  LD1 CPD("eq", "%l0", "d16") "; "
+                            CPD("eq", "%h0", "d17")},
+    {"cnepd_rr", "XX",  CPD("ne", "%l0", "%l1") "; " CPD("ne", "%h0", "%h1")},
+    {"cnepd_ld", "XM",  LD1 CPD("ne", "%l0", "d16") "; "
+                            CPD("ne", "%h0", "d17")},
+    {"cltpd_rr", "XX",  CPD("mi", "%l0", "%l1") "; " CPD("mi", "%h0", "%h1")},
+    {"cltpd_ld", "XM",  LD1 CPD("mi", "%l0", "d16") "; "
+                            CPD("mi", "%h0", "d17")},
+    {"clepd_rr", "XX",  CPD("ls", "%l0", "%l1") "; " CPD("ls", "%h0", "%h1")},
+    {"clepd_ld", "XM",  LD1 CPD("ls", "%l0", "d16") "; "
+                            CPD("ls", "%h0", "d17")},
+    {"cgtpd_rr", "XX",  CPD("hi", "%l0", "%l1") "; " CPD("hi", "%h0", "%h1")},
+    {"cgtpd_ld", "XM",  LD1 CPD("hi", "%l0", "d16") "; "
+                            CPD("hi", "%h0", "d17")},
+    {"cgepd_rr", "XX",  CPD("pl", "%l0", "%l1") "; " CPD("pl", "%h0", "%h1")},
+    {"cgepd_ld", "XM",  LD1 CPD("pl", "%l0", "d16") "; "
+                            CPD("pl", "%h0", "d17")},
+
+    {"cvtsd_rr", "XX",  "vcvt.f64.f32 %h0,%x1; vcvt.f64.f32 %l0,%w1"},
+    {"cvtds_rr", "XX",  "vcvt.f32.f64 %w0,%l1; vcvt.f32.f64 %x0,%h1; "
+                        "veor %h0,%h0,%h0"},
+    {"cvtps_rr", "XX",  "vcvtr.s32.f32 %w0,%w1; vcvtr.s32.f32 %x0,%x1; "
+                        "vcvtr.s32.f32 %y0,%y1; vcvtr.s32.f32 %z0,%z1"},
+    {"cvtps_ld", "XM",  "%a1%p1vld1.32 {%l0,%h0},[%t1:128]; "
+                        "vcvtr.s32.f32 %w0,%w0; vcvtr.s32.f32 %x0,%x0; "
+                        "vcvtr.s32.f32 %y0,%y0; vcvtr.s32.f32 %z0,%z0"},
+    {"cvtpn_rr", "XX",  "vcvt.f32.s32 %0,%1"},
+    {"cvtpn_ld", "XM",  LD1 "vcvt.f32.s32 %0,q8"},
+
+    {"addpx_rr", "XX",  "vadd.i32 %0,%0,%1"},
+    {"addpx_ld", "XM",  LD1 "vadd.i32 %0,%0,q8"},
+    {"subpx_rr", "XX",  "vsub.i32 %0,%0,%1"},
+    {"subpx_ld", "XM",  LD1 "vsub.i32 %0,%0,q8"},
+    {"shlpx_ri", "XB",  "vshl.i32 %0,%0,%1"},
+    {"shlpx_ld", "XM",  LDS "vshl.u32 %0,%0,q8"},
+    {"shrpx_ri", "XB",  "mov r9,%1; vdup.32 q8,r9; vneg.s32 q8,q8; "
+                        "vshl.u32 %0,%0,q8"},
+    {"shrpx_ld", "XM",  LDS "vneg.s32 q8,q8; vshl.u32 %0,%0,q8"},
+    {"shrpn_ri", "XB",  "mov r9,%1; vdup.32 q8,r9; vneg.s32 q8,q8; "
+                        "vshl.s32 %0,%0,q8"},
+    {"shrpn_ld", "XM",  LDS "vneg.s32 q8,q8; vshl.s32 %0,%0,q8"},
+    {"cgtpn_rr", "XX",  "vcgt.s32 %0,%0,%1"},
+    {"cgtpn_ld", "XM",  LD1 "vcgt.s32 %0,%0,q8"},
+
+    {"addpb_rr", "XX",  "vadd.i8 %0,%0,%1"},
+    {"addpb_ld", "XM",  LD1 "vadd.i8 %0,%0,q8"},
+    {"addph_rr", "XX",  "vadd.i16 %0,%0,%1"},
+    {"addph_ld", "XM",  LD1 "vadd.i16 %0,%0,q8"},
+    {"adspb_rr", "XX",  "vqadd.u8 %0,%0,%1"},
+    {"adspb_ld", "XM",  LD1 "vqadd.u8 %0,%0,q8"},
+    {"adsph_rr", "XX",  "vqadd.u16 %0,%0,%1"},
+    {"adsph_ld", "XM",  LD1 "vqadd.u16 %0,%0,q8"},
+    {"subpb_rr", "XX",  "vsub.i8 %0,%0,%1"},
+    {"subpb_ld", "XM",  LD1 "vsub.i8 %0,%0,q8"},
+    {"subph_rr", "XX",  "vsub.i16 %0,%0,%1"},
+    {"subph_ld", "XM",  LD1 "vsub.i16 %0,%0,q8"},
+    {"sbspb_rr", "XX",  "vqsub.u8 %0,%0,%1"},
+    {"sbspb_ld", "XM",  LD1 "vqsub.u8 %0,%0,q8"},
+    {"sbsph_rr", "XX",  "vqsub.u16 %0,%0,%1"},
+    {"sbsph_ld", "XM",  LD1 "vqsub.u16 %0,%0,q8"},
+    {"avgpb_rr", "XX",  "vrhadd.u8 %0,%0,%1"},
+    {"avgpb_ld", "XM",  LD1 "vrhadd.u8 %0,%0,q8"},
+    {"avgph_rr", "XX",  "vrhadd.u16 %0,%0,%1"},
+    {"avgph_ld", "XM",  LD1 "vrhadd.u16 %0,%0,q8"},
+
+    {"unlpb_rr", "XX",  "vmovl.u8 %0,%l1"},
+    {"unhpb_rr", "XX",  "vmovl.u8 %0,%h1"},
+    {"unlph_rr", "XX",  "vmovl.u16 %0,%l1"},
+    {"unhph_rr", "XX",  "vmovl.u16 %0,%h1"},
+    {"pckph_rr", "XX",  "vqmovun.s16 d16,%0; vqmovun.s16 d17,%1; "
+                        "vorr %0,q8,q8"},
+    {"pckpn_rr", "XX",  "vqmovn.s32 d16,%0; vqmovn.s32 d17,%1; "
+                        "vorr %0,q8,q8"},
+
+    {"slnpx_ri", "XL",  "veor q8,q8,q8; vext.32 %0,q8,%0,#3"},
+    {"srnpx_ri", "XL",  "veor q8,q8,q8; vext.32 %0,%0,q8,#1"},
+    {"splpx_ri", "XL",  "vdup.32 %0,%l0[1]"},
+    {"splpx_ld", "XM",  "%a1%p1vld1.32 {%l0[],%h0[]},[%t1]"},
+
+#if RT_SIMD_FP16
+
+    {"cvhps_ld", "XTTM", "%a3%p3vld1.32 {d16},[%t3]; vcvt.f32.f16 %0,d16"},
+    {"cvpsh_st", "XTTM", "vcvt.f16.f32 d16,%0; %a3%p3vst1.32 {d16},[%t3]"},
+
+#endif /* RT_SIMD_FP16 */
+};
+
+#elif defined (RT_A64)
+
+#define RT_COMMENT          "//"
+
+/* load Tmm1 (v16) from SIMD memory operand 1 */
+#define LD1                 "%a1ldr q16,%1; "
+
+static rt_ENCD s_encd[] =
+{
+    /* ------------------------   rtarch_a64.h   ------------------------ */
+
+    {"movxx_ri", "RB",  "%i1mov %0,x17"},
+    {"movxx_ri", "RW",  "%i1mov %0,x17"},
+    {"movxx_mi", "MB",  "%a0%i1str w17,%0"},
+    {"movxx_mi", "MW",  "%a0%i1str w17,%0"},
+    {"movxx_rr", "RR",  "mov %0,%1"},
+    {"movxx_ld", "RM",  "%a1ldr %w0,%1"},
+    {"movxx_st", "RM",  "%a1str %w0,%1"},
+    {"movxa_ld", "RM",  "%a1ldr %0,%1"},
+    {"movxa_st", "RM",  "%a1str %0,%1"},
+    {"adrxx_ld", "RM",  "%a1add %0,%r1,#%o1"},
+    {"stack_st", "R",   "str %0,[sp,#-16]!"},
+    {"stack_ld", "R",   "ldr %0,[sp],#16"},
+
+    {"andxx_ri", "RB",  "%i1ands %0,%0,x17"},
+    {"andxx_ri", "RW",  "%i1ands %0,%0,x17"},
+    {"andxx_mi", "MB",  "%a0%i1ldr w16,%0; ands x16,x16,x17; str w16,%0"},
+    {"andxx_mi", "MW",  "%a0%i1ldr w16,%0; ands x16,x16,x17; str w16,%0"},
+    {"andxx_rr", "RR",  "ands %0,%0,%1"},
+    {"andxx_ld", "RM",  "%a1ldr w16,%1; ands %0,%0,x16"},
+    {"andxx_st", "RM",  "%a1ldr w16,%1; ands x16,x16,%0; str w16,%1"},
+
+    {"orrxx_ri", "RB",  "%i1orr %0,%0,x17"},
+    {"orrxx_ri", "RW",  "%i1orr %0,%0,x17"},
+    {"orrxx_mi", "MB",  "%a0%i1ldr w16,%0; orr x16,x16,x17; str w16,%0"},
+    {"orrxx_mi", "MW",  "%a0%i1ldr w16,%0; orr x16,x16,x17; str w16,%0"},
+    {"orrxx_rr", "RR",  "orr %0,%0,%1"},
+    {"orrxx_ld", "RM",  "%a1ldr w16,%1; orr %0,%0,x16"},
+    {"orrxx_st", "RM",  "%a1ldr w16,%1; orr x16,x16,%0; str w16,%1"},
+
+    {"notxx_rr", "R",   "mvn %0,%0"},
+    {"notxx_mm", "M",   "%a0ldr w16,%0; mvn x16,x16; str w16,%0"},
+
+    {"addxx_ri", "RB",  "%i1adds %0,%0,w17,sxtw"},
+    {"addxx_ri", "RW",  "%i1adds %0,%0,w17,sxtw"},
+    {"addxx_mi", "MB",  "%a0%i1ldr w16,%0; adds x16,x16,w17,sxtw; str w16,%0"},
+    {"addxx_mi", "MW",  "%a0%i1ldr w16,%0; adds x16,x16,w17,sxtw; str w16,%0"},
+    {"addxx_rr", "RR",  "adds %0,%0,%w1,sxtw"},
+    {"addxx_ld", "RM",  "%a1ldr w16,%1; adds %0,%0,w16,sxtw"},
+    {"addxx_st", "RM",  "%a1ldr w16,%1; adds x16,x16,%w0,sxtw; str w16,%1"},
+
+    {"subxx_ri", "RB",  "%i1subs %0,%0,w17,sxtw"},
+    {"subxx_ri", "RW",  "%i1subs %0,%0,w17,sxtw"},
+    {"subxx_mi", "MB",  "%a0%i1ldr w16,%0; subs x16,x16,w17,sxtw; str w16,%0"},
+    {"subxx_mi", "MW",  "%a0%i1ldr w16,%0; subs x16,x16,w17,sxtw; str w16,%0"},
+    {"subxx_rr", "RR",  "subs %0,%0,%w1,sxtw"},
+    {"subxx_ld", "RM",  "%a1ldr w16,%1; subs %0,%0,w16,sxtw"},
+    {"subxx_st", "RM",  "%a1ldr w16,%1; subs x16,x16,%w0,sxtw; str w16,%1"},
+    {"subxx_mr", "MR",  "%a0ldr w16,%0; subs x16,x16,%w1,sxtw; str w16,%0"},
+
+    {"shlxx_ri", "RB",  "lsl %w0,%w0,%1"},
+    {"shlxx_mi", "MB",  "%a0ldr w16,%0; lsl w16,w16,%1; str w16,%0"},
+    {"shrxx_ri", "RB",  "lsr %w0,%w0,%1"},
+    {"shrxx_mi", "MB",  "%a0ldr w16,%0; lsr w16,w16,%1; str w16,%0"},
+    {"shrxn_ri", "RB",  "asr %w0,%w0,%1"},
+    {"shrxn_mi", "MB",  "%a0ldr w16,%0; asr w16,w16,%1; str w16,%0"},
+
+    {"mulxn_ri", "RB",  "%i1mul %w0,%w0,w17"},
+    {"mulxn_ri", "RW",  "%i1mul %w0,%w0,w17"},
+    {"mulxn_rr", "RR",  "mul %w0,%w0,%w1"},
+    {"mulxn_ld", "RM",  "%a1ldr w16,%1; mul %w0,%w0,w16"},
+    {"mulxn_xm", "M",   "%a0ldr w16,%0; mul w0,w0,w16"},
+
+    {"divxx_xm", "M",   "%a0ldr w16,%0; udiv w0,w0,w16"},
+    {"divxn_xm", "M",   "%a0ldr w16,%0; sdiv w0,w0,w16"},
+    {"remxx_xm", "M",   "%a0ldr w16,%0; udiv w17,w0,w16; "
+                        "msub w2,w17,w16,w0; mov w0,w17"},
+    {"remxn_xm", "M",   "%a0ldr w16,%0; sdiv w17,w0,w16; "
+                        "msub w2,w17,w16,w0; mov w0,w17"},
+
+    {"cmpxx_ri", "RB",  "%i1cmp %w0,w17"},
+    {"cmpxx_ri", "RW",  "%i1cmp %w0,w17"},
+    {"cmpxx_mi", "MB",  "%a0%i1ldr w16,%0; cmp w16,w17"},
+    {"cmpxx_mi", "MW",  "%a0%i1ldr w16,%0; cmp w16,w17"},
+    {"cmpxx_rr", "RR",  "cmp %w0,%w1"},
+    {"cmpxx_rm", "RM",  "%a1ldr w16,%1; cmp %w0,w16"},
+    {"cmpxx_mr", "MR",  "%a0ldr w16,%0; cmp w16,%w1"},
+
+    {"jmpxx_mm", "M",   "%a0ldr x16,%0; br x16"},
+
+    /* ----------------------   rtarch_a64_128.h   ---------------------- */
+
+    {"movpx_rr", "XX",  "mov %b0,%b1"},
+    {"movpx_ld", "XM",  "%a1ldr %q0,%1"},
+    {"movpx_st", "XM",  "%a1str %q0,%1"},
+    {"adrpx_ld", "RM",  "%a1add %0,%r1,#%o1"},
+    {"movlx_ld", "XM",  "%a1ldr %l0,%1"},
+    {"movlx_st", "XM",  "%a1str %l0,%1"},
+    {"movux_ld", "XM",  "%a1ldr %q0,%1"},
+    {"movnx_st", "XM",  "%a1str %q0,%1"},
+    {"prfxx_ld", "M",   "%a0prfm pldl1keep,%0"},
+    {"fence_st", "",    "dmb ishst"},
+
+    {"andpx_rr", "XX",  "and %b0,%b0,%b1"},
+    {"andpx_ld", "XM",  LD1 "and %b0,%b0,v16.16b"},
+    {"annpx_rr", "XX",  "bic %b0,%b1,%b0"},
+    {"annpx_ld", "XM",  LD1 "bic %b0,v16.16b,%b0"},
+    {"orrpx_rr", "XX",  "orr %b0,%b0,%b1"},
+    {"orrpx_ld", "XM",  LD1 "orr %b0,%b0,v16.16b"},
+    {"xorpx_rr", "XX",  "eor %b0,%b0,%b1"},
+    {"xorpx_ld", "XM",  LD1 "eor %b0,%b0,v16.16b"},
+
+    {"addps_rr", "XX",  "fadd %0,%0,%1"},
+    {"addps_ld", "XM",  LD1 "fadd %0,%0,v16.4s"},
+    {"subps_rr", "XX",  "fsub %0,%0,%1"},
+    {"subps_ld", "XM",  LD1 "fsub %0,%0,v16.4s"},
+    {"mulps_rr", "XX",  "fmul %0,%0,%1"},
+    {"mulps_ld", "XM",  LD1 "fmul %0,%0,v16.4s"},
+    {"divps_rr", "XX",  "fdiv %0,%0,%1"},
+    {"divps_ld", "XM",  LD1 "fdiv %0,%0,v16.4s"},
+    {"sqrps_rr", "XX",  "fsqrt %0,%1"},
+    {"sqrps_ld", "XM",  LD1 "fsqrt %0,v16.4s"},
+
+    {"rceps_rr", "XX",  "frecpe %0,%1"},
+    {"rcsps_rr", "XX",  "frecps %1,%1,%0; fmul %0,%0,%1"},
+    {"rseps_rr", "XX",  "frsqrte %0,%1"},
+    {"rssps_rr", "XX",  "fmul %1,%1,%0; frsqrts %1,%1,%0; fmul %0,%0,%1"},
+
+    {"minps_rr", "XX",  "fmin %0,%0,%1"},
+    {"minps_ld", "XM",  LD1 "fmin %0,%0,v16.4s"},
+    {"maxps_rr", "XX",  "fmax %0,%0,%1"},
+    {"maxps_ld", "XM",  LD1 "fmax %0,%0,v16.4s"},
+
+    {"ceqps_rr", "XX",  "fcmeq %0,%0,%1"},
+    {"ceqps_ld", "XM",  LD1 "fcmeq %0,%0,v16.4s"},
+    {"cneps_rr", "XX",  "fcmeq %0,%0,%1; mvn %b0,%b0"},
+    {"cneps_ld", "XM",  LD1 "fcmeq %0,%0,v16.4s; mvn %b0,%b0"},
+    {"cltps_rr", "XX",  "fcmgt %0,%1,%0"},
+    {"cltps_ld", "XM",  LD1 "fcmgt %0,v16.4s,%0"},
+    {"cleps_rr", "XX",  "fcmge %0,%1,%0"},
+    {"cleps_ld", "XM",  LD1 "fcmge %0,v16.4s,%0"},
+    {"cgtps_rr", "XX",  "fcmgt %0,%0,%1"},
+    {"cgtps_ld", "XM",  LD1 "fcmgt %0,%0,v16.4s"},
+    {"cgeps_rr", "XX",  "fcmge %0,%0,%1"},
+    {"cgeps_ld", "XM",  LD1 "fcmge %0,%0,v16.4s"},
+
+    {"addpd_rr", "XX",  "fadd %d0,%d0,%d1"},
+    {"addpd_ld", "XM",  LD1 "fadd %d0,%d0,v16.2d"},
+    {"subpd_rr", "XX",  "fsub %d0,%d0,%d1"},
+    {"subpd_ld", "XM",  LD1 "fsub %d0,%d0,v16.2d"},
+    {"mulpd_rr", "XX",  "fmul %d0,%d0,%d1"},
+    {"mulpd_ld", "XM",  LD1 "fmul %d0,%d0,v16.2d"},
+    {"divpd_rr", "XX",  "fdiv %d0,%d0,%d1"},
+    {"divpd_ld", "XM",  LD1 "fdiv %d0,%d0,v16.2d"},
+    {"sqrpd_rr", "XX",  "fsqrt %d0,%d1"},
+    {"sqrpd_ld", "XM",  LD1 "fsqrt %d0,v16.2d"},
+    {"minpd_rr", "XX",  "fmin %d0,%d0,%d1"},
+    {"minpd_ld", "XM",  LD1 "fmin %d0,%d0,v16.2d"},
+    {"maxpd_rr", "XX",  "fmax %d0,%d0,%d1"},
+    {"maxpd_ld", "XM",  LD1 "fmax %d0,%d0,v16.2d"},
+
+    {"ceqpd_rr", "XX",  "fcmeq %d0,%d0,%d1"},
+    {"ceqpd_ld", "XM",  LD1 "fcmeq %d0,%d0,v16.2d"},
+    {"cnepd_rr", "XX",  "fcmeq %d0,%d0,%d1; mvn %b0,%b0"},
+    {"cnepd_ld", "XM",  LD1 "fcmeq %d0,%d0,v16.2d; mvn %b0,%b0"},
+    {"cltpd_rr", "XX",  "fcmgt %d0,%d1,%d0"},
+    {"cltpd_ld", "XM",  LD1 "fcmgt %d0,v16.2d,%d0"},
+    {"clepd_rr", "XX",  "fcmge %d0,%d1,%d0"},
+    {"clepd_ld", "XM",  LD1 "fcmge %d0,v16.2d,%d0"},
+    {"cgtpd_rr", "XX",  "fcmgt %d0,%d0,%d1"},
+    {"cgtpd_ld", "XM",  LD1 "fcmgt %d0,%d0,v16.2d"},
+    {"cgepd_rr", "XX",  "fcmge %d0,%d0,%d1"},
+    {"cgepd_ld", "XM",  LD1 "fcmge %d0,%d0,v16.2d"},
+
+    {"cvtsd_rr", "XX",  "fcvtl %d0,%v1.2s"},
+    {"cvtds_rr", "XX",  "fcvtn %v0.2s,%d1"},
+    {"cvtps_rr", "XX",  "frinti %0,%1; fcvtzs %0,%0"},
+    {"cvtps_ld", "XM",  "%a1ldr %q0,%1; frinti %0,%0; fcvtzs %0,%0"},
+    {"cvtpn_rr", "XX",  "scvtf %0,%1"},
+    {"cvtpn_ld", "XM",  LD1 "scvtf %0,v16.4s"},
+
+    {"addpx_rr", "XX",  "add %0,%0,%1"},
+    {"addpx_ld", "XM",  LD1 "add %0,%0,v16.4s"},
+    {"subpx_rr", "XX",  "sub %0,%0,%1"},
+    {"subpx_ld", "XM",  LD1 "sub %0,%0,v16.4s"},
+    {"shlpx_ri", "XB",  "shl %0,%0,%1"},
+    {"shlpx_ld", "XM",  "%a1ldr s16,%1; dup v16.4s,v16.s[0]; "
+                        "ushl %0,%0,v16.4s"},
+    {"shrpx_ri", "XB",  "ushr %0,%0,%1"},
+    {"shrpx_ld", "XM",  "%a1ldr s16,%1; dup v16.4s,v16.s[0]; "
+                        "neg v16.4s,v16.4s; ushl %0,%0,v16.4s"},
+    {"shrpn_ri", "XB",  "sshr %0,%0,%1"},
+    {"shrpn_ld", "XM",  "%a1ldr s16,%1; dup v16.4s,v16.s[0]; "
+                        "neg v16.4s,v16.4s; sshl %0,%0,v16.4s"},
+    {"cgtpn_rr", "XX",  "cmgt %0,%0,%1"},
+    {"cgtpn_ld", "XM",  LD1 "cmgt %0,%0,v16.4s"},
+
+    {"addpb_rr", "XX",  "add %b0,%b0,%b1"},
+    {"addpb_ld", "XM",  LD1 "add %b0,%b0,v16.16b"},
+    {"addph_rr", "XX",  "add %h0,%h0,%h1"},
+    {"addph_ld", "XM",  LD1 "add %h0,%h0,v16.8h"},
+    {"adspb_rr", "XX",  "uqadd %b0,%b0,%b1"},
+    {"adspb_ld", "XM",  LD1 "uqadd %b0,%b0,v16.16b"},
+    {"adsph_rr", "XX",  "uqadd %h0,%h0,%h1"},
+    {"adsph_ld", "XM",  LD1 "uqadd %h0,%h0,v16.8h"},
+    {"subpb_rr", "XX",  "sub %b0,%b0,%b1"},
+    {"subpb_ld", "XM",  LD1 "sub %b0,%b0,v16.16b"},
+    {"subph_rr", "XX",  "sub %h0,%h0,%h1"},
+    {"subph_ld", "XM",  LD1 "sub %h0,%h0,v16.8h"},
+    {"sbspb_rr", "XX",  "uqsub %b0,%b0,%b1"},
+    {"sbspb_ld", "XM",  LD1 "uqsub %b0,%b0,v16.16b"},
+    {"sbsph_rr", "XX",  "uqsub %h0,%h0,%h1"},
+    {"sbsph_ld", "XM",  LD1 "uqsub %h0,%h0,v16.8h"},
+    {"avgpb_rr", "XX",  "urhadd %b0,%b0,%b1"},
+    {"avgpb_ld", "XM",  LD1 "urhadd %b0,%b0,v16.16b"},
+    {"avgph_rr", "XX",  "urhadd %h0,%h0,%h1"},
+    {"avgph_ld", "XM",  LD1 "urhadd %h0,%h0,v16.8h"},
+
+    {"unlpb_rr", "XX",  "ushll %h0,%v1.8b,#0"},
+    {"unhpb_rr", "XX",  "ushll2 %h0,%b1,#0"},
+    {"unlph_rr", "XX",  "ushll %0,%v1.4h,#0"},
+    {"unhph_rr", "XX",  "ushll2 %0,%h1,#0"},
+    {"pckph_rr", "XX",  "sqxtun v16.8b,%h0; sqxtun2 v16.16b,%h1; "
+                        "mov %b0,v16.16b"},
+    {"pckpn_rr", "XX",  "sqxtn v16.4h,%0; sqxtn2 v16.8h,%1; "
+                        "mov %b0,v16.16b"},
+
+    {"slnpx_ri", "XL",  "eor v16.16b,v16.16b,v16.16b; "
+                        "ext %b0,v16.16b,%b0,#12"},
+    {"srnpx_ri", "XL",  "eor v16.16b,v16.16b,v16.16b; "
+                        "ext %b0,%b0,v16.16b,#4"},
+    {"splpx_ri", "XL",  "dup %0,%v0.s[1]"},
+    {"splpx_ld", "XM",  "%a1ldr %s0,%1; dup %0,%v0.s[0]"},
+
+#if RT_SIMD_FP16
+
+    {"cvhps_ld", "XTTM", "%a3ldr d16,%3; fcvtl %0,v16.4h"},
+    {"cvpsh_st", "XTTM", "fcvtn v16.4h,%0; %a3str d16,%3"},
+
+#endif /* RT_SIMD_FP16 */
+};
+
+#endif /* RT_X86, RT_X32, RT_ARM, RT_A64 */
+
+/******************************************************************************/
+/*********************************   OPERANDS   *******************************/
+/******************************************************************************/
+
+/*
+ * Return number of instances for a given operand kind.
+ */
+rt_cell get_count(rt_char kind)
+{
+    switch (kind)
+    {
+        case 'R':
+        return RT_CORE_REGS;
+
+        case 'X':
+        return RT_SIMD_REGS;
+
+        case 'M':
+        return 2 * RT_ARR_SIZE(s_base) * RT_ARR_SIZE(s_disp);
+
+        default:
+        return 1;
+    }
+}
+
+/*
+ * Fill operand instance n of a given kind.
+ */
+rt_void get_opnd(rt_OPND *op, rt_char kind, rt_cell n)
+{
+    memset(op, 0, sizeof(rt_OPND));
+    op->kind = kind;
+
+    switch (kind)
+    {
+        case 'R':
+        op->reg = n;
+        sprintf(op->arg, "Re%s", s_name[n] + 1);
+        break;
+
+        case 'X':
+        op->reg = n;
+        sprintf(op->arg, "Xmm%X", n);
+        break;
+
+        case 'M':
+        op->dsp = s_disp[n % RT_ARR_SIZE(s_disp)];
+        n /= RT_ARR_SIZE(s_disp);
+        op->reg = s_base[n % RT_ARR_SIZE(s_base)];
+        op->idx = n / RT_ARR_SIZE(s_base);
+        sprintf(op->arg, "%ce%s, DP(0x%03X)", op->idx ? 'I' : 'M',
+                s_name[op->reg] + 1, op->dsp);
+        break;
+
+        case 'B':
+        sprintf(op->arg, "IB(0x1F)");
+        break;
+
+        case 'L':
+        sprintf(op->arg, "IB(1)");
+        break;
+
+        case 'W':
+        sprintf(op->arg, "IW(0x12345678)");
+        break;
+
+        case 'T':
+        sprintf(op->arg, "Xmm7");
+        break;
+    }
+}
+
+/*
+ * Print operand op in objdump syntax, with an optional modifier
+ * (see the legend at the top of the file), return printed length.
+ */
+rt_cell put_opnd(rt_char *dst, rt_OPND *op, rt_char mod)
+{
+#if   defined (RT_X86) || defined (RT_X32)
+
+    switch (op->kind)
+    {
+        case 'R':
+        return sprintf(dst, "%%%s",
+                        mod == 'q' ? s_oadr[op->reg] : s_oreg[op->reg]);
+
+        case 'X':
+        return sprintf(dst, "%%xmm%d", op->reg);
+
+        case 'M':
+        if (op->idx)
+        {
+            return sprintf(dst, "0x%x(%%%s,%%%s,1)",
+                            op->dsp, s_oadr[op->reg], s_oadr[0]);
+        }
+        return sprintf(dst, "0x%x(%%%s)", op->dsp, s_oadr[op->reg]);
+
+        case 'B':
+        return sprintf(dst, "$0x1f");
+
+        case 'W':
+        return sprintf(dst, "$0x12345678");
+    }
+
+#elif defined (RT_ARM)
+
+    rt_char base[8];
+    sprintf(base, "r%d", op->idx ? 10 : op->reg);
+
+    switch (mod)
+    {
+        case 'a':
+        return op->idx ? sprintf(dst, "add r10,r%d,r0; ", op->reg) : 0;
+
+        case 'i':
+        return op->kind == 'W' ?
+                sprintf(dst, "movw r9,#22136; movt r9,#4660; ") : 0;
+
+        case 'p':
+        return op->dsp ? sprintf(dst, "add r10,%s,#%d; ", base, op->dsp) : 0;
+
+        case 't':
+        return sprintf(dst, "%s", op->dsp ? "r10" : base);
+
+        case 'b':
+        return sprintf(dst, "%s", base);
+
+        case 'd':
+        return sprintf(dst, "%d", op->dsp);
+
+        case 'l':
+        case 'h':
+        return sprintf(dst, "d%d", op->reg * 2 + (mod == 'h'));
+
+        case 'w':
+        case 'x':
+        case 'y':
+        case 'z':
+        return sprintf(dst, "s%d", op->reg * 4 + (mod - 'w'));
+    }
+
+    switch (op->kind)
+    {
+        case 'R':
+        return sprintf(dst, "r%d", op->reg);
+
+        case 'X':
+        return sprintf(dst, "q%d", op->reg);
+
+        case 'M':
+        if (op->dsp)
+        {
+            return sprintf(dst, "[%s,#%d]", base, op->dsp);
+        }
+        return sprintf(dst, "[%s]", base);
+
+        case 'B':
+        return sprintf(dst, "#31");
+
+        case 'W':
+        return sprintf(dst, "r9");
+    }
+
+#elif defined (RT_A64)
+
+    rt_char base[8];
+    sprintf(base, "x%d", op->idx ? 15 : op->reg);
+
+    switch (mod)
+    {
+        case 'a':
+        return op->idx ? sprintf(dst, "add x15,x%d,x0; ", op->reg) : 0;
+
+        case 'i':
+        return op->kind == 'W' ?
+                sprintf(dst, "mov w17,#22136; movk w17,#4660,lsl #16; "
+                             "sxtw x17,w17; ") :
+                sprintf(dst, "mov w17,#31; ");
+
+        case 'r':
+        return sprintf(dst, "%s", base);
+
+        case 'o':
+        return sprintf(dst, "%d", op->dsp);
+
+        case 'w':
+        return sprintf(dst, "w%d", op->reg);
+
+        case 'b':
+        return sprintf(dst, "v%d.16b", op->reg);
+
+        case 'h':
+        return sprintf(dst, "v%d.8h", op->reg);
+
+        case 'd':
+        return sprintf(dst, "v%d.2d", op->reg);
+
+        case 'q':
+        return sprintf(dst, "q%d", op->reg);
+
+        case 'l':
+        return sprintf(dst, "d%d", op->reg);
+
+        case 's':
+        return sprintf(dst, "s%d", op->reg);
+
+        case 'v':
+        return sprintf(dst, "v%d", op->reg);
+    }
+
+    switch (op->kind)
+    {
+        case 'R':
+        return sprintf(dst, "x%d", op->reg);
+
+        case 'X':
+        return sprintf(dst, "v%d.4s", op->reg);
+
+        case 'M':
+        if (op->dsp)
+        {
+            return sprintf(dst, "[%s,#%d]", base, op->dsp);
+        }
+        return sprintf(dst, "[%s]", base);
+
+        case 'B':
+        return sprintf(dst, "#31");
+    }
+
+#endif /* RT_X86, RT_X32, RT_ARM, RT_A64 */
+
+    return 0;
+}
+
+/******************************************************************************/
+/*********************************   INSTANCES   ******************************/
+/******************************************************************************/
+
+/*
+ * Build macro call and expected disassembly for instance k,
+ * return RT_FALSE if k is past the last instance.
+ */
+rt_bool get_inst(rt_cell k, rt_char *mac, rt_char *exp)
+{
+    rt_OPND op[OPND_SIZE];
+    rt_cell i, j, n, t;
+
+    for (i = 0; i < (rt_cell)RT_ARR_SIZE(s_encd); i++)
+    {
+        const rt_char *sig = s_encd[i].sig;
+
+        for (j = 0, t = 1; sig[j] != '\0'; j++)
+        {
+            t *= get_count(sig[j]);
+        }
+        if (k >= t)
+        {
+            k -= t;
+            continue;
+        }
+
+        n = sprintf(mac, "%s(", s_encd[i].mac);
+        for (j = 0; sig[j] != '\0'; j++)
+        {
+            get_opnd(&op[j], sig[j], k % get_count(sig[j]));
+            k /= get_count(sig[j]);
+            n += sprintf(mac + n, "%s%s", j > 0 ? ", " : "", op[j].arg);
+        }
+        sprintf(mac + n, ")");
+
+        const rt_char *src = s_encd[i].exp;
+        for (n = 0; *src != '\0'; src++)
+        {
+            if (*src != '%' || src[1] == '%')
+            {
+                exp[n++] = *src;
+                src += *src == '%';
+                continue;
+            }
+            rt_char mod = 0;
+            if (src[1] >= 'a' && src[1] <= 'z')
+            {
+                mod = *++src;
+            }
+            n += put_opnd(exp + n, &op[*++src - '0'], mod);
+        }
+        exp[n] = '\0';
+
+        return RT_TRUE;
+    }
+
+    return RT_FALSE;
+}
+
+/******************************************************************************/
+/********************************   NORMALIZE   *******************************/
+/******************************************************************************/
+
+/*
+ * Normalize a single instruction: drop comments, lowercase,
+ * keep one space after the mnemonic only, unify register aliases
+ * and equivalent forms printed differently by disassemblers.
+ */
+rt_void norm_inst(rt_char *dst, const rt_char *src)
+{
+    rt_char buf[LINE_SIZE];
+    rt_cell n = 0, m = 0;
+
+    while (*src == ' ' || *src == '\t')
+    {
+        src++;
+    }
+    for (; *src != '\0' && strchr(RT_COMMENT "\r\n", *src) == NULL; src++)
+    {
+        rt_char c = *src >= 'A' && *src <= 'Z' ? *src - 'A' + 'a' : *src;
+
+        if (c == ' ' || c == '\t')
+        {
+            if (m == 0 && n > 0)
+            {
+                buf[n++] = ' ';
+            }
+            m = n;
+            continue;
+        }
+        buf[n++] = c;
+    }
+    while (n > 0 && buf[n-1] == ' ')
+    {
+        n--;
+    }
+    buf[n] = '\0';
+
+#if defined (RT_ARM)
+
+    const rt_char *reg[4][2] =
+    {
+        {"sb", "r9"}, {"sl", "r10"}, {"fp", "r11"}, {"ip", "r12"},
+    };
+
+    rt_cell i;
+
+    /* register aliases, register lists, alignment hints */
+    for (i = 0, n = 0; buf[i] != '\0'; )
+    {
+        rt_cell a, b, j;
+
+        if (buf[i] == '{' && sscanf(buf + i, "{d%d-d%d}", &a, &b) == 2)
+        {
+            for (j = a; j <= b; j++)
+            {
+                n += sprintf(dst + n, "%sd%d", j == a ? "{" : ",", j);
+            }
+            dst[n++] = '}';
+            i = strchr(buf + i, '}') - buf + 1;
+            continue;
+        }
+        if (buf[i] == ',' && buf[i+1] == ':')
+        {
+            i++;
+            continue;
+        }
+        for (j = 0; j < 4; j++)
+        {
+            if ((i == 0 || strchr(" ,{[", buf[i-1]) != NULL)
+            &&  strncmp(buf + i, reg[j][0], 2) == 0
+            &&  strchr(" ,}]!:", buf[i+2]) != NULL)
+            {
+                break;
+            }
+        }
+        if (j < 4)
+        {
+            n += sprintf(dst + n, "%s", reg[j][1]);
+            i += 2;
+            continue;
+        }
+        dst[n++] = buf[i++];
+    }
+    dst[n] = '\0';
+
+    rt_cell a, b, c;
+    rt_char s[LINE_SIZE];
+
+    /* rotated immediate printed as value and rotation */
+    rt_char *rot = strstr(dst, ",#");
+    if (rot != NULL && sscanf(rot, ",#%d,#%d%s", &a, &b, s) == 2 && b > 0)
+    {
+        rt_word v = (rt_word)a >> b | (rt_word)a << (32 - b);
+        sprintf(rot, ",#%d", (rt_cell)v);
+    }
+    /* mov r0, r0 is printed as nop */
+    if (strcmp(dst, "nop") == 0)
+    {
+        sprintf(dst, "mov r0,r0");
+    }
+    /* vorr with equal sources is vmov */
+    if (sscanf(dst, "vorr q%d,q%d,q%d%s", &a, &b, &c, s) == 3 && b == c)
+    {
+        sprintf(dst, "vmov q%d,q%d", a, b);
+    }
+    /* single register str/ldr with sp writeback is push/pop */
+    if (sscanf(dst, "str r%d,[sp,#-4]%s", &a, s) == 2 && strcmp(s, "!") == 0)
+    {
+        sprintf(dst, "push {r%d}", a);
+    }
+    if (sscanf(dst, "ldr r%d,[sp],#4%s", &a, s) == 1)
+    {
+        sprintf(dst, "pop {r%d}", a);
+    }
+
+#elif defined (RT_A64)
+
+    rt_cell a, b, c;
+    rt_char s[LINE_SIZE];
+
+    strcpy(dst, buf);
+
+    /* orr with equal sources is mov */
+    if (sscanf(dst, "orr v%d.16b,v%d.16b,v%d.16b%s", &a, &b, &c, s) == 3
+    &&  b == c)
+    {
+        sprintf(dst, "mov v%d.16b,v%d.16b", a, b);
+    }
+
+#else  /* RT_X86, RT_X32 */
+
+    strcpy(dst, buf);
+
+#endif /* RT_X86, RT_X32, RT_ARM, RT_A64 */
+}
+
+/*
+ * Normalize a sequence of instructions separated by ';'.
+ */
+rt_void norm_list(rt_char *dst, const rt_char *src)
+{
+    rt_char buf[LINE_SIZE];
+    rt_cell n = 0;
+
+    while (*src != '\0')
+    {
+        const rt_char *end = strchr(src, ';');
+        rt_cell len = end != NULL ? end - src : strlen(src);
+
+        memcpy(buf, src, len);
+        buf[len] = '\0';
+        src += len + (end != NULL);
+
+        if (n > 0)
+        {
+            n += sprintf(dst + n, "; ");
+        }
+        norm_inst(dst + n, buf);
+        n += strlen(dst + n);
+    }
+    dst[n] = '\0';
+}
+
+/******************************************************************************/
+/*********************************   MODES   **********************************/
+/******************************************************************************/
+
+/*
+ * Generate translation unit with all instances,
+ * each preceded by a label carrying its number.
+ */
+rt_cell gen_encd()
+{
+    rt_char mac[LINE_SIZE], exp[TEXT_SIZE];
+    rt_cell k;
+
+    RT_LOGI("/* generated by simd_encode -g, do not edit */\n\n");
+    RT_LOGI("#include \"rtarch.h\"\n\n");
+    RT_LOGI("rt_void s_encode()\n{\n    asm volatile\n    (\n");
+
+    /* keep first and last labels apart from function's boundaries */
+    RT_LOGI("        ASM_BEG ASM_OP0(nop) ASM_END\n");
+
+    for (k = 0; get_inst(k, mac, exp); k++)
+    {
+        RT_LOGI("        LBL(e_%05d)\n", k);
+        RT_LOGI("        %s\n", mac);
+    }
+
+    RT_LOGI("        LBL(e_end)\n");
+    RT_LOGI("        ASM_BEG ASM_OP0(nop) ASM_END\n");
+    RT_LOGI("        :\n        :\n    );\n}\n");
+
+    return 0;
+}
+
+/*
+ * Compare one instance's disassembly with the expected one,
+ * return number of mismatches (0 or 1).
+ */
+rt_cell chk_inst(rt_cell k, const rt_char *txt)
+{
+    rt_char mac[LINE_SIZE], exp[TEXT_SIZE], out[TEXT_SIZE];
+
+    if (!get_inst(k, mac, exp))
+    {
+        RT_LOGE("Unexpected label e_%05d\n", k);
+        return 1;
+    }
+
+    norm_list(out, exp);
+    if (strcmp(out, txt) == 0)
+    {
+        return 0;
+    }
+
+    RT_LOGE("%s\n", mac);
+    RT_LOGE("  expected: %s\n", out);
+    RT_LOGE("  actual:   %s\n", txt);
+
+    return 1;
+}
+
+/*
+ * Check objdump output read from stdin against the expected table.
+ */
+rt_cell chk_encd()
+{
+    rt_char line[LINE_SIZE], txt[TEXT_SIZE];
+    rt_cell k = -1, n = 0, cnt = 0, err = 0;
+
+    while (fgets(line, LINE_SIZE, stdin) != NULL)
+    {
+        rt_char *lbl = strstr(line, " <e_");
+        rt_cell idx;
+
+        if (lbl != NULL && strstr(lbl, ">:") != NULL)
+        {
+            if (k >= 0)
+            {
+                err += chk_inst(k, txt);
+                cnt++;
+            }
+            if (sscanf(lbl, " <e_%d>:", &idx) != 1)
+            {
+                k = -1;
+                break;
+            }
+            k = idx;
+            n = 0;
+            txt[0] = '\0';
+            continue;
+        }
+        if (k < 0)
+        {
+            continue;
+        }
+
+        /* skip address and bytes, instruction text follows next tab */
+        rt_char *str = strchr(line, ':');
+        if (str == NULL || (rt_cell)strspn(line, " \t0123456789abcdef") != str - line)
+        {
+            continue;
+        }
+        str += strspn(str + 1, " \t") + 1;
+        str = strchr(str, '\t');
+        if (str == NULL || strspn(str, " \t\r\n") == strlen(str))
+        {
+            continue;
+        }
+
+        if (n > 0)
+        {
+            n += sprintf(txt + n, "; ");
+        }
+        norm_inst(txt + n, str);
+        n += strlen(txt + n);
+    }
+
+    rt_char mac[LINE_SIZE], exp[TEXT_SIZE];
+
+    if (!get_inst(cnt, mac, exp) && err == 0 && cnt > 0)
+    {
+        RT_LOGI("All %d instances match\n", cnt);
+        return 0;
+    }
+    if (get_inst(cnt, mac, exp))
+    {
+        RT_LOGE("Missing instances from %s\n", mac);
+    }
+
+    RT_LOGE("%d of %d instances mismatch\n", err, cnt);
+    return 1;
+}
+
+/******************************************************************************/
+/**********************************   MAIN   **********************************/
+/******************************************************************************/
+
+rt_cell main(rt_cell argc, rt_char *argv[])
+{
+    if (argc == 2 && strcmp(argv[1], "-g") == 0)
+    {
+        return gen_encd();
+    }
+    if (argc == 2 && strcmp(argv[1], "-c") == 0)
+    {
+        return chk_encd();
+    }
+
+    RT_LOGI("---------------------------------------------------------\n");
+    RT_LOGI("Usage options are given below:\n");
+    RT_LOGI(" -g, generate instances to stdout\n");
+    RT_LOGI(" -c, check objdump -d -z output from stdin\n");
+    RT_LOGI("---------------------------------------------------------\n");
+
+    return 1;
+}
+
+/******************************************************************************/
+/******************************************************************************/
+/******************************************************************************/
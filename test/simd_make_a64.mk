@@ -0,0 +1,34 @@
+
+INC_PATH =                          \
+        -I../core/
+
+SRC_LIST =                          \
+        simd_test.cpp
+
+simd_test:
+	aarch64-linux-gnu-g++ -O3 -g -pthread -static \
+        -DRT_LINUX -DRT_A64 -DRT_DEBUG=1 \
+        ${INC_PATH} ${SRC_LIST} -o simd_test.a64
+
+simd_encode:
+	g++ -O3 -g \
+        -DRT_LINUX -DRT_A64 -DRT_DEBUG=1 \
+        ${INC_PATH} simd_encode.cpp -o simd_encode.a64
+	./simd_encode.a64 -g > simd_encode_a64.cpp
+	aarch64-linux-gnu-g++ -O3 -c \
+        -DRT_LINUX -DRT_A64 -DRT_DEBUG=1 \
+        ${INC_PATH} simd_encode_a64.cpp -o simd_encode_a64.o
+	llvm-objcopy --wildcard --strip-symbol='$$d*' simd_encode_a64.o
+	llvm-objdump -d -z --no-print-imm-hex simd_encode_a64.o | \
+        ./simd_encode.a64 -c
+
+simd_count:
+	g++ -O3 -g -pthread \
+        -DRT_LINUX -DRT_A64 -DRT_DEBUG=1 -DRT_COUNT \
+        ${INC_PATH} ${SRC_LIST} -o simd_count.a64
+	./simd_count.a64
+
+# On x86 hosts run the static binary as: qemu-aarch64 ./simd_test.a64
+# (cross-build and qemu run not tested yet, A64 kernels were assembled with
+# llvm-mc and executed by an instruction-level AArch64 interpreter on x86,
+# all run levels and fuzz mode pass, simd_encode was checked with llvm-mc)
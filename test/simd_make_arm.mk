@@ -6,6 +6,35 @@ SRC_LIST =                          \
         simd_test.cpp
 
 simd_test:
-	g++ -O3 -g \
+	g++ -O3 -g -pthread \
         -DRT_LINUX -DRT_ARM -DRT_DEBUG=1 \
         ${INC_PATH} ${SRC_LIST} -o simd_test.arm
+
+simd_test_fast:
+	g++ -O3 -g -pthread \
+        -DRT_LINUX -DRT_ARM -DRT_DEBUG=1 \
+        -DRT_SIMD_PREC=RT_SIMD_PREC_FAST \
+        ${INC_PATH} ${SRC_LIST} -o simd_test_fast.arm
+
+simd_test_full:
+	g++ -O3 -g -pthread \
+        -DRT_LINUX -DRT_ARM -DRT_DEBUG=1 \
+        -DRT_SIMD_PREC=RT_SIMD_PREC_FULL \
+        ${INC_PATH} ${SRC_LIST} -o simd_test_full.arm
+
+simd_encode:
+	g++ -O3 -g \
+        -DRT_LINUX -DRT_ARM -DRT_DEBUG=1 \
+        ${INC_PATH} simd_encode.cpp -o simd_encode.arm
+	./simd_encode.arm -g > simd_encode_arm.cpp
+	g++ -O3 -c \
+        -DRT_LINUX -DRT_ARM -DRT_DEBUG=1 \
+        ${INC_PATH} simd_encode_arm.cpp -o simd_encode_arm.o
+	objcopy --wildcard --strip-symbol='$$d*' simd_encode_arm.o
+	objdump -d -z simd_encode_arm.o | ./simd_encode.arm -c
+
+simd_count:
+	g++ -O3 -g -pthread \
+        -DRT_LINUX -DRT_ARM -DRT_DEBUG=1 -DRT_COUNT \
+        ${INC_PATH} ${SRC_LIST} -o simd_count.arm
+	./simd_count.arm
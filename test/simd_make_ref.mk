@@ -0,0 +1,11 @@
+
+INC_PATH =                          \
+        -I../core/
+
+SRC_LIST =                          \
+        simd_test.cpp
+
+simd_test:
+	g++ -O3 -g -pthread -frounding-math \
+        -DRT_LINUX -DRT_REF -DRT_DEBUG=1 \
+        ${INC_PATH} ${SRC_LIST} -o simd_test.ref
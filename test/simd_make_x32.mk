@@ -0,0 +1,27 @@
+
+INC_PATH =                          \
+        -I../core/
+
+SRC_LIST =                          \
+        simd_test.cpp
+
+simd_test:
+	g++ -O3 -g -pthread -mx32 \
+        -DRT_LINUX -DRT_X32 -DRT_DEBUG=1 \
+        ${INC_PATH} ${SRC_LIST} -o simd_test.x32
+
+simd_encode:
+	g++ -O3 -g -mx32 \
+        -DRT_LINUX -DRT_X32 -DRT_DEBUG=1 \
+        ${INC_PATH} simd_encode.cpp -o simd_encode.x32
+	./simd_encode.x32 -g > simd_encode_x32.cpp
+	g++ -O3 -mx32 -c \
+        -DRT_LINUX -DRT_X32 -DRT_DEBUG=1 \
+        ${INC_PATH} simd_encode_x32.cpp -o simd_encode_x32.o
+	objdump -d -z -M x86-64 simd_encode_x32.o | ./simd_encode.x32 -c
+
+simd_count:
+	g++ -O3 -g -pthread -mx32 \
+        -DRT_LINUX -DRT_X32 -DRT_DEBUG=1 -DRT_COUNT \
+        ${INC_PATH} ${SRC_LIST} -o simd_count.x32
+	./simd_count.x32
@@ -6,6 +6,22 @@ SRC_LIST =                          \
         simd_test.cpp
 
 simd_test:
-	g++ -O3 -g -m32 \
+	g++ -O3 -g -pthread -m32 \
         -DRT_LINUX -DRT_X86 -DRT_DEBUG=1 \
         ${INC_PATH} ${SRC_LIST} -o simd_test.x86
+
+simd_encode:
+	g++ -O3 -g -m32 \
+        -DRT_LINUX -DRT_X86 -DRT_DEBUG=1 \
+        ${INC_PATH} simd_encode.cpp -o simd_encode.x86
+	./simd_encode.x86 -g > simd_encode_x86.cpp
+	g++ -O3 -m32 -c \
+        -DRT_LINUX -DRT_X86 -DRT_DEBUG=1 \
+        ${INC_PATH} simd_encode_x86.cpp -o simd_encode_x86.o
+	objdump -d -z simd_encode_x86.o | ./simd_encode.x86 -c
+
+simd_count:
+	g++ -O3 -g -pthread -m32 \
+        -DRT_LINUX -DRT_X86 -DRT_DEBUG=1 -DRT_COUNT \
+        ${INC_PATH} ${SRC_LIST} -o simd_count.x86
+	./simd_count.x86
@@ -8,18 +8,68 @@
 #include <string.h>
 #include <stdio.h>
 
+#include <algorithm>
+
 #include "rtarch.h"
+#include "rtarena.h"
+#include "rtsoa.h"
+#include "rtmem.h"
 #include "rtbase.h"
 
 /******************************************************************************/
 /*******************************   DEFINITIONS   ******************************/
 /******************************************************************************/
 
-#define RUN_LEVEL           14
+#define RUN_LEVEL           48
 #define CYC_SIZE            1000000
 
 #define ARR_SIZE            S*3 /* hardcoded in asm sections, S = SIMD width */
-#define MASK                (RT_SIMD_ALIGN - 1) /* SIMD alignment mask */
+#define MAX_SIZE            (ARR_SIZE*64) /* array capacity, see run_size */
+#define SCR_SIZE            256 /* SIMD vectors in scratch, see fscr */
+
+#define NUM_BOX             16 /* boxes in synthetic scene, see fbox */
+#define NUM_TRI             16 /* triangles in synthetic scene, see ftri */
+
+#define THR_SIZE            4 /* threads in multithreaded levels, see thrd */
+#define THR_WORK            (1 << 18) /* min array size to start threads */
+#define THR_SCR             8 /* SIMD vectors in scratch of each thread */
+
+#define HST_BINS            (S*16) /* buckets in histogram levels, see hbuf */
+#define HST_MAXB            (1 << 16) /* max buckets in histogram table */
+
+#ifndef GMM_L1
+#define GMM_L1              (32*1024) /* data cache sizes for sgemm blocking, */
+#endif /* GMM_L1 */
+#ifndef GMM_L2
+#define GMM_L2              (256*1024) /* override with -D for target CPU */
+#endif /* GMM_L2 */
+#ifndef GMM_L3
+#define GMM_L3              (2048*1024)
+#endif /* GMM_L3 */
+
+/* sgemm tile follows the number of SIMD registers in the target (see gemm_knl):
+ * 16 - 12 accumulate 6 rows of C tile 2 SIMD vectors wide, 2 hold row of
+ *      B sliver, 2 are temporary (broadcast element of A and its product),
+ *  8 -  6 accumulate 6 rows of C tile 1 SIMD vector wide, 1 holds row of
+ *      B sliver, 1 is temporary */
+#if RT_SIMD_REGS >= 16
+#define GMM_MR              6
+#define GMM_NR              (RT_SIMD_WIDTH*2)
+#else  /* RT_SIMD_REGS == 8 */
+#define GMM_MR              6
+#define GMM_NR              RT_SIMD_WIDTH
+#endif /* RT_SIMD_REGS */
+
+/* kc: A sliver (GMM_MR x kc) and B sliver (kc x GMM_NR) in L1/2, rounded
+ * to S for B panel alignment, mc: A block (mc x kc) in L2/2,
+ * nc: B panel (kc x nc) in L3/2 */
+#define GMM_KC              (GMM_L1/2 / ((GMM_MR + GMM_NR)*4) /             \
+                             RT_SIMD_WIDTH * RT_SIMD_WIDTH)
+#define GMM_MC              (GMM_L2/2 / (GMM_KC*4) / GMM_MR * GMM_MR)
+#define GMM_NC              (GMM_L3/2 / (GMM_KC*4) / GMM_NR * GMM_NR)
+
+/* packed A block and B panel, see fpck */
+#define GMM_PCK             (GMM_MC*GMM_KC + GMM_KC*GMM_NC)
 
 #define FRK(f)              (f < 10.0       ?    0.0001     :               \
                              f < 100.0      ?    0.001      :               \
@@ -30,6 +80,12 @@
 #define IEQ(i1, i2)         (i1 == i2)
 #define FEQ(f1, f2)         (RT_FABS((f1) - (f2)) <= t_diff *               \
                              RT_MIN(FRK(f1), FRK(f2)))
+#define DEQ(d1, d2)         (fabs((d1) - (d2)) <= t_diff * 1.0e-15 *        \
+                             RT_MAX(fabs(d1), fabs(d2)))
+
+/* deterministic fp32 sequence in [-62.5, 62.5] for synthetic data */
+#define HSH(k)              ((rt_real)((rt_cell)(((rt_word)(k) *            \
+                             2654435761u) >> 16) % 2001 - 1000) / 16.0f)
 
 #define RT_LOGI             printf
 #define RT_LOGE             printf
@@ -40,65 +96,247 @@
 
 static rt_cell t_diff = 2;
 static rt_bool v_mode = RT_FALSE;
+static rt_cell u_diff = 3;
+static rt_cell fuzz_runs = 0;
+static rt_word fuzz_seed = 0x2545F491;
+static rt_bool n_mode = RT_FALSE;
+static rt_bool h_mode = RT_FALSE;
+static rt_cell bench_size = 0;
+static rt_cell bench_mhz = 0;
+
+/* per-thread scratch, allocated from arena(k) of the thread set in main */
+static rt_real *thr_scr[THR_SIZE];
+
+typedef rt_void (*rt_FUNC_PARA)(rt_pntr data, rt_cell index);
+
+rt_void sys_para(rt_cell num, rt_FUNC_PARA func, rt_pntr data);
 
 /*
  * Extended SIMD info structure for asm enter/leave
  * serves as a container for test arrays and internal variables.
  * Note that DP offsets below start where rt_SIMD_INFO ends (at Q*0x100).
  * SIMD width is taken into account via S and Q from rtarch.h
+ * Pointer size is taken into account via P from rtarch.h
  */
 struct rt_SIMD_INFOX : public rt_SIMD_INFO
 {
     /* floating point arrays */
 
     rt_real*far0;
-#define inf_FAR0            DP(Q*0x100+0x000)
+#define inf_FAR0            DP(Q*0x100+0x000*P)
 
     rt_real*fco1;
-#define inf_FCO1            DP(Q*0x100+0x004)
+#define inf_FCO1            DP(Q*0x100+0x004*P)
 
     rt_real*fco2;
-#define inf_FCO2            DP(Q*0x100+0x008)
+#define inf_FCO2            DP(Q*0x100+0x008*P)
 
     rt_real*fso1;
-#define inf_FSO1            DP(Q*0x100+0x00C)
+#define inf_FSO1            DP(Q*0x100+0x00C*P)
 
     rt_real*fso2;
-#define inf_FSO2            DP(Q*0x100+0x010)
+#define inf_FSO2            DP(Q*0x100+0x010*P)
 
     /* integer arrays */
 
     rt_cell*iar0;
-#define inf_IAR0            DP(Q*0x100+0x014)
+#define inf_IAR0            DP(Q*0x100+0x014*P)
 
     rt_cell*ico1;
-#define inf_ICO1            DP(Q*0x100+0x018)
+#define inf_ICO1            DP(Q*0x100+0x018*P)
 
     rt_cell*ico2;
-#define inf_ICO2            DP(Q*0x100+0x01C)
+#define inf_ICO2            DP(Q*0x100+0x01C*P)
 
     rt_cell*iso1;
-#define inf_ISO1            DP(Q*0x100+0x020)
+#define inf_ISO1            DP(Q*0x100+0x020*P)
 
     rt_cell*iso2;
-#define inf_ISO2            DP(Q*0x100+0x024)
+#define inf_ISO2            DP(Q*0x100+0x024*P)
 
     /* internal variables */
 
     rt_cell cyc;
-#define inf_CYC             DP(Q*0x100+0x028)
+#define inf_CYC             DP(Q*0x100+0x028*P+0x000)
 
     rt_cell loc;
-#define inf_LOC             DP(Q*0x100+0x02C)
+#define inf_LOC             DP(Q*0x100+0x028*P+0x004)
 
     rt_cell size;
-#define inf_SIZE            DP(Q*0x100+0x030)
+#define inf_SIZE            DP(Q*0x100+0x028*P+0x008)
 
     rt_cell simd;
-#define inf_SIMD            DP(Q*0x100+0x034)
+#define inf_SIMD            DP(Q*0x100+0x028*P+0x00C)
 
     rt_pntr label;
-#define inf_LABEL           DP(Q*0x100+0x038)
+#define inf_LABEL           DP(Q*0x100+0x028*P+0x010)
+
+    /* pixel arrays */
+
+    rt_word*par0;
+#define inf_PAR0            DP(Q*0x100+0x02C*P+0x010)
+
+    /* double reference arrays */
+
+    rt_fp64*dre1;
+#define inf_DRE1            DP(Q*0x100+0x030*P+0x010)
+
+    rt_fp64*dre2;
+#define inf_DRE2            DP(Q*0x100+0x034*P+0x010)
+
+    /* block variables */
+
+    rt_cell cnt;
+#define inf_CNT             DP(Q*0x100+0x038*P+0x010)
+
+    rt_cell str;
+#define inf_STR             DP(Q*0x100+0x038*P+0x014)
+
+    /* matrix arguments */
+
+    rt_real*fmat;
+#define inf_FMAT            DP(Q*0x100+0x038*P+0x018)
+
+    rt_real*fscr;
+#define inf_FSCR            DP(Q*0x100+0x03C*P+0x018)
+
+    /* scene arrays */
+
+    rt_real*fbox;
+#define inf_FBOX            DP(Q*0x100+0x040*P+0x018)
+
+    rt_real*ftri;
+#define inf_FTRI            DP(Q*0x100+0x044*P+0x018)
+
+    rt_cell pkt;
+#define inf_PKT             DP(Q*0x100+0x048*P+0x018)
+
+    /* blas arguments */
+
+    rt_real alpha;
+#define inf_ALPHA           DP(Q*0x100+0x048*P+0x01C)
+
+    /* gemm arguments */
+
+    rt_real*fpck;
+#define inf_FPCK            DP(Q*0x100+0x048*P+0x020)
+
+    rt_real*gmma;
+#define inf_GMMA            DP(Q*0x100+0x04C*P+0x020)
+
+    rt_real*gmmb;
+#define inf_GMMB            DP(Q*0x100+0x050*P+0x020)
+
+    rt_real*gmmc;
+#define inf_GMMC            DP(Q*0x100+0x054*P+0x020)
+
+    rt_cell mc;
+#define inf_MC              DP(Q*0x100+0x058*P+0x020)
+
+    rt_cell nc;
+#define inf_NC              DP(Q*0x100+0x058*P+0x024)
+
+    rt_cell kc;
+#define inf_KC              DP(Q*0x100+0x058*P+0x028)
+
+    rt_cell acc;
+#define inf_ACC             DP(Q*0x100+0x058*P+0x02C)
+
+    rt_cell mcl;
+#define inf_MCL             DP(Q*0x100+0x058*P+0x030)
+
+    rt_cell ncl;
+#define inf_NCL             DP(Q*0x100+0x058*P+0x034)
+
+    /* scan arguments */
+
+    rt_word*ssrc;
+#define inf_SSRC            DP(Q*0x100+0x058*P+0x038)
+
+    rt_word*sinc;
+#define inf_SINC            DP(Q*0x100+0x05C*P+0x038)
+
+    rt_word*sexc;
+#define inf_SEXC            DP(Q*0x100+0x060*P+0x038)
+
+    rt_SIMD_INFOX*thrd;
+#define inf_THRD            DP(Q*0x100+0x064*P+0x038)
+
+    rt_cell scnt;
+#define inf_SCNT            DP(Q*0x100+0x068*P+0x038)
+
+    union { rt_real soff; rt_cell sofi; };
+#define inf_SOFF            DP(Q*0x100+0x068*P+0x03C)
+
+    union { rt_real ssum; rt_cell ssmi; };
+#define inf_SSUM            DP(Q*0x100+0x068*P+0x040)
+
+    /* sort arguments */
+
+    rt_cell srem;
+#define inf_SREM            DP(Q*0x100+0x068*P+0x044)
+
+    rt_word*ssrk;
+#define inf_SSRK            DP(Q*0x100+0x068*P+0x048)
+
+    rt_word*ssrv;
+#define inf_SSRV            DP(Q*0x100+0x06C*P+0x048)
+
+    rt_word*sdsk;
+#define inf_SDSK            DP(Q*0x100+0x070*P+0x048)
+
+    rt_word*sdsv;
+#define inf_SDSV            DP(Q*0x100+0x074*P+0x048)
+
+    rt_word*sbuf;
+#define inf_SBUF            DP(Q*0x100+0x078*P+0x048)
+
+    rt_cell srun;
+#define inf_SRUN            DP(Q*0x100+0x07C*P+0x048)
+
+    rt_cell scx;
+#define inf_SCX             DP(Q*0x100+0x07C*P+0x04C)
+
+    rt_cell scy;
+#define inf_SCY             DP(Q*0x100+0x07C*P+0x050)
+
+    /* histogram arguments */
+
+    rt_cell hcnt;
+#define inf_HCNT            DP(Q*0x100+0x07C*P+0x054)
+
+    rt_real*hsrc;
+#define inf_HSRC            DP(Q*0x100+0x07C*P+0x058)
+
+    rt_word*hidx;
+#define inf_HIDX            DP(Q*0x100+0x080*P+0x058)
+
+    rt_word*hbuf;
+#define inf_HBUF            DP(Q*0x100+0x084*P+0x058)
+
+    rt_word*hout;
+#define inf_HOUT            DP(Q*0x100+0x088*P+0x058)
+
+    rt_cell hpad;
+#define inf_HPAD            DP(Q*0x100+0x08C*P+0x058)
+
+    rt_real hlo;
+#define inf_HLO             DP(Q*0x100+0x08C*P+0x05C)
+
+    rt_real hscl;
+#define inf_HSCL            DP(Q*0x100+0x08C*P+0x060)
+
+    rt_real hmax;
+#define inf_HMAX            DP(Q*0x100+0x08C*P+0x064)
+
+    rt_cell hrem;
+#define inf_HREM            DP(Q*0x100+0x08C*P+0x068)
+
+    rt_cell hnum;
+#define inf_HNUM            DP(Q*0x100+0x08C*P+0x06C)
+
+    rt_cell hstr;
+#define inf_HSTR            DP(Q*0x100+0x08C*P+0x070)
 
 };
 
@@ -143,9 +381,9 @@ rt_void s_test01(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Recx, Mebp, inf_FAR0)
-        movxx_ld(Redx, Mebp, inf_FSO1)
-        movxx_ld(Rebx, Mebp, inf_FSO2)
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
 
         movpx_ld(Xmm0, Mecx, AJ0)
         movpx_ld(Xmm1, Mecx, AJ1)
@@ -207,6 +445,21 @@ rt_void p_test01(rt_SIMD_INFOX *info)
     }
 }
 
+rt_void d_test01(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_fp64 *dre1 = info->dre1;
+    rt_fp64 *dre2 = info->dre2;
+
+    j = n;
+    while (j-->0)
+    {
+        dre1[j] = (rt_fp64)far0[j] + (rt_fp64)far0[(j + S) % n];
+        dre2[j] = (rt_fp64)far0[j] - (rt_fp64)far0[(j + S) % n];
+    }
+}
+
 #endif /* RUN_LEVEL  1 */
 
 /******************************************************************************/
@@ -243,9 +496,9 @@ rt_void s_test02(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Recx, Mebp, inf_FAR0)
-        movxx_ld(Redx, Mebp, inf_FSO1)
-        movxx_ld(Rebx, Mebp, inf_FSO2)
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
 
         movpx_ld(Xmm0, Mecx, AJ0)
         movpx_ld(Xmm1, Mecx, AJ1)
@@ -308,6 +561,21 @@ rt_void p_test02(rt_SIMD_INFOX *info)
     }
 }
 
+rt_void d_test02(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_fp64 *dre1 = info->dre1;
+    rt_fp64 *dre2 = info->dre2;
+
+    j = n;
+    while (j-->0)
+    {
+        dre1[j] = (rt_fp64)far0[j] * (rt_fp64)far0[(j + S) % n];
+        dre2[j] = (rt_fp64)far0[j] / (rt_fp64)far0[(j + S) % n];
+    }
+}
+
 #endif /* RUN_LEVEL  2 */
 
 /******************************************************************************/
@@ -344,9 +612,9 @@ rt_void s_test03(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Recx, Mebp, inf_FAR0)
-        movxx_ld(Redx, Mebp, inf_ISO1)
-        movxx_ld(Rebx, Mebp, inf_ISO2)
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_ISO1)
+        movxa_ld(Rebx, Mebp, inf_ISO2)
 
         movpx_ld(Xmm0, Mecx, AJ0)
         movpx_ld(Xmm1, Mecx, AJ1)
@@ -444,9 +712,9 @@ rt_void s_test04(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Recx, Mebp, inf_FAR0)
-        movxx_ld(Redx, Mebp, inf_ISO1)
-        movxx_ld(Rebx, Mebp, inf_ISO2)
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_ISO1)
+        movxa_ld(Rebx, Mebp, inf_ISO2)
 
         movpx_ld(Xmm0, Mecx, AJ0)
         movpx_ld(Xmm1, Mecx, AJ1)
@@ -544,9 +812,9 @@ rt_void s_test05(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Recx, Mebp, inf_FAR0)
-        movxx_ld(Redx, Mebp, inf_ISO1)
-        movxx_ld(Rebx, Mebp, inf_ISO2)
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_ISO1)
+        movxa_ld(Rebx, Mebp, inf_ISO2)
 
         movpx_ld(Xmm0, Mecx, AJ0)
         movpx_ld(Xmm1, Mecx, AJ1)
@@ -647,10 +915,10 @@ rt_void s_test06(rt_SIMD_INFOX *info)
 
         FCTRL_ENTER(ROUNDM)
 
-        movxx_ld(Recx, Mebp, inf_FAR0)
-        movxx_ld(Resi, Mebp, inf_IAR0)
-        movxx_ld(Redx, Mebp, inf_ISO1)
-        movxx_ld(Rebx, Mebp, inf_FSO2)
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Resi, Mebp, inf_IAR0)
+        movxa_ld(Redx, Mebp, inf_ISO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
 
         movpx_ld(Xmm0, Mecx, AJ0)
         movpx_ld(Xmm1, Mesi, AJ0)
@@ -709,6 +977,19 @@ rt_void p_test06(rt_SIMD_INFOX *info)
     }
 }
 
+rt_void d_test06(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+    rt_cell *iar0 = info->iar0;
+    rt_fp64 *dre2 = info->dre2;
+
+    j = n;
+    while (j-->0)
+    {
+        dre2[j] = (rt_fp64)iar0[j];
+    }
+}
+
 #endif /* RUN_LEVEL  6 */
 
 /******************************************************************************/
@@ -745,9 +1026,9 @@ rt_void s_test07(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Recx, Mebp, inf_FAR0)
-        movxx_ld(Redx, Mebp, inf_FSO1)
-        movxx_ld(Rebx, Mebp, inf_FSO2)
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
 
         movpx_ld(Xmm0, Mecx, AJ0)
         sqrps_rr(Xmm2, Xmm0)
@@ -800,6 +1081,21 @@ rt_void p_test07(rt_SIMD_INFOX *info)
     }
 }
 
+rt_void d_test07(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_fp64 *dre1 = info->dre1;
+    rt_fp64 *dre2 = info->dre2;
+
+    j = n;
+    while (j-->0)
+    {
+        dre1[j] = sqrt((rt_fp64)far0[j]);
+        dre2[j] = 1.0 / (rt_fp64)far0[j];
+    }
+}
+
 #endif /* RUN_LEVEL  7 */
 
 /******************************************************************************/
@@ -836,9 +1132,9 @@ rt_void s_test08(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Resi, Mebp, inf_IAR0)
-        movxx_ld(Redx, Mebp, inf_ISO1)
-        movxx_ld(Rebx, Mebp, inf_ISO2)
+        movxa_ld(Resi, Mebp, inf_IAR0)
+        movxa_ld(Redx, Mebp, inf_ISO1)
+        movxa_ld(Rebx, Mebp, inf_ISO2)
 
         movpx_ld(Xmm0, Mesi, AJ0)
         movpx_ld(Xmm1, Mesi, AJ0)
@@ -939,16 +1235,16 @@ rt_void s_test09(rt_SIMD_INFOX *info)
     ASM_ENTER(info)
 
         label_ld(cyc_beg) /* load to Reax */
-        movxx_st(Reax, Mebp, inf_LABEL)
+        movxa_st(Reax, Mebp, inf_LABEL)
 
         movxx_ld(Reax, Mebp, inf_CYC)
         movxx_st(Reax, Mebp, inf_LOC)
 
     LBL(cyc_beg)
 
-        movxx_ld(Recx, Mebp, inf_IAR0)
-        movxx_ld(Rebx, Mebp, inf_ISO1)
-        movxx_ld(Resi, Mebp, inf_ISO2)
+        movxa_ld(Recx, Mebp, inf_IAR0)
+        movxa_ld(Rebx, Mebp, inf_ISO1)
+        movxa_ld(Resi, Mebp, inf_ISO2)
         movxx_ld(Redi, Mebp, inf_SIZE)
 
     LBL(loc_beg)
@@ -968,7 +1264,7 @@ rt_void s_test09(rt_SIMD_INFOX *info)
         cmpxx_ri(Redi, IB(S))
         jgtxx_lb(loc_beg)
 
-        movxx_ld(Redi, Mebp, inf_IAR0)
+        movxa_ld(Redi, Mebp, inf_IAR0)
         movxx_mi(Mebp, inf_SIMD, IB(S))
 
     LBL(smd_beg)
@@ -1066,9 +1362,9 @@ rt_void s_test10(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Recx, Mebp, inf_FAR0)
-        movxx_ld(Redx, Mebp, inf_FSO1)
-        movxx_ld(Rebx, Mebp, inf_FSO2)
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
 
         movpx_ld(Xmm0, Mecx, AJ0)
         movpx_ld(Xmm1, Mecx, AJ1)
@@ -1130,6 +1426,21 @@ rt_void p_test10(rt_SIMD_INFOX *info)
     }
 }
 
+rt_void d_test10(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_fp64 *dre1 = info->dre1;
+    rt_fp64 *dre2 = info->dre2;
+
+    j = n;
+    while (j-->0)
+    {
+        dre1[j] = RT_MIN((rt_fp64)far0[j], (rt_fp64)far0[(j + S) % n]);
+        dre2[j] = RT_MAX((rt_fp64)far0[j], (rt_fp64)far0[(j + S) % n]);
+    }
+}
+
 #endif /* RUN_LEVEL 10 */
 
 /******************************************************************************/
@@ -1166,9 +1477,9 @@ rt_void s_test11(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Resi, Mebp, inf_IAR0)
-        movxx_ld(Redx, Mebp, inf_ISO1)
-        movxx_ld(Rebx, Mebp, inf_ISO2)
+        movxa_ld(Resi, Mebp, inf_IAR0)
+        movxa_ld(Redx, Mebp, inf_ISO1)
+        movxa_ld(Rebx, Mebp, inf_ISO2)
 
         movpx_ld(Xmm0, Mesi, AJ0)
         movpx_ld(Xmm1, Mesi, AJ0)
@@ -1273,9 +1584,9 @@ rt_void s_test12(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Resi, Mebp, inf_IAR0)
-        movxx_ld(Redx, Mebp, inf_ISO1)
-        movxx_ld(Rebx, Mebp, inf_ISO2)
+        movxa_ld(Resi, Mebp, inf_IAR0)
+        movxa_ld(Redx, Mebp, inf_ISO1)
+        movxa_ld(Rebx, Mebp, inf_ISO2)
 
 
         movpx_ld(Xmm0, Mesi, AJ0)
@@ -1381,9 +1692,9 @@ rt_void s_test13(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Recx, Mebp, inf_FAR0)
-        movxx_ld(Redx, Mebp, inf_FSO1)
-        movxx_ld(Rebx, Mebp, inf_FSO2)
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
 
         movpx_ld(Xmm0, Mecx, AJ0)
         cbrps_rr(Xmm2, Xmm5, Xmm6, Xmm0) /* destroys Xmm5, Xmm6 */
@@ -1436,6 +1747,21 @@ rt_void p_test13(rt_SIMD_INFOX *info)
     }
 }
 
+rt_void d_test13(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_fp64 *dre1 = info->dre1;
+    rt_fp64 *dre2 = info->dre2;
+
+    j = n;
+    while (j-->0)
+    {
+        dre1[j] = pow((rt_fp64)far0[j], 1.0 / 3.0);
+        dre2[j] = 1.0 / sqrt((rt_fp64)far0[j]);
+    }
+}
+
 #endif /* RUN_LEVEL 13 */
 
 /******************************************************************************/
@@ -1484,9 +1810,9 @@ rt_void s_test14(rt_SIMD_INFOX *info)
     {
         ASM_ENTER(info)
 
-        movxx_ld(Recx, Mebp, inf_FAR0)
-        movxx_ld(Redx, Mebp, inf_ISO1)
-        movxx_ld(Rebx, Mebp, inf_ISO2)
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_ISO1)
+        movxa_ld(Rebx, Mebp, inf_ISO2)
 
         /* 0th section */
         movpx_ld(Xmm0, Mecx, AJ0)
@@ -1625,198 +1951,8667 @@ rt_void p_test14(rt_SIMD_INFOX *info)
 #endif /* RUN_LEVEL 14 */
 
 /******************************************************************************/
-/*********************************   TABLES   *********************************/
+/******************************   RUN LEVEL 15   ******************************/
 /******************************************************************************/
 
-typedef rt_void (*testXX)(rt_SIMD_INFOX *);
+#if RUN_LEVEL >= 15
 
-testXX c_test[RUN_LEVEL] =
+rt_void c_test15(rt_SIMD_INFOX *info)
 {
-#if RUN_LEVEL >=  1
-    c_test01,
-#endif /* RUN_LEVEL  1 */
-
-#if RUN_LEVEL >=  2
-    c_test02,
-#endif /* RUN_LEVEL  2 */
-
-#if RUN_LEVEL >=  3
-    c_test03,
-#endif /* RUN_LEVEL  3 */
+    rt_cell i, j, k, n = info->size;
+    rt_byte *par0 = (rt_byte *)info->par0;
+    rt_byte *ico1 = (rt_byte *)info->ico1;
+    rt_byte *ico2 = (rt_byte *)info->ico2;
 
-#if RUN_LEVEL >=  4
-    c_test04,
-#endif /* RUN_LEVEL  4 */
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = n;
+        while (j-->0)
+        {
+            k = 4;
+            while (k-->0)
+            {
+                rt_cell a = par0[j*4 + k];
+                rt_cell b = par0[((j + S) % n)*4 + k];
+                ico1[j*4 + k] = (rt_byte)RT_MIN(a + b, 0xFF);
+                ico2[j*4 + k] = (rt_byte)((a + b + 1) >> 1);
+            }
+        }
+    }
+}
 
-#if RUN_LEVEL >=  5
-    c_test05,
-#endif /* RUN_LEVEL  5 */
+rt_void s_test15(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
 
-#if RUN_LEVEL >=  6
-    c_test06,
-#endif /* RUN_LEVEL  6 */
+    i = info->cyc;
+    while (i-->0)
+    {
+        ASM_ENTER(info)
 
-#if RUN_LEVEL >=  7
-    c_test07,
-#endif /* RUN_LEVEL  7 */
+        movxa_ld(Recx, Mebp, inf_PAR0)
+        movxa_ld(Redx, Mebp, inf_ISO1)
+        movxa_ld(Rebx, Mebp, inf_ISO2)
 
-#if RUN_LEVEL >=  8
-    c_test08,
-#endif /* RUN_LEVEL  8 */
+        movpx_ld(Xmm0, Mecx, AJ0)
+        movpx_ld(Xmm1, Mecx, AJ1)
+        movpx_rr(Xmm2, Xmm0)
+        adspb_rr(Xmm2, Xmm1)
+        movpx_rr(Xmm3, Xmm0)
+        avgpb_rr(Xmm3, Xmm1)
+        movpx_st(Xmm2, Medx, AJ0)
+        movpx_st(Xmm3, Mebx, AJ0)
 
-#if RUN_LEVEL >=  9
-    c_test09,
-#endif /* RUN_LEVEL  9 */
+        movpx_ld(Xmm0, Mecx, AJ1)
+        movpx_ld(Xmm1, Mecx, AJ2)
+        movpx_rr(Xmm2, Xmm0)
+        adspb_rr(Xmm2, Xmm1)
+        movpx_rr(Xmm3, Xmm0)
+        avgpb_rr(Xmm3, Xmm1)
+        movpx_st(Xmm2, Medx, AJ1)
+        movpx_st(Xmm3, Mebx, AJ1)
 
-#if RUN_LEVEL >= 10
-    c_test10,
-#endif /* RUN_LEVEL 10 */
+        movpx_ld(Xmm0, Mecx, AJ2)
+        movpx_rr(Xmm2, Xmm0)
+        adspb_ld(Xmm2, Mecx, AJ0)
+        movpx_rr(Xmm3, Xmm0)
+        avgpb_ld(Xmm3, Mecx, AJ0)
+        movpx_st(Xmm2, Medx, AJ2)
+        movpx_st(Xmm3, Mebx, AJ2)
 
-#if RUN_LEVEL >= 11
-    c_test11,
-#endif /* RUN_LEVEL 11 */
+        ASM_LEAVE(info)
+    }
+}
 
-#if RUN_LEVEL >= 12
-    c_test12,
-#endif /* RUN_LEVEL 12 */
+rt_void p_test15(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
 
-#if RUN_LEVEL >= 13
-    c_test13,
-#endif /* RUN_LEVEL 13 */
+    rt_word *par0 = info->par0;
+    rt_cell *ico1 = info->ico1;
+    rt_cell *ico2 = info->ico2;
+    rt_cell *iso1 = info->iso1;
+    rt_cell *iso2 = info->iso2;
 
-#if RUN_LEVEL >= 14
-    c_test14,
-#endif /* RUN_LEVEL 14 */
-};
+    j = n;
+    while (j-->0)
+    {
+        if (IEQ(ico1[j], iso1[j]) && IEQ(ico2[j], iso2[j]) && !v_mode)
+        {
+            continue;
+        }
 
-testXX s_test[RUN_LEVEL] =
-{
-#if RUN_LEVEL >=  1
-    s_test01,
-#endif /* RUN_LEVEL  1 */
+        RT_LOGI("parr[%d] = %08X, parr[%d] = %08X\n",
+                j, par0[j], (j + S) % n, par0[(j + S) % n]);
 
-#if RUN_LEVEL >=  2
-    s_test02,
-#endif /* RUN_LEVEL  2 */
+        RT_LOGI("C ADS(parr[%d],parr[%d]) = %08X, "
+                  "AVG(parr[%d],parr[%d]) = %08X\n",
+                j, (j + S) % n, ico1[j], j, (j + S) % n, ico2[j]);
 
-#if RUN_LEVEL >=  3
-    s_test03,
-#endif /* RUN_LEVEL  3 */
+        RT_LOGI("S ADS(parr[%d],parr[%d]) = %08X, "
+                  "AVG(parr[%d],parr[%d]) = %08X\n",
+                j, (j + S) % n, iso1[j], j, (j + S) % n, iso2[j]);
+    }
+}
 
-#if RUN_LEVEL >=  4
-    s_test04,
-#endif /* RUN_LEVEL  4 */
+#endif /* RUN_LEVEL 15 */
 
-#if RUN_LEVEL >=  5
-    s_test05,
-#endif /* RUN_LEVEL  5 */
+/******************************************************************************/
+/******************************   RUN LEVEL 16   ******************************/
+/******************************************************************************/
 
-#if RUN_LEVEL >=  6
-    s_test06,
-#endif /* RUN_LEVEL  6 */
+#if RUN_LEVEL >= 16
 
-#if RUN_LEVEL >=  7
-    s_test07,
-#endif /* RUN_LEVEL  7 */
+rt_void c_test16(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k, n = info->size;
+    rt_byte *par0 = (rt_byte *)info->par0;
+    rt_byte *ico1 = (rt_byte *)info->ico1;
+    rt_byte *ico2 = (rt_byte *)info->ico2;
 
-#if RUN_LEVEL >=  8
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = n;
+        while (j-->0)
+        {
+            k = 4;
+            while (k-->0)
+            {
+                rt_cell a = par0[j*4 + k];
+                rt_cell b = par0[((j + S) % n)*4 + k];
+                ico1[j*4 + k] = (rt_byte)RT_MIN(a + a + b, 0xFF);
+                ico2[j*4 + k] = (rt_byte)RT_MAX(a - b, 0x00);
+            }
+        }
+    }
+}
+
+rt_void s_test16(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        ASM_ENTER(info)
+
+        movxa_ld(Recx, Mebp, inf_PAR0)
+        movxa_ld(Redx, Mebp, inf_ISO1)
+        movxa_ld(Rebx, Mebp, inf_ISO2)
+
+        movpx_ld(Xmm0, Mecx, AJ0)
+        movpx_ld(Xmm1, Mecx, AJ1)
+        unlpb_rr(Xmm2, Xmm0)
+        unhpb_rr(Xmm3, Xmm0)
+        unlpb_rr(Xmm4, Xmm1)
+        unhpb_rr(Xmm5, Xmm1)
+        addph_rr(Xmm2, Xmm2)
+        addph_rr(Xmm3, Xmm3)
+        addph_rr(Xmm2, Xmm4)
+        addph_rr(Xmm3, Xmm5)
+        pckph_rr(Xmm2, Xmm3)
+        sbspb_rr(Xmm0, Xmm1)
+        movpx_st(Xmm2, Medx, AJ0)
+        movpx_st(Xmm0, Mebx, AJ0)
+
+        movpx_ld(Xmm0, Mecx, AJ1)
+        movpx_ld(Xmm1, Mecx, AJ2)
+        unlpb_rr(Xmm2, Xmm0)
+        unhpb_rr(Xmm3, Xmm0)
+        unlpb_rr(Xmm4, Xmm1)
+        unhpb_rr(Xmm5, Xmm1)
+        addph_rr(Xmm2, Xmm2)
+        addph_rr(Xmm3, Xmm3)
+        addph_rr(Xmm2, Xmm4)
+        addph_rr(Xmm3, Xmm5)
+        pckph_rr(Xmm2, Xmm3)
+        sbspb_rr(Xmm0, Xmm1)
+        movpx_st(Xmm2, Medx, AJ1)
+        movpx_st(Xmm0, Mebx, AJ1)
+
+        movpx_ld(Xmm0, Mecx, AJ2)
+        movpx_ld(Xmm1, Mecx, AJ0)
+        unlpb_rr(Xmm2, Xmm0)
+        unhpb_rr(Xmm3, Xmm0)
+        unlpb_rr(Xmm4, Xmm1)
+        unhpb_rr(Xmm5, Xmm1)
+        addph_rr(Xmm2, Xmm2)
+        addph_rr(Xmm3, Xmm3)
+        addph_rr(Xmm2, Xmm4)
+        addph_rr(Xmm3, Xmm5)
+        pckph_rr(Xmm2, Xmm3)
+        sbspb_ld(Xmm0, Mecx, AJ0)
+        movpx_st(Xmm2, Medx, AJ2)
+        movpx_st(Xmm0, Mebx, AJ2)
+
+        ASM_LEAVE(info)
+    }
+}
+
+rt_void p_test16(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_word *par0 = info->par0;
+    rt_cell *ico1 = info->ico1;
+    rt_cell *ico2 = info->ico2;
+    rt_cell *iso1 = info->iso1;
+    rt_cell *iso2 = info->iso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (IEQ(ico1[j], iso1[j]) && IEQ(ico2[j], iso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("parr[%d] = %08X, parr[%d] = %08X\n",
+                j, par0[j], (j + S) % n, par0[(j + S) % n]);
+
+        RT_LOGI("C ADS(2*parr[%d],parr[%d]) = %08X, "
+                  "SBS(parr[%d],parr[%d]) = %08X\n",
+                j, (j + S) % n, ico1[j], j, (j + S) % n, ico2[j]);
+
+        RT_LOGI("S ADS(2*parr[%d],parr[%d]) = %08X, "
+                  "SBS(parr[%d],parr[%d]) = %08X\n",
+                j, (j + S) % n, iso1[j], j, (j + S) % n, iso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 16 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 17   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 17
+
+rt_void c_test17(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_fp64 *dco1 = (rt_fp64 *)info->fco1;
+    rt_fp64 *dco2 = (rt_fp64 *)info->fco2;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = n / S;
+        while (j-->0)
+        {
+            k = RT_SIMD_WIDTH64;
+            while (k-->0)
+            {
+                rt_fp64 a = far0[j*S + k];
+                rt_fp64 b = far0[((j+1)*S + k) % n];
+                dco1[j*RT_SIMD_WIDTH64 + k] = a * b + a;
+                dco2[j*RT_SIMD_WIDTH64 + k] = sqrt(a) / b;
+            }
+        }
+    }
+}
+
+rt_void s_test17(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        ASM_ENTER(info)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
+
+        movpx_ld(Xmm0, Mecx, AJ0)
+        movpx_ld(Xmm1, Mecx, AJ1)
+        cvtsd_rr(Xmm0, Xmm0)
+        cvtsd_rr(Xmm1, Xmm1)
+        movpx_rr(Xmm2, Xmm0)
+        mulpd_rr(Xmm2, Xmm1)
+        addpd_rr(Xmm2, Xmm0)
+        sqrpd_rr(Xmm3, Xmm0)
+        divpd_rr(Xmm3, Xmm1)
+        movpx_st(Xmm2, Medx, AJ0)
+        movpx_st(Xmm3, Mebx, AJ0)
+
+        movpx_ld(Xmm0, Mecx, AJ1)
+        movpx_ld(Xmm1, Mecx, AJ2)
+        cvtsd_rr(Xmm0, Xmm0)
+        cvtsd_rr(Xmm1, Xmm1)
+        movpx_rr(Xmm2, Xmm0)
+        mulpd_rr(Xmm2, Xmm1)
+        addpd_rr(Xmm2, Xmm0)
+        sqrpd_rr(Xmm3, Xmm0)
+        divpd_rr(Xmm3, Xmm1)
+        movpx_st(Xmm2, Medx, AJ1)
+        movpx_st(Xmm3, Mebx, AJ1)
+
+        movpx_ld(Xmm0, Mecx, AJ2)
+        movpx_ld(Xmm1, Mecx, AJ0)
+        cvtsd_rr(Xmm0, Xmm0)
+        cvtsd_rr(Xmm1, Xmm1)
+        movpx_rr(Xmm2, Xmm0)
+        mulpd_rr(Xmm2, Xmm1)
+        addpd_rr(Xmm2, Xmm0)
+        sqrpd_rr(Xmm3, Xmm0)
+        divpd_rr(Xmm3, Xmm1)
+        movpx_st(Xmm2, Medx, AJ2)
+        movpx_st(Xmm3, Mebx, AJ2)
+
+        ASM_LEAVE(info)
+    }
+}
+
+rt_void p_test17(rt_SIMD_INFOX *info)
+{
+    rt_cell j, k, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_fp64 *dco1 = (rt_fp64 *)info->fco1;
+    rt_fp64 *dco2 = (rt_fp64 *)info->fco2;
+    rt_fp64 *dso1 = (rt_fp64 *)info->fso1;
+    rt_fp64 *dso2 = (rt_fp64 *)info->fso2;
+
+    j = n / S;
+    while (j-->0)
+    {
+        k = RT_SIMD_WIDTH64;
+        while (k-->0)
+        {
+            rt_cell d = j*RT_SIMD_WIDTH64 + k;
+
+            if (DEQ(dco1[d], dso1[d]) && DEQ(dco2[d], dso2[d]) && !v_mode)
+            {
+                continue;
+            }
+
+            RT_LOGI("farr[%d] = %e, farr[%d] = %e\n",
+                    j*S + k, far0[j*S + k],
+                    ((j+1)*S + k) % n, far0[((j+1)*S + k) % n]);
+
+            RT_LOGI("C farr[%d]*farr[%d]+farr[%d] = %.15e, "
+                      "sqrt(farr[%d])/farr[%d] = %.15e\n",
+                    j*S + k, ((j+1)*S + k) % n, j*S + k, dco1[d],
+                    j*S + k, ((j+1)*S + k) % n, dco2[d]);
+
+            RT_LOGI("S farr[%d]*farr[%d]+farr[%d] = %.15e, "
+                      "sqrt(farr[%d])/farr[%d] = %.15e\n",
+                    j*S + k, ((j+1)*S + k) % n, j*S + k, dso1[d],
+                    j*S + k, ((j+1)*S + k) % n, dso2[d]);
+        }
+    }
+}
+
+#endif /* RUN_LEVEL 17 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 18   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 18
+
+rt_half fp32_to_fp16(rt_real f)
+{
+    union { rt_real f; rt_word w; } u;
+    rt_word w, o, m, r, h;
+    rt_cell e;
+
+    u.f = f;
+    w = u.w & 0x7FFFFFFF;
+
+    if (w >= 0x47800000)
+    {
+        o = w > 0x7F800000 ? 0x7E00 : 0x7C00;
+    }
+    else
+    if (w <  0x38800000)
+    {
+        e = 126 - (rt_cell)(w >> 23);
+        m = (w & 0x007FFFFF) | 0x00800000;
+        o = 0;
+        if (e <= 24)
+        {
+            o = m >> e;
+            r = m & ((1 << e) - 1);
+            h = 1 << (e - 1);
+            o += (r > h || (r == h && (o & 1))) ? 1 : 0;
+        }
+    }
+    else
+    {
+        o = (w + 0xC8000FFF + ((w >> 13) & 1)) >> 13;
+    }
+
+    return (rt_half)(o | ((u.w >> 16) & 0x8000));
+}
+
+rt_real fp16_to_fp32(rt_half h)
+{
+    union { rt_real f; rt_word w; } u;
+    rt_word m = h & 0x03FF;
+    rt_cell e = (h >> 10) & 0x1F;
+
+    u.w = (rt_word)(h & 0x8000) << 16;
+
+    if (e == 0x1F)
+    {
+        u.w |= 0x7F800000 | (m << 13);
+    }
+    else
+    if (e == 0 && m != 0)
+    {
+        e = 113;
+        while ((m & 0x0400) == 0)
+        {
+            m <<= 1;
+            e--;
+        }
+        u.w |= (e << 23) | ((m & 0x03FF) << 13);
+    }
+    else
+    if (e != 0)
+    {
+        u.w |= ((e + 112) << 23) | (m << 13);
+    }
+
+    return u.f;
+}
+
+rt_void c_test18(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_half *hco1 = (rt_half *)info->ico1;
+    rt_real *fco2 = info->fco2;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = n / S;
+        while (j-->0)
+        {
+            k = S;
+            while (k-->0)
+            {
+                hco1[j*S*2 + k] = fp32_to_fp16(far0[j*S + k]);
+                fco2[j*S + k] = fp16_to_fp32(hco1[j*S*2 + k]);
+            }
+        }
+    }
+}
+
+rt_void s_test18(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        ASM_ENTER(info)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_ISO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
+
+        movpx_ld(Xmm0, Mecx, AJ0)
+        cvpsh_st(Xmm0, Xmm1, Xmm2, Medx, AJ0)
+        cvhps_ld(Xmm3, Xmm1, Xmm2, Medx, AJ0)
+        movpx_st(Xmm3, Mebx, AJ0)
+
+        movpx_ld(Xmm0, Mecx, AJ1)
+        cvpsh_st(Xmm0, Xmm1, Xmm2, Medx, AJ1)
+        cvhps_ld(Xmm3, Xmm1, Xmm2, Medx, AJ1)
+        movpx_st(Xmm3, Mebx, AJ1)
+
+        movpx_ld(Xmm0, Mecx, AJ2)
+        cvpsh_st(Xmm0, Xmm1, Xmm2, Medx, AJ2)
+        cvhps_ld(Xmm3, Xmm1, Xmm2, Medx, AJ2)
+        movpx_st(Xmm3, Mebx, AJ2)
+
+        ASM_LEAVE(info)
+    }
+}
+
+rt_void p_test18(rt_SIMD_INFOX *info)
+{
+    rt_cell j, k, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_half *hco1 = (rt_half *)info->ico1;
+    rt_half *hso1 = (rt_half *)info->iso1;
+    rt_word *fco2 = (rt_word *)info->fco2;
+    rt_word *fso2 = (rt_word *)info->fso2;
+
+    j = n / S;
+    while (j-->0)
+    {
+        k = S;
+        while (k-->0)
+        {
+            rt_cell h = j*S*2 + k;
+
+            if (IEQ(hco1[h], hso1[h]) && IEQ(fco2[j*S + k], fso2[j*S + k])
+            &&  !v_mode)
+            {
+                continue;
+            }
+
+            RT_LOGI("farr[%d] = %e\n",
+                    j*S + k, far0[j*S + k]);
+
+            RT_LOGI("C (fp16)farr[%d] = %04X, (fp32)(fp16)farr[%d] = %e\n",
+                    j*S + k, hco1[h], j*S + k, info->fco2[j*S + k]);
+
+            RT_LOGI("S (fp16)farr[%d] = %04X, (fp32)(fp16)farr[%d] = %e\n",
+                    j*S + k, hso1[h], j*S + k, info->fso2[j*S + k]);
+        }
+    }
+}
+
+#endif /* RUN_LEVEL 18 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 19   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 19
+
+rt_void c_test19(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_cell *iar0 = info->iar0;
+    rt_real *fco1 = info->fco1;
+    rt_cell *ico2 = info->ico2;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = n;
+        while (j-->0)
+        {
+            fco1[j] = far0[iar0[j] & 7];
+            ico2[j] = 0;
+        }
+
+        for (j = 0; j < n; j++)
+        {
+            ico2[iar0[j] & 7] = iar0[j];
+        }
+    }
+}
+
+rt_void s_test19(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        ASM_ENTER(info)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_IAR0)
+        movxa_ld(Rebx, Mebp, inf_FSO1)
+        movxa_ld(Resi, Mebp, inf_ISO2)
+
+        xorpx_rr(Xmm7, Xmm7)
+        movpx_st(Xmm7, Mesi, AJ0)
+        movpx_st(Xmm7, Mesi, AJ1)
+        movpx_st(Xmm7, Mesi, AJ2)
+
+        movpx_ld(Xmm0, Medx, AJ0)
+        movpx_rr(Xmm2, Xmm0)
+        shlpx_ri(Xmm2, IB(29))
+        shrpx_ri(Xmm2, IB(29))
+        gatpx_ld(Xmm1, Xmm2, Mecx, AJ0)
+        scapx_st(Xmm0, Xmm2, Mesi, AJ0)
+        movpx_st(Xmm1, Mebx, AJ0)
+
+        movpx_ld(Xmm0, Medx, AJ1)
+        movpx_rr(Xmm2, Xmm0)
+        shlpx_ri(Xmm2, IB(29))
+        shrpx_ri(Xmm2, IB(29))
+        gatpx_ld(Xmm1, Xmm2, Mecx, AJ0)
+        scapx_st(Xmm0, Xmm2, Mesi, AJ0)
+        movpx_st(Xmm1, Mebx, AJ1)
+
+        movpx_ld(Xmm0, Medx, AJ2)
+        movpx_rr(Xmm2, Xmm0)
+        shlpx_ri(Xmm2, IB(29))
+        shrpx_ri(Xmm2, IB(29))
+        scapx_st(Xmm0, Xmm2, Mesi, AJ0)
+        gatpx_ld(Xmm2, Xmm2, Mecx, AJ0)
+        movpx_st(Xmm2, Mebx, AJ2)
+
+        ASM_LEAVE(info)
+    }
+}
+
+rt_void p_test19(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_cell *iar0 = info->iar0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fso1 = info->fso1;
+    rt_cell *ico2 = info->ico2;
+    rt_cell *iso2 = info->iso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && IEQ(ico2[j], iso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("iarr[%d] = %d, farr[iarr[%d]&7] = %e\n",
+                j, iar0[j], j, far0[iar0[j] & 7]);
+
+        RT_LOGI("C farr[iarr[%d]&7] = %e, iarr[...][%d] = %d\n",
+                j, fco1[j], j, ico2[j]);
+
+        RT_LOGI("S farr[iarr[%d]&7] = %e, iarr[...][%d] = %d\n",
+                j, fso1[j], j, iso2[j]);
+    }
+}
+
+rt_void d_test19(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_cell *iar0 = info->iar0;
+    rt_fp64 *dre1 = info->dre1;
+
+    j = n;
+    while (j-->0)
+    {
+        dre1[j] = (rt_fp64)far0[iar0[j] & 7];
+    }
+}
+
+#endif /* RUN_LEVEL 19 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 20   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 20
+
+rt_void c_test20(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = n / S;
+        while (j-->0)
+        {
+            k = S;
+            while (k-->0)
+            {
+                rt_real a = far0[j*S + k];
+                fco1[j*S + k] = k < j*2 + 1 ? a : 0.0f;
+                fco2[j*S + k] = k < j*2 + 1 ? a + a : a;
+            }
+        }
+    }
+}
+
+rt_void s_test20(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        ASM_ENTER(info)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
+
+        movxx_ri(Reax, IB(1))
+        mskpx_rr(Xmm7, Reax)
+        mmvpx_ld(Xmm0, Xmm7, Mecx, AJ0)
+        movpx_st(Xmm0, Medx, AJ0)
+        movpx_ld(Xmm1, Mecx, AJ0)
+        movpx_st(Xmm1, Mebx, AJ0)
+        addps_rr(Xmm1, Xmm1)
+        mmvpx_st(Xmm1, Xmm7, Mebx, AJ0)
+
+        movxx_ri(Reax, IB(3))
+        mskpx_rr(Xmm7, Reax)
+        mmvpx_ld(Xmm0, Xmm7, Mecx, AJ1)
+        movpx_st(Xmm0, Medx, AJ1)
+        movpx_ld(Xmm1, Mecx, AJ1)
+        movpx_st(Xmm1, Mebx, AJ1)
+        addps_rr(Xmm1, Xmm1)
+        mmvpx_st(Xmm1, Xmm7, Mebx, AJ1)
+
+        movxx_ri(Reax, IB(5))
+        mskpx_rr(Xmm7, Reax)
+        movpx_ld(Xmm1, Mecx, AJ2)
+        movpx_st(Xmm1, Mebx, AJ2)
+        addps_rr(Xmm1, Xmm1)
+        mmvpx_st(Xmm1, Xmm7, Mebx, AJ2)
+        mmvpx_ld(Xmm7, Xmm7, Mecx, AJ2)
+        movpx_st(Xmm7, Medx, AJ2)
+
+        ASM_LEAVE(info)
+    }
+}
+
+rt_void p_test20(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && FEQ(fco2[j], fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("farr[%d] = %e, lane %d of %d active\n",
+                j, far0[j], j % S, (j / S)*2 + 1);
+
+        RT_LOGI("C masked farr[%d] = %e, masked farr[%d]+farr[%d] = %e\n",
+                j, fco1[j], j, j, fco2[j]);
+
+        RT_LOGI("S masked farr[%d] = %e, masked farr[%d]+farr[%d] = %e\n",
+                j, fso1[j], j, j, fso2[j]);
+    }
+}
+
+rt_void d_test20(rt_SIMD_INFOX *info)
+{
+    rt_cell j, k, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_fp64 *dre1 = info->dre1;
+    rt_fp64 *dre2 = info->dre2;
+
+    j = n / S;
+    while (j-->0)
+    {
+        k = S;
+        while (k-->0)
+        {
+            rt_fp64 a = far0[j*S + k];
+            dre1[j*S + k] = k < j*2 + 1 ? a : 0.0;
+            dre2[j*S + k] = k < j*2 + 1 ? a + a : a;
+        }
+    }
+}
+
+#endif /* RUN_LEVEL 20 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 21   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 21
+
+rt_void c_test21(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, n = info->size;
+    rt_cell *iar0 = info->iar0;
+    rt_cell *ico1 = info->ico1;
+    rt_cell *ico2 = info->ico2;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = n;
+        while (j-->0)
+        {
+            ico1[j] = (rt_word)iar0[j] / (rt_word)iar0[(j + S) % n];
+            ico2[j] = iar0[j] % iar0[(j + S) % n];
+        }
+    }
+}
+
+rt_void s_test21(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+
+        label_ld(cy2_beg) /* load to Reax */
+        movxa_st(Reax, Mebp, inf_LABEL)
+
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(cy2_beg)
+
+        movxa_ld(Recx, Mebp, inf_IAR0)
+        movxa_ld(Rebx, Mebp, inf_ISO1)
+        movxa_ld(Resi, Mebp, inf_ISO2)
+        movxx_ld(Redi, Mebp, inf_SIZE)
+
+    LBL(lo2_beg)
+
+        movxx_ld(Reax, Mecx, DP(Q*0x000))
+        movxx_ri(Redx, IB(0))
+        divxx_xm(Mecx, DP(Q*0x010))
+        movxx_st(Reax, Mebx, DP(Q*0x000))
+        movxx_ld(Reax, Mecx, DP(Q*0x000))
+        movxx_ri(Redx, IB(0))
+        remxn_xm(Mecx, DP(Q*0x010))
+        movxx_st(Redx, Mesi, DP(Q*0x000))
+
+        addxx_ri(Recx, IB(4))
+        addxx_ri(Rebx, IB(4))
+        addxx_ri(Resi, IB(4))
+        subxx_ri(Redi, IB(1))
+        cmpxx_ri(Redi, IB(S))
+        jgtxx_lb(lo2_beg)
+
+        movxa_ld(Redi, Mebp, inf_IAR0)
+        movxx_mi(Mebp, inf_SIMD, IB(S))
+
+    LBL(sm2_beg)
+
+        movxx_ld(Reax, Mecx, DP(Q*0x000))
+        movxx_ri(Redx, IB(0))
+        divxx_xm(Medi, DP(Q*0x000))
+        movxx_st(Reax, Mebx, DP(Q*0x000))
+        movxx_ld(Reax, Mecx, DP(Q*0x000))
+        movxx_ri(Redx, IB(0))
+        remxn_xm(Medi, DP(Q*0x000))
+        movxx_st(Redx, Mesi, DP(Q*0x000))
+
+        addxx_ri(Recx, IB(4))
+        addxx_ri(Rebx, IB(4))
+        addxx_ri(Resi, IB(4))
+        addxx_ri(Redi, IB(4))
+        subxx_mi(Mebp, inf_SIMD, IB(1))
+        cmpxx_mi(Mebp, inf_SIMD, IB(0))
+        jgtxx_lb(sm2_beg)
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jeqxx_lb(cy2_end)
+        jmpxx_mm(Mebp, inf_LABEL)
+        jmpxx_lb(cy2_beg) /* the same jump as above */
+
+    LBL(cy2_end)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test21(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_cell *iar0 = info->iar0;
+    rt_cell *ico1 = info->ico1;
+    rt_cell *ico2 = info->ico2;
+    rt_cell *iso1 = info->iso1;
+    rt_cell *iso2 = info->iso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (IEQ(ico1[j], iso1[j]) && IEQ(ico2[j], iso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("iarr[%d] = %d, iarr[%d] = %d\n",
+                j, iar0[j], (j + S) % n, iar0[(j + S) % n]);
+
+        RT_LOGI("C iarr[%d]/iarr[%d] = %d, iarr[%d]%%iarr[%d] = %d\n",
+                j, (j + S) % n, ico1[j], j, (j + S) % n, ico2[j]);
+
+        RT_LOGI("S iarr[%d]/iarr[%d] = %d, iarr[%d]%%iarr[%d] = %d\n",
+                j, (j + S) % n, iso1[j], j, (j + S) % n, iso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 21 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 22   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 22
+
+/*
+ * Array of n / 3 rt_vec3 elements (AoS) is converted to rt_SoA<3> streams
+ * in out1, which are then converted back to AoS in out2, element count
+ * is not a multiple of S to exercise tails and zero padding of streams.
+ */
+rt_void c_test22(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+    rt_SoA<3> soa(info->fco1, info->size / 3);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        soa.from_aos(info->far0);
+        soa.to_aos(info->fco2);
+    }
+}
+
+rt_void s_test22(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+    rt_SoA<3> soa(info->fso1, info->size / 3);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        rt_soa_from_aos3(&soa, info->far0);
+        rt_soa_to_aos3(&soa, info->fso2);
+    }
+}
+
+rt_void p_test22(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size, k = RT_SOA_PAD(n / 3) * 3;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = k;
+    while (j-->0)
+    {
+        if (IEQ(((rt_word *)fco1)[j], ((rt_word *)fso1)[j]) &&
+            (j >= n || IEQ(((rt_word *)fco2)[j], ((rt_word *)fso2)[j]))
+            && !v_mode)
+        {
+            continue;
+        }
+
+        if (j < n)
+        {
+            RT_LOGI("farr[%d] = %e\n",
+                    j, far0[j]);
+
+            RT_LOGI("C soa[%d] = %e, aos[%d] = %e\n",
+                    j, fco1[j], j, fco2[j]);
+
+            RT_LOGI("S soa[%d] = %e, aos[%d] = %e\n",
+                    j, fso1[j], j, fso2[j]);
+        }
+        else
+        {
+            RT_LOGI("C soa[%d] = %e\n",
+                    j, fco1[j]);
+
+            RT_LOGI("S soa[%d] = %e\n",
+                    j, fso1[j]);
+        }
+    }
+}
+
+#endif /* RUN_LEVEL 22 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 23   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 23
+
+/*
+ * Array of n / 4 rt_vec4 elements in rt_SoA<4> streams is transformed
+ * by rt_mat4 fmat (column vectors, v' = M * v) into out1, which is then
+ * normalized into out2, streams are processed in whole SIMD-width blocks.
+ */
+rt_void c_test23(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k;
+    rt_vec4 *m = (rt_vec4 *)info->fmat;
+    rt_SoA<4> vin(info->far0, info->size / 4);
+    rt_SoA<4> vo1(info->fco1, info->size / 4);
+    rt_SoA<4> vo2(info->fco2, info->size / 4);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = vin.pads;
+        while (j-->0)
+        {
+            rt_real v[4], r[4], d;
+
+            for (k = 0; k < 4; k++)
+            {
+                v[k] = vin.stream(k)[j];
+            }
+            for (k = 0; k < 4; k++)
+            {
+                r[k] = m[k][RT_X] * v[RT_X] + m[k][RT_Y] * v[RT_Y] +
+                       m[k][RT_Z] * v[RT_Z] + m[k][RT_W] * v[RT_W];
+                vo1.stream(k)[j] = r[k];
+            }
+
+            d = sqrtf(r[RT_X] * r[RT_X] + r[RT_Y] * r[RT_Y] +
+                      r[RT_Z] * r[RT_Z] + r[RT_W] * r[RT_W]);
+
+            for (k = 0; k < 4; k++)
+            {
+                vo2.stream(k)[j] = r[k] / d;
+            }
+        }
+    }
+}
+
+/*
+ * SIMD offsets within matrix block.
+ */
+#define MJ(e)               DP(Q*0x010*(e))
+
+/*
+ * Out1 row r of matrix in scratch times vector in Xmm0..Xmm3 (Xmm4, Xmm5).
+ */
+#define TRN_ROW(r)                                                          \
+        movpx_ld(Xmm4, Mesi, MJ(r*4+0))                                     \
+        mulps_rr(Xmm4, Xmm0)                                                \
+        movpx_ld(Xmm5, Mesi, MJ(r*4+1))                                     \
+        mulps_rr(Xmm5, Xmm1)                                                \
+        addps_rr(Xmm4, Xmm5)                                                \
+        movpx_ld(Xmm5, Mesi, MJ(r*4+2))                                     \
+        mulps_rr(Xmm5, Xmm2)                                                \
+        addps_rr(Xmm4, Xmm5)                                                \
+        movpx_ld(Xmm5, Mesi, MJ(r*4+3))                                     \
+        mulps_rr(Xmm5, Xmm3)                                                \
+        addps_rr(Xmm4, Xmm5)                                                \
+        movpx_st(Xmm4, Medi, DP(0x000))                                     \
+        addxx_ld(Redi, Mebp, inf_STR)
+
+/*
+ * Broadcast element e of matrix in Recx to all lanes in scratch.
+ */
+#define TRN_SPL(e)                                                          \
+        splpx_ld(Xmm0, Mecx, DP(0x004*e))                                   \
+        movpx_st(Xmm0, Mesi, MJ(e))
+
+rt_void s_test23(rt_SIMD_INFOX *info)
+{
+    rt_SoA<4> vin(info->far0, info->size / 4);
+
+    info->cnt = vin.blocks();
+    info->str = vin.stride();
+
+    ASM_ENTER(info)
+
+        movxa_ld(Recx, Mebp, inf_FMAT)
+        movxa_ld(Resi, Mebp, inf_FSCR)
+
+        TRN_SPL(0x0)
+        TRN_SPL(0x1)
+        TRN_SPL(0x2)
+        TRN_SPL(0x3)
+        TRN_SPL(0x4)
+        TRN_SPL(0x5)
+        TRN_SPL(0x6)
+        TRN_SPL(0x7)
+        TRN_SPL(0x8)
+        TRN_SPL(0x9)
+        TRN_SPL(0xA)
+        TRN_SPL(0xB)
+        TRN_SPL(0xC)
+        TRN_SPL(0xD)
+        TRN_SPL(0xE)
+        TRN_SPL(0xF)
+
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(trn_cyc)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
+        movxx_ld(Reax, Mebp, inf_CNT)
+
+    LBL(trn_blk)
+
+        movxx_rr(Redi, Recx)
+        movpx_ld(Xmm0, Medi, DP(0x000))
+        addxx_ld(Redi, Mebp, inf_STR)
+        movpx_ld(Xmm1, Medi, DP(0x000))
+        addxx_ld(Redi, Mebp, inf_STR)
+        movpx_ld(Xmm2, Medi, DP(0x000))
+        addxx_ld(Redi, Mebp, inf_STR)
+        movpx_ld(Xmm3, Medi, DP(0x000))
+
+        movxx_rr(Redi, Redx)
+        TRN_ROW(0)
+        TRN_ROW(1)
+        TRN_ROW(2)
+        TRN_ROW(3)
+
+        movxx_rr(Redi, Redx)
+        movpx_ld(Xmm0, Medi, DP(0x000))
+        addxx_ld(Redi, Mebp, inf_STR)
+        movpx_ld(Xmm1, Medi, DP(0x000))
+        addxx_ld(Redi, Mebp, inf_STR)
+        movpx_ld(Xmm2, Medi, DP(0x000))
+        addxx_ld(Redi, Mebp, inf_STR)
+        movpx_ld(Xmm3, Medi, DP(0x000))
+
+        movpx_rr(Xmm4, Xmm0)
+        mulps_rr(Xmm4, Xmm0)
+        movpx_rr(Xmm5, Xmm1)
+        mulps_rr(Xmm5, Xmm1)
+        addps_rr(Xmm4, Xmm5)
+        movpx_rr(Xmm5, Xmm2)
+        mulps_rr(Xmm5, Xmm2)
+        addps_rr(Xmm4, Xmm5)
+        movpx_rr(Xmm5, Xmm3)
+        mulps_rr(Xmm5, Xmm3)
+        addps_rr(Xmm4, Xmm5)
+        sqrps_rr(Xmm4, Xmm4)
+        divps_rr(Xmm0, Xmm4)
+        divps_rr(Xmm1, Xmm4)
+        divps_rr(Xmm2, Xmm4)
+        divps_rr(Xmm3, Xmm4)
+
+        movxx_rr(Redi, Rebx)
+        movpx_st(Xmm0, Medi, DP(0x000))
+        addxx_ld(Redi, Mebp, inf_STR)
+        movpx_st(Xmm1, Medi, DP(0x000))
+        addxx_ld(Redi, Mebp, inf_STR)
+        movpx_st(Xmm2, Medi, DP(0x000))
+        addxx_ld(Redi, Mebp, inf_STR)
+        movpx_st(Xmm3, Medi, DP(0x000))
+
+        addxx_ri(Recx, IB(Q*0x010))
+        addxx_ri(Redx, IB(Q*0x010))
+        addxx_ri(Rebx, IB(Q*0x010))
+        subxx_ri(Reax, IB(1))
+        cmpxx_ri(Reax, IB(0))
+        jgtxx_lb(trn_blk)
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jgtxx_lb(trn_cyc)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test23(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && FEQ(fco2[j], fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("farr[%d] = %e\n",
+                j, far0[j]);
+
+        RT_LOGI("C M*v[%d] = %e, |M*v|[%d] = %e\n",
+                j, fco1[j], j, fco2[j]);
+
+        RT_LOGI("S M*v[%d] = %e, |M*v|[%d] = %e\n",
+                j, fso1[j], j, fso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 23 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 24   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 24
+
+/*
+ * Array of n / 16 rt_mat4 elements A in rt_AoSoA<16> blocks is multiplied
+ * by matrices B of the next block (wrapping) into out1 (A * B), transposed
+ * inverse of A (normal matrix) is written to out2, inverse is computed
+ * via 2x2 sub-determinants of row pairs (s0..s5, c0..c5) in this exact order.
+ */
+rt_void mat_mul4(rt_mat4 c, rt_mat4 a, rt_mat4 b)
+{
+    rt_cell i, j;
+
+    for (i = 0; i < 4; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            c[i][j] = a[i][0] * b[0][j] + a[i][1] * b[1][j] +
+                      a[i][2] * b[2][j] + a[i][3] * b[3][j];
+        }
+    }
+}
+
+rt_void mat_inv4(rt_mat4 b, rt_mat4 a)
+{
+    rt_real s[6], c[6], d;
+
+    s[0] = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+    s[1] = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+    s[2] = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+    s[3] = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+    s[4] = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+    s[5] = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+    c[0] = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+    c[1] = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+    c[2] = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+    c[3] = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+    c[4] = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+    c[5] = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+
+    d = s[0] * c[5] - s[1] * c[4] + s[2] * c[3] +
+        s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+    d = 1.0f / d;
+
+    b[0][0] = (a[1][1] * c[5] - a[1][2] * c[4] + a[1][3] * c[3]) * d;
+    b[0][1] = (a[0][2] * c[4] - a[0][1] * c[5] - a[0][3] * c[3]) * d;
+    b[0][2] = (a[3][1] * s[5] - a[3][2] * s[4] + a[3][3] * s[3]) * d;
+    b[0][3] = (a[2][2] * s[4] - a[2][1] * s[5] - a[2][3] * s[3]) * d;
+
+    b[1][0] = (a[1][2] * c[2] - a[1][0] * c[5] - a[1][3] * c[1]) * d;
+    b[1][1] = (a[0][0] * c[5] - a[0][2] * c[2] + a[0][3] * c[1]) * d;
+    b[1][2] = (a[3][2] * s[2] - a[3][0] * s[5] - a[3][3] * s[1]) * d;
+    b[1][3] = (a[2][0] * s[5] - a[2][2] * s[2] + a[2][3] * s[1]) * d;
+
+    b[2][0] = (a[1][0] * c[4] - a[1][1] * c[2] + a[1][3] * c[0]) * d;
+    b[2][1] = (a[0][1] * c[2] - a[0][0] * c[4] - a[0][3] * c[0]) * d;
+    b[2][2] = (a[3][0] * s[4] - a[3][1] * s[2] + a[3][3] * s[0]) * d;
+    b[2][3] = (a[2][1] * s[2] - a[2][0] * s[4] - a[2][3] * s[0]) * d;
+
+    b[3][0] = (a[1][1] * c[1] - a[1][0] * c[3] - a[1][2] * c[0]) * d;
+    b[3][1] = (a[0][0] * c[3] - a[0][1] * c[1] + a[0][2] * c[0]) * d;
+    b[3][2] = (a[3][1] * s[1] - a[3][0] * s[3] - a[3][2] * s[0]) * d;
+    b[3][3] = (a[2][0] * s[3] - a[2][1] * s[1] + a[2][2] * s[0]) * d;
+}
+
+rt_void c_test24(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k;
+    rt_AoSoA<16> ain(info->far0, info->size / 16);
+    rt_AoSoA<16> ao1(info->fco1, info->size / 16);
+    rt_AoSoA<16> ao2(info->fco2, info->size / 16);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = ain.pads;
+        while (j-->0)
+        {
+            rt_mat4 a, b, c, d;
+
+            for (k = 0; k < 16; k++)
+            {
+                a[k / 4][k % 4] = *ain.elem(j, k);
+                b[k / 4][k % 4] = *ain.elem((j + S) % ain.pads, k);
+            }
+
+            mat_mul4(c, a, b);
+            mat_inv4(d, a);
+
+            for (k = 0; k < 16; k++)
+            {
+                *ao1.elem(j, k) = c[k / 4][k % 4];
+                *ao2.elem(j, k) = d[k % 4][k / 4];
+            }
+        }
+    }
+}
+
+/*
+ * Out1 element (r, c) of A in Recx times B in Redx (A row r in Xmm0..Xmm3).
+ */
+#define MUL_ELM(r, c)                                                       \
+        movpx_rr(Xmm4, Xmm0)                                                \
+        mulps_ld(Xmm4, Medx, MJ(0x0+c))                                     \
+        movpx_rr(Xmm5, Xmm1)                                                \
+        mulps_ld(Xmm5, Medx, MJ(0x4+c))                                     \
+        addps_rr(Xmm4, Xmm5)                                                \
+        movpx_rr(Xmm5, Xmm2)                                                \
+        mulps_ld(Xmm5, Medx, MJ(0x8+c))                                     \
+        addps_rr(Xmm4, Xmm5)                                                \
+        movpx_rr(Xmm5, Xmm3)                                                \
+        mulps_ld(Xmm5, Medx, MJ(0xC+c))                                     \
+        addps_rr(Xmm4, Xmm5)                                                \
+        movpx_st(Xmm4, Mebx, MJ(r*4+c))
+
+#define MUL_ROW(r)                                                          \
+        movpx_ld(Xmm0, Mecx, MJ(r*4+0))                                     \
+        movpx_ld(Xmm1, Mecx, MJ(r*4+1))                                     \
+        movpx_ld(Xmm2, Mecx, MJ(r*4+2))                                     \
+        movpx_ld(Xmm3, Mecx, MJ(r*4+3))                                     \
+        MUL_ELM(r, 0)                                                       \
+        MUL_ELM(r, 1)                                                       \
+        MUL_ELM(r, 2)                                                       \
+        MUL_ELM(r, 3)
+
+/*
+ * Scratch k = A[p] * A[q] - A[r] * A[s] (sub-determinant of two rows).
+ */
+#define INV_DET(k, p, q, r, s)                                              \
+        movpx_ld(Xmm0, Mecx, MJ(p))                                         \
+        mulps_ld(Xmm0, Mecx, MJ(q))                                         \
+        movpx_ld(Xmm1, Mecx, MJ(r))                                         \
+        mulps_ld(Xmm1, Mecx, MJ(s))                                         \
+        subps_rr(Xmm0, Xmm1)                                                \
+        movpx_st(Xmm0, Medi, MJ(k))
+
+/*
+ * Out2 element e = ((A[p1] * X[k1] - A[p2] * X[k2]) op A[p3] * X[k3]) / det
+ * with X taken from scratch, 1 / det in Xmm7.
+ */
+#define INV_COF(e, p1, k1, p2, k2, op, p3, k3)                              \
+        movpx_ld(Xmm0, Mecx, MJ(p1))                                        \
+        mulps_ld(Xmm0, Medi, MJ(k1))                                        \
+        movpx_ld(Xmm1, Mecx, MJ(p2))                                        \
+        mulps_ld(Xmm1, Medi, MJ(k2))                                        \
+        subps_rr(Xmm0, Xmm1)                                                \
+        movpx_ld(Xmm1, Mecx, MJ(p3))                                        \
+        mulps_ld(Xmm1, Medi, MJ(k3))                                        \
+        op(Xmm0, Xmm1)                                                      \
+        mulps_rr(Xmm0, Xmm7)                                                \
+        movpx_st(Xmm0, Mesi, MJ(e))
+
+/*
+ * Inverse of A in Recx to Resi via scratch in Redi, element (r, c)
+ * is stored at E(r, c): transposed (INV_TRN) or in place (INV_ROW).
+ */
+#define INV_TRN(r, c)       (c*4+r)
+#define INV_ROW(r, c)       (r*4+c)
+
+#define INV_MAT(E)                                                          \
+        /* s0..s5 from rows 0, 1 and c0..c5 from rows 2, 3 */               \
+        INV_DET(0x0, 0x0, 0x5, 0x4, 0x1)                                    \
+        INV_DET(0x1, 0x0, 0x6, 0x4, 0x2)                                    \
+        INV_DET(0x2, 0x0, 0x7, 0x4, 0x3)                                    \
+        INV_DET(0x3, 0x1, 0x6, 0x5, 0x2)                                    \
+        INV_DET(0x4, 0x1, 0x7, 0x5, 0x3)                                    \
+        INV_DET(0x5, 0x2, 0x7, 0x6, 0x3)                                    \
+        INV_DET(0x6, 0x8, 0xD, 0xC, 0x9)                                    \
+        INV_DET(0x7, 0x8, 0xE, 0xC, 0xA)                                    \
+        INV_DET(0x8, 0x8, 0xF, 0xC, 0xB)                                    \
+        INV_DET(0x9, 0x9, 0xE, 0xD, 0xA)                                    \
+        INV_DET(0xA, 0x9, 0xF, 0xD, 0xB)                                    \
+        INV_DET(0xB, 0xA, 0xF, 0xE, 0xB)                                    \
+        /* det = s0*c5 - s1*c4 + s2*c3 + s3*c2 - s4*c1 + s5*c0 */           \
+        movpx_ld(Xmm0, Medi, MJ(0x0))                                       \
+        mulps_ld(Xmm0, Medi, MJ(0xB))                                       \
+        movpx_ld(Xmm1, Medi, MJ(0x1))                                       \
+        mulps_ld(Xmm1, Medi, MJ(0xA))                                       \
+        subps_rr(Xmm0, Xmm1)                                                \
+        movpx_ld(Xmm1, Medi, MJ(0x2))                                       \
+        mulps_ld(Xmm1, Medi, MJ(0x9))                                       \
+        addps_rr(Xmm0, Xmm1)                                                \
+        movpx_ld(Xmm1, Medi, MJ(0x3))                                       \
+        mulps_ld(Xmm1, Medi, MJ(0x8))                                       \
+        addps_rr(Xmm0, Xmm1)                                                \
+        movpx_ld(Xmm1, Medi, MJ(0x4))                                       \
+        mulps_ld(Xmm1, Medi, MJ(0x7))                                       \
+        subps_rr(Xmm0, Xmm1)                                                \
+        movpx_ld(Xmm1, Medi, MJ(0x5))                                       \
+        mulps_ld(Xmm1, Medi, MJ(0x6))                                       \
+        addps_rr(Xmm0, Xmm1)                                                \
+        movpx_ld(Xmm7, Mebp, inf_GPC01)                                     \
+        divps_rr(Xmm7, Xmm0)                                                \
+        /* cofactors / det, element b[r][c] is stored at E(r, c) */         \
+        INV_COF(E(0, 0), 0x5, 0xB, 0x6, 0xA, addps_rr, 0x7, 0x9)            \
+        INV_COF(E(0, 1), 0x2, 0xA, 0x1, 0xB, subps_rr, 0x3, 0x9)            \
+        INV_COF(E(0, 2), 0xD, 0x5, 0xE, 0x4, addps_rr, 0xF, 0x3)            \
+        INV_COF(E(0, 3), 0xA, 0x4, 0x9, 0x5, subps_rr, 0xB, 0x3)            \
+        INV_COF(E(1, 0), 0x6, 0x8, 0x4, 0xB, subps_rr, 0x7, 0x7)            \
+        INV_COF(E(1, 1), 0x0, 0xB, 0x2, 0x8, addps_rr, 0x3, 0x7)            \
+        INV_COF(E(1, 2), 0xE, 0x2, 0xC, 0x5, subps_rr, 0xF, 0x1)            \
+        INV_COF(E(1, 3), 0x8, 0x5, 0xA, 0x2, addps_rr, 0xB, 0x1)            \
+        INV_COF(E(2, 0), 0x4, 0xA, 0x5, 0x8, addps_rr, 0x7, 0x6)            \
+        INV_COF(E(2, 1), 0x1, 0x8, 0x0, 0xA, subps_rr, 0x3, 0x6)            \
+        INV_COF(E(2, 2), 0xC, 0x4, 0xD, 0x2, addps_rr, 0xF, 0x0)            \
+        INV_COF(E(2, 3), 0x9, 0x2, 0x8, 0x4, subps_rr, 0xB, 0x0)            \
+        INV_COF(E(3, 0), 0x5, 0x7, 0x4, 0x9, subps_rr, 0x6, 0x6)            \
+        INV_COF(E(3, 1), 0x0, 0x9, 0x1, 0x7, addps_rr, 0x2, 0x6)            \
+        INV_COF(E(3, 2), 0xD, 0x1, 0xC, 0x3, subps_rr, 0xE, 0x0)            \
+        INV_COF(E(3, 3), 0x8, 0x3, 0x9, 0x1, addps_rr, 0xA, 0x0)
+
+rt_void s_test24(rt_SIMD_INFOX *info)
+{
+    rt_AoSoA<16> ain(info->far0, info->size / 16);
+
+    info->cnt = ain.blocks();
+
+    ASM_ENTER(info)
+
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(mat_cyc)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Rebx, Mebp, inf_FSO1)
+        movxa_ld(Resi, Mebp, inf_FSO2)
+        movxa_ld(Redi, Mebp, inf_FSCR)
+        movxx_ld(Reax, Mebp, inf_CNT)
+
+    LBL(mat_blk)
+
+        movxx_rr(Redx, Recx)
+        addxx_ri(Redx, IH(Q*0x100))
+        cmpxx_ri(Reax, IB(1))
+        jgtxx_lb(mat_mul)
+        movxa_ld(Redx, Mebp, inf_FAR0)
+
+    LBL(mat_mul)
+
+        MUL_ROW(0)
+        MUL_ROW(1)
+        MUL_ROW(2)
+        MUL_ROW(3)
+
+        INV_MAT(INV_TRN)
+
+        addxx_ri(Recx, IH(Q*0x100))
+        addxx_ri(Rebx, IH(Q*0x100))
+        addxx_ri(Resi, IH(Q*0x100))
+        subxx_ri(Reax, IB(1))
+        cmpxx_ri(Reax, IB(0))
+        jgtxx_lb(mat_blk)
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jgtxx_lb(mat_cyc)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test24(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && FEQ(fco2[j], fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("farr[%d] = %e\n",
+                j, far0[j]);
+
+        RT_LOGI("C A*B[%d] = %e, inv(A)^T[%d] = %e\n",
+                j, fco1[j], j, fco2[j]);
+
+        RT_LOGI("S A*B[%d] = %e, inv(A)^T[%d] = %e\n",
+                j, fso1[j], j, fso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 24 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 25   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 25
+
+/*
+ * Reciprocal as computed by rcpps_rr (estimate refined with one N-R step),
+ * matches REF backend exactly, which has exact estimate.
+ */
+rt_real rcp_ray(rt_real d)
+{
+    rt_real r = 1.0f / d;
+
+    return (r + r) - (d * r) * r;
+}
+
+/*
+ * Array of n / 6 rays (origin, direction) in rt_SoA<6> streams is tested
+ * against NUM_BOX axis-aligned boxes in fbox (min, max) with slab method,
+ * distance to the nearest box is written to out1 (RT_INF if missed),
+ * its index to int out2 (-1 if missed), rays inside a box hit it at 0.
+ */
+rt_void c_test25(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k, b;
+    rt_SoA<6> ray(info->far0, info->size / 6);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = ray.pads;
+        while (j-->0)
+        {
+            rt_real o[3], r[3], t = RT_INF;
+            rt_cell h = -1;
+
+            for (k = 0; k < 3; k++)
+            {
+                o[k] = ray.stream(k)[j];
+                r[k] = rcp_ray(ray.stream(k + 3)[j]);
+            }
+
+            for (b = 0; b < NUM_BOX; b++)
+            {
+                rt_real *box = info->fbox + b * 6, tn = 0.0f, tf = t;
+
+                for (k = 0; k < 3; k++)
+                {
+                    rt_real t1 = (box[k + 0] - o[k]) * r[k];
+                    rt_real t2 = (box[k + 3] - o[k]) * r[k];
+
+                    tn = RT_MAX(tn, RT_MIN(t1, t2));
+                    tf = RT_MIN(tf, RT_MAX(t1, t2));
+                }
+
+                if (tn <= tf)
+                {
+                    t = tn;
+                    h = b;
+                }
+            }
+
+            info->fco1[j] = t;
+            info->ico2[j] = h;
+        }
+    }
+}
+
+/*
+ * Slab of box axis k (box in Resi, ray in Redi), near in Xmm3, far in Xmm4.
+ */
+#define BOX_SLB(k)                                                          \
+        movpx_ld(Xmm0, Mesi, MJ(k))                                         \
+        subps_ld(Xmm0, Medi, MJ(k))                                         \
+        mulps_ld(Xmm0, Medi, MJ(k+3))                                       \
+        movpx_ld(Xmm1, Mesi, MJ(k+3))                                       \
+        subps_ld(Xmm1, Medi, MJ(k))                                         \
+        mulps_ld(Xmm1, Medi, MJ(k+3))                                       \
+        movpx_rr(Xmm2, Xmm0)                                                \
+        minps_rr(Xmm2, Xmm1)                                                \
+        maxps_rr(Xmm0, Xmm1)                                                \
+        maxps_rr(Xmm3, Xmm2)                                                \
+        minps_rr(Xmm4, Xmm0)
+
+rt_void s_test25(rt_SIMD_INFOX *info)
+{
+    rt_SoA<6> ray(info->far0, info->size / 6);
+
+    info->cnt = ray.blocks();
+    info->str = ray.stride();
+
+    ASM_ENTER(info)
+
+        /* splat boxes to scratch: min, max, index (8 vectors per box) */
+        movxa_ld(Recx, Mebp, inf_FBOX)
+        movxa_ld(Resi, Mebp, inf_FSCR)
+        movxx_ri(Reax, IB(NUM_BOX))
+        xorpx_rr(Xmm7, Xmm7)
+        xorpx_rr(Xmm6, Xmm6)
+        movpx_rr(Xmm5, Xmm7)
+        ceqps_rr(Xmm5, Xmm7) /* -1 in all lanes */
+
+    LBL(box_spl)
+
+        TRN_SPL(0)
+        TRN_SPL(1)
+        TRN_SPL(2)
+        TRN_SPL(3)
+        TRN_SPL(4)
+        TRN_SPL(5)
+        movpx_st(Xmm6, Mesi, MJ(6))
+        subpx_rr(Xmm6, Xmm5)
+
+        addxx_ri(Recx, IB(24))
+        addxx_ri(Resi, IH(Q*0x080))
+        subxx_ri(Reax, IB(1))
+        cmpxx_ri(Reax, IB(0))
+        jgtxx_lb(box_spl)
+
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(box_cyc)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_ISO2)
+        movxa_ld(Redi, Mebp, inf_FSCR) /* ray packet follows boxes */
+        addxx_ri(Redi, IH(NUM_BOX*Q*0x080))
+        movxx_ld(Reax, Mebp, inf_CNT)
+        movxx_st(Reax, Mebp, inf_PKT)
+
+    LBL(box_pkt)
+
+        /* S rays to scratch: origin, inverse direction */
+        movxx_rr(Resi, Recx)
+        movpx_ld(Xmm0, Mesi, DP(0x000))
+        movpx_st(Xmm0, Medi, MJ(0))
+        addxx_ld(Resi, Mebp, inf_STR)
+        movpx_ld(Xmm0, Mesi, DP(0x000))
+        movpx_st(Xmm0, Medi, MJ(1))
+        addxx_ld(Resi, Mebp, inf_STR)
+        movpx_ld(Xmm0, Mesi, DP(0x000))
+        movpx_st(Xmm0, Medi, MJ(2))
+        addxx_ld(Resi, Mebp, inf_STR)
+        movpx_ld(Xmm1, Mesi, DP(0x000))
+        rcpps_rr(Xmm0, Xmm1) /* destroys Xmm1 */
+        movpx_st(Xmm0, Medi, MJ(3))
+        addxx_ld(Resi, Mebp, inf_STR)
+        movpx_ld(Xmm1, Mesi, DP(0x000))
+        rcpps_rr(Xmm0, Xmm1) /* destroys Xmm1 */
+        movpx_st(Xmm0, Medi, MJ(4))
+        addxx_ld(Resi, Mebp, inf_STR)
+        movpx_ld(Xmm1, Mesi, DP(0x000))
+        rcpps_rr(Xmm0, Xmm1) /* destroys Xmm1 */
+        movpx_st(Xmm0, Medi, MJ(5))
+
+        /* nearest distance in Xmm6, index in Xmm7 */
+        movpx_ld(Xmm6, Mebp, inf_GPC06)
+        addpx_rr(Xmm6, Xmm5) /* RT_INF */
+        movpx_rr(Xmm7, Xmm5)
+        movxa_ld(Resi, Mebp, inf_FSCR)
+
+    LBL(box_blk)
+
+        xorpx_rr(Xmm3, Xmm3)
+        movpx_rr(Xmm4, Xmm6)
+        BOX_SLB(0)
+        BOX_SLB(1)
+        BOX_SLB(2)
+        movpx_rr(Xmm0, Xmm3)
+        cleps_rr(Xmm0, Xmm4)
+        CHECK_MASK(box_nxt, NONE, Xmm0)
+
+        andpx_rr(Xmm3, Xmm0)
+        movpx_rr(Xmm1, Xmm0)
+        annpx_rr(Xmm1, Xmm6)
+        orrpx_rr(Xmm3, Xmm1)
+        movpx_rr(Xmm6, Xmm3)
+        movpx_ld(Xmm2, Mesi, MJ(6))
+        andpx_rr(Xmm2, Xmm0)
+        annpx_rr(Xmm0, Xmm7)
+        orrpx_rr(Xmm0, Xmm2)
+        movpx_rr(Xmm7, Xmm0)
+
+    LBL(box_nxt)
+
+        addxx_ri(Resi, IH(Q*0x080))
+        cmpxx_rr(Resi, Redi)
+        jltxx_lb(box_blk)
+
+        movpx_st(Xmm6, Medx, DP(0x000))
+        movpx_st(Xmm7, Mebx, DP(0x000))
+
+        addxx_ri(Recx, IB(Q*0x010))
+        addxx_ri(Redx, IB(Q*0x010))
+        addxx_ri(Rebx, IB(Q*0x010))
+        subxx_mi(Mebp, inf_PKT, IB(1))
+        cmpxx_mi(Mebp, inf_PKT, IB(0))
+        jgtxx_lb(box_pkt)
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jgtxx_lb(box_cyc)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test25(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size / 6;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_cell *ico2 = info->ico2;
+    rt_real *fso1 = info->fso1;
+    rt_cell *iso2 = info->iso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && IEQ(ico2[j], iso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("org[%d] = {%e, %e, %e}\n",
+                j, far0[j + n * 0], far0[j + n * 1], far0[j + n * 2]);
+
+        RT_LOGI("dir[%d] = {%e, %e, %e}\n",
+                j, far0[j + n * 3], far0[j + n * 4], far0[j + n * 5]);
+
+        RT_LOGI("C t[%d] = %e, box[%d] = %d\n",
+                j, fco1[j], j, ico2[j]);
+
+        RT_LOGI("S t[%d] = %e, box[%d] = %d\n",
+                j, fso1[j], j, iso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 25 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 26   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 26
+
+/*
+ * Array of n / 6 rays (origin, direction) in rt_SoA<6> streams is tested
+ * against NUM_TRI triangles in ftri (v0, v1, v2) with Moller-Trumbore method,
+ * distance to the nearest triangle is written to out1 (RT_INF if missed),
+ * its index to int out2 (-1 if missed), parallel rays miss via NaN 1 / det.
+ */
+rt_void c_test26(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k, b;
+    rt_SoA<6> ray(info->far0, info->size / 6);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = ray.pads;
+        while (j-->0)
+        {
+            rt_real o[3], d[3], t = RT_INF;
+            rt_cell h = -1;
+
+            for (k = 0; k < 3; k++)
+            {
+                o[k] = ray.stream(k + 0)[j];
+                d[k] = ray.stream(k + 3)[j];
+            }
+
+            for (b = 0; b < NUM_TRI; b++)
+            {
+                rt_real *w = info->ftri + b * 9;
+                rt_real e1[3], e2[3], s[3], p[3], q[3], r, u, v, x;
+
+                for (k = 0; k < 3; k++)
+                {
+                    e1[k] = w[k + 3] - w[k];
+                    e2[k] = w[k + 6] - w[k];
+                    s[k]  = o[k] - w[k];
+                }
+
+                p[0] = d[1] * e2[2] - d[2] * e2[1];
+                p[1] = d[2] * e2[0] - d[0] * e2[2];
+                p[2] = d[0] * e2[1] - d[1] * e2[0];
+
+                r = rcp_ray(e1[0] * p[0] + e1[1] * p[1] + e1[2] * p[2]);
+                u = (s[0] * p[0] + s[1] * p[1] + s[2] * p[2]) * r;
+
+                q[0] = s[1] * e1[2] - s[2] * e1[1];
+                q[1] = s[2] * e1[0] - s[0] * e1[2];
+                q[2] = s[0] * e1[1] - s[1] * e1[0];
+
+                v = (d[0] * q[0] + d[1] * q[1] + d[2] * q[2]) * r;
+                x = (e2[0] * q[0] + e2[1] * q[1] + e2[2] * q[2]) * r;
+
+                if (u >= 0.0f && v >= 0.0f && u + v <= 1.0f
+                &&  x > 0.0f && x < t)
+                {
+                    t = x;
+                    h = b;
+                }
+            }
+
+            info->fco1[j] = t;
+            info->ico2[j] = h;
+        }
+    }
+}
+
+/*
+ * Splat axis k of triangle in Recx to scratch in Resi: v0, e1, e2.
+ */
+#define TRI_SPL(k)                                                          \
+        splpx_ld(Xmm0, Mecx, DP(0x004*k+0x000))                             \
+        splpx_ld(Xmm1, Mecx, DP(0x004*k+0x00C))                             \
+        splpx_ld(Xmm2, Mecx, DP(0x004*k+0x018))                             \
+        subps_rr(Xmm1, Xmm0)                                                \
+        subps_rr(Xmm2, Xmm0)                                                \
+        movpx_st(Xmm0, Mesi, MJ(k+0))                                       \
+        movpx_st(Xmm1, Mesi, MJ(k+3))                                       \
+        movpx_st(Xmm2, Mesi, MJ(k+6))
+
+/*
+ * Cross product component Xmm(r) = R[a] * T[b] - R[c] * T[d] (Xmm6),
+ * R is ray scratch in Redi, T is triangle scratch in Resi.
+ */
+#define TRI_CRS(r, a, b, c, d)                                              \
+        movpx_ld(Xmm##r, Medi, MJ(a))                                       \
+        mulps_ld(Xmm##r, Mesi, MJ(b))                                       \
+        movpx_ld(Xmm6, Medi, MJ(c))                                         \
+        mulps_ld(Xmm6, Mesi, MJ(d))                                         \
+        subps_rr(Xmm##r, Xmm6)
+
+/*
+ * Edge to ray origin component k to R[k+6], Xmm5 = s[k] * Xmm(k).
+ */
+#define TRI_ORG(k)                                                          \
+        movpx_ld(Xmm5, Medi, MJ(k))                                         \
+        subps_ld(Xmm5, Mesi, MJ(k))                                         \
+        movpx_st(Xmm5, Medi, MJ(k+6))                                       \
+        mulps_rr(Xmm5, Xmm##k)
+
+rt_void s_test26(rt_SIMD_INFOX *info)
+{
+    rt_SoA<6> ray(info->far0, info->size / 6);
+
+    info->cnt = ray.blocks();
+    info->str = ray.stride();
+
+    ASM_ENTER(info)
+
+        /* splat triangles to scratch: v0, e1, e2, index (12 vectors each) */
+        movxa_ld(Recx, Mebp, inf_FTRI)
+        movxa_ld(Resi, Mebp, inf_FSCR)
+        movxx_ri(Reax, IB(NUM_TRI))
+        xorpx_rr(Xmm7, Xmm7)
+        xorpx_rr(Xmm6, Xmm6)
+        movpx_rr(Xmm5, Xmm7)
+        ceqps_rr(Xmm5, Xmm7) /* -1 in all lanes */
+
+    LBL(tri_spl)
+
+        TRI_SPL(0)
+        TRI_SPL(1)
+        TRI_SPL(2)
+        movpx_st(Xmm6, Mesi, MJ(9))
+        subpx_rr(Xmm6, Xmm5)
+
+        addxx_ri(Recx, IB(36))
+        addxx_ri(Resi, IH(Q*0x0C0))
+        subxx_ri(Reax, IB(1))
+        cmpxx_ri(Reax, IB(0))
+        jgtxx_lb(tri_spl)
+
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(tri_cyc)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_ISO2)
+        movxa_ld(Redi, Mebp, inf_FSCR) /* ray packet follows triangles */
+        addxx_ri(Redi, IH(NUM_TRI*Q*0x0C0))
+        movxx_ld(Reax, Mebp, inf_CNT)
+        movxx_st(Reax, Mebp, inf_PKT)
+
+    LBL(tri_pkt)
+
+        /* S rays to scratch: origin, direction */
+        movxx_rr(Resi, Recx)
+        movpx_ld(Xmm0, Mesi, DP(0x000))
+        movpx_st(Xmm0, Medi, MJ(0))
+        addxx_ld(Resi, Mebp, inf_STR)
+        movpx_ld(Xmm0, Mesi, DP(0x000))
+        movpx_st(Xmm0, Medi, MJ(1))
+        addxx_ld(Resi, Mebp, inf_STR)
+        movpx_ld(Xmm0, Mesi, DP(0x000))
+        movpx_st(Xmm0, Medi, MJ(2))
+        addxx_ld(Resi, Mebp, inf_STR)
+        movpx_ld(Xmm0, Mesi, DP(0x000))
+        movpx_st(Xmm0, Medi, MJ(3))
+        addxx_ld(Resi, Mebp, inf_STR)
+        movpx_ld(Xmm0, Mesi, DP(0x000))
+        movpx_st(Xmm0, Medi, MJ(4))
+        addxx_ld(Resi, Mebp, inf_STR)
+        movpx_ld(Xmm0, Mesi, DP(0x000))
+        movpx_st(Xmm0, Medi, MJ(5))
+
+        /* nearest distance in out1, index in out2 */
+        movpx_rr(Xmm0, Xmm7)
+        ceqps_rr(Xmm0, Xmm7)
+        movpx_st(Xmm0, Mebx, DP(0x000))
+        movpx_ld(Xmm1, Mebp, inf_GPC06)
+        addpx_rr(Xmm1, Xmm0) /* RT_INF */
+        movpx_st(Xmm1, Medx, DP(0x000))
+        movxa_ld(Resi, Mebp, inf_FSCR)
+
+    LBL(tri_blk)
+
+        /* p = d x e2 */
+        TRI_CRS(0, 4, 8, 5, 7)
+        TRI_CRS(1, 5, 6, 3, 8)
+        TRI_CRS(2, 3, 7, 4, 6)
+
+        /* 1 / det = 1 / (e1 . p) in Xmm3 */
+        movpx_ld(Xmm4, Mesi, MJ(3))
+        mulps_rr(Xmm4, Xmm0)
+        movpx_ld(Xmm6, Mesi, MJ(4))
+        mulps_rr(Xmm6, Xmm1)
+        addps_rr(Xmm4, Xmm6)
+        movpx_ld(Xmm6, Mesi, MJ(5))
+        mulps_rr(Xmm6, Xmm2)
+        addps_rr(Xmm4, Xmm6)
+        rcpps_rr(Xmm3, Xmm4) /* destroys Xmm4 */
+
+        /* u = (s . p) / det in Xmm4, s = o - v0 */
+        TRI_ORG(0)
+        movpx_rr(Xmm4, Xmm5)
+        TRI_ORG(1)
+        addps_rr(Xmm4, Xmm5)
+        TRI_ORG(2)
+        addps_rr(Xmm4, Xmm5)
+        mulps_rr(Xmm4, Xmm3)
+
+        /* q = s x e1 */
+        TRI_CRS(0, 7, 5, 8, 4)
+        TRI_CRS(1, 8, 3, 6, 5)
+        TRI_CRS(2, 6, 4, 7, 3)
+
+        /* v = (d . q) / det in Xmm5 */
+        movpx_ld(Xmm5, Medi, MJ(3))
+        mulps_rr(Xmm5, Xmm0)
+        movpx_ld(Xmm6, Medi, MJ(4))
+        mulps_rr(Xmm6, Xmm1)
+        addps_rr(Xmm5, Xmm6)
+        movpx_ld(Xmm6, Medi, MJ(5))
+        mulps_rr(Xmm6, Xmm2)
+        addps_rr(Xmm5, Xmm6)
+        mulps_rr(Xmm5, Xmm3)
+
+        /* t = (e2 . q) / det in Xmm0 */
+        mulps_ld(Xmm0, Mesi, MJ(6))
+        mulps_ld(Xmm1, Mesi, MJ(7))
+        addps_rr(Xmm0, Xmm1)
+        mulps_ld(Xmm2, Mesi, MJ(8))
+        addps_rr(Xmm0, Xmm2)
+        mulps_rr(Xmm0, Xmm3)
+
+        /* u >= 0, v >= 0, u + v <= 1, 0 < t < nearest */
+        movpx_rr(Xmm1, Xmm4)
+        cgeps_rr(Xmm1, Xmm7)
+        movpx_rr(Xmm2, Xmm5)
+        cgeps_rr(Xmm2, Xmm7)
+        andpx_rr(Xmm1, Xmm2)
+        addps_rr(Xmm4, Xmm5)
+        cleps_ld(Xmm4, Mebp, inf_GPC01)
+        andpx_rr(Xmm1, Xmm4)
+        movpx_rr(Xmm2, Xmm0)
+        cgtps_rr(Xmm2, Xmm7)
+        andpx_rr(Xmm1, Xmm2)
+        movpx_rr(Xmm2, Xmm0)
+        cltps_ld(Xmm2, Medx, DP(0x000))
+        andpx_rr(Xmm1, Xmm2)
+        CHECK_MASK(tri_nxt, NONE, Xmm1)
+
+        andpx_rr(Xmm0, Xmm1)
+        movpx_rr(Xmm2, Xmm1)
+        annpx_ld(Xmm2, Medx, DP(0x000))
+        orrpx_rr(Xmm0, Xmm2)
+        movpx_st(Xmm0, Medx, DP(0x000))
+        movpx_ld(Xmm0, Mesi, MJ(9))
+        andpx_rr(Xmm0, Xmm1)
+        annpx_ld(Xmm1, Mebx, DP(0x000))
+        orrpx_rr(Xmm0, Xmm1)
+        movpx_st(Xmm0, Mebx, DP(0x000))
+
+    LBL(tri_nxt)
+
+        addxx_ri(Resi, IH(Q*0x0C0))
+        cmpxx_rr(Resi, Redi)
+        jltxx_lb(tri_blk)
+
+        addxx_ri(Recx, IB(Q*0x010))
+        addxx_ri(Redx, IB(Q*0x010))
+        addxx_ri(Rebx, IB(Q*0x010))
+        subxx_mi(Mebp, inf_PKT, IB(1))
+        cmpxx_mi(Mebp, inf_PKT, IB(0))
+        jgtxx_lb(tri_pkt)
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jgtxx_lb(tri_cyc)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test26(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size / 6;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_cell *ico2 = info->ico2;
+    rt_real *fso1 = info->fso1;
+    rt_cell *iso2 = info->iso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && IEQ(ico2[j], iso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("org[%d] = {%e, %e, %e}\n",
+                j, far0[j + n * 0], far0[j + n * 1], far0[j + n * 2]);
+
+        RT_LOGI("dir[%d] = {%e, %e, %e}\n",
+                j, far0[j + n * 3], far0[j + n * 4], far0[j + n * 5]);
+
+        RT_LOGI("C t[%d] = %e, tri[%d] = %d\n",
+                j, fco1[j], j, ico2[j]);
+
+        RT_LOGI("S t[%d] = %e, tri[%d] = %d\n",
+                j, fso1[j], j, iso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 26 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 27   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 27
+
+/*
+ * Vectors x (n elements in far0) and y (n elements next to x at RT_SOA_PAD(n))
+ * are combined into saxpy alpha * x + y in out1 and sscal alpha * x in out2,
+ * n is not a multiple of S, tail is processed with masked loads/stores.
+ */
+rt_void c_test27(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, n = info->size;
+    rt_real *x = info->far0, *y = info->far0 + RT_SOA_PAD(n);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = n;
+        while (j-->0)
+        {
+            info->fco2[j] = x[j] * info->alpha;
+            info->fco1[j] = x[j] * info->alpha + y[j];
+        }
+    }
+}
+
+rt_void s_test27(rt_SIMD_INFOX *info)
+{
+    info->cnt = info->size;
+    info->str = RT_SOA_PAD(info->size) * sizeof(rt_real);
+
+    ASM_ENTER(info)
+
+        splpx_ld(Xmm7, Mebp, inf_ALPHA)
+
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(axp_cyc)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxx_rr(Redx, Recx)
+        addxx_ld(Redx, Mebp, inf_STR)
+        movxa_ld(Resi, Mebp, inf_FSO1)
+        movxa_ld(Redi, Mebp, inf_FSO2)
+        movxx_ld(Reax, Mebp, inf_CNT)
+        cmpxx_ri(Reax, IB(S))
+        jltxx_lb(axp_tl1)
+
+    LBL(axp_blk)
+
+        movpx_ld(Xmm0, Mecx, DP(0x000))
+        mulps_rr(Xmm0, Xmm7)
+        movpx_st(Xmm0, Medi, DP(0x000))
+        addps_ld(Xmm0, Medx, DP(0x000))
+        movpx_st(Xmm0, Mesi, DP(0x000))
+
+        addxx_ri(Recx, IB(Q*0x010))
+        addxx_ri(Redx, IB(Q*0x010))
+        addxx_ri(Resi, IB(Q*0x010))
+        addxx_ri(Redi, IB(Q*0x010))
+        subxx_ri(Reax, IB(S))
+        cmpxx_ri(Reax, IB(S))
+        jgexx_lb(axp_blk)
+
+    LBL(axp_tl1)
+
+        cmpxx_ri(Reax, IB(0))
+        jeqxx_lb(axp_end)
+
+        mskpx_rr(Xmm5, Reax)
+        mmvpx_ld(Xmm0, Xmm5, Mecx, DP(0x000))
+        mulps_rr(Xmm0, Xmm7)
+        mmvpx_st(Xmm0, Xmm5, Medi, DP(0x000))
+        mmvpx_ld(Xmm1, Xmm5, Medx, DP(0x000))
+        addps_rr(Xmm0, Xmm1)
+        mmvpx_st(Xmm0, Xmm5, Mesi, DP(0x000))
+
+    LBL(axp_end)
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jgtxx_lb(axp_cyc)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test27(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && FEQ(fco2[j], fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("x[%d] = %e, y[%d] = %e\n",
+                j, far0[j], j, far0[j + RT_SOA_PAD(n)]);
+
+        RT_LOGI("C saxpy[%d] = %e, sscal[%d] = %e\n",
+                j, fco1[j], j, fco2[j]);
+
+        RT_LOGI("S saxpy[%d] = %e, sscal[%d] = %e\n",
+                j, fso1[j], j, fso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 27 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 28   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 28
+
+/*
+ * Horizontal sum of S lanes of v in place, as done by HSUM below
+ * (lanes i + k are added to lanes i < k for k = S/2, .. 2, 1),
+ * all lanes get the total.
+ */
+rt_void hsum_ref(rt_real *v)
+{
+    rt_cell i, k;
+
+    for (k = RT_SIMD_WIDTH / 2; k > 0; k /= 2)
+    {
+        for (i = 0; i < k; i++)
+        {
+            v[i] = v[i] + v[i + k];
+        }
+    }
+    for (i = 1; i < RT_SIMD_WIDTH; i++)
+    {
+        v[i] = v[0];
+    }
+}
+
+/*
+ * Horizontal sum step: upper lanes of Xmm0 shifted down by k are added
+ * with op, destroys Xmm1.
+ */
+#define HSUM_STP(op, k)                                                     \
+        movpx_rr(Xmm1, Xmm0)                                                \
+        srnpx_ri(Xmm1, IB(k))                                               \
+        op##_rr(Xmm0, Xmm1)
+
+/*
+ * Horizontal sum of Xmm0 to all lanes with op (addps or addpx),
+ * steps for k = S/2, .. 2, 1 leave the total in lane 0, which is then
+ * broadcast, destroys Xmm1.
+ */
+#if   RT_SIMD_WIDTH == 4
+#define HSUM(op)                                                            \
+        HSUM_STP(op, 2)                                                     \
+        HSUM_STP(op, 1)                                                     \
+        splpx_ri(Xmm0, IB(0))
+#elif RT_SIMD_WIDTH == 8
+#define HSUM(op)                                                            \
+        HSUM_STP(op, 4)                                                     \
+        HSUM_STP(op, 2)                                                     \
+        HSUM_STP(op, 1)                                                     \
+        splpx_ri(Xmm0, IB(0))
+#endif /* RT_SIMD_WIDTH */
+
+/*
+ * Vectors x (n elements in far0) and y (n elements next to x at RT_SOA_PAD(n))
+ * are reduced to sdot x . y in out1 and snrm2 |x| in out2 (S equal lanes),
+ * products are accumulated per lane, then summed horizontally.
+ * Snrm2 takes plain square root of the sum (no scaling against overflow).
+ */
+rt_void c_test28(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k, n = info->size;
+    rt_real *x = info->far0, *y = info->far0 + RT_SOA_PAD(n);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        rt_real d[RT_SIMD_WIDTH], r[RT_SIMD_WIDTH];
+
+        for (k = 0; k < RT_SIMD_WIDTH; k++)
+        {
+            d[k] = 0.0f;
+            r[k] = 0.0f;
+        }
+
+        for (j = 0; j < RT_SOA_PAD(n); j++)
+        {
+            rt_real a = j < n ? x[j] : 0.0f, b = j < n ? y[j] : 0.0f;
+
+            d[j % RT_SIMD_WIDTH] += a * b;
+            r[j % RT_SIMD_WIDTH] += a * a;
+        }
+
+        hsum_ref(d);
+        hsum_ref(r);
+
+        for (k = 0; k < RT_SIMD_WIDTH; k++)
+        {
+            info->fco1[k] = d[k];
+            info->fco2[k] = sqrtf(r[k]);
+        }
+    }
+}
+
+rt_void s_test28(rt_SIMD_INFOX *info)
+{
+    info->cnt = info->size;
+    info->str = RT_SOA_PAD(info->size) * sizeof(rt_real);
+
+    ASM_ENTER(info)
+
+        movxa_ld(Redi, Mebp, inf_FSCR)
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(dot_cyc)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxx_rr(Redx, Recx)
+        addxx_ld(Redx, Mebp, inf_STR)
+        xorpx_rr(Xmm6, Xmm6)
+        xorpx_rr(Xmm7, Xmm7)
+        movxx_ld(Reax, Mebp, inf_CNT)
+        cmpxx_ri(Reax, IB(S))
+        jltxx_lb(dot_tl1)
+
+    LBL(dot_blk)
+
+        movpx_ld(Xmm0, Mecx, DP(0x000))
+        movpx_rr(Xmm1, Xmm0)
+        mulps_ld(Xmm0, Medx, DP(0x000))
+        addps_rr(Xmm6, Xmm0)
+        mulps_rr(Xmm1, Xmm1)
+        addps_rr(Xmm7, Xmm1)
+
+        addxx_ri(Recx, IB(Q*0x010))
+        addxx_ri(Redx, IB(Q*0x010))
+        subxx_ri(Reax, IB(S))
+        cmpxx_ri(Reax, IB(S))
+        jgexx_lb(dot_blk)
+
+    LBL(dot_tl1)
+
+        cmpxx_ri(Reax, IB(0))
+        jeqxx_lb(dot_sum)
+
+        mskpx_rr(Xmm5, Reax)
+        mmvpx_ld(Xmm0, Xmm5, Mecx, DP(0x000))
+        mmvpx_ld(Xmm2, Xmm5, Medx, DP(0x000))
+        movpx_rr(Xmm1, Xmm0)
+        mulps_rr(Xmm0, Xmm2)
+        addps_rr(Xmm6, Xmm0)
+        mulps_rr(Xmm1, Xmm1)
+        addps_rr(Xmm7, Xmm1)
+
+    LBL(dot_sum)
+
+        movpx_rr(Xmm0, Xmm6)
+        HSUM(addps)
+        movxa_ld(Resi, Mebp, inf_FSO1)
+        movpx_st(Xmm0, Mesi, DP(0x000))
+
+        movpx_rr(Xmm0, Xmm7)
+        HSUM(addps)
+        sqrps_rr(Xmm0, Xmm0)
+        movxa_ld(Resi, Mebp, inf_FSO2)
+        movpx_st(Xmm0, Mesi, DP(0x000))
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jgtxx_lb(dot_cyc)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test28(rt_SIMD_INFOX *info)
+{
+    rt_cell j;
+
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = RT_SIMD_WIDTH;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && FEQ(fco2[j], fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("C sdot[%d] = %e, snrm2[%d] = %e\n",
+                j, fco1[j], j, fco2[j]);
+
+        RT_LOGI("S sdot[%d] = %e, snrm2[%d] = %e\n",
+                j, fso1[j], j, fso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 28 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 29   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 29
+
+/* columns (and rows) of square matrix A, which fits in size elements
+ * along with x and x2 as every row is padded to RT_SOA_PAD(cols) */
+#define GMV_COLS(size)      ((rt_cell)sqrt((rt_fp64)(size)) - RT_SIMD_WIDTH)
+
+/*
+ * Vector x (far0), vector x2 (next to x) and matrix A (n x n, row-major,
+ * next to x2) with all three padded to lda = RT_SOA_PAD(n) are multiplied
+ * as sgemv y = A * x to out1 (per row dot products) and as sgemv (trans)
+ * y2 = A^T * x2 to out2 (saxpy of rows of A with broadcast x2[i]).
+ */
+rt_void c_test29(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k, n = GMV_COLS(info->size), lda = RT_SOA_PAD(n);
+    rt_real *x = info->far0, *x2 = x + lda, *a = x2 + lda;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        for (k = 0; k < n; k++)
+        {
+            rt_real d[RT_SIMD_WIDTH];
+
+            for (j = 0; j < RT_SIMD_WIDTH; j++)
+            {
+                d[j] = 0.0f;
+            }
+
+            for (j = 0; j < lda; j++)
+            {
+                d[j % RT_SIMD_WIDTH] += j < n ? a[k * lda + j] * x[j] : 0.0f;
+            }
+
+            hsum_ref(d);
+
+            info->fco1[k] = d[0];
+        }
+
+        for (j = 0; j < n; j++)
+        {
+            info->fco2[j] = 0.0f;
+        }
+
+        for (k = 0; k < n; k++)
+        {
+            for (j = 0; j < n; j++)
+            {
+                info->fco2[j] += a[k * lda + j] * x2[k];
+            }
+        }
+    }
+}
+
+rt_void s_test29(rt_SIMD_INFOX *info)
+{
+    info->cnt = GMV_COLS(info->size);
+    info->str = RT_SOA_PAD(info->cnt) * sizeof(rt_real);
+
+    ASM_ENTER(info)
+
+        movxa_ld(Redi, Mebp, inf_FSCR)
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(gmv_cyc)
+
+        /* y = A * x, row by row */
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        addxx_ld(Recx, Mebp, inf_STR)
+        addxx_ld(Recx, Mebp, inf_STR)
+        movxa_ld(Rebx, Mebp, inf_FSO1)
+        movxx_ld(Reax, Mebp, inf_CNT)
+        movxx_st(Reax, Mebp, inf_PKT)
+
+    LBL(gmv_row)
+
+        movxx_rr(Resi, Recx)
+        movxa_ld(Redx, Mebp, inf_FAR0)
+        xorpx_rr(Xmm6, Xmm6)
+        movxx_ld(Reax, Mebp, inf_CNT)
+        cmpxx_ri(Reax, IB(S))
+        jltxx_lb(gmv_tl1)
+
+    LBL(gmv_blk)
+
+        movpx_ld(Xmm0, Mesi, DP(0x000))
+        mulps_ld(Xmm0, Medx, DP(0x000))
+        addps_rr(Xmm6, Xmm0)
+
+        addxx_ri(Resi, IB(Q*0x010))
+        addxx_ri(Redx, IB(Q*0x010))
+        subxx_ri(Reax, IB(S))
+        cmpxx_ri(Reax, IB(S))
+        jgexx_lb(gmv_blk)
+
+    LBL(gmv_tl1)
+
+        cmpxx_ri(Reax, IB(0))
+        jeqxx_lb(gmv_sum)
+
+        mskpx_rr(Xmm5, Reax)
+        mmvpx_ld(Xmm0, Xmm5, Mesi, DP(0x000))
+        mmvpx_ld(Xmm1, Xmm5, Medx, DP(0x000))
+        mulps_rr(Xmm0, Xmm1)
+        addps_rr(Xmm6, Xmm0)
+
+    LBL(gmv_sum)
+
+        movpx_rr(Xmm0, Xmm6)
+        HSUM(addps)
+        movpx_st(Xmm0, Medi, DP(0x000))
+        movxx_ld(Reax, Medi, DP(0x000))
+        movxx_st(Reax, Mebx, DP(0x000))
+
+        addxx_ld(Recx, Mebp, inf_STR)
+        addxx_ri(Rebx, IB(4))
+        subxx_mi(Mebp, inf_PKT, IB(1))
+        cmpxx_mi(Mebp, inf_PKT, IB(0))
+        jgtxx_lb(gmv_row)
+
+        /* y2 = A^T * x2, zero y2 first */
+        movxa_ld(Rebx, Mebp, inf_FSO2)
+        xorpx_rr(Xmm6, Xmm6)
+        movxx_ld(Reax, Mebp, inf_CNT)
+        cmpxx_ri(Reax, IB(S))
+        jltxx_lb(gmt_tl0)
+
+    LBL(gmt_zro)
+
+        movpx_st(Xmm6, Mebx, DP(0x000))
+        addxx_ri(Rebx, IB(Q*0x010))
+        subxx_ri(Reax, IB(S))
+        cmpxx_ri(Reax, IB(S))
+        jgexx_lb(gmt_zro)
+
+    LBL(gmt_tl0)
+
+        cmpxx_ri(Reax, IB(0))
+        jeqxx_lb(gmt_beg)
+
+        mskpx_rr(Xmm5, Reax)
+        mmvpx_st(Xmm6, Xmm5, Mebx, DP(0x000))
+
+    LBL(gmt_beg)
+
+        movxa_ld(Redx, Mebp, inf_FAR0)
+        addxx_ld(Redx, Mebp, inf_STR)
+        movxx_rr(Recx, Redx)
+        addxx_ld(Recx, Mebp, inf_STR)
+        movxx_ld(Reax, Mebp, inf_CNT)
+        movxx_st(Reax, Mebp, inf_PKT)
+
+    LBL(gmt_row)
+
+        splpx_ld(Xmm7, Medx, DP(0x000)) /* x2[i] in all lanes */
+        movxx_rr(Resi, Recx)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
+        movxx_ld(Reax, Mebp, inf_CNT)
+        cmpxx_ri(Reax, IB(S))
+        jltxx_lb(gmt_tl1)
+
+    LBL(gmt_blk)
+
+        movpx_ld(Xmm0, Mesi, DP(0x000))
+        mulps_rr(Xmm0, Xmm7)
+        addps_ld(Xmm0, Mebx, DP(0x000))
+        movpx_st(Xmm0, Mebx, DP(0x000))
+
+        addxx_ri(Resi, IB(Q*0x010))
+        addxx_ri(Rebx, IB(Q*0x010))
+        subxx_ri(Reax, IB(S))
+        cmpxx_ri(Reax, IB(S))
+        jgexx_lb(gmt_blk)
+
+    LBL(gmt_tl1)
+
+        cmpxx_ri(Reax, IB(0))
+        jeqxx_lb(gmt_nxt)
+
+        mskpx_rr(Xmm5, Reax)
+        mmvpx_ld(Xmm0, Xmm5, Mesi, DP(0x000))
+        mulps_rr(Xmm0, Xmm7)
+        mmvpx_ld(Xmm1, Xmm5, Mebx, DP(0x000))
+        addps_rr(Xmm0, Xmm1)
+        mmvpx_st(Xmm0, Xmm5, Mebx, DP(0x000))
+
+    LBL(gmt_nxt)
+
+        addxx_ld(Recx, Mebp, inf_STR)
+        addxx_ri(Redx, IB(4))
+        subxx_mi(Mebp, inf_PKT, IB(1))
+        cmpxx_mi(Mebp, inf_PKT, IB(0))
+        jgtxx_lb(gmt_row)
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jgtxx_lb(gmv_cyc)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test29(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = GMV_COLS(info->size);
+
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && FEQ(fco2[j], fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("C A*x[%d] = %e, A^T*x2[%d] = %e\n",
+                j, fco1[j], j, fco2[j]);
+
+        RT_LOGI("S A*x[%d] = %e, A^T*x2[%d] = %e\n",
+                j, fso1[j], j, fso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 29 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 30   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 30
+
+/* rows (and columns) of square matrices A, B, C, which fit in size elements
+ * as every row is padded to GMM_PAD(rows) */
+#define GMM_DIM(size)       ((rt_cell)sqrt((rt_fp64)(size) / 2) - GMM_NR)
+#define GMM_PAD(n)          (((n) + GMM_NR - 1) / GMM_NR * GMM_NR)
+
+#if RT_SIMD_REGS >= 16
+
+/*
+ * Load (or store) row r of C tile (Xmm(r), Xmm(s)) from (to) Redi
+ * and advance to next row, skip to lb if there are no more rows in the tile.
+ */
+#define GMM_LD(r, s, lb)                                                    \
+        movpx_ld(Xmm##r, Medi, DP(0x000))                                   \
+        movpx_ld(Xmm##s, Medi, DP(Q*0x010))                                 \
+        addxx_ld(Redi, Mebp, inf_STR)                                       \
+        cmpxx_mi(Mebp, inf_MCL, IB(r+2))                                    \
+        jltxx_lb(lb)
+
+#define GMM_ST(r, s, lb)                                                    \
+        movpx_st(Xmm##r, Medi, DP(0x000))                                   \
+        movpx_st(Xmm##s, Medi, DP(Q*0x010))                                 \
+        addxx_ld(Redi, Mebp, inf_STR)                                       \
+        cmpxx_mi(Mebp, inf_MCL, IB(r+2))                                    \
+        jltxx_lb(lb)
+
+#define GMM_ZR(r, s)                                                        \
+        xorpx_rr(Xmm##r, Xmm##r)                                            \
+        xorpx_rr(Xmm##s, Xmm##s)
+
+/*
+ * Load row of B sliver from Redx to Xmm6, XmmE.
+ */
+#define GMM_RB()                                                            \
+        movpx_ld(Xmm6, Medx, DP(0x000))                                     \
+        movpx_ld(XmmE, Medx, DP(Q*0x010))
+
+/*
+ * Accumulate element r of A (broadcast from Resi) in row r of C tile
+ * multiplied by row of B in Xmm6, XmmE, destroys Xmm7, XmmF.
+ */
+#define GMM_MAD(r, s)                                                       \
+        splpx_ld(Xmm7, Mesi, DP(0x004*r))                                   \
+        movpx_rr(XmmF, Xmm7)                                                \
+        mulps_rr(Xmm7, Xmm6)                                                \
+        mulps_rr(XmmF, XmmE)                                                \
+        addps_rr(Xmm##r, Xmm7)                                              \
+        addps_rr(Xmm##s, XmmF)
+
+#else  /* RT_SIMD_REGS == 8 */
+
+/*
+ * Load (or store) row r of C tile (Xmm(r), s is not used) from (to) Redi
+ * and advance to next row, skip to lb if there are no more rows in the tile.
+ */
+#define GMM_LD(r, s, lb)                                                    \
+        movpx_ld(Xmm##r, Medi, DP(0x000))                                   \
+        addxx_ld(Redi, Mebp, inf_STR)                                       \
+        cmpxx_mi(Mebp, inf_MCL, IB(r+2))                                    \
+        jltxx_lb(lb)
+
+#define GMM_ST(r, s, lb)                                                    \
+        movpx_st(Xmm##r, Medi, DP(0x000))                                   \
+        addxx_ld(Redi, Mebp, inf_STR)                                       \
+        cmpxx_mi(Mebp, inf_MCL, IB(r+2))                                    \
+        jltxx_lb(lb)
+
+#define GMM_ZR(r, s)                                                        \
+        xorpx_rr(Xmm##r, Xmm##r)
+
+/*
+ * Load row of B sliver from Redx to Xmm6.
+ */
+#define GMM_RB()                                                            \
+        movpx_ld(Xmm6, Medx, DP(0x000))
+
+/*
+ * Accumulate element r of A (broadcast from Resi) in row r of C tile
+ * multiplied by row of B in Xmm6, destroys Xmm7.
+ */
+#define GMM_MAD(r, s)                                                       \
+        splpx_ld(Xmm7, Mesi, DP(0x004*r))                                   \
+        mulps_rr(Xmm7, Xmm6)                                                \
+        addps_rr(Xmm##r, Xmm7)
+
+#endif /* RT_SIMD_REGS */
+
+/*
+ * Multiply packed A block (mc x kc) by packed B panel (kc x nc) into C block
+ * with row stride in inf_STR, one GMM_MR x GMM_NR tile at a time
+ * (accumulators Xmm0..Xmm5 and Xmm8..XmmD if GMM_NR is 2 SIMD vectors,
+ * row of B in Xmm6 and XmmE), going down the block for each B sliver
+ * so that it stays in L1, C tile rows past mc are skipped.
+ * C block is overwritten if acc is 0, accumulated to otherwise.
+ */
+rt_void gemm_knl(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+
+        movxa_ld(Rebx, Mebp, inf_GMMB)
+        movxx_ld(Reax, Mebp, inf_NC)
+        movxx_st(Reax, Mebp, inf_NCL)
+
+    LBL(gmm_jr)
+
+        movxa_ld(Resi, Mebp, inf_GMMA)
+        movxa_ld(Recx, Mebp, inf_GMMC)
+        movxx_ld(Reax, Mebp, inf_MC)
+        movxx_st(Reax, Mebp, inf_MCL)
+
+    LBL(gmm_ir)
+
+        cmpxx_mi(Mebp, inf_ACC, IB(0))
+        jeqxx_lb(gmm_zro)
+
+        movxx_rr(Redi, Recx)
+        GMM_LD(0, 8, gmm_mad)
+        GMM_LD(1, 9, gmm_mad)
+        GMM_LD(2, A, gmm_mad)
+        GMM_LD(3, B, gmm_mad)
+        GMM_LD(4, C, gmm_mad)
+        GMM_LD(5, D, gmm_mad)
+        jmpxx_lb(gmm_mad)
+
+    LBL(gmm_zro)
+
+        GMM_ZR(0, 8)
+        GMM_ZR(1, 9)
+        GMM_ZR(2, A)
+        GMM_ZR(3, B)
+        GMM_ZR(4, C)
+        GMM_ZR(5, D)
+
+    LBL(gmm_mad)
+
+        movxx_rr(Redx, Rebx)
+        movxx_ld(Reax, Mebp, inf_KC)
+
+    LBL(gmm_knl)
+
+        GMM_RB()
+        GMM_MAD(0, 8)
+        GMM_MAD(1, 9)
+        GMM_MAD(2, A)
+        GMM_MAD(3, B)
+        GMM_MAD(4, C)
+        GMM_MAD(5, D)
+
+        addxx_ri(Resi, IB(0x004*GMM_MR))
+        addxx_ri(Redx, IB(0x004*GMM_NR))
+        subxx_ri(Reax, IB(1))
+        cmpxx_ri(Reax, IB(0))
+        jgtxx_lb(gmm_knl)
+
+        movxx_rr(Redi, Recx)
+        GMM_ST(0, 8, gmm_str)
+        GMM_ST(1, 9, gmm_str)
+        GMM_ST(2, A, gmm_str)
+        GMM_ST(3, B, gmm_str)
+        GMM_ST(4, C, gmm_str)
+        GMM_ST(5, D, gmm_str)
+
+    LBL(gmm_str)
+
+        cmpxx_mi(Mebp, inf_MCL, IB(GMM_MR+1))
+        jltxx_lb(gmm_jn)
+
+        subxx_mi(Mebp, inf_MCL, IB(GMM_MR))
+        movxx_rr(Recx, Redi)
+        jmpxx_lb(gmm_ir)
+
+    LBL(gmm_jn)
+
+        movxx_rr(Rebx, Redx)
+        movxa_ld(Recx, Mebp, inf_GMMC)
+        addxx_ri(Recx, IB(0x004*GMM_NR))
+        movxa_st(Recx, Mebp, inf_GMMC)
+
+        cmpxx_mi(Mebp, inf_NCL, IB(GMM_NR+1))
+        jltxx_lb(gmm_end)
+
+        subxx_mi(Mebp, inf_NCL, IB(GMM_NR))
+        jmpxx_lb(gmm_jr)
+
+    LBL(gmm_end)
+
+    ASM_LEAVE(info)
+}
+
+/*
+ * Multiply A (d x d, far0) by B (d x d, next to A) into C (d x d, c) with
+ * all rows padded to ld = GMM_PAD(d), blocked by mc x nc x kc:
+ * B panel (kc x nc) is packed in GMM_NR-column slivers, then for each
+ * A block (mc x kc) packed in GMM_MR-row slivers (GMM_MR elements of
+ * a column of A are adjacent) gemm_knl runs its micro-kernels over C block.
+ * Packing pads slivers with zeros, so padding columns of C are 0.
+ */
+rt_void gemm_blk(rt_SIMD_INFOX *info, rt_real *c,
+                 rt_cell mc, rt_cell nc, rt_cell kc)
+{
+    rt_cell d = GMM_DIM(info->size), ld = GMM_PAD(d);
+    rt_real *a = info->far0, *b = info->far0 + d * ld, *pa, *pb;
+    rt_cell i, j, l, p, r, ic, jc, pc;
+
+    info->str  = ld * sizeof(rt_real);
+    info->gmma = info->fpck;
+    info->gmmb = info->fpck + GMM_MC * GMM_KC;
+
+    for (jc = 0; jc < ld; jc += nc)
+    {
+        rt_cell n = RT_MIN(ld - jc, nc);
+
+        for (pc = 0; pc < d; pc += kc)
+        {
+            rt_cell k = RT_MIN(d - pc, kc);
+
+            pb = info->gmmb;
+
+            for (j = jc; j < jc + n; j += GMM_NR)
+            {
+                for (p = pc; p < pc + k; p++)
+                {
+                    for (l = j; l < j + GMM_NR; l++)
+                    {
+                        *pb++ = l < d ? b[p * ld + l] : 0.0f;
+                    }
+                }
+            }
+
+            for (ic = 0; ic < d; ic += mc)
+            {
+                rt_cell m = RT_MIN(d - ic, mc);
+
+                pa = info->gmma;
+
+                for (i = ic; i < ic + m; i += GMM_MR)
+                {
+                    for (p = pc; p < pc + k; p++)
+                    {
+                        for (r = i; r < i + GMM_MR; r++)
+                        {
+                            *pa++ = r < ic + m ? a[r * ld + p] : 0.0f;
+                        }
+                    }
+                }
+
+                info->gmmc = c + ic * ld + jc;
+                info->mc   = m;
+                info->nc   = n;
+                info->kc   = k;
+                info->acc  = pc > 0;
+
+                gemm_knl(info);
+            }
+        }
+    }
+}
+
+/* flops in one multiplication of d x d matrices in size elements */
+rt_fp64 gemm_work(rt_cell size)
+{
+    rt_fp64 d = GMM_DIM(size);
+
+    return 2.0 * d * d * d;
+}
+
+/*
+ * Matrices A (d x d, far0) and B (d x d, next to A) with rows padded to
+ * GMM_PAD(d) are multiplied as sgemm C = A * B to out1 with cache-sized
+ * blocks and to out2 with blocks smaller than d, which checks accumulation
+ * over k-blocks and row/column tails of C (not done in -b mode).
+ */
+rt_void c_test30(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k, p, d = GMM_DIM(info->size), ld = GMM_PAD(d);
+    rt_real *a = info->far0, *b = info->far0 + d * ld;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        for (j = 0; j < d; j++)
+        {
+            for (k = 0; k < ld; k++)
+            {
+                rt_real c = 0.0f;
+
+                for (p = 0; p < d; p++)
+                {
+                    c += a[j * ld + p] * (k < d ? b[p * ld + k] : 0.0f);
+                }
+
+                info->fco1[j * ld + k] = c;
+            }
+        }
+
+        if (info->size <= MAX_SIZE)
+        {
+            memcpy(info->fco2, info->fco1, d * ld * sizeof(rt_real));
+        }
+    }
+}
+
+rt_void s_test30(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        gemm_blk(info, info->fso1, GMM_MC, GMM_NC, GMM_KC);
+
+        if (info->size <= MAX_SIZE)
+        {
+            gemm_blk(info, info->fso2, GMM_MR, GMM_NR * 2, 5);
+        }
+    }
+}
+
+rt_void p_test30(rt_SIMD_INFOX *info)
+{
+    rt_cell j, d = GMM_DIM(info->size), n = d * GMM_PAD(d);
+
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && FEQ(fco2[j], fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("C A*B[%d][%d] = %e, blocked %e\n",
+                j / GMM_PAD(d), j % GMM_PAD(d), fco1[j], fco2[j]);
+
+        RT_LOGI("S A*B[%d][%d] = %e, blocked %e\n",
+                j / GMM_PAD(d), j % GMM_PAD(d), fso1[j], fso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 30 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 31   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 31
+
+/*
+ * Shift-and-add step of scan: lane i of Xmm0 gets lane i-k added with op
+ * (zeros are shifted into lanes below k). Destroys Xmm2.
+ */
+#define SCN_STP(op, k)                                                      \
+        movpx_rr(Xmm2, Xmm0)                                                \
+        slnpx_ri(Xmm2, IB(k))                                               \
+        op##_rr(Xmm0, Xmm2)
+
+/* steps for k = 1, 2, .. S/2 */
+#if   RT_SIMD_WIDTH == 4
+#define SCN_SHF(op)                                                         \
+        SCN_STP(op, 1)                                                      \
+        SCN_STP(op, 2)
+#elif RT_SIMD_WIDTH == 8
+#define SCN_SHF(op)                                                         \
+        SCN_STP(op, 1)                                                      \
+        SCN_STP(op, 2)                                                      \
+        SCN_STP(op, 4)
+#endif /* RT_SIMD_WIDTH */
+
+/*
+ * Scan block in Xmm0 with op (SCN_SHF), then add carry Xmm7 to get
+ * inclusive scan in Xmm0, exclusive in Xmm1 (block scan shifted up by one
+ * lane, carry added), broadcast last lane of inclusive scan to Xmm7
+ * as carry for next block. Destroys Xmm2.
+ */
+#define SCN_BLK(op)                                                         \
+        SCN_SHF(op)                                                         \
+        movpx_rr(Xmm1, Xmm0)                                                \
+        slnpx_ri(Xmm1, IB(1))                                               \
+        op##_rr(Xmm1, Xmm7)                                                 \
+        op##_rr(Xmm0, Xmm7)                                                 \
+        movpx_rr(Xmm7, Xmm0)                                                \
+        splpx_ri(Xmm7, IB(S-1))
+
+/*
+ * Scan scnt elements from ssrc to sinc (inclusive) and sexc (exclusive)
+ * with op, soff is carried into the first block, tail is masked.
+ */
+#define SCN_KNL(op, lb)                                                     \
+        splpx_ld(Xmm7, Mebp, inf_SOFF)                                      \
+        movxa_ld(Recx, Mebp, inf_SSRC)                                      \
+        movxa_ld(Redx, Mebp, inf_SINC)                                      \
+        movxa_ld(Rebx, Mebp, inf_SEXC)                                      \
+        movxx_ld(Reax, Mebp, inf_SCNT)                                      \
+        cmpxx_ri(Reax, IB(S))                                               \
+        jltxx_lb(lb##_tl1)                                                  \
+    LBL(lb##_blk)                                                           \
+        movpx_ld(Xmm0, Mecx, DP(0x000))                                     \
+        SCN_BLK(op)                                                         \
+        movpx_st(Xmm0, Medx, DP(0x000))                                     \
+        movpx_st(Xmm1, Mebx, DP(0x000))                                     \
+        addxx_ri(Recx, IB(Q*0x010))                                         \
+        addxx_ri(Redx, IB(Q*0x010))                                         \
+        addxx_ri(Rebx, IB(Q*0x010))                                         \
+        subxx_ri(Reax, IB(S))                                               \
+        cmpxx_ri(Reax, IB(S))                                               \
+        jgexx_lb(lb##_blk)                                                  \
+    LBL(lb##_tl1)                                                           \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jeqxx_lb(lb##_end)                                                  \
+        mskpx_rr(Xmm5, Reax)                                                \
+        mmvpx_ld(Xmm0, Xmm5, Mecx, DP(0x000))                               \
+        SCN_BLK(op)                                                         \
+        mmvpx_st(Xmm0, Xmm5, Medx, DP(0x000))                               \
+        mmvpx_st(Xmm1, Xmm5, Mebx, DP(0x000))                               \
+    LBL(lb##_end)
+
+/*
+ * Sum scnt elements from ssrc with op to ssum (per-lane sums of blocks,
+ * then horizontal sum), tail is masked.
+ */
+#define SCN_SUM(op, lb)                                                     \
+        movxa_ld(Redi, Mebp, inf_FSCR)                                      \
+        movxa_ld(Recx, Mebp, inf_SSRC)                                      \
+        xorpx_rr(Xmm6, Xmm6)                                                \
+        movxx_ld(Reax, Mebp, inf_SCNT)                                      \
+        cmpxx_ri(Reax, IB(S))                                               \
+        jltxx_lb(lb##_tl1)                                                  \
+    LBL(lb##_blk)                                                           \
+        movpx_ld(Xmm0, Mecx, DP(0x000))                                     \
+        op##_rr(Xmm6, Xmm0)                                                 \
+        addxx_ri(Recx, IB(Q*0x010))                                         \
+        subxx_ri(Reax, IB(S))                                               \
+        cmpxx_ri(Reax, IB(S))                                               \
+        jgexx_lb(lb##_blk)                                                  \
+    LBL(lb##_tl1)                                                           \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jeqxx_lb(lb##_sum)                                                  \
+        mskpx_rr(Xmm5, Reax)                                                \
+        mmvpx_ld(Xmm0, Xmm5, Mecx, DP(0x000))                               \
+        op##_rr(Xmm6, Xmm0)                                                 \
+    LBL(lb##_sum)                                                           \
+        movpx_rr(Xmm0, Xmm6)                                                \
+        HSUM(op)                                                            \
+        movpx_st(Xmm0, Medi, DP(0x000))                                     \
+        movxx_ld(Reax, Medi, DP(0x000))                                     \
+        movxx_st(Reax, Mebp, inf_SSUM)
+
+rt_void scan_ps(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SCN_KNL(addps, scf)
+    ASM_LEAVE(info)
+}
+
+rt_void scan_sum_ps(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SCN_SUM(addps, ssf)
+    ASM_LEAVE(info)
+}
+
+/*
+ * Scan n elements of src to inc (inclusive) and exc (exclusive)
+ * with carry-in c as done by SCN_BLK, one S-wide block at a time.
+ */
+rt_void scan_ref_ps(rt_real *src, rt_cell n, rt_real c,
+                    rt_real *inc, rt_real *exc)
+{
+    rt_cell i, j, k;
+    rt_real v[RT_SIMD_WIDTH], t[RT_SIMD_WIDTH];
+
+    for (j = 0; j < n; j += RT_SIMD_WIDTH)
+    {
+        for (i = 0; i < RT_SIMD_WIDTH; i++)
+        {
+            v[i] = j + i < n ? src[j + i] : 0.0f;
+        }
+        for (k = 1; k < RT_SIMD_WIDTH; k *= 2)
+        {
+            for (i = 0; i < RT_SIMD_WIDTH; i++)
+            {
+                t[i] = v[i] + (i >= k ? v[i - k] : 0.0f);
+            }
+            for (i = 0; i < RT_SIMD_WIDTH; i++)
+            {
+                v[i] = t[i];
+            }
+        }
+        for (i = 0; i < RT_SIMD_WIDTH; i++)
+        {
+            v[i] = v[i] + c;
+        }
+        for (i = 0; i < RT_SIMD_WIDTH && j + i < n; i++)
+        {
+            inc[j + i] = v[i];
+            exc[j + i] = i == 0 ? c : v[i - 1];
+        }
+        c = v[RT_SIMD_WIDTH - 1];
+    }
+}
+
+/*
+ * Array far0 (n elements, n is not a multiple of S) is scanned to
+ * inclusive prefix sums in out1 and exclusive prefix sums in out2,
+ * carry is broadcast from the last lane of each block to the next.
+ */
+rt_void c_test31(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        scan_ref_ps(info->far0, info->size, 0.0f, info->fco1, info->fco2);
+    }
+}
+
+rt_void s_test31(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    info->ssrc = (rt_word *)info->far0;
+    info->sinc = (rt_word *)info->fso1;
+    info->sexc = (rt_word *)info->fso2;
+    info->scnt = info->size;
+    info->soff = 0.0f;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        scan_ps(info);
+    }
+}
+
+rt_void p_test31(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && FEQ(fco2[j], fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("farr[%d] = %e\n",
+                j, far0[j]);
+
+        RT_LOGI("C inclusive[%d] = %e, exclusive[%d] = %e\n",
+                j, fco1[j], j, fco2[j]);
+
+        RT_LOGI("S inclusive[%d] = %e, exclusive[%d] = %e\n",
+                j, fso1[j], j, fso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 31 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 32   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 32
+
+rt_void scan_px(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SCN_KNL(addpx, scx)
+    ASM_LEAVE(info)
+}
+
+rt_void scan_sum_px(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SCN_SUM(addpx, ssx)
+    ASM_LEAVE(info)
+}
+
+/*
+ * Scan n elements of src to inc (inclusive) and exc (exclusive)
+ * with carry-in c, integer sums wrap around.
+ */
+rt_void scan_ref_px(rt_cell *src, rt_cell n, rt_cell c,
+                    rt_cell *inc, rt_cell *exc)
+{
+    rt_cell j;
+    rt_word s = (rt_word)c;
+
+    for (j = 0; j < n; j++)
+    {
+        exc[j] = (rt_cell)s;
+        s += (rt_word)src[j];
+        inc[j] = (rt_cell)s;
+    }
+}
+
+/*
+ * Array iar0 (n elements, n is not a multiple of S) is scanned to
+ * inclusive prefix sums in out1 and exclusive prefix sums in out2.
+ */
+rt_void c_test32(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        scan_ref_px(info->iar0, info->size, 0, info->ico1, info->ico2);
+    }
+}
+
+rt_void s_test32(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    info->ssrc = (rt_word *)info->iar0;
+    info->sinc = (rt_word *)info->iso1;
+    info->sexc = (rt_word *)info->iso2;
+    info->scnt = info->size;
+    info->sofi = 0;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        scan_px(info);
+    }
+}
+
+rt_void p_test32(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_cell *iar0 = info->iar0;
+    rt_cell *ico1 = info->ico1;
+    rt_cell *ico2 = info->ico2;
+    rt_cell *iso1 = info->iso1;
+    rt_cell *iso2 = info->iso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (IEQ(ico1[j], iso1[j]) && IEQ(ico2[j], iso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("iarr[%d] = %d\n",
+                j, iar0[j]);
+
+        RT_LOGI("C inclusive[%d] = %d, exclusive[%d] = %d\n",
+                j, ico1[j], j, ico2[j]);
+
+        RT_LOGI("S inclusive[%d] = %d, exclusive[%d] = %d\n",
+                j, iso1[j], j, iso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 32 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 33   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 33
+
+rt_void scan_sum_ps_thr(rt_pntr data, rt_cell k)
+{
+    scan_sum_ps((rt_SIMD_INFOX *)data + k);
+}
+
+rt_void scan_ps_thr(rt_pntr data, rt_cell k)
+{
+    scan_ps((rt_SIMD_INFOX *)data + k);
+}
+
+rt_void scan_sum_px_thr(rt_pntr data, rt_cell k)
+{
+    scan_sum_px((rt_SIMD_INFOX *)data + k);
+}
+
+rt_void scan_px_thr(rt_pntr data, rt_cell k)
+{
+    scan_px((rt_SIMD_INFOX *)data + k);
+}
+
+/* elements in each of THR_SIZE chunks of two-pass scan */
+#define SCN_CHUNK(n)        RT_SOA_PAD(((n) + THR_SIZE - 1) / THR_SIZE)
+
+/*
+ * Run f for THR_SIZE thread infos, in parallel if array is large enough
+ * to pay for thread startup or if para is set, in a loop otherwise
+ * (same results). Test levels set para in their last cycle, so that
+ * threads are started and checked at small run_size as well.
+ */
+rt_void thrd_run(rt_SIMD_INFOX *info, rt_FUNC_PARA f, rt_bool para)
+{
+    rt_cell k;
+
+    if (para || info->size >= THR_WORK)
+    {
+        sys_para(THR_SIZE, f, info->thrd);
+        return;
+    }
+
+    for (k = 0; k < THR_SIZE; k++)
+    {
+        f(info->thrd, k);
+    }
+}
+
+/*
+ * Two-pass scan of size elements (fp32 if fp is true, int32 otherwise)
+ * from src to inc (inclusive) and exc (exclusive) in THR_SIZE chunks:
+ * first sums of all chunks are computed in parallel, then carries of
+ * chunks are summed up in order, then all chunks are scanned in parallel.
+ */
+rt_void scan_par(rt_SIMD_INFOX *info, rt_bool fp,
+                 rt_pntr src, rt_pntr inc, rt_pntr exc, rt_bool para)
+{
+    rt_SIMD_INFOX *thr = info->thrd;
+    rt_cell k, n = info->size, c = SCN_CHUNK(n);
+
+    for (k = 0; k < THR_SIZE; k++)
+    {
+        memcpy(&thr[k], info, sizeof(rt_SIMD_INFOX));
+
+        thr[k].fscr = thr_scr[k];
+        thr[k].ssrc = (rt_word *)src + k * c;
+        thr[k].sinc = (rt_word *)inc + k * c;
+        thr[k].sexc = (rt_word *)exc + k * c;
+        thr[k].scnt = RT_MAX(RT_MIN(n - k * c, c), 0);
+    }
+
+    thrd_run(info, fp ? scan_sum_ps_thr : scan_sum_px_thr, para);
+
+    thr[0].sofi = 0;
+
+    for (k = 1; k < THR_SIZE; k++)
+    {
+        if (fp)
+        {
+            thr[k].soff = thr[k - 1].soff + thr[k - 1].ssum;
+        }
+        else
+        {
+            thr[k].sofi = (rt_cell)((rt_word)thr[k - 1].sofi +
+                                    (rt_word)thr[k - 1].ssmi);
+        }
+    }
+
+    thrd_run(info, fp ? scan_ps_thr : scan_px_thr, para);
+}
+
+/*
+ * Sum of n elements of src as done by SCN_SUM.
+ */
+rt_real scan_sum_ref(rt_real *src, rt_cell n)
+{
+    rt_cell i, j;
+    rt_real d[RT_SIMD_WIDTH];
+
+    for (i = 0; i < RT_SIMD_WIDTH; i++)
+    {
+        d[i] = 0.0f;
+    }
+
+    for (j = 0; j < RT_SOA_PAD(n); j++)
+    {
+        d[j % RT_SIMD_WIDTH] += j < n ? src[j] : 0.0f;
+    }
+
+    hsum_ref(d);
+
+    return d[0];
+}
+
+/*
+ * Array far0 is scanned to inclusive (out1) and exclusive (out2) prefix
+ * sums in THR_SIZE chunks by two-pass scan, chunks start with the sum
+ * of preceding chunks, thus results differ from level 31 in rounding.
+ */
+rt_void c_test33(rt_SIMD_INFOX *info)
+{
+    rt_cell i, k, n = info->size, c = SCN_CHUNK(n);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        rt_real s = 0.0f;
+
+        for (k = 0; k < THR_SIZE; k++)
+        {
+            rt_cell m = RT_MAX(RT_MIN(n - k * c, c), 0);
+
+            scan_ref_ps(info->far0 + k * c, m, s,
+                        info->fco1 + k * c, info->fco2 + k * c);
+
+            s = s + scan_sum_ref(info->far0 + k * c, m);
+        }
+    }
+}
+
+rt_void s_test33(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        scan_par(info, RT_TRUE, info->far0, info->fso1, info->fso2, i == 0);
+    }
+}
+
+rt_void p_test33(rt_SIMD_INFOX *info)
+{
+    p_test31(info);
+}
+
+#endif /* RUN_LEVEL 33 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 34   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 34
+
+/*
+ * Array iar0 is scanned to inclusive (out1) and exclusive (out2) prefix
+ * sums in THR_SIZE chunks by two-pass scan, same as level 32 results.
+ */
+rt_void c_test34(rt_SIMD_INFOX *info)
+{
+    c_test32(info);
+}
+
+rt_void s_test34(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        scan_par(info, RT_FALSE, info->iar0, info->iso1, info->iso2, i == 0);
+    }
+}
+
+rt_void p_test34(rt_SIMD_INFOX *info)
+{
+    p_test32(info);
+}
+
+#endif /* RUN_LEVEL 34 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 35   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 35
+
+/*
+ * Sort kernels work on int32 keys (fp32 keys are mapped to int32 images
+ * of the same order on load and back on store, see SRT_ORD), thus a single
+ * signed compare orders fp32 and int32 keys including -0.0, NaNs and
+ * denormals (not flushed by the compare), lanes are exchanged by masks
+ * (not min/max) to carry values along with keys. Keys-only kernels keep
+ * keys in buffers, key-value kernels keep blocks of S keys followed by
+ * S values (rt_AoSoA<2> layout).
+ */
+#define SRT_MAX             0x7FFFFFFF /* padding key, sorts last */
+#define SRT_PAD(n)          (((n) + S*S - 1) / (S*S) * (S*S))
+#define SRT_STG             (0x40*RT_SIMD_WIDTH) /* fscr staging for tail */
+
+/*
+ * Scratch slots (SIMD vectors from fscr) of sort kernels.
+ */
+#define SRT_TMK             DP(Q*0x000) /* keys being permuted */
+#define SRT_TMV             DP(Q*0x010) /* values being permuted */
+#define SRT_HDK             DP(Q*0x020) /* upper keys of merge, descending */
+#define SRT_HDV             DP(Q*0x030) /* upper values of merge */
+#define SRT_REV             DP(Q*0x040) /* S-1-i, lane reversal */
+#define SRT_LN0             DP(Q*0x050) /* all ones in lane 0 */
+#define SRT_ONE             DP(Q*0x060) /* 1 in all lanes */
+#define SRT_TRN             DP(Q*0x070) /* i*S, block transposition */
+#define SRT_TBL             DP(Q*0x080) /* lane exchange stages, see below */
+#define SRT_ROW             DP(Q*0x200) /* S+1 key rows, S+1 value rows */
+#define SRT_RWV             DP(Q*0x200+Q*0x010*(S+1))
+
+/*
+ * Lane exchange stage j = S/2, .. 2, 1 of SRT_TBL is 3 vectors:
+ * partner lanes i^j, lanes with i&j == 0 (low), other lanes (high).
+ */
+#define SRT_IDX             DP(Q*0x000)
+#define SRT_LOW             DP(Q*0x010)
+#define SRT_HGH             DP(Q*0x020)
+
+/*
+ * Map fp32 keys in RG to int32 of the same order or back (the mapping
+ * is its own inverse), int32 keys are left as is. Destroys RT.
+ */
+#define SRT_ORD_ps(RG, RT)                                                  \
+        movpx_rr(W(RT), W(RG))                                              \
+        shrpn_ri(W(RT), IB(31))                                             \
+        andpx_ld(W(RT), Mebp, inf_GPC04)                                    \
+        xorpx_rr(W(RG), W(RT))
+
+#define SRT_ORD_pn(RG, RT)
+
+/*
+ * Value ops of key-value kernels (kv = 1),
+ * nothing is done for values in keys-only kernels (kv = 0).
+ */
+#define SRT_VLD0(RG, RM, DP)
+#define SRT_VLD1(RG, RM, DP)                                                \
+        movpx_ld(W(RG), W(RM), W(DP))
+
+#define SRT_VST0(RG, RM, DP)
+#define SRT_VST1(RG, RM, DP)                                                \
+        movpx_st(W(RG), W(RM), W(DP))
+
+#define SRT_VGT0(RG, RI, RM, DP)
+#define SRT_VGT1(RG, RI, RM, DP)                                            \
+        gatpx_ld(W(RG), W(RI), W(RM), W(DP))
+
+#define SRT_VAD0(RM, IM)
+#define SRT_VAD1(RM, IM)                                                    \
+        addxx_ri(W(RM), W(IM))
+
+#define SRT_VSW0(RG, RK, RM, RT)
+#define SRT_VSW1(RG, RK, RM, RT)                                            \
+        SRT_SWP(W(RG), W(RK), W(RM), W(RT))
+
+/* lanes of RG from RI-indexed lanes of RG where RM, RG kept in SRT_TMV */
+#define SRT_VPM0(RG, RI, RM, RT)
+#define SRT_VPM1(RG, RI, RM, RT)                                            \
+        movpx_st(W(RG), Medi, SRT_TMV)                                      \
+        gatpx_ld(W(RT), W(RI), Medi, SRT_TMV)                               \
+        xorpx_rr(W(RT), W(RG))                                              \
+        andpx_rr(W(RT), W(RM))                                              \
+        xorpx_rr(W(RG), W(RT))
+
+/*
+ * Exchange lanes of RG and RK where RM is set. Destroys RT.
+ */
+#define SRT_SWP(RG, RK, RM, RT)                                             \
+        movpx_rr(W(RT), W(RG))                                              \
+        xorpx_rr(W(RT), W(RK))                                              \
+        andpx_rr(W(RT), W(RM))                                              \
+        xorpx_rr(W(RG), W(RT))                                              \
+        xorpx_rr(W(RK), W(RT))
+
+/*
+ * Compare-exchange keys Xmm0 with keys Xmm2 (values Xmm1 with Xmm3),
+ * lower keys go to Xmm0, upper keys to Xmm2. Destroys Xmm4, Xmm5.
+ */
+#define SRT_CXR(kv)                                                         \
+        movpx_rr(Xmm4, Xmm0)                                                \
+        cgtpn_rr(Xmm4, Xmm2)                                                \
+        SRT_SWP(Xmm0, Xmm2, Xmm4, Xmm5)                                     \
+        SRT_VSW##kv(Xmm1, Xmm3, Xmm4, Xmm5)
+
+/*
+ * Sort bitonic keys Xmm0 (values Xmm1) by lane exchange stages
+ * S/2, .. 2, 1 with partner lanes gathered from scratch, lanes lo take
+ * lower keys and lanes hi upper keys of each pair (SRT_LOW and SRT_HGH
+ * for ascending order, swapped for descending).
+ * Destroys Xmm2..Xmm4, Xmm7, Reax and Resi.
+ */
+#define SRT_VEC(kv, lo, hi, lb)                                             \
+        movxx_rr(Resi, Redi)                                                \
+        addxx_ri(Resi, IH(Q*0x080))                                         \
+        movxx_ri(Reax, IB(S/2))                                             \
+    LBL(lb)                                                                 \
+        movpx_st(Xmm0, Medi, SRT_TMK)                                       \
+        movpx_ld(Xmm7, Mesi, SRT_IDX)                                       \
+        gatpx_ld(Xmm2, Xmm7, Medi, SRT_TMK)                                 \
+        movpx_rr(Xmm3, Xmm0)                                                \
+        cgtpn_rr(Xmm3, Xmm2)                                                \
+        andpx_ld(Xmm3, Mesi, W(lo))                                         \
+        movpx_rr(Xmm4, Xmm2)                                                \
+        cgtpn_rr(Xmm4, Xmm0)                                                \
+        andpx_ld(Xmm4, Mesi, W(hi))                                         \
+        orrpx_rr(Xmm3, Xmm4)                                                \
+        xorpx_rr(Xmm2, Xmm0)                                                \
+        andpx_rr(Xmm2, Xmm3)                                                \
+        xorpx_rr(Xmm0, Xmm2)                                                \
+        SRT_VPM##kv(Xmm1, Xmm7, Xmm3, Xmm2)                                 \
+        addxx_ri(Resi, IB(Q*0x030))                                         \
+        shrxx_ri(Reax, IB(1))                                               \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jgtxx_lb(lb)
+
+/*
+ * Sort srem blocks of S x S keys from ssrk (values from ssrv) to runs
+ * of S keys at sdsk: rows of a block are sorted lane-wise by odd-even
+ * transposition network (S rounds of S/2 row pairs, the odd rounds end
+ * at the padding row S), then the block is transposed by gathers.
+ * Pointers ssrk, ssrv and sdsk are advanced past the blocks.
+ */
+#define SRT_BLK(ty, kv, lb)                                                 \
+        movxa_ld(Redi, Mebp, inf_FSCR)                                      \
+    LBL(lb##_blk)                                                           \
+        movxx_ld(Reax, Mebp, inf_SREM)                                      \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jeqxx_lb(lb##_end)                                                  \
+        subxx_ri(Reax, IB(1))                                               \
+        movxx_st(Reax, Mebp, inf_SREM)                                      \
+        movxa_ld(Recx, Mebp, inf_SSRK)                                      \
+        movxa_ld(Redx, Mebp, inf_SSRV)                                      \
+        movxx_rr(Rebx, Redi)                                                \
+        addxx_ri(Rebx, IH(Q*0x200))                                         \
+        movxx_ri(Reax, IB(S))                                               \
+    LBL(lb##_row)                                                           \
+        movpx_ld(Xmm0, Mecx, DP(Q*0x000))                                   \
+        SRT_ORD_##ty(Xmm0, Xmm2)                                            \
+        movpx_st(Xmm0, Mebx, DP(Q*0x000))                                   \
+        SRT_VLD##kv(Xmm1, Medx, DP(Q*0x000))                                \
+        SRT_VST##kv(Xmm1, Mebx, DP(Q*0x010*(S+1)))                          \
+        addxx_ri(Recx, IB(Q*0x010))                                         \
+        SRT_VAD##kv(Redx, IB(Q*0x010))                                      \
+        addxx_ri(Rebx, IB(Q*0x010))                                         \
+        subxx_ri(Reax, IB(1))                                               \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jgtxx_lb(lb##_row)                                                  \
+        movxa_st(Recx, Mebp, inf_SSRK)                                      \
+        movxa_st(Redx, Mebp, inf_SSRV)                                      \
+        movxx_rr(Reax, Redi)                                                \
+        addxx_ri(Reax, IH(Q*0x200))                                         \
+        movxx_rr(Resi, Reax)                                                \
+        addxx_ri(Resi, IB(Q*0x010))                                         \
+        movxx_ri(Redx, IB(S))                                               \
+    LBL(lb##_rnd)                                                           \
+        movxx_rr(Rebx, Reax)                                                \
+        movxx_ri(Recx, IB(S/2))                                             \
+    LBL(lb##_cxr)                                                           \
+        movpx_ld(Xmm0, Mebx, DP(Q*0x000))                                   \
+        movpx_ld(Xmm2, Mebx, DP(Q*0x010))                                   \
+        SRT_VLD##kv(Xmm1, Mebx, DP(Q*0x010*(S+1)))                          \
+        SRT_VLD##kv(Xmm3, Mebx, DP(Q*0x010*(S+2)))                          \
+        SRT_CXR(kv)                                                         \
+        movpx_st(Xmm0, Mebx, DP(Q*0x000))                                   \
+        movpx_st(Xmm2, Mebx, DP(Q*0x010))                                   \
+        SRT_VST##kv(Xmm1, Mebx, DP(Q*0x010*(S+1)))                          \
+        SRT_VST##kv(Xmm3, Mebx, DP(Q*0x010*(S+2)))                          \
+        addxx_ri(Rebx, IB(Q*0x020))                                         \
+        subxx_ri(Recx, IB(1))                                               \
+        cmpxx_ri(Recx, IB(0))                                               \
+        jgtxx_lb(lb##_cxr)                                                  \
+        movxx_rr(Rebx, Reax)                                                \
+        movxx_rr(Reax, Resi)                                                \
+        movxx_rr(Resi, Rebx)                                                \
+        subxx_ri(Redx, IB(1))                                               \
+        cmpxx_ri(Redx, IB(0))                                               \
+        jgtxx_lb(lb##_rnd)                                                  \
+        movxa_ld(Rebx, Mebp, inf_SDSK)                                      \
+        movpx_ld(Xmm7, Medi, SRT_TRN)                                       \
+        movxx_ri(Recx, IB(S))                                               \
+    LBL(lb##_trn)                                                           \
+        gatpx_ld(Xmm0, Xmm7, Medi, SRT_ROW)                                 \
+        movpx_st(Xmm0, Mebx, DP(Q*0x000))                                   \
+        SRT_VGT##kv(Xmm1, Xmm7, Medi, SRT_RWV)                              \
+        SRT_VST##kv(Xmm1, Mebx, DP(Q*0x010))                                \
+        addpx_ld(Xmm7, Medi, SRT_ONE)                                       \
+        addxx_ri(Rebx, IB(Q*0x010*(1+kv)))                                  \
+        subxx_ri(Recx, IB(1))                                               \
+        cmpxx_ri(Recx, IB(0))                                               \
+        jgtxx_lb(lb##_trn)                                                  \
+        movxa_st(Rebx, Mebp, inf_SDSK)                                      \
+        jmpxx_lb(lb##_blk)                                                  \
+    LBL(lb##_end)
+
+/*
+ * Merge pairs of sorted runs (srun bytes each, the last pair may be
+ * shorter) of srem bytes from ssrk to sdsk: the upper S keys are kept
+ * descending in scratch, each next vector is taken from the run with
+ * the lower head, lanes are compare-exchanged with the upper keys
+ * (ascending against descending is bitonic), then the lower S keys
+ * are sorted and stored, the upper S keys sorted descending and kept.
+ */
+#define SRT_MRG(kv, lb)                                                     \
+        movxa_ld(Redi, Mebp, inf_FSCR)                                      \
+        movxa_ld(Recx, Mebp, inf_SSRK)                                      \
+        movxa_ld(Rebx, Mebp, inf_SDSK)                                      \
+    LBL(lb##_par)                                                           \
+        movxx_ld(Reax, Mebp, inf_SREM)                                      \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jeqxx_lb(lb##_end)                                                  \
+        movxx_ld(Resi, Mebp, inf_SRUN)                                      \
+        cmpxx_rr(Reax, Resi)                                                \
+        jgexx_lb(lb##_lnx)                                                  \
+        movxx_rr(Resi, Reax)                                                \
+    LBL(lb##_lnx)                                                           \
+        movxx_st(Resi, Mebp, inf_SCX)                                       \
+        movxx_rr(Redx, Recx)                                                \
+        addxx_rr(Redx, Resi)                                                \
+        subxx_rr(Reax, Resi)                                                \
+        movxx_ld(Resi, Mebp, inf_SRUN)                                      \
+        cmpxx_rr(Reax, Resi)                                                \
+        jgexx_lb(lb##_lny)                                                  \
+        movxx_rr(Resi, Reax)                                                \
+    LBL(lb##_lny)                                                           \
+        movxx_st(Resi, Mebp, inf_SCY)                                       \
+        subxx_rr(Reax, Resi)                                                \
+        movxx_st(Reax, Mebp, inf_SREM)                                      \
+        movpx_ld(Xmm7, Medi, SRT_REV)                                       \
+        gatpx_ld(Xmm0, Xmm7, Mecx, DP(Q*0x000))                             \
+        movpx_st(Xmm0, Medi, SRT_HDK)                                       \
+        SRT_VGT##kv(Xmm1, Xmm7, Mecx, DP(Q*0x010))                          \
+        SRT_VST##kv(Xmm1, Medi, SRT_HDV)                                    \
+        addxx_ri(Recx, IB(Q*0x010*(1+kv)))                                  \
+        subxx_mi(Mebp, inf_SCX, IB(Q*0x010*(1+kv)))                         \
+    LBL(lb##_sel)                                                           \
+        cmpxx_mi(Mebp, inf_SCX, IB(0))                                      \
+        jeqxx_lb(lb##_sly)                                                  \
+        cmpxx_mi(Mebp, inf_SCY, IB(0))                                      \
+        jeqxx_lb(lb##_tkx)                                                  \
+        movpx_ld(Xmm0, Mecx, DP(Q*0x000))                                   \
+        cgtpn_ld(Xmm0, Medx, DP(Q*0x000))                                   \
+        andpx_ld(Xmm0, Medi, SRT_LN0)                                       \
+        CHECK_MASK(lb##_tkx, NONE, Xmm0)                                    \
+        jmpxx_lb(lb##_tky)                                                  \
+    LBL(lb##_sly)                                                           \
+        cmpxx_mi(Mebp, inf_SCY, IB(0))                                      \
+        jeqxx_lb(lb##_fin)                                                  \
+    LBL(lb##_tky)                                                           \
+        movpx_ld(Xmm0, Medx, DP(Q*0x000))                                   \
+        SRT_VLD##kv(Xmm1, Medx, DP(Q*0x010))                                \
+        addxx_ri(Redx, IB(Q*0x010*(1+kv)))                                  \
+        subxx_mi(Mebp, inf_SCY, IB(Q*0x010*(1+kv)))                         \
+        jmpxx_lb(lb##_cxr)                                                  \
+    LBL(lb##_tkx)                                                           \
+        movpx_ld(Xmm0, Mecx, DP(Q*0x000))                                   \
+        SRT_VLD##kv(Xmm1, Mecx, DP(Q*0x010))                                \
+        addxx_ri(Recx, IB(Q*0x010*(1+kv)))                                  \
+        subxx_mi(Mebp, inf_SCX, IB(Q*0x010*(1+kv)))                         \
+    LBL(lb##_cxr)                                                           \
+        movpx_ld(Xmm2, Medi, SRT_HDK)                                       \
+        SRT_VLD##kv(Xmm3, Medi, SRT_HDV)                                    \
+        SRT_CXR(kv)                                                         \
+        movpx_st(Xmm2, Medi, SRT_HDK)                                       \
+        SRT_VST##kv(Xmm3, Medi, SRT_HDV)                                    \
+        SRT_VEC(kv, SRT_LOW, SRT_HGH, lb##_asc)                             \
+        movpx_st(Xmm0, Mebx, DP(Q*0x000))                                   \
+        SRT_VST##kv(Xmm1, Mebx, DP(Q*0x010))                                \
+        addxx_ri(Rebx, IB(Q*0x010*(1+kv)))                                  \
+        movpx_ld(Xmm0, Medi, SRT_HDK)                                       \
+        SRT_VLD##kv(Xmm1, Medi, SRT_HDV)                                    \
+        SRT_VEC(kv, SRT_HGH, SRT_LOW, lb##_dsc)                             \
+        movpx_st(Xmm0, Medi, SRT_HDK)                                       \
+        SRT_VST##kv(Xmm1, Medi, SRT_HDV)                                    \
+        jmpxx_lb(lb##_sel)                                                  \
+    LBL(lb##_fin)                                                           \
+        movpx_ld(Xmm7, Medi, SRT_REV)                                       \
+        gatpx_ld(Xmm0, Xmm7, Medi, SRT_HDK)                                 \
+        movpx_st(Xmm0, Mebx, DP(Q*0x000))                                   \
+        SRT_VGT##kv(Xmm1, Xmm7, Medi, SRT_HDV)                              \
+        SRT_VST##kv(Xmm1, Mebx, DP(Q*0x010))                                \
+        addxx_ri(Rebx, IB(Q*0x010*(1+kv)))                                  \
+        movxx_rr(Recx, Redx)                                                \
+        jmpxx_lb(lb##_par)                                                  \
+    LBL(lb##_end)
+
+/*
+ * Store srem vectors of keys from ssrk to sdsk (values to sdsv),
+ * fp32 keys are mapped back from their int32 images.
+ */
+#define SRT_SPL(ty, kv, lb)                                                 \
+        movxa_ld(Recx, Mebp, inf_SSRK)                                      \
+        movxa_ld(Redx, Mebp, inf_SDSK)                                      \
+        movxa_ld(Rebx, Mebp, inf_SDSV)                                      \
+        movxx_ld(Reax, Mebp, inf_SREM)                                      \
+    LBL(lb)                                                                 \
+        movpx_ld(Xmm0, Mecx, DP(Q*0x000))                                   \
+        SRT_ORD_##ty(Xmm0, Xmm2)                                            \
+        movpx_st(Xmm0, Medx, DP(Q*0x000))                                   \
+        SRT_VLD##kv(Xmm1, Mecx, DP(Q*0x010))                                \
+        SRT_VST##kv(Xmm1, Mebx, DP(Q*0x000))                                \
+        addxx_ri(Recx, IB(Q*0x010*(1+kv)))                                  \
+        addxx_ri(Redx, IB(Q*0x010))                                         \
+        SRT_VAD##kv(Rebx, IB(Q*0x010))                                      \
+        subxx_ri(Reax, IB(1))                                               \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jgtxx_lb(lb)
+
+rt_void sort_blk_ps(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SRT_BLK(ps, 0, bkf)
+    ASM_LEAVE(info)
+}
+
+rt_void sort_blk_pn(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SRT_BLK(pn, 0, bki)
+    ASM_LEAVE(info)
+}
+
+rt_void sort_blk_psv(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SRT_BLK(ps, 1, bvf)
+    ASM_LEAVE(info)
+}
+
+rt_void sort_blk_pnv(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SRT_BLK(pn, 1, bvi)
+    ASM_LEAVE(info)
+}
+
+rt_void sort_mrg_pn(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SRT_MRG(0, mgk)
+    ASM_LEAVE(info)
+}
+
+rt_void sort_mrg_pnv(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SRT_MRG(1, mgv)
+    ASM_LEAVE(info)
+}
+
+rt_void sort_spl_ps(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SRT_SPL(ps, 0, spf)
+    ASM_LEAVE(info)
+}
+
+rt_void sort_spl_pn(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SRT_SPL(pn, 0, spi)
+    ASM_LEAVE(info)
+}
+
+rt_void sort_spl_psv(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SRT_SPL(ps, 1, svf)
+    ASM_LEAVE(info)
+}
+
+rt_void sort_spl_pnv(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        SRT_SPL(pn, 1, svi)
+    ASM_LEAVE(info)
+}
+
+/*
+ * Map fp32 key k to int32 of the same order or back, as SRT_ORD_ps.
+ */
+rt_word sort_ord(rt_word k, rt_bool fp)
+{
+    return fp && (k & 0x80000000) ? k ^ 0x7FFFFFFF : k;
+}
+
+/*
+ * Fill scratch slots of sort kernels (SRT_REV .. SRT_TBL)
+ * and the padding row S of SRT_ROW (keys SRT_MAX, values 0).
+ */
+rt_void sort_tbl(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k;
+    rt_word *t = (rt_word *)info->fscr;
+
+    for (i = 0; i < RT_SIMD_WIDTH; i++)
+    {
+        t[0x04 * RT_SIMD_WIDTH + i] = RT_SIMD_WIDTH - 1 - i;
+        t[0x05 * RT_SIMD_WIDTH + i] = i == 0 ? 0xFFFFFFFF : 0;
+        t[0x06 * RT_SIMD_WIDTH + i] = 1;
+        t[0x07 * RT_SIMD_WIDTH + i] = i * RT_SIMD_WIDTH;
+
+        for (j = RT_SIMD_WIDTH / 2, k = 0x08; j > 0; j /= 2, k += 3)
+        {
+            t[(k + 0) * RT_SIMD_WIDTH + i] = i ^ j;
+            t[(k + 1) * RT_SIMD_WIDTH + i] = i & j ? 0 : 0xFFFFFFFF;
+            t[(k + 2) * RT_SIMD_WIDTH + i] = i & j ? 0xFFFFFFFF : 0;
+        }
+
+        k = 0x20 + RT_SIMD_WIDTH;
+        t[k * RT_SIMD_WIDTH + i] = SRT_MAX;
+
+        k = 0x20 + RT_SIMD_WIDTH * 2 + 1;
+        t[k * RT_SIMD_WIDTH + i] = 0;
+    }
+}
+
+/*
+ * Padding sorts behind all keys but may mix with SRT_MAX keys of input,
+ * drop m - n padding values (zeros) from the run of SRT_MAX keys at the
+ * end of m sorted keys ok, values ov of equal keys are interchangeable.
+ */
+rt_void sort_fix(rt_word *ok, rt_word *ov, rt_cell n, rt_cell m)
+{
+    rt_cell i, j, k = m - n;
+
+    for (j = m; j > 0 && ok[j - 1] == SRT_MAX; j--);
+
+    for (i = j; j < m; j++)
+    {
+        if (k > 0 && ov[j] == 0)
+        {
+            k--;
+            continue;
+        }
+        ov[i++] = ov[j];
+    }
+}
+
+typedef rt_void (*rt_FUNC_SORT)(rt_SIMD_INFOX *info);
+
+/*
+ * Sort size keys (fp32 if fp, int32 otherwise) from key to ok and their
+ * values from val to ov (keys only if val is NULL) with SIMD kernels:
+ * S x S blocks to runs of S, then merge passes doubling runs in sbuf.
+ * Outputs take SRT_PAD(size) elements, the first size are sorted.
+ */
+rt_void sort_simd(rt_SIMD_INFOX *info, rt_bool fp,
+                  rt_word *key, rt_word *val, rt_word *ok, rt_word *ov)
+{
+    rt_cell j, r, n = info->size, m = SRT_PAD(n);
+    rt_cell b = n / (RT_SIMD_WIDTH * RT_SIMD_WIDTH) * RT_SIMD_WIDTH;
+    rt_cell w = val != RT_NULL ? 2 : 1;
+
+    rt_word *src = info->sbuf, *dst = info->sbuf + m * w, *tmp;
+    rt_word *stg = (rt_word *)info->fscr + SRT_STG;
+
+    rt_FUNC_SORT blk = fp ? (w == 2 ? sort_blk_psv : sort_blk_ps) :
+                            (w == 2 ? sort_blk_pnv : sort_blk_pn);
+    rt_FUNC_SORT mrg = w == 2 ? sort_mrg_pnv : sort_mrg_pn;
+    rt_FUNC_SORT spl = fp ? (w == 2 ? sort_spl_psv : sort_spl_ps) :
+                            (w == 2 ? sort_spl_pnv : sort_spl_pn);
+
+    if (n <= 0)
+    {
+        return;
+    }
+
+    sort_tbl(info);
+
+    info->ssrk = key;
+    info->ssrv = val;
+    info->sdsk = src;
+    info->srem = b / RT_SIMD_WIDTH;
+    blk(info);
+
+    if (b * RT_SIMD_WIDTH < n)
+    {
+        for (j = 0; j < RT_SIMD_WIDTH * RT_SIMD_WIDTH; j++)
+        {
+            r = b * RT_SIMD_WIDTH + j;
+            stg[j] = r < n ? key[r] : SRT_MAX;
+            stg[j + RT_SIMD_WIDTH * RT_SIMD_WIDTH] = r < n && w == 2 ?
+                                                     val[r] : 0;
+        }
+
+        info->ssrk = stg;
+        info->ssrv = stg + RT_SIMD_WIDTH * RT_SIMD_WIDTH;
+        info->srem = 1;
+        blk(info);
+    }
+
+    for (r = RT_SIMD_WIDTH; r < m; r *= 2)
+    {
+        info->ssrk = src;
+        info->sdsk = dst;
+        info->srem = m * w * sizeof(rt_word);
+        info->srun = r * w * sizeof(rt_word);
+        mrg(info);
+
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    info->ssrk = src;
+    info->sdsk = ok;
+    info->sdsv = ov;
+    info->srem = m / RT_SIMD_WIDTH;
+    spl(info);
+
+    if (w == 2)
+    {
+        sort_fix(ok, ov, n, m);
+    }
+}
+
+/*
+ * Sort bitonic keys k (values v) of S lanes as SRT_VEC,
+ * in descending order if dsc.
+ */
+rt_void sort_vec_ref(rt_cell *k, rt_cell *v, rt_bool dsc)
+{
+    rt_cell i, j;
+    rt_cell pk[RT_SIMD_WIDTH], pv[RT_SIMD_WIDTH];
+
+    for (j = RT_SIMD_WIDTH / 2; j > 0; j /= 2)
+    {
+        for (i = 0; i < RT_SIMD_WIDTH; i++)
+        {
+            pk[i] = k[i ^ j];
+            pv[i] = v[i ^ j];
+        }
+        for (i = 0; i < RT_SIMD_WIDTH; i++)
+        {
+            rt_bool lo = ((i & j) == 0) != dsc;
+
+            if (lo ? k[i] > pk[i] : pk[i] > k[i])
+            {
+                k[i] = pk[i];
+                v[i] = pv[i];
+            }
+        }
+    }
+}
+
+/*
+ * Merge sorted runs x (lx keys) and y (ly keys) following x
+ * to z as SRT_MRG (values follow keys in separate arrays).
+ */
+rt_void sort_mrg_ref(rt_cell *xk, rt_cell *xv, rt_cell lx, rt_cell ly,
+                     rt_cell *zk, rt_cell *zv)
+{
+    rt_cell i, t;
+    rt_cell *yk = xk + lx, *yv = xv + lx;
+    rt_cell hk[RT_SIMD_WIDTH], hv[RT_SIMD_WIDTH];
+    rt_cell bk[RT_SIMD_WIDTH], bv[RT_SIMD_WIDTH];
+
+    for (i = 0; i < RT_SIMD_WIDTH; i++)
+    {
+        hk[i] = xk[RT_SIMD_WIDTH - 1 - i];
+        hv[i] = xv[RT_SIMD_WIDTH - 1 - i];
+    }
+    xk += RT_SIMD_WIDTH;
+    xv += RT_SIMD_WIDTH;
+    lx -= RT_SIMD_WIDTH;
+
+    while (lx > 0 || ly > 0)
+    {
+        rt_bool tx = lx > 0 && (ly == 0 || !(xk[0] > yk[0]));
+
+        for (i = 0; i < RT_SIMD_WIDTH; i++)
+        {
+            bk[i] = tx ? xk[i] : yk[i];
+            bv[i] = tx ? xv[i] : yv[i];
+        }
+        if (tx)
+        {
+            xk += RT_SIMD_WIDTH;
+            xv += RT_SIMD_WIDTH;
+            lx -= RT_SIMD_WIDTH;
+        }
+        else
+        {
+            yk += RT_SIMD_WIDTH;
+            yv += RT_SIMD_WIDTH;
+            ly -= RT_SIMD_WIDTH;
+        }
+
+        for (i = 0; i < RT_SIMD_WIDTH; i++)
+        {
+            if (bk[i] > hk[i])
+            {
+                t = bk[i]; bk[i] = hk[i]; hk[i] = t;
+                t = bv[i]; bv[i] = hv[i]; hv[i] = t;
+            }
+        }
+
+        sort_vec_ref(bk, bv, RT_FALSE);
+
+        for (i = 0; i < RT_SIMD_WIDTH; i++)
+        {
+            zk[i] = bk[i];
+            zv[i] = bv[i];
+        }
+        zk += RT_SIMD_WIDTH;
+        zv += RT_SIMD_WIDTH;
+
+        sort_vec_ref(hk, hv, RT_TRUE);
+    }
+
+    for (i = 0; i < RT_SIMD_WIDTH; i++)
+    {
+        zk[i] = hk[RT_SIMD_WIDTH - 1 - i];
+        zv[i] = hv[RT_SIMD_WIDTH - 1 - i];
+    }
+}
+
+/*
+ * Sort n keys and values as sort_simd does, but in C,
+ * buf holds 4 * SRT_PAD(n) elements.
+ */
+rt_void sort_ref(rt_bool fp, rt_word *key, rt_word *val, rt_cell n,
+                 rt_word *ok, rt_word *ov, rt_word *buf)
+{
+    rt_cell i, j, l, r, t, m = SRT_PAD(n);
+    rt_cell rk[RT_SIMD_WIDTH + 1][RT_SIMD_WIDTH];
+    rt_cell rv[RT_SIMD_WIDTH + 1][RT_SIMD_WIDTH];
+
+    rt_cell *k0 = (rt_cell *)buf, *v0 = k0 + m, *k1 = v0 + m, *v1 = k1 + m;
+    rt_cell *tmp;
+
+    for (j = 0; j < m; j += RT_SIMD_WIDTH * RT_SIMD_WIDTH)
+    {
+        for (i = 0; i <= RT_SIMD_WIDTH; i++)
+        {
+            for (l = 0; l < RT_SIMD_WIDTH; l++)
+            {
+                r = j + i * RT_SIMD_WIDTH + l;
+                t = i < RT_SIMD_WIDTH && r < n;
+                rk[i][l] = t ? sort_ord(key[r], fp) : SRT_MAX;
+                rv[i][l] = t && val != RT_NULL ? val[r] : 0;
+            }
+        }
+
+        for (r = 0; r < RT_SIMD_WIDTH; r++)
+        {
+            for (i = r & 1; i < RT_SIMD_WIDTH; i += 2)
+            {
+                for (l = 0; l < RT_SIMD_WIDTH; l++)
+                {
+                    if (rk[i][l] > rk[i + 1][l])
+                    {
+                        t = rk[i][l]; rk[i][l] = rk[i + 1][l];
+                        rk[i + 1][l] = t;
+                        t = rv[i][l]; rv[i][l] = rv[i + 1][l];
+                        rv[i + 1][l] = t;
+                    }
+                }
+            }
+        }
+
+        for (i = 0; i < RT_SIMD_WIDTH; i++)
+        {
+            for (l = 0; l < RT_SIMD_WIDTH; l++)
+            {
+                k0[j + i * RT_SIMD_WIDTH + l] = rk[l][i];
+                v0[j + i * RT_SIMD_WIDTH + l] = rv[l][i];
+            }
+        }
+    }
+
+    for (r = RT_SIMD_WIDTH; r < m; r *= 2)
+    {
+        for (j = 0; j < m; j += 2 * r)
+        {
+            l = RT_MIN(r, m - j);
+            sort_mrg_ref(k0 + j, v0 + j, l, RT_MIN(r, m - j - l),
+                         k1 + j, v1 + j);
+        }
+
+        tmp = k0; k0 = k1; k1 = tmp;
+        tmp = v0; v0 = v1; v1 = tmp;
+    }
+
+    for (j = 0; j < m; j++)
+    {
+        ok[j] = sort_ord(k0[j], fp);
+        if (val != RT_NULL)
+        {
+            ov[j] = v0[j];
+        }
+    }
+
+    if (val != RT_NULL)
+    {
+        sort_fix(ok, ov, n, m);
+    }
+}
+
+/*
+ * Array far0 (n elements, n is not a multiple of S) is sorted to out1,
+ * C version is std::sort of int32 images of fp32 keys (same order).
+ */
+rt_void c_test35(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, n = info->size;
+    rt_word *far0 = (rt_word *)info->far0;
+    rt_word *fco1 = (rt_word *)info->fco1;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        for (j = 0; j < n; j++)
+        {
+            fco1[j] = sort_ord(far0[j], RT_TRUE);
+        }
+
+        std::sort((rt_cell *)fco1, (rt_cell *)fco1 + n);
+
+        for (j = 0; j < n; j++)
+        {
+            fco1[j] = sort_ord(fco1[j], RT_TRUE);
+        }
+    }
+}
+
+rt_void s_test35(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        sort_simd(info, RT_TRUE, (rt_word *)info->far0, RT_NULL,
+                  (rt_word *)info->fso1, RT_NULL);
+    }
+}
+
+rt_void p_test35(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *fco1 = info->fco1;
+    rt_real *fso1 = info->fso1;
+
+    j = n;
+    while (j-->0)
+    {
+        if (IEQ(*(rt_word *)&fco1[j], *(rt_word *)&fso1[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("C key[%d] = %e (0x%08X), S key[%d] = %e (0x%08X)\n",
+                j, fco1[j], *(rt_word *)&fco1[j],
+                j, fso1[j], *(rt_word *)&fso1[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 35 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 36   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 36
+
+/*
+ * Array iar0 (n elements, n is not a multiple of S) is sorted to out1,
+ * C version is std::sort.
+ */
+rt_void c_test36(rt_SIMD_INFOX *info)
+{
+    rt_cell i, n = info->size;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        memcpy(info->ico1, info->iar0, n * sizeof(rt_cell));
+
+        std::sort(info->ico1, info->ico1 + n);
+    }
+}
+
+rt_void s_test36(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        sort_simd(info, RT_FALSE, (rt_word *)info->iar0, RT_NULL,
+                  (rt_word *)info->iso1, RT_NULL);
+    }
+}
+
+rt_void p_test36(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_cell *ico1 = info->ico1;
+    rt_cell *iso1 = info->iso1;
+
+    j = n;
+    while (j-->0)
+    {
+        if (IEQ(ico1[j], iso1[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("C key[%d] = %d, S key[%d] = %d\n",
+                j, ico1[j], j, iso1[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 36 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 37   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 37
+
+/*
+ * Keys far0 with values iar0 (n pairs) are sorted to out1 (keys)
+ * and out2 (values), values of equal keys come in the order given
+ * by the sorting network, thus C version mirrors it.
+ */
+rt_void c_test37(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        sort_ref(RT_TRUE, (rt_word *)info->far0, (rt_word *)info->iar0,
+                 info->size, (rt_word *)info->fco1, (rt_word *)info->ico2,
+                 info->sbuf);
+    }
+}
+
+rt_void s_test37(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        sort_simd(info, RT_TRUE, (rt_word *)info->far0,
+                  (rt_word *)info->iar0, (rt_word *)info->fso1,
+                  (rt_word *)info->iso2);
+    }
+}
+
+rt_void p_test37(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *fco1 = info->fco1;
+    rt_real *fso1 = info->fso1;
+    rt_cell *ico2 = info->ico2;
+    rt_cell *iso2 = info->iso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (IEQ(*(rt_word *)&fco1[j], *(rt_word *)&fso1[j]) &&
+            IEQ(ico2[j], iso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("C key[%d] = %e, value[%d] = %d\n",
+                j, fco1[j], j, ico2[j]);
+
+        RT_LOGI("S key[%d] = %e, value[%d] = %d\n",
+                j, fso1[j], j, iso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 37 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 38   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 38
+
+/*
+ * Keys iar0 with values far0 (n pairs) are sorted to out1 (keys)
+ * and out2 (values), C version mirrors the sorting network.
+ */
+rt_void c_test38(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        sort_ref(RT_FALSE, (rt_word *)info->iar0, (rt_word *)info->far0,
+                 info->size, (rt_word *)info->ico1, (rt_word *)info->fco2,
+                 info->sbuf);
+    }
+}
+
+rt_void s_test38(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        sort_simd(info, RT_FALSE, (rt_word *)info->iar0,
+                  (rt_word *)info->far0, (rt_word *)info->iso1,
+                  (rt_word *)info->fso2);
+    }
+}
+
+rt_void p_test38(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_cell *ico1 = info->ico1;
+    rt_cell *iso1 = info->iso1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso2 = info->fso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (IEQ(ico1[j], iso1[j]) &&
+            IEQ(*(rt_word *)&fco2[j], *(rt_word *)&fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("C key[%d] = %d, value[%d] = %e\n",
+                j, ico1[j], j, fco2[j]);
+
+        RT_LOGI("S key[%d] = %d, value[%d] = %e\n",
+                j, iso1[j], j, fso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 38 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 39   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 39
+
+/*
+ * Histogram kernels count fp32 elements in hbin buckets of width 1/hscl
+ * starting at hlo, elements below (or NaN) go to the first bucket,
+ * elements above go to the last one. Each lane counts to its own private
+ * sub-histogram (lane i at i*hpad words of hbuf, hpad is hbin rounded up
+ * to a multiple of S), thus gather-add-scatter never has conflicting lanes,
+ * sub-histograms are summed (and cleared for next use) by merge kernel.
+ * Bucket index is clamped (x - hlo) * hscl rounded towards minus infinity
+ * by cvtps in default mode with correction (switching the mode would also
+ * change rounding of the arithmetic), NaNs are masked out before min/max
+ * as their handling differs across targets. Lane offsets i*hpad are
+ * computed in fp32 (exact while hpad*S < 2^24).
+ */
+
+/*
+ * Scratch slots (SIMD vectors from fscr) of histogram kernels.
+ */
+#define HST_LO              DP(Q*0x010) /* hlo in all lanes */
+#define HST_SCL             DP(Q*0x020) /* hscl in all lanes */
+#define HST_MAX             DP(Q*0x030) /* last bucket (fp32) in all lanes */
+#define HST_OFF             DP(Q*0x040) /* i*hpad, sub-histogram of lane */
+
+/*
+ * Broadcast 32-bit field DS of info to all lanes of scratch slot DT.
+ * Destroys Xmm1.
+ */
+#define HST_BRD(DS, DT)                                                     \
+        splpx_ld(Xmm1, Mebp, W(DS))                                         \
+        movpx_st(Xmm1, Medi, W(DT))
+
+/*
+ * Bucket indices of elements in Xmm0 to Xmm0, cvtps rounds to nearest,
+ * thus 1 is subtracted (mask -1 added) where it rounded up.
+ * Destroys Xmm1, Xmm2.
+ */
+#define HST_BKT()                                                           \
+        subps_ld(Xmm0, Medi, HST_LO)                                        \
+        mulps_ld(Xmm0, Medi, HST_SCL)                                       \
+        movpx_rr(Xmm1, Xmm0)                                                \
+        ceqps_rr(Xmm1, Xmm0)                                                \
+        andpx_rr(Xmm0, Xmm1)                                                \
+        xorpx_rr(Xmm1, Xmm1)                                                \
+        maxps_rr(Xmm0, Xmm1)                                                \
+        minps_ld(Xmm0, Medi, HST_MAX)                                       \
+        cvtps_rr(Xmm1, Xmm0)                                                \
+        cvtpn_rr(Xmm2, Xmm1)                                                \
+        cgtps_rr(Xmm2, Xmm0)                                                \
+        addpx_rr(Xmm1, Xmm2)                                                \
+        movpx_rr(Xmm0, Xmm1)
+
+/*
+ * Add Xmm4 to buckets Xmm0 of private sub-histograms at Rebx.
+ * Destroys Xmm0, Xmm1.
+ */
+#define HST_CNT()                                                           \
+        addpx_ld(Xmm0, Medi, HST_OFF)                                       \
+        gatpx_ld(Xmm1, Xmm0, Mebx, DP(0x000))                               \
+        addpx_rr(Xmm1, Xmm4)                                                \
+        scapx_st(Xmm1, Xmm0, Mebx, DP(0x000))
+
+/*
+ * Bucket index ops of bucketing kernels (ix = 1),
+ * nothing is done in histogram-only kernels (ix = 0).
+ */
+#define HST_ILD0(RG, RM, DP)
+#define HST_ILD1(RG, RM, DP)                                                \
+        movxa_ld(W(RG), W(RM), W(DP))
+
+#define HST_IST0(RG, RM, DP)
+#define HST_IST1(RG, RM, DP)                                                \
+        movpx_st(W(RG), W(RM), W(DP))
+
+#define HST_IMS0(RG, RK, RM, DP)
+#define HST_IMS1(RG, RK, RM, DP)                                            \
+        mmvpx_st(W(RG), W(RK), W(RM), W(DP))
+
+#define HST_IAD0(RM, IM)
+#define HST_IAD1(RM, IM)                                                    \
+        addxx_ri(W(RM), W(IM))
+
+/*
+ * Count hcnt elements from hsrc to private sub-histograms at hbuf,
+ * which are expected to be zeroed (as left by merge), bucketing kernels
+ * also store bucket index of each element to hidx.
+ */
+#define HST_KNL(ix, lb)                                                     \
+        movxa_ld(Redi, Mebp, inf_FSCR)                                      \
+        HST_BRD(inf_HLO, HST_LO)                                            \
+        HST_BRD(inf_HSCL, HST_SCL)                                          \
+        HST_BRD(inf_HMAX, HST_MAX)                                          \
+        HST_BRD(inf_HPAD, HST_OFF)                                          \
+        movpx_ld(Xmm1, Medi, HST_OFF)                                       \
+        cvtpn_rr(Xmm1, Xmm1)                                                \
+        movpx_ld(Xmm2, Mebp, inf_GPC15)                                     \
+        cvtpn_rr(Xmm2, Xmm2)                                                \
+        mulps_rr(Xmm1, Xmm2)                                                \
+        cvtps_rr(Xmm1, Xmm1)                                                \
+        movpx_st(Xmm1, Medi, HST_OFF)                                       \
+        xorpx_rr(Xmm4, Xmm4)                                                \
+        xorpx_rr(Xmm1, Xmm1)                                                \
+        ceqps_rr(Xmm1, Xmm1)                                                \
+        subpx_rr(Xmm4, Xmm1)                                                \
+        movxa_ld(Recx, Mebp, inf_HSRC)                                      \
+        movxa_ld(Rebx, Mebp, inf_HBUF)                                      \
+        HST_ILD##ix(Redx, Mebp, inf_HIDX)                                   \
+        movxx_ld(Reax, Mebp, inf_HCNT)                                      \
+        cmpxx_ri(Reax, IB(S))                                               \
+        jltxx_lb(lb##_tl1)                                                  \
+    LBL(lb##_blk)                                                           \
+        movpx_ld(Xmm0, Mecx, DP(0x000))                                     \
+        HST_BKT()                                                           \
+        HST_IST##ix(Xmm0, Medx, DP(0x000))                                  \
+        HST_CNT()                                                           \
+        addxx_ri(Recx, IB(Q*0x010))                                         \
+        HST_IAD##ix(Redx, IB(Q*0x010))                                      \
+        subxx_ri(Reax, IB(S))                                               \
+        cmpxx_ri(Reax, IB(S))                                               \
+        jgexx_lb(lb##_blk)                                                  \
+    LBL(lb##_tl1)                                                           \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jeqxx_lb(lb##_end)                                                  \
+        mskpx_rr(Xmm5, Reax)                                                \
+        xorpx_rr(Xmm0, Xmm0)                                                \
+        mmvpx_ld(Xmm0, Xmm5, Mecx, DP(0x000))                               \
+        andpx_rr(Xmm4, Xmm5)                                                \
+        HST_BKT()                                                           \
+        HST_IMS##ix(Xmm0, Xmm5, Medx, DP(0x000))                            \
+        HST_CNT()                                                           \
+    LBL(lb##_end)
+
+/*
+ * Sum hnum sub-histograms (hstr bytes apart) from hbuf to hout for hrem
+ * vectors of S buckets, summed sub-histograms are cleared.
+ */
+#define HST_MRG(lb)                                                         \
+        movxa_ld(Recx, Mebp, inf_HBUF)                                      \
+        movxa_ld(Redx, Mebp, inf_HOUT)                                      \
+        movxx_ld(Reax, Mebp, inf_HREM)                                      \
+        xorpx_rr(Xmm7, Xmm7)                                                \
+    LBL(lb##_vec)                                                           \
+        cmpxx_ri(Reax, IB(0))                                               \
+        jeqxx_lb(lb##_end)                                                  \
+        xorpx_rr(Xmm0, Xmm0)                                                \
+        movxx_rr(Resi, Recx)                                                \
+        movxx_ld(Rebx, Mebp, inf_HNUM)                                      \
+    LBL(lb##_sum)                                                           \
+        addpx_ld(Xmm0, Mesi, DP(0x000))                                     \
+        movpx_st(Xmm7, Mesi, DP(0x000))                                     \
+        addxx_ld(Resi, Mebp, inf_HSTR)                                      \
+        subxx_ri(Rebx, IB(1))                                               \
+        cmpxx_ri(Rebx, IB(0))                                               \
+        jgtxx_lb(lb##_sum)                                                  \
+        movpx_st(Xmm0, Medx, DP(0x000))                                     \
+        addxx_ri(Recx, IB(Q*0x010))                                         \
+        addxx_ri(Redx, IB(Q*0x010))                                         \
+        subxx_ri(Reax, IB(1))                                               \
+        jmpxx_lb(lb##_vec)                                                  \
+    LBL(lb##_end)
+
+rt_void hist_ps(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        HST_KNL(0, hsf)
+    ASM_LEAVE(info)
+}
+
+rt_void hist_idx_ps(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        HST_KNL(1, hsx)
+    ASM_LEAVE(info)
+}
+
+rt_void hist_mrg(rt_SIMD_INFOX *info)
+{
+    ASM_ENTER(info)
+        HST_MRG(hmg)
+    ASM_LEAVE(info)
+}
+
+/*
+ * Set bins buckets over lo .. hi for histogram kernels.
+ */
+rt_void hist_set(rt_SIMD_INFOX *info, rt_cell bins, rt_real lo, rt_real hi)
+{
+    info->hpad = RT_SOA_PAD(bins);
+    info->hlo  = lo;
+    info->hscl = (rt_real)bins / (hi - lo);
+    info->hmax = (rt_real)(bins - 1);
+}
+
+/*
+ * Count size elements of src to hpad buckets of cnt (bucket indices
+ * to idx unless it is NULL) with a single thread.
+ */
+rt_void hist_run(rt_SIMD_INFOX *info, rt_real *src, rt_cell *cnt,
+                 rt_cell *idx)
+{
+    info->hsrc = src;
+    info->hcnt = info->size;
+    info->hidx = (rt_word *)idx;
+
+    if (idx != RT_NULL)
+    {
+        hist_idx_ps(info);
+    }
+    else
+    {
+        hist_ps(info);
+    }
+
+    info->hout = (rt_word *)cnt;
+    info->hrem = info->hpad / RT_SIMD_WIDTH;
+    info->hnum = RT_SIMD_WIDTH;
+    info->hstr = info->hpad * sizeof(rt_word);
+
+    hist_mrg(info);
+}
+
+/*
+ * Bucket index of element x as done by HST_BKT.
+ */
+rt_cell hist_bkt(rt_SIMD_INFOX *info, rt_real x)
+{
+    rt_real t = (x - info->hlo) * info->hscl;
+
+    t = t == t ? t : 0.0f;
+    t = RT_MAX(t, 0.0f);
+    t = RT_MIN(t, info->hmax);
+
+    return (rt_cell)floorf(t);
+}
+
+/*
+ * Count size elements of src to hpad buckets of cnt
+ * (bucket indices to idx unless it is NULL) in C.
+ */
+rt_void hist_ref(rt_SIMD_INFOX *info, rt_real *src, rt_cell *cnt,
+                 rt_cell *idx)
+{
+    rt_cell j, b, n = info->size;
+
+    memset(cnt, 0, info->hpad * sizeof(rt_cell));
+
+    for (j = 0; j < n; j++)
+    {
+        b = hist_bkt(info, src[j]);
+        cnt[b]++;
+
+        if (idx != RT_NULL)
+        {
+            idx[j] = b;
+        }
+    }
+}
+
+/*
+ * Array far0 is counted to HST_BINS buckets over -64.0 .. +64.0 in out1,
+ * bucket index of each element is stored to out2.
+ */
+rt_void c_test39(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    hist_set(info, HST_BINS, -64.0f, +64.0f);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        hist_ref(info, info->far0, info->ico1, info->ico2);
+    }
+}
+
+rt_void s_test39(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    hist_set(info, HST_BINS, -64.0f, +64.0f);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        hist_run(info, info->far0, info->iso1, info->iso2);
+    }
+}
+
+rt_void p_test39(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_cell *ico1 = info->ico1;
+    rt_cell *ico2 = info->ico2;
+    rt_cell *iso1 = info->iso1;
+    rt_cell *iso2 = info->iso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (IEQ(ico1[j], iso1[j]) && IEQ(ico2[j], iso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("farr[%d] = %e\n",
+                j, far0[j]);
+
+        RT_LOGI("C count[%d] = %d, bucket[%d] = %d\n",
+                j, ico1[j], j, ico2[j]);
+
+        RT_LOGI("S count[%d] = %d, bucket[%d] = %d\n",
+                j, iso1[j], j, iso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 39 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 40   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 40
+
+rt_void hist_ps_thr(rt_pntr data, rt_cell k)
+{
+    hist_ps((rt_SIMD_INFOX *)data + k);
+}
+
+rt_void hist_mrg_thr(rt_pntr data, rt_cell k)
+{
+    hist_mrg((rt_SIMD_INFOX *)data + k);
+}
+
+/*
+ * Count size elements of src to hpad buckets of cnt in THR_SIZE chunks:
+ * each thread counts its chunk to its own S sub-histograms (hbuf holds
+ * THR_SIZE * S * hpad words), then each thread sums its slice of buckets
+ * over all THR_SIZE * S sub-histograms.
+ */
+rt_void hist_par(rt_SIMD_INFOX *info, rt_real *src, rt_cell *cnt,
+              rt_bool para)
+{
+    rt_SIMD_INFOX *thr = info->thrd;
+    rt_cell k, n = info->size, c = SCN_CHUNK(n);
+    rt_cell v = info->hpad / RT_SIMD_WIDTH;
+    rt_cell w = (v + THR_SIZE - 1) / THR_SIZE;
+
+    for (k = 0; k < THR_SIZE; k++)
+    {
+        memcpy(&thr[k], info, sizeof(rt_SIMD_INFOX));
+
+        thr[k].fscr = thr_scr[k];
+        thr[k].hsrc = src + k * c;
+        thr[k].hcnt = RT_MAX(RT_MIN(n - k * c, c), 0);
+        thr[k].hbuf = info->hbuf + k * RT_SIMD_WIDTH * info->hpad;
+    }
+
+    thrd_run(info, hist_ps_thr, para);
+
+    for (k = 0; k < THR_SIZE; k++)
+    {
+        thr[k].hbuf = info->hbuf + k * w * RT_SIMD_WIDTH;
+        thr[k].hout = (rt_word *)cnt + k * w * RT_SIMD_WIDTH;
+        thr[k].hrem = RT_MAX(RT_MIN(v - k * w, w), 0);
+        thr[k].hnum = THR_SIZE * RT_SIMD_WIDTH;
+        thr[k].hstr = info->hpad * sizeof(rt_word);
+    }
+
+    thrd_run(info, hist_mrg_thr, para);
+}
+
+/*
+ * Array far0 is counted to HST_BINS buckets over -64.0 .. +64.0 in out1
+ * by THR_SIZE threads, same as level 39 counts.
+ */
+rt_void c_test40(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    hist_set(info, HST_BINS, -64.0f, +64.0f);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        hist_ref(info, info->far0, info->ico1, RT_NULL);
+    }
+}
+
+rt_void s_test40(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    hist_set(info, HST_BINS, -64.0f, +64.0f);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        hist_par(info, info->far0, info->iso1, i == 0);
+    }
+}
+
+rt_void p_test40(rt_SIMD_INFOX *info)
+{
+    p_test39(info);
+}
+
+#endif /* RUN_LEVEL 40 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 41   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 41
+
+#define MEM_LEN             (S*32) /* max bytes in copy sweep, 2 blocks */
+#define MEM_WIN             (MEM_LEN + RT_SIMD_ALIGN*2) /* sweep window */
+
+/*
+ * Signature of size bytes at p (depends on the order of bytes).
+ */
+rt_word mem_sign(rt_byte *p, rt_cell size)
+{
+    rt_word h = 0;
+    rt_cell j;
+
+    for (j = 0; j < size; j++)
+    {
+        h = h * 31 + p[j];
+    }
+
+    return h;
+}
+
+/*
+ * Array iar0 is copied to out1, its bytes from 6 on are copied to out2
+ * from byte 3 on (S uses non-temporal stores for out2). Then (not done
+ * in -b mode) for every length 0..MEM_LEN bytes of iar0 from every offset
+ * 0..RT_SIMD_ALIGN-1 are copied to every offset 0..RT_SIMD_ALIGN-1 of
+ * a window in fscr filled with 0xEE, signatures of the whole window
+ * (bytes around the copy included) are folded to fco1/fso1 per length,
+ * which covers all head and tail cases of the kernels, C uses libc.
+ */
+rt_void c_test41(rt_SIMD_INFOX *info)
+{
+    rt_cell i, l, d, o;
+    rt_size n = info->size * sizeof(rt_cell);
+
+    rt_byte *iar0 = (rt_byte *)info->iar0;
+    rt_byte *ico1 = (rt_byte *)info->ico1;
+    rt_byte *ico2 = (rt_byte *)info->ico2;
+    rt_byte *fscr = (rt_byte *)info->fscr;
+    rt_word *fco1 = (rt_word *)info->fco1;
+
+    memset(ico2, 0, n);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        memcpy(ico1, iar0, n);
+        memcpy(ico2 + 3, iar0 + 6, n - 7);
+    }
+
+    if (bench_size > 0)
+    {
+        return;
+    }
+
+    for (l = 0; l <= MEM_LEN; l++)
+    {
+        fco1[l] = 0;
+
+        for (d = 0; d < RT_SIMD_ALIGN; d++)
+        {
+            for (o = 0; o < RT_SIMD_ALIGN; o++)
+            {
+                memset(fscr, 0xEE, MEM_WIN);
+                memcpy(fscr + d, iar0 + o, l);
+                fco1[l] = fco1[l] * 31 + mem_sign(fscr, MEM_WIN);
+            }
+        }
+    }
+}
+
+rt_void s_test41(rt_SIMD_INFOX *info)
+{
+    rt_cell i, l, d, o;
+    rt_size n = info->size * sizeof(rt_cell);
+
+    rt_byte *iar0 = (rt_byte *)info->iar0;
+    rt_byte *iso1 = (rt_byte *)info->iso1;
+    rt_byte *iso2 = (rt_byte *)info->iso2;
+    rt_byte *fscr = (rt_byte *)info->fscr;
+    rt_word *fso1 = (rt_word *)info->fso1;
+
+    memset(iso2, 0, n);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        rt_memcpy(iso1, iar0, n);
+        rt_memcpy_nt(iso2 + 3, iar0 + 6, n - 7);
+    }
+
+    if (bench_size > 0)
+    {
+        return;
+    }
+
+    for (l = 0; l <= MEM_LEN; l++)
+    {
+        fso1[l] = 0;
+
+        for (d = 0; d < RT_SIMD_ALIGN; d++)
+        {
+            for (o = 0; o < RT_SIMD_ALIGN; o++)
+            {
+                memset(fscr, 0xEE, MEM_WIN);
+                rt_memcpy(fscr + d, iar0 + o, l);
+                fso1[l] = fso1[l] * 31 + mem_sign(fscr, MEM_WIN);
+            }
+        }
+    }
+}
+
+/*
+ * Compare out1, out2 of memory levels.
+ */
+rt_void mem_test(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_cell *iar0 = info->iar0;
+    rt_cell *ico1 = info->ico1;
+    rt_cell *ico2 = info->ico2;
+    rt_cell *iso1 = info->iso1;
+    rt_cell *iso2 = info->iso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (IEQ(ico1[j], iso1[j]) && IEQ(ico2[j], iso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("iarr[%d] = 0x%08X\n",
+                j, iar0[j]);
+
+        RT_LOGI("C out1[%d] = 0x%08X, out2[%d] = 0x%08X\n",
+                j, ico1[j], j, ico2[j]);
+
+        RT_LOGI("S out1[%d] = 0x%08X, out2[%d] = 0x%08X\n",
+                j, iso1[j], j, iso2[j]);
+    }
+}
+
+rt_void p_test41(rt_SIMD_INFOX *info)
+{
+    rt_cell j;
+
+    rt_word *fco1 = (rt_word *)info->fco1;
+    rt_word *fso1 = (rt_word *)info->fso1;
+
+    mem_test(info);
+
+    j = MEM_LEN + 1;
+    while (j-->0)
+    {
+        if (fco1[j] == fso1[j] && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("C sweep[%d] = 0x%08X\n",
+                j, fco1[j]);
+
+        RT_LOGI("S sweep[%d] = 0x%08X\n",
+                j, fso1[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 41 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 42   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 42
+
+/*
+ * Out1 is filled with byte 0xA5, out2 with low byte of iar0[0] except
+ * its first and last bytes (S uses non-temporal stores for out2),
+ * C uses libc.
+ */
+rt_void c_test42(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+    rt_size n = info->size * sizeof(rt_cell);
+
+    rt_byte *ico1 = (rt_byte *)info->ico1;
+    rt_byte *ico2 = (rt_byte *)info->ico2;
+
+    memset(ico2, 0, n);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        memset(ico1, 0xA5, n);
+        memset(ico2 + 1, info->iar0[0], n - 2);
+    }
+}
+
+rt_void s_test42(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+    rt_size n = info->size * sizeof(rt_cell);
+
+    rt_byte *iso1 = (rt_byte *)info->iso1;
+    rt_byte *iso2 = (rt_byte *)info->iso2;
+
+    memset(iso2, 0, n);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        rt_memset(iso1, 0xA5, n);
+        rt_memset_nt(iso2 + 1, info->iar0[0], n - 2);
+    }
+}
+
+rt_void p_test42(rt_SIMD_INFOX *info)
+{
+    mem_test(info);
+}
+
+#endif /* RUN_LEVEL 42 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 43   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 43
+
+#define MEM_NUM             8 /* mismatch positions in memcmp level */
+
+/*
+ * Bytes of iar0 are copied to out2 from byte 1 on, then compared
+ * with a byte flipped at MEM_NUM positions spread over the copy,
+ * signs of results go to out1 followed by equal compares at different
+ * offsets, C uses libc.
+ */
+rt_void c_test43(rt_SIMD_INFOX *info)
+{
+    rt_cell i, k, r;
+    rt_size p, n = info->size * sizeof(rt_cell) - 1;
+
+    rt_byte *iar0 = (rt_byte *)info->iar0;
+    rt_cell *ico1 = info->ico1;
+    rt_byte *ico2 = (rt_byte *)info->ico2 + 1;
+
+    memset(info->ico2, 0, n + 1);
+    memcpy(ico2, iar0, n);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        for (k = 0; k < MEM_NUM; k++)
+        {
+            p = (n - 1) * k / (MEM_NUM - 1);
+            ico2[p] ^= 1 << k;
+            r = memcmp(iar0, ico2, n);
+            ico2[p] ^= 1 << k;
+            ico1[k] = (r > 0) - (r < 0);
+        }
+
+        r = memcmp(iar0, ico2, n);
+        ico1[k + 0] = (r > 0) - (r < 0);
+        r = memcmp(iar0 + 3, ico2 + 3, n - 3);
+        ico1[k + 1] = (r > 0) - (r < 0);
+    }
+}
+
+rt_void s_test43(rt_SIMD_INFOX *info)
+{
+    rt_cell i, k, r;
+    rt_size p, n = info->size * sizeof(rt_cell) - 1;
+
+    rt_byte *iar0 = (rt_byte *)info->iar0;
+    rt_cell *iso1 = info->iso1;
+    rt_byte *iso2 = (rt_byte *)info->iso2 + 1;
+
+    memset(info->iso2, 0, n + 1);
+    memcpy(iso2, iar0, n);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        for (k = 0; k < MEM_NUM; k++)
+        {
+            p = (n - 1) * k / (MEM_NUM - 1);
+            iso2[p] ^= 1 << k;
+            r = rt_memcmp(iar0, iso2, n);
+            iso2[p] ^= 1 << k;
+            iso1[k] = (r > 0) - (r < 0);
+        }
+
+        r = rt_memcmp(iar0, iso2, n);
+        iso1[k + 0] = (r > 0) - (r < 0);
+        r = rt_memcmp(iar0 + 3, iso2 + 3, n - 3);
+        iso1[k + 1] = (r > 0) - (r < 0);
+    }
+}
+
+rt_void p_test43(rt_SIMD_INFOX *info)
+{
+    mem_test(info);
+}
+
+#endif /* RUN_LEVEL 43 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 44   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 44
+
+/*
+ * Extended register files: inputs are kept in Xmm8..XmmA, results are
+ * formed in XmmB..XmmF (and Xmm0 for mixed encodings), pointers are kept
+ * in Reg8..RegE and used as Meg** and Ieg** bases, targets with 8 SIMD
+ * or 8 core registers run the same math on the lower registers.
+ */
+rt_void c_test44(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = n;
+        while (j-->0)
+        {
+            fco1[j] = far0[j] * far0[(j + S) % n] + far0[j];
+            fco2[j] = (far0[j] - far0[(j + S) % n]) * far0[(j + S) % n];
+        }
+    }
+}
+
+rt_void s_test44(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        ASM_ENTER(info)
+
+#if RT_SIMD_REGS >= 16 && RT_CORE_REGS >= 15
+
+        movxa_ld(Reg8, Mebp, inf_FAR0)
+        movxa_ld(Reg9, Mebp, inf_FSO1)
+        movxa_ld(RegA, Mebp, inf_FSO2)
+        movxx_rr(RegB, Reg8)
+        movxx_rr(RegC, Reg9)
+        movxx_rr(RegD, RegA)
+        movxx_rr(RegE, Reg9)
+        movxx_ri(Reax, IB(0))
+
+        movpx_ld(Xmm8, Meg8, AJ0)
+        movpx_ld(Xmm9, MegB, AJ1)
+        movpx_ld(XmmA, IegB, AJ2)
+
+        movpx_rr(XmmB, Xmm8)
+        mulps_rr(XmmB, Xmm9)
+        addps_rr(XmmB, Xmm8)
+        movpx_rr(XmmC, Xmm8)
+        subps_rr(XmmC, Xmm9)
+        mulps_rr(XmmC, Xmm9)
+        movpx_st(XmmB, Meg9, AJ0)
+        movpx_st(XmmC, MegA, AJ0)
+
+        movpx_rr(XmmD, Xmm9)
+        mulps_rr(XmmD, XmmA)
+        addps_rr(XmmD, Xmm9)
+        movpx_rr(XmmE, Xmm9)
+        subps_rr(XmmE, XmmA)
+        mulps_rr(XmmE, XmmA)
+        movpx_st(XmmD, MegC, AJ1)
+        movpx_st(XmmE, MegD, AJ1)
+
+        movpx_rr(XmmF, XmmA)
+        mulps_rr(XmmF, Xmm8)
+        addps_rr(XmmF, XmmA)
+        movpx_rr(Xmm0, XmmA)
+        subps_rr(Xmm0, Xmm8)
+        mulps_rr(Xmm0, Xmm8)
+        movpx_st(XmmF, IegE, AJ2)
+        movpx_st(Xmm0, MegD, AJ2)
+
+#else /* RT_SIMD_REGS < 16 || RT_CORE_REGS < 15 */
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
+
+        movpx_ld(Xmm0, Mecx, AJ0)
+        movpx_ld(Xmm1, Mecx, AJ1)
+        movpx_ld(Xmm2, Mecx, AJ2)
+
+        movpx_rr(Xmm3, Xmm0)
+        mulps_rr(Xmm3, Xmm1)
+        addps_rr(Xmm3, Xmm0)
+        movpx_rr(Xmm4, Xmm0)
+        subps_rr(Xmm4, Xmm1)
+        mulps_rr(Xmm4, Xmm1)
+        movpx_st(Xmm3, Medx, AJ0)
+        movpx_st(Xmm4, Mebx, AJ0)
+
+        movpx_rr(Xmm3, Xmm1)
+        mulps_rr(Xmm3, Xmm2)
+        addps_rr(Xmm3, Xmm1)
+        movpx_rr(Xmm4, Xmm1)
+        subps_rr(Xmm4, Xmm2)
+        mulps_rr(Xmm4, Xmm2)
+        movpx_st(Xmm3, Medx, AJ1)
+        movpx_st(Xmm4, Mebx, AJ1)
+
+        movpx_rr(Xmm3, Xmm2)
+        mulps_rr(Xmm3, Xmm0)
+        addps_rr(Xmm3, Xmm2)
+        movpx_rr(Xmm4, Xmm2)
+        subps_rr(Xmm4, Xmm0)
+        mulps_rr(Xmm4, Xmm0)
+        movpx_st(Xmm3, Medx, AJ2)
+        movpx_st(Xmm4, Mebx, AJ2)
+
+#endif /* RT_SIMD_REGS, RT_CORE_REGS */
+
+        ASM_LEAVE(info)
+    }
+}
+
+rt_void p_test44(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && FEQ(fco2[j], fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("farr[%d] = %e, farr[%d] = %e\n",
+                j, far0[j], (j + S) % n, far0[(j + S) % n]);
+
+        RT_LOGI("C a*b+a = %e, (a-b)*b = %e\n", fco1[j], fco2[j]);
+
+        RT_LOGI("S a*b+a = %e, (a-b)*b = %e\n", fso1[j], fso2[j]);
+    }
+}
+
+rt_void d_test44(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_fp64 *dre1 = info->dre1;
+    rt_fp64 *dre2 = info->dre2;
+
+    j = n;
+    while (j-->0)
+    {
+        dre1[j] = (rt_fp64)far0[j] * (rt_fp64)far0[(j + S) % n]
+                + (rt_fp64)far0[j];
+        dre2[j] = ((rt_fp64)far0[j] - (rt_fp64)far0[(j + S) % n])
+                * (rt_fp64)far0[(j + S) % n];
+    }
+}
+
+#endif /* RUN_LEVEL 44 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 45   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 45
+
+/*
+ * Array of n / 16 rt_mat4 elements A in rt_AoSoA<16> blocks is transposed
+ * into out1 (A^T) by the standalone transpose kernel, which then transposes
+ * out1 into out2 (A^T^T, equal to A).
+ */
+rt_void mat_trn4(rt_mat4 b, rt_mat4 a)
+{
+    rt_cell i, j;
+
+    for (i = 0; i < 4; i++)
+    {
+        for (j = 0; j < 4; j++)
+        {
+            b[i][j] = a[j][i];
+        }
+    }
+}
+
+rt_void c_test45(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k;
+    rt_AoSoA<16> ain(info->far0, info->size / 16);
+    rt_AoSoA<16> ao1(info->fco1, info->size / 16);
+    rt_AoSoA<16> ao2(info->fco2, info->size / 16);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = ain.pads;
+        while (j-->0)
+        {
+            rt_mat4 a, b, c;
+
+            for (k = 0; k < 16; k++)
+            {
+                a[k / 4][k % 4] = *ain.elem(j, k);
+            }
+
+            mat_trn4(b, a);
+            mat_trn4(c, b);
+
+            for (k = 0; k < 16; k++)
+            {
+                *ao1.elem(j, k) = b[k / 4][k % 4];
+                *ao2.elem(j, k) = c[k / 4][k % 4];
+            }
+        }
+    }
+}
+
+/*
+ * Element (c, r) of matrix in MD is element (r, c) of matrix in MS.
+ */
+#define TRP_ELM(MS, MD, r, c)                                               \
+        movpx_ld(Xmm0, W(MS), MJ(r*4+c))                                    \
+        movpx_st(Xmm0, W(MD), MJ(c*4+r))
+
+/*
+ * Transpose of matrix in MS to MD (must not be the same). Destroys Xmm0.
+ */
+#define TRP_MAT(MS, MD)                                                     \
+        TRP_ELM(W(MS), W(MD), 0, 0)                                         \
+        TRP_ELM(W(MS), W(MD), 0, 1)                                         \
+        TRP_ELM(W(MS), W(MD), 0, 2)                                         \
+        TRP_ELM(W(MS), W(MD), 0, 3)                                         \
+        TRP_ELM(W(MS), W(MD), 1, 0)                                         \
+        TRP_ELM(W(MS), W(MD), 1, 1)                                         \
+        TRP_ELM(W(MS), W(MD), 1, 2)                                         \
+        TRP_ELM(W(MS), W(MD), 1, 3)                                         \
+        TRP_ELM(W(MS), W(MD), 2, 0)                                         \
+        TRP_ELM(W(MS), W(MD), 2, 1)                                         \
+        TRP_ELM(W(MS), W(MD), 2, 2)                                         \
+        TRP_ELM(W(MS), W(MD), 2, 3)                                         \
+        TRP_ELM(W(MS), W(MD), 3, 0)                                         \
+        TRP_ELM(W(MS), W(MD), 3, 1)                                         \
+        TRP_ELM(W(MS), W(MD), 3, 2)                                         \
+        TRP_ELM(W(MS), W(MD), 3, 3)
+
+rt_void s_test45(rt_SIMD_INFOX *info)
+{
+    rt_AoSoA<16> ain(info->far0, info->size / 16);
+
+    info->cnt = ain.blocks();
+
+    ASM_ENTER(info)
+
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(trp_cyc)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Rebx, Mebp, inf_FSO1)
+        movxa_ld(Resi, Mebp, inf_FSO2)
+        movxx_ld(Reax, Mebp, inf_CNT)
+
+    LBL(trp_blk)
+
+        TRP_MAT(Mecx, Mebx)
+        TRP_MAT(Mebx, Mesi)
+
+        addxx_ri(Recx, IH(Q*0x100))
+        addxx_ri(Rebx, IH(Q*0x100))
+        addxx_ri(Resi, IH(Q*0x100))
+        subxx_ri(Reax, IB(1))
+        cmpxx_ri(Reax, IB(0))
+        jgtxx_lb(trp_blk)
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jgtxx_lb(trp_cyc)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test45(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && FEQ(fco2[j], fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("farr[%d] = %e\n",
+                j, far0[j]);
+
+        RT_LOGI("C A^T[%d] = %e, A^T^T[%d] = %e\n",
+                j, fco1[j], j, fco2[j]);
+
+        RT_LOGI("S A^T[%d] = %e, A^T^T[%d] = %e\n",
+                j, fso1[j], j, fso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 45 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 46   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 46
+
+/*
+ * Array of n / 16 rt_mat4 elements A in rt_AoSoA<16> blocks is inverted
+ * into out1 by the standalone inverse kernel (same order of operations
+ * as in run level 24), out1 is then transposed into out2 (normal matrix).
+ */
+rt_void c_test46(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, k;
+    rt_AoSoA<16> ain(info->far0, info->size / 16);
+    rt_AoSoA<16> ao1(info->fco1, info->size / 16);
+    rt_AoSoA<16> ao2(info->fco2, info->size / 16);
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = ain.pads;
+        while (j-->0)
+        {
+            rt_mat4 a, b, c;
+
+            for (k = 0; k < 16; k++)
+            {
+                a[k / 4][k % 4] = *ain.elem(j, k);
+            }
+
+            mat_inv4(b, a);
+            mat_trn4(c, b);
+
+            for (k = 0; k < 16; k++)
+            {
+                *ao1.elem(j, k) = b[k / 4][k % 4];
+                *ao2.elem(j, k) = c[k / 4][k % 4];
+            }
+        }
+    }
+}
+
+rt_void s_test46(rt_SIMD_INFOX *info)
+{
+    rt_AoSoA<16> ain(info->far0, info->size / 16);
+
+    info->cnt = ain.blocks();
+
+    ASM_ENTER(info)
+
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(inv_cyc)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Resi, Mebp, inf_FSO1)
+        movxa_ld(Rebx, Mebp, inf_FSO2)
+        movxa_ld(Redi, Mebp, inf_FSCR)
+        movxx_ld(Reax, Mebp, inf_CNT)
+
+    LBL(inv_blk)
+
+        INV_MAT(INV_ROW)
+        TRP_MAT(Mesi, Mebx)
+
+        addxx_ri(Recx, IH(Q*0x100))
+        addxx_ri(Resi, IH(Q*0x100))
+        addxx_ri(Rebx, IH(Q*0x100))
+        subxx_ri(Reax, IB(1))
+        cmpxx_ri(Reax, IB(0))
+        jgtxx_lb(inv_blk)
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jgtxx_lb(inv_cyc)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test46(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fco2 = info->fco2;
+    rt_real *fso1 = info->fso1;
+    rt_real *fso2 = info->fso2;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && FEQ(fco2[j], fso2[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("farr[%d] = %e\n",
+                j, far0[j]);
+
+        RT_LOGI("C inv(A)[%d] = %e, inv(A)^T[%d] = %e\n",
+                j, fco1[j], j, fco2[j]);
+
+        RT_LOGI("S inv(A)[%d] = %e, inv(A)^T[%d] = %e\n",
+                j, fso1[j], j, fso2[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 46 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 47   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 47
+
+/*
+ * Array of n fp32 elements x (n is a multiple of S) is streamed through
+ * sscal alpha * x into out1, fp32 baseline for the fp16 stream of level 48
+ * (8 bytes of memory traffic per element).
+ */
+rt_void c_test47(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, n = info->size;
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = n;
+        while (j-->0)
+        {
+            fco1[j] = far0[j] * info->alpha;
+        }
+    }
+}
+
+rt_void s_test47(rt_SIMD_INFOX *info)
+{
+    info->cnt = info->size;
+
+    ASM_ENTER(info)
+
+        splpx_ld(Xmm7, Mebp, inf_ALPHA)
+
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(f32_cyc)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Resi, Mebp, inf_FSO1)
+        movxx_ld(Reax, Mebp, inf_CNT)
+
+    LBL(f32_blk)
+
+        movpx_ld(Xmm0, Mecx, DP(0x000))
+        mulps_rr(Xmm0, Xmm7)
+        movpx_st(Xmm0, Mesi, DP(0x000))
+
+        addxx_ri(Recx, IB(Q*0x010))
+        addxx_ri(Resi, IB(Q*0x010))
+        subxx_ri(Reax, IB(S))
+        cmpxx_ri(Reax, IB(0))
+        jgtxx_lb(f32_blk)
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jgtxx_lb(f32_cyc)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test47(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_real *far0 = info->far0;
+    rt_real *fco1 = info->fco1;
+    rt_real *fso1 = info->fso1;
+
+    j = n;
+    while (j-->0)
+    {
+        if (FEQ(fco1[j], fso1[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("x[%d] = %e\n",
+                j, far0[j]);
+
+        RT_LOGI("C sscal[%d] = %e\n",
+                j, fco1[j]);
+
+        RT_LOGI("S sscal[%d] = %e\n",
+                j, fso1[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 47 */
+
+/******************************************************************************/
+/******************************   RUN LEVEL 48   ******************************/
+/******************************************************************************/
+
+#if RUN_LEVEL >= 48
+
+/*
+ * Array of n fp16 elements x (packed in the first 2 * n bytes of iar0)
+ * is streamed through sscal alpha * x computed in fp32 into n fp16
+ * elements of out1, same work as level 47 at half the memory traffic.
+ * Fp16 denormals are flushed to zero by the ARM fallback of cvhps_ld.
+ */
+rt_half fp16_scal(rt_half h, rt_real alpha)
+{
+#if defined (RT_ARM) && RT_SIMD_FP16 == 0
+    h = (h & 0x7C00) == 0 ? h & 0x8000 : h;
+#endif /* RT_ARM, RT_SIMD_FP16 */
+
+    return fp32_to_fp16(fp16_to_fp32(h) * alpha);
+}
+
+rt_void c_test48(rt_SIMD_INFOX *info)
+{
+    rt_cell i, j, n = info->size;
+    rt_half *har0 = (rt_half *)info->iar0;
+    rt_half *hco1 = (rt_half *)info->ico1;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        j = n;
+        while (j-->0)
+        {
+            hco1[j] = fp16_scal(har0[j], info->alpha);
+        }
+    }
+}
+
+rt_void s_test48(rt_SIMD_INFOX *info)
+{
+    info->cnt = info->size;
+
+    ASM_ENTER(info)
+
+        splpx_ld(Xmm7, Mebp, inf_ALPHA)
+
+        movxx_ld(Reax, Mebp, inf_CYC)
+        movxx_st(Reax, Mebp, inf_LOC)
+
+    LBL(f16_cyc)
+
+        movxa_ld(Recx, Mebp, inf_IAR0)
+        movxa_ld(Resi, Mebp, inf_ISO1)
+        movxx_ld(Reax, Mebp, inf_CNT)
+
+    LBL(f16_blk)
+
+        cvhps_ld(Xmm0, Xmm1, Xmm2, Mecx, DP(0x000))
+        mulps_rr(Xmm0, Xmm7)
+        cvpsh_st(Xmm0, Xmm1, Xmm2, Mesi, DP(0x000))
+
+        addxx_ri(Recx, IB(Q*0x008))
+        addxx_ri(Resi, IB(Q*0x008))
+        subxx_ri(Reax, IB(S))
+        cmpxx_ri(Reax, IB(0))
+        jgtxx_lb(f16_blk)
+
+        subxx_mi(Mebp, inf_LOC, IB(1))
+        cmpxx_mi(Mebp, inf_LOC, IB(0))
+        jgtxx_lb(f16_cyc)
+
+    ASM_LEAVE(info)
+}
+
+rt_void p_test48(rt_SIMD_INFOX *info)
+{
+    rt_cell j, n = info->size;
+
+    rt_half *har0 = (rt_half *)info->iar0;
+    rt_half *hco1 = (rt_half *)info->ico1;
+    rt_half *hso1 = (rt_half *)info->iso1;
+
+    j = n;
+    while (j-->0)
+    {
+        if (IEQ(hco1[j], hso1[j]) && !v_mode)
+        {
+            continue;
+        }
+
+        RT_LOGI("x[%d] = %04X\n",
+                j, har0[j]);
+
+        RT_LOGI("C sscal[%d] = %04X\n",
+                j, hco1[j]);
+
+        RT_LOGI("S sscal[%d] = %04X\n",
+                j, hso1[j]);
+    }
+}
+
+#endif /* RUN_LEVEL 48 */
+
+/******************************************************************************/
+/*********************************   TABLES   *********************************/
+/******************************************************************************/
+
+typedef rt_void (*testXX)(rt_SIMD_INFOX *);
+
+testXX c_test[RUN_LEVEL] =
+{
+#if RUN_LEVEL >=  1
+    c_test01,
+#endif /* RUN_LEVEL  1 */
+
+#if RUN_LEVEL >=  2
+    c_test02,
+#endif /* RUN_LEVEL  2 */
+
+#if RUN_LEVEL >=  3
+    c_test03,
+#endif /* RUN_LEVEL  3 */
+
+#if RUN_LEVEL >=  4
+    c_test04,
+#endif /* RUN_LEVEL  4 */
+
+#if RUN_LEVEL >=  5
+    c_test05,
+#endif /* RUN_LEVEL  5 */
+
+#if RUN_LEVEL >=  6
+    c_test06,
+#endif /* RUN_LEVEL  6 */
+
+#if RUN_LEVEL >=  7
+    c_test07,
+#endif /* RUN_LEVEL  7 */
+
+#if RUN_LEVEL >=  8
+    c_test08,
+#endif /* RUN_LEVEL  8 */
+
+#if RUN_LEVEL >=  9
+    c_test09,
+#endif /* RUN_LEVEL  9 */
+
+#if RUN_LEVEL >= 10
+    c_test10,
+#endif /* RUN_LEVEL 10 */
+
+#if RUN_LEVEL >= 11
+    c_test11,
+#endif /* RUN_LEVEL 11 */
+
+#if RUN_LEVEL >= 12
+    c_test12,
+#endif /* RUN_LEVEL 12 */
+
+#if RUN_LEVEL >= 13
+    c_test13,
+#endif /* RUN_LEVEL 13 */
+
+#if RUN_LEVEL >= 14
+    c_test14,
+#endif /* RUN_LEVEL 14 */
+
+#if RUN_LEVEL >= 15
+    c_test15,
+#endif /* RUN_LEVEL 15 */
+
+#if RUN_LEVEL >= 16
+    c_test16,
+#endif /* RUN_LEVEL 16 */
+
+#if RUN_LEVEL >= 17
+    c_test17,
+#endif /* RUN_LEVEL 17 */
+
+#if RUN_LEVEL >= 18
+    c_test18,
+#endif /* RUN_LEVEL 18 */
+
+#if RUN_LEVEL >= 19
+    c_test19,
+#endif /* RUN_LEVEL 19 */
+
+#if RUN_LEVEL >= 20
+    c_test20,
+#endif /* RUN_LEVEL 20 */
+
+#if RUN_LEVEL >= 21
+    c_test21,
+#endif /* RUN_LEVEL 21 */
+
+#if RUN_LEVEL >= 22
+    c_test22,
+#endif /* RUN_LEVEL 22 */
+
+#if RUN_LEVEL >= 23
+    c_test23,
+#endif /* RUN_LEVEL 23 */
+
+#if RUN_LEVEL >= 24
+    c_test24,
+#endif /* RUN_LEVEL 24 */
+
+#if RUN_LEVEL >= 25
+    c_test25,
+#endif /* RUN_LEVEL 25 */
+
+#if RUN_LEVEL >= 26
+    c_test26,
+#endif /* RUN_LEVEL 26 */
+
+#if RUN_LEVEL >= 27
+    c_test27,
+#endif /* RUN_LEVEL 27 */
+
+#if RUN_LEVEL >= 28
+    c_test28,
+#endif /* RUN_LEVEL 28 */
+
+#if RUN_LEVEL >= 29
+    c_test29,
+#endif /* RUN_LEVEL 29 */
+
+#if RUN_LEVEL >= 30
+    c_test30,
+#endif /* RUN_LEVEL 30 */
+
+#if RUN_LEVEL >= 31
+    c_test31,
+#endif /* RUN_LEVEL 31 */
+
+#if RUN_LEVEL >= 32
+    c_test32,
+#endif /* RUN_LEVEL 32 */
+
+#if RUN_LEVEL >= 33
+    c_test33,
+#endif /* RUN_LEVEL 33 */
+
+#if RUN_LEVEL >= 34
+    c_test34,
+#endif /* RUN_LEVEL 34 */
+
+#if RUN_LEVEL >= 35
+    c_test35,
+#endif /* RUN_LEVEL 35 */
+
+#if RUN_LEVEL >= 36
+    c_test36,
+#endif /* RUN_LEVEL 36 */
+
+#if RUN_LEVEL >= 37
+    c_test37,
+#endif /* RUN_LEVEL 37 */
+
+#if RUN_LEVEL >= 38
+    c_test38,
+#endif /* RUN_LEVEL 38 */
+
+#if RUN_LEVEL >= 39
+    c_test39,
+#endif /* RUN_LEVEL 39 */
+
+#if RUN_LEVEL >= 40
+    c_test40,
+#endif /* RUN_LEVEL 40 */
+
+#if RUN_LEVEL >= 41
+    c_test41,
+#endif /* RUN_LEVEL 41 */
+
+#if RUN_LEVEL >= 42
+    c_test42,
+#endif /* RUN_LEVEL 42 */
+
+#if RUN_LEVEL >= 43
+    c_test43,
+#endif /* RUN_LEVEL 43 */
+
+#if RUN_LEVEL >= 44
+    c_test44,
+#endif /* RUN_LEVEL 44 */
+
+#if RUN_LEVEL >= 45
+    c_test45,
+#endif /* RUN_LEVEL 45 */
+
+#if RUN_LEVEL >= 46
+    c_test46,
+#endif /* RUN_LEVEL 46 */
+
+#if RUN_LEVEL >= 47
+    c_test47,
+#endif /* RUN_LEVEL 47 */
+
+#if RUN_LEVEL >= 48
+    c_test48,
+#endif /* RUN_LEVEL 48 */
+};
+
+testXX s_test[RUN_LEVEL] =
+{
+#if RUN_LEVEL >=  1
+    s_test01,
+#endif /* RUN_LEVEL  1 */
+
+#if RUN_LEVEL >=  2
+    s_test02,
+#endif /* RUN_LEVEL  2 */
+
+#if RUN_LEVEL >=  3
+    s_test03,
+#endif /* RUN_LEVEL  3 */
+
+#if RUN_LEVEL >=  4
+    s_test04,
+#endif /* RUN_LEVEL  4 */
+
+#if RUN_LEVEL >=  5
+    s_test05,
+#endif /* RUN_LEVEL  5 */
+
+#if RUN_LEVEL >=  6
+    s_test06,
+#endif /* RUN_LEVEL  6 */
+
+#if RUN_LEVEL >=  7
+    s_test07,
+#endif /* RUN_LEVEL  7 */
+
+#if RUN_LEVEL >=  8
     s_test08,
 #endif /* RUN_LEVEL  8 */
 
-#if RUN_LEVEL >=  9
-    s_test09,
-#endif /* RUN_LEVEL  9 */
+#if RUN_LEVEL >=  9
+    s_test09,
+#endif /* RUN_LEVEL  9 */
+
+#if RUN_LEVEL >= 10
+    s_test10,
+#endif /* RUN_LEVEL 10 */
+
+#if RUN_LEVEL >= 11
+    s_test11,
+#endif /* RUN_LEVEL 11 */
+
+#if RUN_LEVEL >= 12
+    s_test12,
+#endif /* RUN_LEVEL 12 */
+
+#if RUN_LEVEL >= 13
+    s_test13,
+#endif /* RUN_LEVEL 13 */
+
+#if RUN_LEVEL >= 14
+    s_test14,
+#endif /* RUN_LEVEL 14 */
+
+#if RUN_LEVEL >= 15
+    s_test15,
+#endif /* RUN_LEVEL 15 */
+
+#if RUN_LEVEL >= 16
+    s_test16,
+#endif /* RUN_LEVEL 16 */
+
+#if RUN_LEVEL >= 17
+    s_test17,
+#endif /* RUN_LEVEL 17 */
+
+#if RUN_LEVEL >= 18
+    s_test18,
+#endif /* RUN_LEVEL 18 */
+
+#if RUN_LEVEL >= 19
+    s_test19,
+#endif /* RUN_LEVEL 19 */
+
+#if RUN_LEVEL >= 20
+    s_test20,
+#endif /* RUN_LEVEL 20 */
+
+#if RUN_LEVEL >= 21
+    s_test21,
+#endif /* RUN_LEVEL 21 */
+
+#if RUN_LEVEL >= 22
+    s_test22,
+#endif /* RUN_LEVEL 22 */
+
+#if RUN_LEVEL >= 23
+    s_test23,
+#endif /* RUN_LEVEL 23 */
+
+#if RUN_LEVEL >= 24
+    s_test24,
+#endif /* RUN_LEVEL 24 */
+
+#if RUN_LEVEL >= 25
+    s_test25,
+#endif /* RUN_LEVEL 25 */
+
+#if RUN_LEVEL >= 26
+    s_test26,
+#endif /* RUN_LEVEL 26 */
+
+#if RUN_LEVEL >= 27
+    s_test27,
+#endif /* RUN_LEVEL 27 */
+
+#if RUN_LEVEL >= 28
+    s_test28,
+#endif /* RUN_LEVEL 28 */
+
+#if RUN_LEVEL >= 29
+    s_test29,
+#endif /* RUN_LEVEL 29 */
+
+#if RUN_LEVEL >= 30
+    s_test30,
+#endif /* RUN_LEVEL 30 */
+
+#if RUN_LEVEL >= 31
+    s_test31,
+#endif /* RUN_LEVEL 31 */
+
+#if RUN_LEVEL >= 32
+    s_test32,
+#endif /* RUN_LEVEL 32 */
+
+#if RUN_LEVEL >= 33
+    s_test33,
+#endif /* RUN_LEVEL 33 */
+
+#if RUN_LEVEL >= 34
+    s_test34,
+#endif /* RUN_LEVEL 34 */
+
+#if RUN_LEVEL >= 35
+    s_test35,
+#endif /* RUN_LEVEL 35 */
+
+#if RUN_LEVEL >= 36
+    s_test36,
+#endif /* RUN_LEVEL 36 */
+
+#if RUN_LEVEL >= 37
+    s_test37,
+#endif /* RUN_LEVEL 37 */
+
+#if RUN_LEVEL >= 38
+    s_test38,
+#endif /* RUN_LEVEL 38 */
+
+#if RUN_LEVEL >= 39
+    s_test39,
+#endif /* RUN_LEVEL 39 */
+
+#if RUN_LEVEL >= 40
+    s_test40,
+#endif /* RUN_LEVEL 40 */
+
+#if RUN_LEVEL >= 41
+    s_test41,
+#endif /* RUN_LEVEL 41 */
+
+#if RUN_LEVEL >= 42
+    s_test42,
+#endif /* RUN_LEVEL 42 */
+
+#if RUN_LEVEL >= 43
+    s_test43,
+#endif /* RUN_LEVEL 43 */
+
+#if RUN_LEVEL >= 44
+    s_test44,
+#endif /* RUN_LEVEL 44 */
+
+#if RUN_LEVEL >= 45
+    s_test45,
+#endif /* RUN_LEVEL 45 */
+
+#if RUN_LEVEL >= 46
+    s_test46,
+#endif /* RUN_LEVEL 46 */
+
+#if RUN_LEVEL >= 47
+    s_test47,
+#endif /* RUN_LEVEL 47 */
+
+#if RUN_LEVEL >= 48
+    s_test48,
+#endif /* RUN_LEVEL 48 */
+};
+
+testXX p_test[RUN_LEVEL] =
+{
+#if RUN_LEVEL >=  1
+    p_test01,
+#endif /* RUN_LEVEL  1 */
+
+#if RUN_LEVEL >=  2
+    p_test02,
+#endif /* RUN_LEVEL  2 */
+
+#if RUN_LEVEL >=  3
+    p_test03,
+#endif /* RUN_LEVEL  3 */
+
+#if RUN_LEVEL >=  4
+    p_test04,
+#endif /* RUN_LEVEL  4 */
+
+#if RUN_LEVEL >=  5
+    p_test05,
+#endif /* RUN_LEVEL  5 */
+
+#if RUN_LEVEL >=  6
+    p_test06,
+#endif /* RUN_LEVEL  6 */
+
+#if RUN_LEVEL >=  7
+    p_test07,
+#endif /* RUN_LEVEL  7 */
+
+#if RUN_LEVEL >=  8
+    p_test08,
+#endif /* RUN_LEVEL  8 */
+
+#if RUN_LEVEL >=  9
+    p_test09,
+#endif /* RUN_LEVEL  9 */
+
+#if RUN_LEVEL >= 10
+    p_test10,
+#endif /* RUN_LEVEL 10 */
+
+#if RUN_LEVEL >= 11
+    p_test11,
+#endif /* RUN_LEVEL 11 */
+
+#if RUN_LEVEL >= 12
+    p_test12,
+#endif /* RUN_LEVEL 12 */
+
+#if RUN_LEVEL >= 13
+    p_test13,
+#endif /* RUN_LEVEL 13 */
+
+#if RUN_LEVEL >= 14
+    p_test14,
+#endif /* RUN_LEVEL 14 */
+
+#if RUN_LEVEL >= 15
+    p_test15,
+#endif /* RUN_LEVEL 15 */
+
+#if RUN_LEVEL >= 16
+    p_test16,
+#endif /* RUN_LEVEL 16 */
+
+#if RUN_LEVEL >= 17
+    p_test17,
+#endif /* RUN_LEVEL 17 */
+
+#if RUN_LEVEL >= 18
+    p_test18,
+#endif /* RUN_LEVEL 18 */
+
+#if RUN_LEVEL >= 19
+    p_test19,
+#endif /* RUN_LEVEL 19 */
+
+#if RUN_LEVEL >= 20
+    p_test20,
+#endif /* RUN_LEVEL 20 */
+
+#if RUN_LEVEL >= 21
+    p_test21,
+#endif /* RUN_LEVEL 21 */
+
+#if RUN_LEVEL >= 22
+    p_test22,
+#endif /* RUN_LEVEL 22 */
+
+#if RUN_LEVEL >= 23
+    p_test23,
+#endif /* RUN_LEVEL 23 */
+
+#if RUN_LEVEL >= 24
+    p_test24,
+#endif /* RUN_LEVEL 24 */
+
+#if RUN_LEVEL >= 25
+    p_test25,
+#endif /* RUN_LEVEL 25 */
+
+#if RUN_LEVEL >= 26
+    p_test26,
+#endif /* RUN_LEVEL 26 */
+
+#if RUN_LEVEL >= 27
+    p_test27,
+#endif /* RUN_LEVEL 27 */
+
+#if RUN_LEVEL >= 28
+    p_test28,
+#endif /* RUN_LEVEL 28 */
+
+#if RUN_LEVEL >= 29
+    p_test29,
+#endif /* RUN_LEVEL 29 */
+
+#if RUN_LEVEL >= 30
+    p_test30,
+#endif /* RUN_LEVEL 30 */
+
+#if RUN_LEVEL >= 31
+    p_test31,
+#endif /* RUN_LEVEL 31 */
+
+#if RUN_LEVEL >= 32
+    p_test32,
+#endif /* RUN_LEVEL 32 */
+
+#if RUN_LEVEL >= 33
+    p_test33,
+#endif /* RUN_LEVEL 33 */
+
+#if RUN_LEVEL >= 34
+    p_test34,
+#endif /* RUN_LEVEL 34 */
+
+#if RUN_LEVEL >= 35
+    p_test35,
+#endif /* RUN_LEVEL 35 */
+
+#if RUN_LEVEL >= 36
+    p_test36,
+#endif /* RUN_LEVEL 36 */
+
+#if RUN_LEVEL >= 37
+    p_test37,
+#endif /* RUN_LEVEL 37 */
+
+#if RUN_LEVEL >= 38
+    p_test38,
+#endif /* RUN_LEVEL 38 */
+
+#if RUN_LEVEL >= 39
+    p_test39,
+#endif /* RUN_LEVEL 39 */
+
+#if RUN_LEVEL >= 40
+    p_test40,
+#endif /* RUN_LEVEL 40 */
+
+#if RUN_LEVEL >= 41
+    p_test41,
+#endif /* RUN_LEVEL 41 */
+
+#if RUN_LEVEL >= 42
+    p_test42,
+#endif /* RUN_LEVEL 42 */
+
+#if RUN_LEVEL >= 43
+    p_test43,
+#endif /* RUN_LEVEL 43 */
+
+#if RUN_LEVEL >= 44
+    p_test44,
+#endif /* RUN_LEVEL 44 */
+
+#if RUN_LEVEL >= 45
+    p_test45,
+#endif /* RUN_LEVEL 45 */
+
+#if RUN_LEVEL >= 46
+    p_test46,
+#endif /* RUN_LEVEL 46 */
+
+#if RUN_LEVEL >= 47
+    p_test47,
+#endif /* RUN_LEVEL 47 */
+
+#if RUN_LEVEL >= 48
+    p_test48,
+#endif /* RUN_LEVEL 48 */
+};
+
+/*
+ * Fuzz mode output types per run level (first out, second out):
+ * f - fp32 in fco/fso, d - fp64 in fco/fso, i - int32 in ico/iso,
+ * followed by optional input constraints:
+ * + - non-negative fp32 inputs (C reference differs for negatives),
+ * ! - fp32 inputs within 2^-64 <= |x| < 2^64 or NaN, as Newton-Raphson
+ *     steps of rcpps/rsqps/cbrps are undefined for zeros, denormals
+ *     and infinities (0 * inf gives NaN) and powf(x, 1.0f/3.0f) reference
+ *     drifts from cube root by about 0.1 ULP per binary order of x,
+ * * - non-negative int32 inputs (C reference differs for negatives),
+ * / - no zero or INT_MIN/-1 int32 divisors (C reference and idiv trap),
+ * ~ - no fp16 NaNs in int32 inputs read as halves (C reference returns
+ *     the default NaN, F16C keeps the payload),
+ * ? - no fp32 NaN inputs (C reference and x86 minps/maxps return the second
+ *     operand, ARM returns the NaN, C reference fp16 conversion returns
+ *     the default NaN, F16C and ARM keep the payload).
+ */
+rt_pstr fuzz_type[RUN_LEVEL] =
+{
+#if RUN_LEVEL >=  1
+    "ff",
+#endif /* RUN_LEVEL  1 */
+
+#if RUN_LEVEL >=  2
+    "ff",
+#endif /* RUN_LEVEL  2 */
+
+#if RUN_LEVEL >=  3
+    "ii",
+#endif /* RUN_LEVEL  3 */
+
+#if RUN_LEVEL >=  4
+    "ii",
+#endif /* RUN_LEVEL  4 */
+
+#if RUN_LEVEL >=  5
+    "ii",
+#endif /* RUN_LEVEL  5 */
+
+#if RUN_LEVEL >=  6
+    "if+",
+#endif /* RUN_LEVEL  6 */
+
+#if RUN_LEVEL >=  7
+    "ff!",
+#endif /* RUN_LEVEL  7 */
+
+#if RUN_LEVEL >=  8
+    "ii*",
+#endif /* RUN_LEVEL  8 */
+
+#if RUN_LEVEL >=  9
+    "ii/",
+#endif /* RUN_LEVEL  9 */
+
+#if RUN_LEVEL >= 10
+    "ff?",
+#endif /* RUN_LEVEL 10 */
+
+#if RUN_LEVEL >= 11
+    "ii*",
+#endif /* RUN_LEVEL 11 */
+
+#if RUN_LEVEL >= 12
+    "ii*",
+#endif /* RUN_LEVEL 12 */
+
+#if RUN_LEVEL >= 13
+    "ff+!",
+#endif /* RUN_LEVEL 13 */
+
+#if RUN_LEVEL >= 14
+    "ii",
+#endif /* RUN_LEVEL 14 */
+
+#if RUN_LEVEL >= 15
+    "ii",
+#endif /* RUN_LEVEL 15 */
+
+#if RUN_LEVEL >= 16
+    "ii",
+#endif /* RUN_LEVEL 16 */
+
+#if RUN_LEVEL >= 17
+    "dd",
+#endif /* RUN_LEVEL 17 */
+
+#if RUN_LEVEL >= 18
+    "if?",
+#endif /* RUN_LEVEL 18 */
+
+#if RUN_LEVEL >= 19
+    "fi",
+#endif /* RUN_LEVEL 19 */
+
+#if RUN_LEVEL >= 20
+    "ff",
+#endif /* RUN_LEVEL 20 */
+
+#if RUN_LEVEL >= 21
+    "ii/",
+#endif /* RUN_LEVEL 21 */
+
+#if RUN_LEVEL >= 22
+    "ii",
+#endif /* RUN_LEVEL 22 */
+
+#if RUN_LEVEL >= 23
+    "ff",
+#endif /* RUN_LEVEL 23 */
+
+#if RUN_LEVEL >= 24
+    "ff",
+#endif /* RUN_LEVEL 24 */
+
+#if RUN_LEVEL >= 25
+    "fi!?",
+#endif /* RUN_LEVEL 25 */
+
+#if RUN_LEVEL >= 26
+    "fi",
+#endif /* RUN_LEVEL 26 */
+
+#if RUN_LEVEL >= 27
+    "ff",
+#endif /* RUN_LEVEL 27 */
+
+#if RUN_LEVEL >= 28
+    "ff",
+#endif /* RUN_LEVEL 28 */
+
+#if RUN_LEVEL >= 29
+    "ff",
+#endif /* RUN_LEVEL 29 */
+
+#if RUN_LEVEL >= 30
+    "ff",
+#endif /* RUN_LEVEL 30 */
+
+#if RUN_LEVEL >= 31
+    "ff",
+#endif /* RUN_LEVEL 31 */
+
+#if RUN_LEVEL >= 32
+    "ii",
+#endif /* RUN_LEVEL 32 */
+
+#if RUN_LEVEL >= 33
+    "ff",
+#endif /* RUN_LEVEL 33 */
+
+#if RUN_LEVEL >= 34
+    "ii",
+#endif /* RUN_LEVEL 34 */
+
+#if RUN_LEVEL >= 35
+    "ff",
+#endif /* RUN_LEVEL 35 */
+
+#if RUN_LEVEL >= 36
+    "ii",
+#endif /* RUN_LEVEL 36 */
+
+#if RUN_LEVEL >= 37
+    "fi",
+#endif /* RUN_LEVEL 37 */
+
+#if RUN_LEVEL >= 38
+    "if",
+#endif /* RUN_LEVEL 38 */
+
+#if RUN_LEVEL >= 39
+    "ii",
+#endif /* RUN_LEVEL 39 */
+
+#if RUN_LEVEL >= 40
+    "ii",
+#endif /* RUN_LEVEL 40 */
+
+#if RUN_LEVEL >= 41
+    "ii",
+#endif /* RUN_LEVEL 41 */
+
+#if RUN_LEVEL >= 42
+    "ii",
+#endif /* RUN_LEVEL 42 */
+
+#if RUN_LEVEL >= 43
+    "ii",
+#endif /* RUN_LEVEL 43 */
+
+#if RUN_LEVEL >= 44
+    "ff",
+#endif /* RUN_LEVEL 44 */
+
+#if RUN_LEVEL >= 45
+    "ff",
+#endif /* RUN_LEVEL 45 */
+
+#if RUN_LEVEL >= 46
+    "ff",
+#endif /* RUN_LEVEL 46 */
+
+#if RUN_LEVEL >= 47
+    "ff",
+#endif /* RUN_LEVEL 47 */
+
+#if RUN_LEVEL >= 48
+    "ii~",
+#endif /* RUN_LEVEL 48 */
+};
+
+/*
+ * Double-precision references for fp32 outputs of run levels,
+ * NULL where none applies (fp16 round trip has no such counterpart).
+ */
+testXX d_test[RUN_LEVEL] =
+{
+#if RUN_LEVEL >=  1
+    d_test01,
+#endif /* RUN_LEVEL  1 */
+
+#if RUN_LEVEL >=  2
+    d_test02,
+#endif /* RUN_LEVEL  2 */
+
+#if RUN_LEVEL >=  3
+    NULL,
+#endif /* RUN_LEVEL  3 */
+
+#if RUN_LEVEL >=  4
+    NULL,
+#endif /* RUN_LEVEL  4 */
+
+#if RUN_LEVEL >=  5
+    NULL,
+#endif /* RUN_LEVEL  5 */
+
+#if RUN_LEVEL >=  6
+    d_test06,
+#endif /* RUN_LEVEL  6 */
+
+#if RUN_LEVEL >=  7
+    d_test07,
+#endif /* RUN_LEVEL  7 */
+
+#if RUN_LEVEL >=  8
+    NULL,
+#endif /* RUN_LEVEL  8 */
+
+#if RUN_LEVEL >=  9
+    NULL,
+#endif /* RUN_LEVEL  9 */
+
+#if RUN_LEVEL >= 10
+    d_test10,
+#endif /* RUN_LEVEL 10 */
+
+#if RUN_LEVEL >= 11
+    NULL,
+#endif /* RUN_LEVEL 11 */
+
+#if RUN_LEVEL >= 12
+    NULL,
+#endif /* RUN_LEVEL 12 */
+
+#if RUN_LEVEL >= 13
+    d_test13,
+#endif /* RUN_LEVEL 13 */
+
+#if RUN_LEVEL >= 14
+    NULL,
+#endif /* RUN_LEVEL 14 */
+
+#if RUN_LEVEL >= 15
+    NULL,
+#endif /* RUN_LEVEL 15 */
+
+#if RUN_LEVEL >= 16
+    NULL,
+#endif /* RUN_LEVEL 16 */
+
+#if RUN_LEVEL >= 17
+    NULL,
+#endif /* RUN_LEVEL 17 */
+
+#if RUN_LEVEL >= 18
+    NULL,
+#endif /* RUN_LEVEL 18 */
+
+#if RUN_LEVEL >= 19
+    d_test19,
+#endif /* RUN_LEVEL 19 */
+
+#if RUN_LEVEL >= 20
+    d_test20,
+#endif /* RUN_LEVEL 20 */
+
+#if RUN_LEVEL >= 21
+    NULL,
+#endif /* RUN_LEVEL 21 */
+
+#if RUN_LEVEL >= 22
+    NULL,
+#endif /* RUN_LEVEL 22 */
+
+#if RUN_LEVEL >= 23
+    NULL,
+#endif /* RUN_LEVEL 23 */
+
+#if RUN_LEVEL >= 24
+    NULL,
+#endif /* RUN_LEVEL 24 */
+
+#if RUN_LEVEL >= 25
+    NULL,
+#endif /* RUN_LEVEL 25 */
+
+#if RUN_LEVEL >= 26
+    NULL,
+#endif /* RUN_LEVEL 26 */
+
+#if RUN_LEVEL >= 27
+    NULL,
+#endif /* RUN_LEVEL 27 */
+
+#if RUN_LEVEL >= 28
+    NULL,
+#endif /* RUN_LEVEL 28 */
+
+#if RUN_LEVEL >= 29
+    NULL,
+#endif /* RUN_LEVEL 29 */
+
+#if RUN_LEVEL >= 30
+    NULL,
+#endif /* RUN_LEVEL 30 */
+
+#if RUN_LEVEL >= 31
+    NULL,
+#endif /* RUN_LEVEL 31 */
+
+#if RUN_LEVEL >= 32
+    NULL,
+#endif /* RUN_LEVEL 32 */
+
+#if RUN_LEVEL >= 33
+    NULL,
+#endif /* RUN_LEVEL 33 */
+
+#if RUN_LEVEL >= 34
+    NULL,
+#endif /* RUN_LEVEL 34 */
+
+#if RUN_LEVEL >= 35
+    NULL,
+#endif /* RUN_LEVEL 35 */
+
+#if RUN_LEVEL >= 36
+    NULL,
+#endif /* RUN_LEVEL 36 */
+
+#if RUN_LEVEL >= 37
+    NULL,
+#endif /* RUN_LEVEL 37 */
+
+#if RUN_LEVEL >= 38
+    NULL,
+#endif /* RUN_LEVEL 38 */
+
+#if RUN_LEVEL >= 39
+    NULL,
+#endif /* RUN_LEVEL 39 */
+
+#if RUN_LEVEL >= 40
+    NULL,
+#endif /* RUN_LEVEL 40 */
+
+#if RUN_LEVEL >= 41
+    NULL,
+#endif /* RUN_LEVEL 41 */
+
+#if RUN_LEVEL >= 42
+    NULL,
+#endif /* RUN_LEVEL 42 */
+
+#if RUN_LEVEL >= 43
+    NULL,
+#endif /* RUN_LEVEL 43 */
+
+#if RUN_LEVEL >= 44
+    d_test44,
+#endif /* RUN_LEVEL 44 */
+
+#if RUN_LEVEL >= 45
+    NULL,
+#endif /* RUN_LEVEL 45 */
+
+#if RUN_LEVEL >= 46
+    NULL,
+#endif /* RUN_LEVEL 46 */
+
+#if RUN_LEVEL >= 47
+    NULL,
+#endif /* RUN_LEVEL 47 */
+
+#if RUN_LEVEL >= 48
+    NULL,
+#endif /* RUN_LEVEL 48 */
+};
+
+/*
+ * Array sizes (elements) per run level, up to MAX_SIZE,
+ * levels with hardcoded SIMD offsets (AJ0..AJ2) use ARR_SIZE.
+ */
+rt_cell run_size[RUN_LEVEL] =
+{
+#if RUN_LEVEL >=  1
+    ARR_SIZE,
+#endif /* RUN_LEVEL  1 */
+
+#if RUN_LEVEL >=  2
+    ARR_SIZE,
+#endif /* RUN_LEVEL  2 */
+
+#if RUN_LEVEL >=  3
+    ARR_SIZE,
+#endif /* RUN_LEVEL  3 */
+
+#if RUN_LEVEL >=  4
+    ARR_SIZE,
+#endif /* RUN_LEVEL  4 */
+
+#if RUN_LEVEL >=  5
+    ARR_SIZE,
+#endif /* RUN_LEVEL  5 */
+
+#if RUN_LEVEL >=  6
+    ARR_SIZE,
+#endif /* RUN_LEVEL  6 */
+
+#if RUN_LEVEL >=  7
+    ARR_SIZE,
+#endif /* RUN_LEVEL  7 */
+
+#if RUN_LEVEL >=  8
+    ARR_SIZE,
+#endif /* RUN_LEVEL  8 */
+
+#if RUN_LEVEL >=  9
+    ARR_SIZE,
+#endif /* RUN_LEVEL  9 */
+
+#if RUN_LEVEL >= 10
+    ARR_SIZE,
+#endif /* RUN_LEVEL 10 */
+
+#if RUN_LEVEL >= 11
+    ARR_SIZE,
+#endif /* RUN_LEVEL 11 */
+
+#if RUN_LEVEL >= 12
+    ARR_SIZE,
+#endif /* RUN_LEVEL 12 */
+
+#if RUN_LEVEL >= 13
+    ARR_SIZE,
+#endif /* RUN_LEVEL 13 */
+
+#if RUN_LEVEL >= 14
+    ARR_SIZE,
+#endif /* RUN_LEVEL 14 */
+
+#if RUN_LEVEL >= 15
+    ARR_SIZE,
+#endif /* RUN_LEVEL 15 */
+
+#if RUN_LEVEL >= 16
+    ARR_SIZE,
+#endif /* RUN_LEVEL 16 */
+
+#if RUN_LEVEL >= 17
+    ARR_SIZE,
+#endif /* RUN_LEVEL 17 */
+
+#if RUN_LEVEL >= 18
+    ARR_SIZE,
+#endif /* RUN_LEVEL 18 */
+
+#if RUN_LEVEL >= 19
+    ARR_SIZE,
+#endif /* RUN_LEVEL 19 */
+
+#if RUN_LEVEL >= 20
+    ARR_SIZE,
+#endif /* RUN_LEVEL 20 */
+
+#if RUN_LEVEL >= 21
+    ARR_SIZE,
+#endif /* RUN_LEVEL 21 */
+
+#if RUN_LEVEL >= 22
+    3*(S*5-1),
+#endif /* RUN_LEVEL 22 */
+
+#if RUN_LEVEL >= 23
+    4*S*4,
+#endif /* RUN_LEVEL 23 */
+
+#if RUN_LEVEL >= 24
+    16*S*2,
+#endif /* RUN_LEVEL 24 */
+
+#if RUN_LEVEL >= 25
+    6*S*2,
+#endif /* RUN_LEVEL 25 */
+
+#if RUN_LEVEL >= 26
+    6*S*2,
+#endif /* RUN_LEVEL 26 */
+
+#if RUN_LEVEL >= 27
+    S*5+3,
+#endif /* RUN_LEVEL 27 */
+
+#if RUN_LEVEL >= 28
+    S*9+1,
+#endif /* RUN_LEVEL 28 */
+
+#if RUN_LEVEL >= 29
+    (S+15)*(S+15),
+#endif /* RUN_LEVEL 29 */
+
+#if RUN_LEVEL >= 30
+    2*(S+9)*(S+9),
+#endif /* RUN_LEVEL 30 */
+
+#if RUN_LEVEL >= 31
+    S*7+3,
+#endif /* RUN_LEVEL 31 */
+
+#if RUN_LEVEL >= 32
+    S*7+3,
+#endif /* RUN_LEVEL 32 */
+
+#if RUN_LEVEL >= 33
+    S*13+5,
+#endif /* RUN_LEVEL 33 */
+
+#if RUN_LEVEL >= 34
+    S*13+5,
+#endif /* RUN_LEVEL 34 */
+
+#if RUN_LEVEL >= 35
+    S*9+5,
+#endif /* RUN_LEVEL 35 */
+
+#if RUN_LEVEL >= 36
+    S*9+5,
+#endif /* RUN_LEVEL 36 */
+
+#if RUN_LEVEL >= 37
+    S*9+5,
+#endif /* RUN_LEVEL 37 */
+
+#if RUN_LEVEL >= 38
+    S*9+5,
+#endif /* RUN_LEVEL 38 */
+
+#if RUN_LEVEL >= 39
+    S*13+5,
+#endif /* RUN_LEVEL 39 */
+
+#if RUN_LEVEL >= 40
+    S*13+5,
+#endif /* RUN_LEVEL 40 */
+
+#if RUN_LEVEL >= 41
+    S*16+3,
+#endif /* RUN_LEVEL 41 */
+
+#if RUN_LEVEL >= 42
+    S*16+3,
+#endif /* RUN_LEVEL 42 */
+
+#if RUN_LEVEL >= 43
+    S*16+3,
+#endif /* RUN_LEVEL 43 */
+
+#if RUN_LEVEL >= 44
+    ARR_SIZE,
+#endif /* RUN_LEVEL 44 */
+
+#if RUN_LEVEL >= 45
+    16*S*2,
+#endif /* RUN_LEVEL 45 */
+
+#if RUN_LEVEL >= 46
+    16*S*2,
+#endif /* RUN_LEVEL 46 */
+
+#if RUN_LEVEL >= 47
+    S*16,
+#endif /* RUN_LEVEL 47 */
+
+#if RUN_LEVEL >= 48
+    S*16,
+#endif /* RUN_LEVEL 48 */
+};
+
+/*
+ * Benchmark work units per run level (name, units per array element
+ * or per run for array size if f_work is set), levels with hardcoded
+ * array size have no unit and are skipped in -b mode.
+ */
+struct rt_BENCH
+{
+    rt_pstr unit;
+    rt_real work;
+    rt_fp64 (*f_work)(rt_cell size);
+};
+
+rt_BENCH b_test[RUN_LEVEL] =
+{
+#if RUN_LEVEL >=  1
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL  1 */
+
+#if RUN_LEVEL >=  2
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL  2 */
+
+#if RUN_LEVEL >=  3
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL  3 */
+
+#if RUN_LEVEL >=  4
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL  4 */
+
+#if RUN_LEVEL >=  5
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL  5 */
+
+#if RUN_LEVEL >=  6
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL  6 */
+
+#if RUN_LEVEL >=  7
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL  7 */
+
+#if RUN_LEVEL >=  8
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL  8 */
+
+#if RUN_LEVEL >=  9
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL  9 */
+
+#if RUN_LEVEL >= 10
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 10 */
+
+#if RUN_LEVEL >= 11
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 11 */
+
+#if RUN_LEVEL >= 12
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 12 */
+
+#if RUN_LEVEL >= 13
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 13 */
+
+#if RUN_LEVEL >= 14
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 14 */
+
+#if RUN_LEVEL >= 15
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 15 */
+
+#if RUN_LEVEL >= 16
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 16 */
+
+#if RUN_LEVEL >= 17
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 17 */
+
+#if RUN_LEVEL >= 18
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 18 */
+
+#if RUN_LEVEL >= 19
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 19 */
+
+#if RUN_LEVEL >= 20
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 20 */
+
+#if RUN_LEVEL >= 21
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 21 */
+
+#if RUN_LEVEL >= 22
+    {"vec3", 1.0f/3, RT_NULL},
+#endif /* RUN_LEVEL 22 */
+
+#if RUN_LEVEL >= 23
+    {"vec4", 1.0f/4, RT_NULL},
+#endif /* RUN_LEVEL 23 */
+
+#if RUN_LEVEL >= 24
+    {"mat4", 1.0f/16, RT_NULL},
+#endif /* RUN_LEVEL 24 */
+
+#if RUN_LEVEL >= 25
+    {"ray", 1.0f/6, RT_NULL},
+#endif /* RUN_LEVEL 25 */
+
+#if RUN_LEVEL >= 26
+    {"ray", 1.0f/6, RT_NULL},
+#endif /* RUN_LEVEL 26 */
+
+#if RUN_LEVEL >= 27
+    {"flop", 3.0f, RT_NULL},
+#endif /* RUN_LEVEL 27 */
+
+#if RUN_LEVEL >= 28
+    {"flop", 4.0f, RT_NULL},
+#endif /* RUN_LEVEL 28 */
+
+#if RUN_LEVEL >= 29
+    {"flop", 4.0f, RT_NULL},
+#endif /* RUN_LEVEL 29 */
+
+#if RUN_LEVEL >= 30
+    {"flop", 0.0f, gemm_work},
+#endif /* RUN_LEVEL 30 */
+
+#if RUN_LEVEL >= 31
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 31 */
+
+#if RUN_LEVEL >= 32
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 32 */
+
+#if RUN_LEVEL >= 33
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 33 */
+
+#if RUN_LEVEL >= 34
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 34 */
+
+#if RUN_LEVEL >= 35
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 35 */
+
+#if RUN_LEVEL >= 36
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 36 */
+
+#if RUN_LEVEL >= 37
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 37 */
+
+#if RUN_LEVEL >= 38
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 38 */
+
+#if RUN_LEVEL >= 39
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 39 */
+
+#if RUN_LEVEL >= 40
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 40 */
+
+#if RUN_LEVEL >= 41
+    {"byte", 8.0f, RT_NULL},
+#endif /* RUN_LEVEL 41 */
+
+#if RUN_LEVEL >= 42
+    {"byte", 8.0f, RT_NULL},
+#endif /* RUN_LEVEL 42 */
+
+#if RUN_LEVEL >= 43
+    {"byte", 24.0f, RT_NULL},
+#endif /* RUN_LEVEL 43 */
+
+#if RUN_LEVEL >= 44
+    {RT_NULL, 0.0f, RT_NULL},
+#endif /* RUN_LEVEL 44 */
+
+#if RUN_LEVEL >= 45
+    {"mat4", 1.0f/16, RT_NULL},
+#endif /* RUN_LEVEL 45 */
+
+#if RUN_LEVEL >= 46
+    {"mat4", 1.0f/16, RT_NULL},
+#endif /* RUN_LEVEL 46 */
+
+#if RUN_LEVEL >= 47
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 47 */
+
+#if RUN_LEVEL >= 48
+    {"elem", 1.0f, RT_NULL},
+#endif /* RUN_LEVEL 48 */
+};
+
+/******************************************************************************/
+/**********************************   FUZZ   **********************************/
+/******************************************************************************/
+
+/*
+ * Fuzz mode replaces fixed test arrays with random and adversarial values,
+ * runs c_testXX and s_testXX once per round and compares their outputs
+ * per lane: fp32/fp64 within 2^u_diff ULPs (NaNs match any NaN),
+ * int32 exactly. First failing round of each run level is shrunk
+ * to a minimal input (other lanes reset to simple values, low bits cleared)
+ * before being reported with the seed its inputs were generated from
+ * (fuzz_seed at the start of the round).
+ */
+
+/*
+ * Distance in ULPs between two fp32 values, NaN is infinitely far
+ * from everything but another NaN. Fp32 denormals are flushed on ARM.
+ */
+rt_full ulp_diff32(rt_real f1, rt_real f2)
+{
+    rt_word a, b;
+
+    if (f1 != f1 || f2 != f2)
+    {
+        return f1 != f1 && f2 != f2 ? 0 : (rt_full)-1;
+    }
+
+#if defined (RT_ARM)
+    f1 = RT_FABS(f1) < FLT_MIN ? 0.0f : f1;
+    f2 = RT_FABS(f2) < FLT_MIN ? 0.0f : f2;
+#endif /* RT_ARM */
+
+    memcpy(&a, &f1, sizeof(a));
+    memcpy(&b, &f2, sizeof(b));
+
+    a = a & 0x80000000 ? ~a : a | 0x80000000;
+    b = b & 0x80000000 ? ~b : b | 0x80000000;
+
+    return a > b ? a - b : b - a;
+}
+
+/*
+ * Distance in ULPs between two fp64 values, NaN is infinitely far
+ * from everything but another NaN.
+ */
+rt_full ulp_diff64(rt_fp64 d1, rt_fp64 d2)
+{
+    rt_full a, b;
+
+    if (d1 != d1 || d2 != d2)
+    {
+        return d1 != d1 && d2 != d2 ? 0 : (rt_full)-1;
+    }
+
+    memcpy(&a, &d1, sizeof(a));
+    memcpy(&b, &d2, sizeof(b));
+
+    a = a & 0x8000000000000000ULL ? ~a : a | 0x8000000000000000ULL;
+    b = b & 0x8000000000000000ULL ? ~b : b | 0x8000000000000000ULL;
+
+    return a > b ? a - b : b - a;
+}
+
+/*
+ * Xorshift generator, period 2^32-1 for any non-zero seed.
+ */
+rt_word fuzz_rand()
+{
+    fuzz_seed ^= fuzz_seed << 13;
+    fuzz_seed ^= fuzz_seed >> 17;
+    fuzz_seed ^= fuzz_seed << 5;
+    return fuzz_seed;
+}
+
+/*
+ * Random fp32 bit pattern biased towards edge cases.
+ */
+rt_word fuzz_real()
+{
+    static rt_word edge[] =
+    {
+        0x00000000, 0x80000000, /* +0.0, -0.0 */
+        0x00000001, 0x807FFFFF, /* min denormal, -max denormal */
+        0x00800000, 0xFF7FFFFF, /* min normal, -max normal */
+        0x7F800000, 0xFF800000, /* +inf, -inf */
+        0x7FC00000, 0xFFFFFFFF, /* quiet NaNs */
+        0x3F800000, 0xBF800000, /* +1.0, -1.0 */
+    };
+
+    rt_word r = fuzz_rand();
+
+    switch (r & 7)
+    {
+        case 0:
+        return edge[(r >> 3) % RT_ARR_SIZE(edge)];
+
+        case 1: /* denormal */
+        return fuzz_rand() & 0x807FFFFF;
+
+        case 2: /* any pattern */
+        return fuzz_rand();
+
+        default: /* moderate magnitudes, 2^-20 .. 2^+20 */
+        return (r & 0x80000000) | (fuzz_rand() & 0x007FFFFF) |
+               ((107 + (r >> 3) % 41) << 23);
+    }
+}
+
+/*
+ * Random int32 biased towards edge cases.
+ */
+rt_word fuzz_cell()
+{
+    static rt_word edge[] =
+    {
+        0x00000000, 0x00000001, 0xFFFFFFFF, /* 0, 1, -1 */
+        0x80000000, 0x7FFFFFFF, /* INT_MIN, INT_MAX */
+        0x80000001, 0x00000002, 0xFFFFFFFE,
+    };
+
+    rt_word r = fuzz_rand();
+
+    switch (r & 3)
+    {
+        case 0:
+        return edge[(r >> 2) % RT_ARR_SIZE(edge)];
+
+        case 1: /* small magnitudes */
+        return (r & 0x80000000 ? -1 : +1) * (rt_cell)(fuzz_rand() % 1000);
+
+        default: /* any pattern */
+        return fuzz_rand();
+    }
+}
+
+/*
+ * Check (or fix if requested) input constraints of run level l,
+ * return number of violations found.
+ */
+rt_cell fuzz_sane(rt_SIMD_INFOX *info, rt_cell l, rt_bool fix)
+{
+    rt_cell j, k = 0, n = info->size;
+    rt_word *far0 = (rt_word *)info->far0;
+    rt_cell *iar0 = info->iar0;
+
+    if (strchr(fuzz_type[l], '+') != NULL)
+    {
+        for (j = 0; j < n; j++)
+        {
+            if ((far0[j] & 0x80000000) == 0)
+            {
+                continue;
+            }
+            k++;
+            if (fix)
+            {
+                far0[j] &= 0x7FFFFFFF;
+            }
+        }
+    }
+
+    if (strchr(fuzz_type[l], '!') != NULL)
+    {
+        for (j = 0; j < n; j++)
+        {
+            rt_word e = (far0[j] >> 23) & 0xFF;
+
+            if ((e >= 127 - 64 && e < 127 + 64)
+            ||  (e == 0xFF && (far0[j] & 0x007FFFFF) != 0))
+            {
+                continue;
+            }
+            k++;
+            if (fix)
+            {
+                far0[j] = (far0[j] & 0x80000000) | 0x3F800000;
+            }
+        }
+    }
+
+    if (strchr(fuzz_type[l], '?') != NULL)
+    {
+        for (j = 0; j < n; j++)
+        {
+            if ((far0[j] & 0x7FFFFFFF) <= 0x7F800000)
+            {
+                continue;
+            }
+            k++;
+            if (fix)
+            {
+                far0[j] = (far0[j] & 0x80000000) | 0x3F800000;
+            }
+        }
+    }
+
+    if (strchr(fuzz_type[l], '*') != NULL)
+    {
+        for (j = 0; j < n; j++)
+        {
+            if (iar0[j] >= 0)
+            {
+                continue;
+            }
+            k++;
+            if (fix)
+            {
+                iar0[j] &= 0x7FFFFFFF;
+            }
+        }
+    }
+
+    if (strchr(fuzz_type[l], '/') != NULL)
+    {
+        for (j = 0; j < n; j++)
+        {
+            if (iar0[j] != 0)
+            {
+                continue;
+            }
+            k++;
+            if (fix)
+            {
+                iar0[j] = 1;
+            }
+        }
+        for (j = 0; j < n; j++)
+        {
+            if (iar0[j] != (rt_cell)0x80000000 || iar0[(j + S) % n] != -1)
+            {
+                continue;
+            }
+            k++;
+            if (fix)
+            {
+                iar0[j] = 0x7FFFFFFF;
+            }
+        }
+    }
+
+    if (strchr(fuzz_type[l], '~') != NULL)
+    {
+        rt_half *har0 = (rt_half *)info->iar0;
+
+        for (j = 0; j < n * 2; j++)
+        {
+            if ((har0[j] & 0x7C00) != 0x7C00 || (har0[j] & 0x03FF) == 0)
+            {
+                continue;
+            }
+            k++;
+            if (fix)
+            {
+                har0[j] &= 0xFC00;
+            }
+        }
+    }
+
+    return k;
+}
+
+/*
+ * Run c_testXX and s_testXX of run level l once on current inputs,
+ * return number of mismatching output lanes (logged if requested).
+ */
+rt_cell fuzz_diff(rt_SIMD_INFOX *info, rt_cell l, rt_bool log)
+{
+    rt_cell j, k, e = 0, n = info->size;
+    rt_full u = (rt_full)1 << u_diff;
+
+    memset(info->fco1, 0, n * sizeof(rt_real));
+    memset(info->fco2, 0, n * sizeof(rt_real));
+    memset(info->fso1, 0, n * sizeof(rt_real));
+    memset(info->fso2, 0, n * sizeof(rt_real));
+    memset(info->ico1, 0, n * sizeof(rt_cell));
+    memset(info->ico2, 0, n * sizeof(rt_cell));
+    memset(info->iso1, 0, n * sizeof(rt_cell));
+    memset(info->iso2, 0, n * sizeof(rt_cell));
+
+    c_test[l](info);
+    s_test[l](info);
+
+    for (k = 0; k < 2; k++)
+    {
+        rt_real *fco = k == 0 ? info->fco1 : info->fco2;
+        rt_real *fso = k == 0 ? info->fso1 : info->fso2;
+        rt_cell *ico = k == 0 ? info->ico1 : info->ico2;
+        rt_cell *iso = k == 0 ? info->iso1 : info->iso2;
+
+        for (j = 0; j < n; j++)
+        {
+            rt_fp64 *dco = (rt_fp64 *)fco;
+            rt_fp64 *dso = (rt_fp64 *)fso;
+
+            switch (fuzz_type[l][k])
+            {
+                case 'f':
+                if (ulp_diff32(fco[j], fso[j]) <= u)
+                {
+                    continue;
+                }
+                if (log)
+                {
+                    RT_LOGI("C out%d[%d] = %e (0x%08X), "
+                            "S out%d[%d] = %e (0x%08X)\n",
+                            k+1, j, fco[j], ((rt_word *)fco)[j],
+                            k+1, j, fso[j], ((rt_word *)fso)[j]);
+                }
+                break;
+
+                case 'd':
+                if (j >= n / 2 || ulp_diff64(dco[j], dso[j]) <= u)
+                {
+                    continue;
+                }
+                if (log)
+                {
+                    RT_LOGI("C out%d[%d] = %e, S out%d[%d] = %e\n",
+                            k+1, j, dco[j], k+1, j, dso[j]);
+                }
+                break;
+
+                default:
+                if (ico[j] == iso[j])
+                {
+                    continue;
+                }
+                if (log)
+                {
+                    RT_LOGI("C out%d[%d] = %d (0x%08X), "
+                            "S out%d[%d] = %d (0x%08X)\n",
+                            k+1, j, ico[j], ico[j], k+1, j, iso[j], iso[j]);
+                }
+                break;
+            }
+            e++;
+        }
+    }
+
+    return e;
+}
+
+/*
+ * Shrink failing inputs of run level l while the failure persists:
+ * first reset lanes to simple values, then clear low bits of the rest.
+ */
+rt_void fuzz_trim(rt_SIMD_INFOX *info, rt_cell l)
+{
+    rt_word *arr[3] = {(rt_word *)info->far0, (rt_word *)info->iar0,
+                                                          info->par0};
+    rt_word val[3] = {0x3F800000, 0x00000001, 0x00000000};
+    rt_cell a, b, j, k, m, n = info->size;
+
+    for (m = 0; m < 2; m++)
+    {
+        k = 1;
+        while (k > 0)
+        {
+            k = 0;
+            for (a = 0; a < 3; a++)
+            {
+                for (j = 0; j < n; j++)
+                {
+                    rt_word t = arr[a][j];
+
+                    for (b = m == 0 ? 1 : 31; b > 0 && t != val[a]; b--)
+                    {
+                        arr[a][j] = m == 0 ? val[a] : t & (0xFFFFFFFF << b);
+                        if (arr[a][j] != t
+                        &&  fuzz_sane(info, l, RT_FALSE) == 0
+                        &&  fuzz_diff(info, l, RT_FALSE) > 0)
+                        {
+                            k++;
+                            break;
+                        }
+                        arr[a][j] = t;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Run fuzz_runs rounds of run level l, report first failure shrunk,
+ * return number of failed rounds.
+ */
+rt_cell fuzz_test(rt_SIMD_INFOX *info, rt_cell l)
+{
+    rt_cell i, j, e = 0, n = info->size;
+    rt_word *far0 = (rt_word *)info->far0;
+    rt_word *iar0 = (rt_word *)info->iar0;
+    rt_word *par0 = info->par0;
+    rt_word s;
+
+    info->cyc = 1;
+
+    for (i = 0; i < fuzz_runs; i++)
+    {
+        s = fuzz_seed;
+
+        for (j = 0; j < n; j++)
+        {
+            far0[j] = fuzz_real();
+            iar0[j] = fuzz_cell();
+            par0[j] = fuzz_rand();
+        }
+
+        fuzz_sane(info, l, RT_TRUE);
+
+        if (fuzz_diff(info, l, RT_FALSE) == 0)
+        {
+            continue;
+        }
+
+        if (e++ > 0)
+        {
+            continue;
+        }
+
+        RT_LOGI("Fuzz round %d failed (round seed 0x%08X), shrunk input:\n",
+                i, s);
+
+        fuzz_trim(info, l);
+
+        for (j = 0; j < n; j++)
+        {
+            if (far0[j] != 0x3F800000)
+            {
+                RT_LOGI("farr[%d] = %e (0x%08X)\n",
+                        j, info->far0[j], far0[j]);
+            }
+            if (iar0[j] != 0x00000001)
+            {
+                RT_LOGI("iarr[%d] = %d (0x%08X)\n",
+                        j, info->iar0[j], iar0[j]);
+            }
+            if (par0[j] != 0x00000000)
+            {
+                RT_LOGI("parr[%d] = 0x%08X\n",
+                        j, par0[j]);
+            }
+        }
+
+        fuzz_diff(info, l, RT_TRUE);
+    }
+
+    RT_LOGI("Fuzz rounds = %d, failed = %d\n", fuzz_runs, e);
+
+    return e;
+}
+
+/******************************************************************************/
+/********************************   ACCURACY   ********************************/
+/******************************************************************************/
+
+rt_time get_time();
+
+/*
+ * Error of fp32 value f in ULPs of the exact result d (rounded to fp32),
+ * correctly rounded operations stay within 0.5, NaN or inf mismatch
+ * gives an infinite error.
+ */
+rt_fp64 ulp_err32(rt_real f, rt_fp64 d)
+{
+    rt_cell e;
+    rt_real r = (rt_real)d;
+
+    if (d != d || f != f || RT_FABS(f) > FLT_MAX || RT_FABS(r) > FLT_MAX)
+    {
+        return (d != d && f != f) || f == r ? 0.0 : HUGE_VAL;
+    }
+
+    frexp(d, &e);
+
+    return fabs((rt_fp64)f - d) / ldexp(1.0, d == 0.0 ? -149 :
+                                        RT_MAX(e - 24, -149));
+}
+
+/*
+ * Report max and mean ULP errors of C and S fp32 outputs of run level l
+ * against its double-precision reference, return 1 if S exceeds
+ * the ULP threshold (-u n), 0 otherwise.
+ */
+rt_cell ulp_test(rt_SIMD_INFOX *info, rt_cell l)
+{
+    rt_cell j, k, r = 0, n = info->size;
+    rt_fp64 u = (rt_fp64)(1 << u_diff);
+
+    if (d_test[l] == NULL)
+    {
+        return 0;
+    }
+
+    d_test[l](info);
+
+    for (k = 0; k < 2; k++)
+    {
+        rt_real *fco = k == 0 ? info->fco1 : info->fco2;
+        rt_real *fso = k == 0 ? info->fso1 : info->fso2;
+        rt_fp64 *dre = k == 0 ? info->dre1 : info->dre2;
+        rt_fp64 cmax = 0.0, cavg = 0.0, smax = 0.0, savg = 0.0;
+
+        if (fuzz_type[l][k] != 'f')
+        {
+            continue;
+        }
+
+        for (j = 0; j < n; j++)
+        {
+            rt_fp64 c = ulp_err32(fco[j], dre[j]);
+            rt_fp64 s = ulp_err32(fso[j], dre[j]);
+
+            cmax = RT_MAX(cmax, c);
+            smax = RT_MAX(smax, s);
+            cavg += c / n;
+            savg += s / n;
+        }
+
+        RT_LOGI("ULP out%d C max = %.2f, mean = %.2f, "
+                "S max = %.2f, mean = %.2f\n",
+                k+1, cmax, cavg, smax, savg);
+
+        if (smax > u)
+        {
+            RT_LOGI("ULP out%d S max exceeds threshold %d\n",
+                    k+1, 1 << u_diff);
+            r = 1;
+        }
+    }
+
+    return r;
+}
+
+/*
+ * Approximation kernels for Newton-Raphson cost/accuracy table,
+ * number of N-R steps after the estimate is taken from inf_LOC,
+ * negative value selects full precision divps/sqrps path instead.
+ */
+rt_void s_rcpnr(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        ASM_ENTER(info)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxx_ld(Redi, Mebp, inf_SIZE)
+
+    LBL(rcp_beg)
+
+        movpx_ld(Xmm0, Mecx, AJ0)
+        movxx_ld(Resi, Mebp, inf_LOC)
+        cmpxx_ri(Resi, IB(0))
+        jltxn_lb(rcp_div)
+        rceps_rr(Xmm1, Xmm0)
+
+    LBL(rcp_nrs)
+
+        cmpxx_ri(Resi, IB(0))
+        jeqxx_lb(rcp_end)
+        movpx_rr(Xmm2, Xmm0)
+        rcsps_rr(Xmm1, Xmm2)
+        subxx_ri(Resi, IB(1))
+        jmpxx_lb(rcp_nrs)
+
+    LBL(rcp_div)
+
+        movpx_ld(Xmm1, Mebp, inf_GPC01)
+        divps_rr(Xmm1, Xmm0)
+
+    LBL(rcp_end)
+
+        movpx_st(Xmm1, Medx, AJ0)
+        addxx_ri(Recx, IB(RT_SIMD_ALIGN))
+        addxx_ri(Redx, IB(RT_SIMD_ALIGN))
+        subxx_ri(Redi, IB(S))
+        cmpxx_ri(Redi, IB(0))
+        jgtxx_lb(rcp_beg)
+
+        ASM_LEAVE(info)
+    }
+}
+
+rt_void s_rsqnr(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        ASM_ENTER(info)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxx_ld(Redi, Mebp, inf_SIZE)
+
+    LBL(rsq_beg)
+
+        movpx_ld(Xmm0, Mecx, AJ0)
+        movxx_ld(Resi, Mebp, inf_LOC)
+        cmpxx_ri(Resi, IB(0))
+        jltxn_lb(rsq_div)
+        rseps_rr(Xmm1, Xmm0)
+
+    LBL(rsq_nrs)
+
+        cmpxx_ri(Resi, IB(0))
+        jeqxx_lb(rsq_end)
+        movpx_rr(Xmm2, Xmm0)
+        rssps_rr(Xmm1, Xmm2)
+        subxx_ri(Resi, IB(1))
+        jmpxx_lb(rsq_nrs)
+
+    LBL(rsq_div)
+
+        sqrps_rr(Xmm2, Xmm0)
+        movpx_ld(Xmm1, Mebp, inf_GPC01)
+        divps_rr(Xmm1, Xmm2)
+
+    LBL(rsq_end)
+
+        movpx_st(Xmm1, Medx, AJ0)
+        addxx_ri(Recx, IB(RT_SIMD_ALIGN))
+        addxx_ri(Redx, IB(RT_SIMD_ALIGN))
+        subxx_ri(Redi, IB(S))
+        cmpxx_ri(Redi, IB(0))
+        jgtxx_lb(rsq_beg)
+
+        ASM_LEAVE(info)
+    }
+}
+
+rt_void s_cbrnr(rt_SIMD_INFOX *info)
+{
+    rt_cell i;
+
+    i = info->cyc;
+    while (i-->0)
+    {
+        ASM_ENTER(info)
+
+        movxa_ld(Recx, Mebp, inf_FAR0)
+        movxa_ld(Redx, Mebp, inf_FSO1)
+        movxx_ld(Redi, Mebp, inf_SIZE)
+
+    LBL(cbr_beg)
 
-#if RUN_LEVEL >= 10
-    s_test10,
-#endif /* RUN_LEVEL 10 */
+        movpx_ld(Xmm0, Mecx, AJ0)
+        movxx_ld(Resi, Mebp, inf_LOC)
+        cbeps_rr(Xmm1, Xmm2, Xmm3, Xmm0)
 
-#if RUN_LEVEL >= 11
-    s_test11,
-#endif /* RUN_LEVEL 11 */
+    LBL(cbr_nrs)
 
-#if RUN_LEVEL >= 12
-    s_test12,
-#endif /* RUN_LEVEL 12 */
+        cmpxx_ri(Resi, IB(0))
+        jlexn_lb(cbr_end)
+        cbsps_rr(Xmm1, Xmm2, Xmm3, Xmm0)
+        subxx_ri(Resi, IB(1))
+        jmpxx_lb(cbr_nrs)
 
-#if RUN_LEVEL >= 13
-    s_test13,
-#endif /* RUN_LEVEL 13 */
+    LBL(cbr_end)
 
-#if RUN_LEVEL >= 14
-    s_test14,
-#endif /* RUN_LEVEL 14 */
+        movpx_st(Xmm1, Medx, AJ0)
+        addxx_ri(Recx, IB(RT_SIMD_ALIGN))
+        addxx_ri(Redx, IB(RT_SIMD_ALIGN))
+        subxx_ri(Redi, IB(S))
+        cmpxx_ri(Redi, IB(0))
+        jgtxx_lb(cbr_beg)
+
+        ASM_LEAVE(info)
+    }
+}
+
+#define NR_SIZE             (S*256)
+
+/*
+ * Print cost (time per CYC_SIZE*ARR_SIZE elements, same as run levels)
+ * and accuracy (max and mean ULPs against double precision)
+ * of rcp, rsq and cbr for each number of Newton-Raphson steps
+ * over positive inputs in 2^-20 .. 2^+20 range.
+ */
+rt_void nr_table(rt_SIMD_INFOX *info)
+{
+    static rt_pstr name[3] = {"rcp", "rsq", "cbr"};
+    testXX nr_test[3] = {s_rcpnr, s_rsqnr, s_cbrnr};
+
+    rt_cell i, j, k, n = NR_SIZE;
+    rt_Arena heap(RT_ARENA_CHUNK,
+                  rt_Arena::page_alloc, rt_Arena::page_free);
+    rt_real *far0 = (rt_real *)heap.alloc(2 * NR_SIZE * sizeof(rt_real));
+    rt_real *fso1 = far0 + NR_SIZE;
+
+    rt_real *far0_save = info->far0;
+    rt_real *fso1_save = info->fso1;
+    rt_cell size_save = info->size;
+    rt_cell cyc_save = info->cyc;
+
+    for (j = 0; j < n; j++)
+    {
+        rt_word w = (fuzz_rand() & 0x007FFFFF) | ((107 + j % 41) << 23);
+        memcpy(&far0[j], &w, sizeof(w));
+    }
+
+    info->far0 = far0;
+    info->fso1 = fso1;
+    info->size = n;
+    info->cyc  = CYC_SIZE / (NR_SIZE / ARR_SIZE);
+
+    RT_LOGI("-----------------  N-R TABLE  ----------------------\n");
+    RT_LOGI("op  steps    time    max ulp   mean ulp\n");
+
+    for (i = 0; i < 3; i++)
+    {
+        for (k = i < 2 ? -1 : 0; k <= (i < 2 ? 3 : 4); k++)
+        {
+            rt_fp64 umax = 0.0, uavg = 0.0;
+
+            info->loc = k;
+
+            rt_time time1 = get_time();
+
+            nr_test[i](info);
+
+            rt_time time2 = get_time();
+
+            for (j = 0; j < n; j++)
+            {
+                rt_fp64 d = i == 0 ? 1.0 / far0[j] :
+                            i == 1 ? 1.0 / sqrt((rt_fp64)far0[j]) :
+                                     pow((rt_fp64)far0[j], 1.0 / 3.0);
+                rt_fp64 u = ulp_err32(fso1[j], d);
+
+                umax = RT_MAX(umax, u);
+                uavg += u / n;
+            }
+
+            if (k < 0)
+            {
+                RT_LOGI("%s  %5s  %6d  %9.2f  %9.2f\n", name[i],
+                        "full", (rt_cell)(time2 - time1), umax, uavg);
+            }
+            else
+            {
+                RT_LOGI("%s  %5d  %6d  %9.2f  %9.2f\n", name[i],
+                        k, (rt_cell)(time2 - time1), umax, uavg);
+            }
+        }
+    }
+
+    RT_LOGI("----------------------------------------------------\n");
+
+    info->far0 = far0_save;
+    info->fso1 = fso1_save;
+    info->size = size_save;
+    info->cyc  = cyc_save;
+}
+
+#if RUN_LEVEL >= 40
+
+#define HST_TBL             (1 << 18) /* elements in histogram table */
+#define HST_CYC             16 /* runs per bucket count */
+
+/*
+ * Print time of C, single-threaded S (level 39) and THR_SIZE-threaded S
+ * (level 40) histograms of HST_TBL uniform elements for bucket counts
+ * from 16 to HST_MAXB, private sub-histograms (and their merge) grow
+ * with bucket count, while C keeps a single one.
+ */
+rt_void hist_table(rt_SIMD_INFOX *info)
+{
+    rt_cell b, i, j, n = HST_TBL;
+    rt_Arena heap(RT_ARENA_CHUNK,
+                  rt_Arena::page_alloc, rt_Arena::page_free);
+    rt_real *far0 = (rt_real *)heap.alloc(n * sizeof(rt_real));
+    rt_cell *ico1 = (rt_cell *)heap.alloc(HST_MAXB * sizeof(rt_cell));
+    rt_cell *iso1 = (rt_cell *)heap.alloc(HST_MAXB * sizeof(rt_cell));
+    rt_word *hbuf = (rt_word *)heap.alloc(THR_SIZE * RT_SIMD_WIDTH *
+                                          HST_MAXB * sizeof(rt_word));
+
+    rt_word *hbuf_save = info->hbuf;
+    rt_cell size_save = info->size;
+
+    if (far0 == RT_NULL || ico1 == RT_NULL ||
+        iso1 == RT_NULL || hbuf == RT_NULL)
+    {
+        RT_LOGI("Histogram table allocation failed\n");
+        return;
+    }
+
+    memset(hbuf, 0, THR_SIZE * RT_SIMD_WIDTH * HST_MAXB * sizeof(rt_word));
+
+    for (j = 0; j < n; j++)
+    {
+        far0[j] = (rt_real)(fuzz_rand() & 0x00FFFFFF) / 16777216.0f *
+                  128.0f - 64.0f;
+    }
+
+    info->hbuf = hbuf;
+    info->size = n;
+
+    RT_LOGI("-----------------  HISTOGRAM TABLE  ----------------\n");
+    RT_LOGI("%8s %8s %8s %8s %8s %8s\n", "buckets", "C ms", "S ms",
+            "T ms", "S/C", "T/C");
+
+    for (b = 16; b <= HST_MAXB; b *= 4)
+    {
+        hist_set(info, b, -64.0f, +64.0f);
+
+        rt_time time1 = get_time();
+
+        for (i = 0; i < HST_CYC; i++)
+        {
+            hist_ref(info, far0, ico1, RT_NULL);
+        }
+
+        rt_time time2 = get_time();
+
+        for (i = 0; i < HST_CYC; i++)
+        {
+            hist_run(info, far0, iso1, RT_NULL);
+        }
+
+        rt_time time3 = get_time();
+
+        for (i = 0; i < HST_CYC; i++)
+        {
+            hist_par(info, far0, iso1, RT_FALSE);
+        }
+
+        rt_time time4 = get_time();
+
+        rt_fp64 tC = (rt_fp64)RT_MAX(time2 - time1, 1);
+        rt_fp64 tS = (rt_fp64)RT_MAX(time3 - time2, 1);
+        rt_fp64 tT = (rt_fp64)RT_MAX(time4 - time3, 1);
+
+        RT_LOGI("%8d %8d %8d %8d %8.2f %8.2f%s\n", b,
+                (rt_cell)(time2 - time1), (rt_cell)(time3 - time2),
+                (rt_cell)(time4 - time3), tC / tS, tC / tT,
+                memcmp(ico1, iso1, b * sizeof(rt_cell)) ? "  mismatch" : "");
+    }
+
+    RT_LOGI("----------------------------------------------------\n");
+
+    info->hbuf = hbuf_save;
+    info->size = size_save;
+}
+
+#endif /* RUN_LEVEL 40 */
+
+/******************************************************************************/
+/*********************************   BENCH   **********************************/
+/******************************************************************************/
+
+#define WRK_SIZE            (1 << 26) /* elements processed per array size */
+#define WRK_FUNC            (1 << 30) /* work per array size if f_work is set */
+
+/*
+ * Benchmark mode times c_testXX and s_testXX of run level l on arrays
+ * growing 4x from run_size up to bench_size MB (fp32 input), inputs are
+ * tiled from the fixed test arrays, C and S share their outputs (not checked)
+ * and cycles are scaled for every size to process WRK_SIZE elements
+ * (or WRK_FUNC units of work). If CPU clock is given (-g), flop throughput
+ * of S is also shown as percentage of SIMD peak, which is 2*S flop per cycle
+ * (separate mul and add, there are no fused ops in the instruction set).
+ */
+rt_void bench_test(rt_SIMD_INFOX *info, rt_cell l)
+{
+    rt_cell j, k, n;
+
+    rt_Arena heap(RT_ARENA_CHUNK,
+                  rt_Arena::page_alloc, rt_Arena::page_free);
+
+    rt_fp64 peak = (rt_fp64)bench_mhz * 2 * RT_SIMD_WIDTH;
+    rt_bool flop = peak > 0.0 && strcmp(b_test[l].unit, "flop") == 0;
+
+    if (flop)
+    {
+        RT_LOGI("SIMD peak at %d MHz is %.2f GFLOP/s\n", bench_mhz,
+                peak / 1000.0);
+    }
+
+    RT_LOGI("%10s %10s %10s %12s %12s %8s%s\n", "size", "C ms", "S ms",
+            "C M/s", "S M/s", "S/C", flop ? "   S peak" : "");
+
+    for (n = run_size[l]; n <= (bench_size << 20) / 4; n *= 4)
+    {
+        rt_cell m = n + MAX_SIZE; /* room for padding and block tails */
+        rt_word *a[7];
+
+        heap.reset();
+
+        rt_SIMD_INFOX *inf1 = (rt_SIMD_INFOX *)heap.alloc(sizeof(*info));
+        memcpy(inf1, info, sizeof(*info));
+
+        for (k = 0; k < 7; k++)
+        {
+            a[k] = (rt_word *)heap.alloc(m * sizeof(rt_word));
+
+            if (a[k] == RT_NULL)
+            {
+                RT_LOGI("Bench arrays allocation failed: %d elements\n", m);
+                return;
+            }
+
+            memset(a[k], 0, m * sizeof(rt_word));
+        }
+
+        for (j = 0; j < n; j += MAX_SIZE)
+        {
+            k = RT_MIN(n - j, MAX_SIZE) * sizeof(rt_word);
+
+            memcpy(a[0] + j, info->far0, k);
+            memcpy(a[1] + j, info->iar0, k);
+            memcpy(a[2] + j, info->par0, k);
+        }
+
+        inf1->far0 = (rt_real *)a[0];
+        inf1->iar0 = (rt_cell *)a[1];
+        inf1->par0 = a[2];
+
+        inf1->fco1 = inf1->fso1 = (rt_real *)a[3];
+        inf1->fco2 = inf1->fso2 = (rt_real *)a[4];
+        inf1->ico1 = inf1->iso1 = (rt_cell *)a[5];
+        inf1->ico2 = inf1->iso2 = (rt_cell *)a[6];
+
+        inf1->sbuf = (rt_word *)heap.alloc(4 * m * sizeof(rt_word));
+
+        if (inf1->sbuf == RT_NULL)
+        {
+            RT_LOGI("Bench arrays allocation failed: %d elements\n", 4 * m);
+            return;
+        }
+
+        rt_fp64 r = b_test[l].f_work != RT_NULL ?
+                    b_test[l].f_work(n) : (rt_fp64)n * b_test[l].work;
+
+        inf1->size = n;
+        inf1->cyc  = b_test[l].f_work != RT_NULL ?
+                    (rt_cell)RT_MAX(WRK_FUNC / r, 1) : RT_MAX(WRK_SIZE / n, 1);
+
+        rt_time time1 = get_time();
+
+        c_test[l](inf1);
+
+        rt_time time2 = get_time();
+
+        s_test[l](inf1);
+
+        rt_time time3 = get_time();
+
+        rt_fp64 w = r * inf1->cyc / 1000.0;
+        rt_fp64 tC = (rt_fp64)RT_MAX(time2 - time1, 1);
+        rt_fp64 tS = (rt_fp64)RT_MAX(time3 - time2, 1);
+
+        if (flop)
+        {
+            RT_LOGI("%10d %10d %10d %12.2f %12.2f %8.2f %7.1f%%\n", n,
+                    (rt_cell)(time2 - time1), (rt_cell)(time3 - time2),
+                    w / tC, w / tS, tC / tS, w / tS / peak * 100.0);
+            continue;
+        }
+
+        RT_LOGI("%10d %10d %10d %12.2f %12.2f %8.2f\n", n,
+                (rt_cell)(time2 - time1), (rt_cell)(time3 - time2),
+                w / tC, w / tS, tC / tS);
+    }
+
+    RT_LOGI("M/s is %s throughput in millions per second\n",
+            b_test[l].unit);
+}
+
+/******************************************************************************/
+/*********************************   COUNT   **********************************/
+/******************************************************************************/
+
+#if defined (RT_COUNT)
+
+/*
+ * Static instruction and byte counts (RT_COUNT build), asm blocks are
+ * replaced with calls to rt_count_asm() (see rtarch.h) which evaluates
+ * their .byte/.if expressions the way GNU as does and tallies the results
+ * per kernel. Instructions are counted per EMITW in ARM targets and by
+ * decoding instruction lengths in x86 targets, jumps and label loads
+ * emitted as mnemonics are counted at their longest encoding.
+ */
+
+#define CNT_SIZE            64 /* max number of counted kernels */
+#define CNT_BUFF            65536 /* max number of bytes per asm block */
+
+#define CNT(mac)            {#mac, mac}
+
+struct rt_COUNT
+{
+    rt_pstr name;
+    rt_pstr text;
+    rt_cell blks;
+    rt_cell inst;
+    rt_cell byte;
 };
 
-testXX p_test[RUN_LEVEL] =
+static rt_COUNT cnt_list[CNT_SIZE];
+static rt_cell  cnt_size = 0;
+static rt_byte  cnt_buff[CNT_BUFF];
+
+/*
+ * Representative instances of instruction macros,
+ * composite and emulated ones are the ones worth watching.
+ */
+static rt_COUNT cnt_macs[] =
 {
-#if RUN_LEVEL >=  1
-    p_test01,
-#endif /* RUN_LEVEL  1 */
+    /* ---------------------------   core   ---------------------------- */
+
+    CNT(movxx_ri(Recx, IW(0x12345678))),
+    CNT(movxx_mi(Mecx, DP(0x010), IW(0x12345678))),
+    CNT(movxx_rr(Recx, Rebx)),
+    CNT(movxx_ld(Recx, Mebx, DP(0x010))),
+    CNT(movxx_st(Recx, Mebx, DP(0x010))),
+    CNT(movxa_ld(Recx, Mebx, DP(0x010))),
+    CNT(adrpx_ld(Recx, Mebx, DP(0x010))),
+    CNT(stack_sa()),
+    CNT(stack_la()),
+
+    CNT(addxx_ri(Recx, IB(1))),
+    CNT(addxx_ri(Recx, IW(0x12345678))),
+    CNT(addxx_mi(Mecx, DP(0x010), IW(0x12345678))),
+    CNT(addxx_rr(Recx, Rebx)),
+    CNT(addxx_ld(Recx, Mebx, DP(0x010))),
+    CNT(addxx_st(Recx, Mebx, DP(0x010))),
+    CNT(subxx_mr(Mecx, DP(0x010), Rebx)),
+    CNT(andxx_ri(Recx, IW(0x12345678))),
+    CNT(orrxx_mi(Mecx, DP(0x010), IW(0x12345678))),
+    CNT(notxx_mm(Mecx, DP(0x010))),
+    CNT(shlxx_ri(Recx, IB(1))),
+    CNT(shrxn_mi(Mecx, DP(0x010), IB(1))),
+
+    CNT(mulxn_ri(Recx, IW(0x12345678))),
+    CNT(mulxn_rr(Recx, Rebx)),
+    CNT(mulxn_ld(Recx, Mebx, DP(0x010))),
+    CNT(mulxn_xm(Mecx, DP(0x010))),
+    CNT(divxx_xm(Mecx, DP(0x010))),
+    CNT(divxn_xm(Mecx, DP(0x010))),
+    CNT(remxx_xm(Mecx, DP(0x010))),
+    CNT(remxn_xm(Mecx, DP(0x010))),
+
+    CNT(cmpxx_ri(Recx, IW(0x12345678))),
+    CNT(cmpxx_mi(Mecx, DP(0x010), IW(0x12345678))),
+    CNT(cmpxx_rm(Recx, Mebx, DP(0x010))),
+    CNT(jmpxx_mm(Mecx, DP(0x010))),
+    CNT(jeqxx_lb(cnt_lbl)),
+
+    /* ---------------------------   simd   ---------------------------- */
+
+    CNT(movpx_rr(Xmm0, Xmm1)),
+    CNT(movpx_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(movpx_st(Xmm0, Mecx, DP(0x010))),
+    CNT(movlx_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(movlx_st(Xmm0, Mecx, DP(0x010))),
+    CNT(movux_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(movnx_st(Xmm0, Mecx, DP(0x010))),
+    CNT(prfxx_ld(Mecx, DP(0x010))),
+    CNT(fence_st()),
+
+    CNT(andpx_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(annpx_rr(Xmm0, Xmm1)),
+    CNT(orrpx_rr(Xmm0, Xmm1)),
+    CNT(xorpx_ld(Xmm0, Mecx, DP(0x010))),
+
+    CNT(addps_rr(Xmm0, Xmm1)),
+    CNT(addps_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(subps_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(mulps_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(divps_rr(Xmm0, Xmm1)),
+    CNT(divps_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(sqrps_rr(Xmm0, Xmm1)),
+    CNT(sqrps_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(rceps_rr(Xmm0, Xmm1)),
+    CNT(rcsps_rr(Xmm0, Xmm1)),
+    CNT(rcpps_rr(Xmm0, Xmm1)),
+    CNT(rseps_rr(Xmm0, Xmm1)),
+    CNT(rssps_rr(Xmm0, Xmm1)),
+    CNT(rsqps_rr(Xmm0, Xmm1)),
+    CNT(cbeps_rr(Xmm0, Xmm2, Xmm3, Xmm1)),
+    CNT(cbsps_rr(Xmm0, Xmm2, Xmm3, Xmm1)),
+    CNT(cbrps_rr(Xmm0, Xmm2, Xmm3, Xmm1)),
+    CNT(minps_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(maxps_ld(Xmm0, Mecx, DP(0x010))),
+
+    CNT(addpd_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(divpd_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(sqrpd_ld(Xmm0, Mecx, DP(0x010))),
+
+    CNT(ceqps_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(cneps_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(cltps_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(cgeps_ld(Xmm0, Mecx, DP(0x010))),
+
+    CNT(cvtps_rr(Xmm0, Xmm1)),
+    CNT(cvtps_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(cvtpn_rr(Xmm0, Xmm1)),
+    CNT(cvtpn_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(cvtds_rr(Xmm0, Xmm1)),
+    CNT(cvtsd_rr(Xmm0, Xmm1)),
+    CNT(cvhps_ld(Xmm0, Xmm2, Xmm3, Mecx, DP(0x010))),
+    CNT(cvpsh_st(Xmm0, Xmm2, Xmm3, Mecx, DP(0x010))),
+
+    CNT(shlpx_ri(Xmm0, IB(1))),
+    CNT(shlpx_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(shrpn_ri(Xmm0, IB(1))),
+    CNT(cgtpn_rr(Xmm0, Xmm1)),
+    CNT(cgtpn_ld(Xmm0, Mecx, DP(0x010))),
+
+    CNT(addpb_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(adspb_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(sbsph_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(avgpb_ld(Xmm0, Mecx, DP(0x010))),
+    CNT(pckph_rr(Xmm0, Xmm1)),
+    CNT(unlpb_rr(Xmm0, Xmm1)),
+
+    CNT(slnpx_ri(Xmm0, IB(1))),
+    CNT(srnpx_ri(Xmm0, IB(1))),
+    CNT(splpx_ri(Xmm0, IB(1))),
+    CNT(splpx_ld(Xmm0, Mecx, DP(0x010))),
+
+    CNT(mskpx_rr(Xmm0, Recx)),
+    CNT(mmvpx_ld(Xmm0, Xmm4, Mecx, DP(0x010))),
+    CNT(mmvpx_st(Xmm0, Xmm4, Mecx, DP(0x010))),
+    CNT(gatpx_ld(Xmm0, Xmm5, Mecx, DP(0x010))),
+    CNT(scapx_st(Xmm0, Xmm5, Mecx, DP(0x010))),
+};
+
+/*
+ * Evaluate GNU as expression at *p above operator rank r,
+ * ranks follow GNU as: shifts and mul/div above bitwise above add/sub
+ * above comparisons above logical ops, true comparisons give -1.
+ */
+rt_si64 cnt_eval(rt_pstr *p, rt_cell r)
+{
+    static rt_pstr op[] =
+    {
+        "||", "&&", "==", "!=", "<>", "<=", ">=", "<<", ">>",
+        "<",  ">",  "+",  "-",  "|",  "&",  "^",  "*",  "/",  "%",
+    };
+    static rt_cell rk[] =
+    {
+        2,    3,    4,    4,    4,    4,    4,    9,    9,
+        4,    4,    7,    7,    8,    8,    8,    9,    9,    9,
+    };
+
+    rt_si64 v, w;
+    rt_char *e;
+    rt_cell k;
+
+    while (**p == ' ')
+    {
+        (*p)++;
+    }
+
+    switch (*(*p)++)
+    {
+        case '(':
+        v = cnt_eval(p, 0);
+        while (*(*p)++ != ')');
+        break;
+
+        case '-':
+        v = -cnt_eval(p, 10);
+        break;
+
+        case '~':
+        v = ~cnt_eval(p, 10);
+        break;
+
+        case '!':
+        v = !cnt_eval(p, 10);
+        break;
+
+        default:
+        v = (rt_si64)strtoull(--(*p), &e, 0);
+        *p = e;
+        break;
+    }
+
+    while (1)
+    {
+        while (**p == ' ')
+        {
+            (*p)++;
+        }
+
+        for (k = 0; k < (rt_cell)RT_ARR_SIZE(op); k++)
+        {
+            if (strncmp(*p, op[k], strlen(op[k])) == 0)
+            {
+                break;
+            }
+        }
+
+        if (k == (rt_cell)RT_ARR_SIZE(op) || rk[k] <= r)
+        {
+            return v;
+        }
+
+        *p += strlen(op[k]);
+        w = cnt_eval(p, rk[k]);
+
+        switch (k)
+        {
+            case  0: v = v || w;                        break;
+            case  1: v = v && w;                        break;
+            case  2: v = v == w ? -1 : 0;               break;
+            case  3:
+            case  4: v = v != w ? -1 : 0;               break;
+            case  5: v = v <= w ? -1 : 0;               break;
+            case  6: v = v >= w ? -1 : 0;               break;
+            case  7: v = (rt_si64)((rt_ui64)v << w);    break;
+            case  8: v = (rt_si64)((rt_ui64)v >> w);    break;
+            case  9: v = v <  w ? -1 : 0;               break;
+            case 10: v = v >  w ? -1 : 0;               break;
+            case 11: v = v + w;                         break;
+            case 12: v = v - w;                         break;
+            case 13: v = v | w;                         break;
+            case 14: v = v & w;                         break;
+            case 15: v = v ^ w;                         break;
+            case 16: v = v * w;                         break;
+            case 17: v = w != 0 ? v / w : 0;            break;
+            case 18: v = w != 0 ? v % w : 0;            break;
+        }
+    }
+}
+
+/*
+ * Number of instructions in n bytes of cnt_buff,
+ * x86 decoding covers the subset of encodings emitted by the backends.
+ */
+rt_cell cnt_inst(rt_cell n)
+{
+#if defined (RT_X86) || defined (RT_X32)
+
+    rt_byte *b = cnt_buff;
+    rt_cell i = 0, k = 0;
+
+    while (i < n)
+    {
+        rt_cell o, m = 0, d = 0, w = 4;
+
+        while (b[i] == 0x66 || b[i] == 0xF2 || b[i] == 0xF3 || b[i] == 0x67
+#if defined (RT_X32)
+           || (b[i] & 0xF0) == 0x40 /* REX */
+#endif /* RT_X32 */
+              )
+        {
+            w = b[i++] == 0x66 ? 2 : w;
+        }
+
+        o = b[i++];
+
+        if (o == 0x0F)
+        {
+            o = b[i++];
+            m = 1;
+            d = o == 0x70 || o == 0x71 || o == 0x72 || o == 0x73 ||
+                o == 0xC2 || o == 0xC4 || o == 0xC5 || o == 0xC6;
+            if (o == 0x38 || o == 0x3A)
+            {
+                d = o == 0x3A;
+                i++;
+            }
+        }
+        else
+        if (o < 0x40)
+        {
+            m = (o & 7) < 4;
+            d = (o & 7) == 4 ? 1 : (o & 7) == 5 ? w : 0;
+        }
+        else
+        if (o == 0x68 || (o >= 0xB8 && o <= 0xBF))
+        {
+            d = w;
+        }
+        else
+        if (o == 0x69 || o == 0x81 || o == 0xC7)
+        {
+            m = 1;
+            d = w;
+        }
+        else
+        if (o == 0x6A)
+        {
+            d = 1;
+        }
+        else
+        if (o == 0x6B || o == 0x80 || o == 0x83 || o == 0xC0 || o == 0xC1
+        ||  o == 0xC6)
+        {
+            m = 1;
+            d = 1;
+        }
+        else
+        if ((o >= 0x84 && o <= 0x8F) || (o >= 0xD0 && o <= 0xD3)
+        ||  o == 0xF6 || o == 0xF7 || o == 0xFE || o == 0xFF)
+        {
+            m = 1;
+            d = (b[i] & 0x38) > 0x08 ? 0 : o == 0xF6 ? 1 : o == 0xF7 ? w : 0;
+        }
+
+        if (m)
+        {
+            rt_cell r = b[i++];
+
+            if ((r & 0xC0) != 0xC0 && (r & 0x07) == 0x04)
+            {
+                i += (r & 0xC0) == 0x00 && (b[i] & 0x07) == 0x05 ? 5 : 1;
+            }
+            else
+            if ((r & 0xC0) == 0x00 && (r & 0x07) == 0x05)
+            {
+                i += 4;
+            }
+
+            i += (r & 0xC0) == 0x40 ? 1 : (r & 0xC0) == 0x80 ? 4 : 0;
+        }
+
+        i += d;
+        k++;
+    }
+
+    return k;
+
+#else  /* RT_ARM, RT_A64 */
+
+    return n / 4;
+
+#endif /* RT_X86, RT_X32 */
+}
+
+/*
+ * Tally instructions and bytes of asm block text into c.
+ */
+rt_void cnt_text(rt_COUNT *c, rt_pstr text)
+{
+    rt_cell a[16], d = 0, n = 0;
+    rt_pstr p, q;
+
+    a[0] = 1;
+
+    for (p = text; *p != '\0'; p = *q != '\0' ? q + 1 : q)
+    {
+        for (q = p; *q != '\n' && *q != '\0'; q++);
+
+        while (*p == ' ' || *p == '\t')
+        {
+            p++;
+        }
+
+        if (strncmp(p, ".byte", 5) == 0)
+        {
+            p += 5;
+            if (a[d])
+            {
+                cnt_buff[n++] = (rt_byte)cnt_eval(&p, 0);
+            }
+        }
+        else
+        if (strncmp(p, ".if", 3) == 0)
+        {
+            p += 3;
+            d++;
+            a[d] = a[d-1] && cnt_eval(&p, 0) != 0;
+        }
+        else
+        if (strncmp(p, ".endif", 6) == 0)
+        {
+            d--;
+        }
+        else
+        if (p < q && q[-1] != ':' && a[d]) /* mnemonic, not label */
+        {
+#if defined (RT_X86) || defined (RT_X32)
+            c->byte += strncmp(p, "jmp", 3) == 0 ? 5 : 6;
+#else  /* RT_ARM, RT_A64 */
+            c->byte += 4;
+#endif /* RT_X86, RT_X32 */
+            c->inst += 1;
+        }
+    }
 
-#if RUN_LEVEL >=  2
-    p_test02,
-#endif /* RUN_LEVEL  2 */
+    c->inst += cnt_inst(n);
+    c->byte += n;
+    c->blks += 1;
+}
 
-#if RUN_LEVEL >=  3
-    p_test03,
-#endif /* RUN_LEVEL  3 */
+/*
+ * Hook for asm blocks in RT_COUNT build, tallies per kernel,
+ * repeated runs of the same block (kernel called from a loop) count once.
+ */
+rt_void rt_count_asm(rt_pstr name, rt_pstr text)
+{
+    rt_cell k;
 
-#if RUN_LEVEL >=  4
-    p_test04,
-#endif /* RUN_LEVEL  4 */
+    for (k = 0; k < cnt_size; k++)
+    {
+        if (strcmp(cnt_list[k].name, name) == 0)
+        {
+            break;
+        }
+    }
 
-#if RUN_LEVEL >=  5
-    p_test05,
-#endif /* RUN_LEVEL  5 */
+    if (k == cnt_size && cnt_size < CNT_SIZE)
+    {
+        memset(&cnt_list[k], 0, sizeof(rt_COUNT));
+        cnt_list[k].name = name;
+        cnt_size++;
+    }
 
-#if RUN_LEVEL >=  6
-    p_test06,
-#endif /* RUN_LEVEL  6 */
+    if (k < cnt_size && cnt_list[k].text != text)
+    {
+        cnt_list[k].text = text;
+        cnt_text(&cnt_list[k], text);
+    }
+}
 
-#if RUN_LEVEL >=  7
-    p_test07,
-#endif /* RUN_LEVEL  7 */
+/*
+ * Print instruction and byte counts per kernel and per macro.
+ */
+rt_void cnt_print()
+{
+    rt_cell k;
 
-#if RUN_LEVEL >=  8
-    p_test08,
-#endif /* RUN_LEVEL  8 */
+    RT_LOGI("-----------------  KERNEL COUNTS  ------------------\n");
+    RT_LOGI("%-24s %8s %8s %8s\n", "kernel", "blocks", "insts", "bytes");
 
-#if RUN_LEVEL >=  9
-    p_test09,
-#endif /* RUN_LEVEL  9 */
+    for (k = 0; k < cnt_size; k++)
+    {
+        RT_LOGI("%-24s %8d %8d %8d\n", cnt_list[k].name,
+                cnt_list[k].blks, cnt_list[k].inst, cnt_list[k].byte);
+    }
 
-#if RUN_LEVEL >= 10
-    p_test10,
-#endif /* RUN_LEVEL 10 */
+    RT_LOGI("-----------------  MACRO COUNTS  -------------------\n");
+    RT_LOGI("%-48s %8s %8s\n", "macro", "insts", "bytes");
 
-#if RUN_LEVEL >= 11
-    p_test11,
-#endif /* RUN_LEVEL 11 */
+    for (k = 0; k < (rt_cell)RT_ARR_SIZE(cnt_macs); k++)
+    {
+        cnt_text(&cnt_macs[k], cnt_macs[k].text);
 
-#if RUN_LEVEL >= 12
-    p_test12,
-#endif /* RUN_LEVEL 12 */
+        RT_LOGI("%-48s %8d %8d\n", cnt_macs[k].name,
+                cnt_macs[k].inst, cnt_macs[k].byte);
+    }
 
-#if RUN_LEVEL >= 13
-    p_test13,
-#endif /* RUN_LEVEL 13 */
+    RT_LOGI("----------------------------------------------------\n");
+}
 
-#if RUN_LEVEL >= 14
-    p_test14,
-#endif /* RUN_LEVEL 14 */
-};
+#endif /* RT_COUNT */
 
 /******************************************************************************/
 /**********************************   MAIN   **********************************/
 /******************************************************************************/
 
-rt_time get_time();
-
 /*
- * info - info original pointer
+ * heap - arena for all aligned arrays
+ *
  * inf0 - info aligned pointer
- * marr - memory original pointer
  * mar0 - memory aligned pointer
  *
  * farr - float original array
@@ -1832,10 +10627,33 @@ rt_time get_time();
  * ico2 - int aligned C out 2
  * iso1 - int aligned S out 1
  * iso2 - int aligned S out 2
+ *
+ * parr - pixel original array (RGBA8)
+ * par0 - pixel aligned array 0
+ *
+ * dre1 - double aligned reference 1
+ * dre2 - double aligned reference 2
+ *
+ * fmat - float aligned matrix (rt_mat4)
+ * fscr - float aligned scratch (SCR_SIZE SIMD vectors)
+ *
+ * fbox - float aligned scene boxes (min, max)
+ * ftri - float aligned scene triangles (v0, v1, v2)
+ *
+ * alpha - float scalar for saxpy/sscal
+ *
+ * fpck - float aligned sgemm packing buffer (GMM_PCK elements)
+ *
+ * thrd - infos for THR_SIZE threads
+ * tset - arenas for THR_SIZE threads (THR_SCR SIMD vectors of scratch each)
+ *
+ * sbuf - word aligned sort buffer (4 * MAX_SIZE words, two halves)
+ * hbuf - word aligned histogram buffer (THR_SIZE * S private histograms
+ *        of HST_BINS words, zeroed before first use and by each merge)
  */
 rt_cell main(rt_cell argc, rt_char *argv[])
 {
-    rt_cell k;
+    rt_cell j, k;
 
     if (argc >= 2)
     {
@@ -1843,12 +10661,25 @@ rt_cell main(rt_cell argc, rt_char *argv[])
         RT_LOGI("Usage options are given below:\n");
         RT_LOGI(" -d n, override diff threshold, where n is new diff 0..9\n");
         RT_LOGI(" -v, enable verbose mode\n");
-        RT_LOGI("options -d, -v can be combined\n");
+        RT_LOGI(" -f n, enable fuzz mode, where n is rounds per run level\n");
+        RT_LOGI(" -s n, override fuzz seed, where n is new non-zero seed\n");
+        RT_LOGI(" -u n, override ULP threshold 2^n, where n is 0..9\n");
+        RT_LOGI(" -n, print Newton-Raphson cost/accuracy table\n");
+        RT_LOGI(" -t, print histogram time table over bucket counts\n");
+        RT_LOGI(" -b n, enable bench mode, where n is max array size in MB\n");
+        RT_LOGI(" -g n, show SIMD peak in bench mode, where n is CPU MHz\n");
+        RT_LOGI("options -d, -v, -f, -s, -u, -n, -t, -b, -g can be combined\n");
         RT_LOGI("---------------------------------------------------------\n");
     }
 
     for (k = 1; k < argc; k++)
     {
+        if (k + 1 == argc && strlen(argv[k]) == 2
+        &&  argv[k][0] == '-' && strchr("dfsubg", argv[k][1]) != NULL)
+        {
+            RT_LOGI("Option %s requires a value\n", argv[k]);
+            return 0;
+        }
         if (strcmp(argv[k], "-d") == 0 && ++k < argc)
         {
             t_diff = argv[k][0] - '0';
@@ -1862,16 +10693,107 @@ rt_cell main(rt_cell argc, rt_char *argv[])
                 return 0;
             }
         }
+        else
         if (strcmp(argv[k], "-v") == 0 && !v_mode)
         {
             v_mode = RT_TRUE;
             RT_LOGI("Verbose mode enabled\n");
         }
+        else
+        if (strcmp(argv[k], "-f") == 0 && ++k < argc)
+        {
+            fuzz_runs = atoi(argv[k]);
+            if (fuzz_runs > 0)
+            {
+                RT_LOGI("Fuzz mode enabled: %d rounds\n", fuzz_runs);
+            }
+            else
+            {
+                RT_LOGI("Fuzz rounds value out of range\n");
+                return 0;
+            }
+        }
+        else
+        if (strcmp(argv[k], "-s") == 0 && ++k < argc)
+        {
+            fuzz_seed = (rt_word)strtoul(argv[k], NULL, 0);
+            if (fuzz_seed != 0)
+            {
+                RT_LOGI("Fuzz seed overriden: 0x%08X\n", fuzz_seed);
+            }
+            else
+            {
+                RT_LOGI("Fuzz seed value out of range\n");
+                return 0;
+            }
+        }
+        else
+        if (strcmp(argv[k], "-u") == 0 && ++k < argc)
+        {
+            u_diff = argv[k][0] - '0';
+            if (strlen(argv[k]) == 1 && u_diff >= 0 && u_diff <= 9)
+            {
+                RT_LOGI("ULP threshold overriden: %d\n", 1 << u_diff);
+            }
+            else
+            {
+                RT_LOGI("ULP threshold value out of range\n");
+                return 0;
+            }
+        }
+        else
+        if (strcmp(argv[k], "-n") == 0 && !n_mode)
+        {
+            n_mode = RT_TRUE;
+            RT_LOGI("N-R table enabled\n");
+        }
+        else
+        if (strcmp(argv[k], "-t") == 0 && !h_mode)
+        {
+            h_mode = RT_TRUE;
+            RT_LOGI("Histogram table enabled\n");
+        }
+        else
+        if (strcmp(argv[k], "-b") == 0 && ++k < argc)
+        {
+            bench_size = atoi(argv[k]);
+            if (bench_size > 0 && bench_size < 2048)
+            {
+                RT_LOGI("Bench mode enabled: up to %d MB\n", bench_size);
+            }
+            else
+            {
+                RT_LOGI("Bench size value out of range\n");
+                return 0;
+            }
+        }
+        else
+        if (strcmp(argv[k], "-g") == 0 && ++k < argc)
+        {
+            bench_mhz = atoi(argv[k]);
+            if (bench_mhz > 0 && bench_mhz < 100000)
+            {
+                RT_LOGI("CPU clock for SIMD peak: %d MHz\n", bench_mhz);
+            }
+            else
+            {
+                RT_LOGI("CPU clock value out of range\n");
+                return 0;
+            }
+        }
     }
 
-    rt_pntr marr = malloc(10 * ARR_SIZE * sizeof(rt_word) + MASK);
-    memset(marr, 0, 10 * ARR_SIZE * sizeof(rt_word) + MASK);
-    rt_pntr mar0 = (rt_pntr)(((rt_word)marr + MASK) & ~MASK);
+#if defined (RT_ARM)
+    RT_LOGI("SIMD precision level: %s\n",
+            RT_SIMD_PREC == RT_SIMD_PREC_FAST ? "fast" :
+            RT_SIMD_PREC == RT_SIMD_PREC_FULL ? "full" : "norm");
+#endif /* RT_ARM */
+
+    rt_Arena heap(RT_ARENA_CHUNK,
+                  rt_Arena::page_alloc, rt_Arena::page_free);
+
+    rt_pntr mar0 = heap.alloc(15 * MAX_SIZE * sizeof(rt_word));
+    memset(mar0, 0, 15 * MAX_SIZE * sizeof(rt_word));
 
     rt_real farr[4*3] =
     {
@@ -1889,17 +10811,23 @@ rt_cell main(rt_cell argc, rt_char *argv[])
         43187.487,
     };
 
-    rt_real *far0 = (rt_real *)mar0 + ARR_SIZE * 0;
-    rt_real *fco1 = (rt_real *)mar0 + ARR_SIZE * 1;
-    rt_real *fco2 = (rt_real *)mar0 + ARR_SIZE * 2;
-    rt_real *fso1 = (rt_real *)mar0 + ARR_SIZE * 3;
-    rt_real *fso2 = (rt_real *)mar0 + ARR_SIZE * 4;
+    rt_real *far0 = (rt_real *)mar0 + MAX_SIZE * 0;
+    rt_real *fco1 = (rt_real *)mar0 + MAX_SIZE * 1;
+    rt_real *fco2 = (rt_real *)mar0 + MAX_SIZE * 2;
+    rt_real *fso1 = (rt_real *)mar0 + MAX_SIZE * 3;
+    rt_real *fso2 = (rt_real *)mar0 + MAX_SIZE * 4;
 
-    for (k = 0; k < Q; k++)
+    for (k = 0; k < MAX_SIZE / (rt_cell)RT_ARR_SIZE(farr); k++)
     {
         memcpy(far0 + RT_ARR_SIZE(farr) * k, farr, sizeof(farr));
     }
 
+    /* non-periodic values past ARR_SIZE keep matrices of farr invertible */
+    for (k = ARR_SIZE; k < MAX_SIZE; k++)
+    {
+        far0[k] = HSH(k);
+    }
+
     rt_cell iarr[4*3] =
     {
         285,
@@ -1916,25 +10844,123 @@ rt_cell main(rt_cell argc, rt_char *argv[])
         318773,
     };
 
-    rt_cell *iar0 = (rt_cell *)mar0 + ARR_SIZE * 5;
-    rt_cell *ico1 = (rt_cell *)mar0 + ARR_SIZE * 6;
-    rt_cell *ico2 = (rt_cell *)mar0 + ARR_SIZE * 7;
-    rt_cell *iso1 = (rt_cell *)mar0 + ARR_SIZE * 8;
-    rt_cell *iso2 = (rt_cell *)mar0 + ARR_SIZE * 9;
+    rt_cell *iar0 = (rt_cell *)mar0 + MAX_SIZE * 5;
+    rt_cell *ico1 = (rt_cell *)mar0 + MAX_SIZE * 6;
+    rt_cell *ico2 = (rt_cell *)mar0 + MAX_SIZE * 7;
+    rt_cell *iso1 = (rt_cell *)mar0 + MAX_SIZE * 8;
+    rt_cell *iso2 = (rt_cell *)mar0 + MAX_SIZE * 9;
 
-    for (k = 0; k < Q; k++)
+    for (k = 0; k < MAX_SIZE / (rt_cell)RT_ARR_SIZE(iarr); k++)
     {
         memcpy(iar0 + RT_ARR_SIZE(iarr) * k, iarr, sizeof(iarr));
     }
 
-    rt_pntr info = malloc(sizeof(rt_SIMD_INFOX) + MASK);
-    rt_SIMD_INFOX *inf0 = (rt_SIMD_INFOX *)(((rt_word)info + MASK) & ~MASK);
+    rt_word parr[4*3] =
+    {
+        0xFF2040C0,
+        0x80E0F010,
+        0xFF000000,
+        0x00FFFFFF,
+        0x7F7F7F7F,
+        0x01020304,
+        0xFFFFFFFF,
+        0x10203040,
+        0xC0804020,
+        0x00000000,
+        0x80808080,
+        0x3A9BD2E7,
+    };
+
+    rt_word *par0 = (rt_word *)mar0 + MAX_SIZE * 10;
+
+    for (k = 0; k < MAX_SIZE / (rt_cell)RT_ARR_SIZE(parr); k++)
+    {
+        memcpy(par0 + RT_ARR_SIZE(parr) * k, parr, sizeof(parr));
+    }
+
+    rt_fp64 *dre1 = (rt_fp64 *)((rt_word *)mar0 + MAX_SIZE * 11);
+    rt_fp64 *dre2 = (rt_fp64 *)((rt_word *)mar0 + MAX_SIZE * 13);
+
+    rt_mat4 mat0 =
+    {
+        {0.8f, -0.6f, 0.0f, 12.5f},
+        {0.6f,  0.8f, 0.0f, -3.25f},
+        {0.0f,  0.0f, 2.0f, 7.0f},
+        {0.0f,  0.0f, 0.0f, 1.0f},
+    };
+
+    rt_real *fmat = (rt_real *)heap.alloc(sizeof(mat0));
+    rt_real *fscr = (rt_real *)heap.alloc(SCR_SIZE * S * sizeof(rt_real));
+
+    memcpy(fmat, mat0, sizeof(mat0));
+
+    rt_real *fbox = (rt_real *)heap.alloc(NUM_BOX * 6 * sizeof(rt_real));
+    rt_real *ftri = (rt_real *)heap.alloc(NUM_TRI * 9 * sizeof(rt_real));
+    rt_real *fpck = (rt_real *)heap.alloc(GMM_PCK * sizeof(rt_real));
+
+    rt_SIMD_INFOX *thrd = (rt_SIMD_INFOX *)heap.alloc(THR_SIZE *
+                                                      sizeof(rt_SIMD_INFOX));
+
+    rt_ArenaSet<THR_SIZE> tset;
+
+    for (k = 0; k < THR_SIZE; k++)
+    {
+        thr_scr[k] = (rt_real *)tset.arena(k)->alloc(THR_SCR * S *
+                                                     sizeof(rt_real));
+    }
+
+    rt_word *sbuf = (rt_word *)heap.alloc(4 * MAX_SIZE * sizeof(rt_word));
+    rt_word *hbuf = (rt_word *)heap.alloc(THR_SIZE * S * HST_BINS *
+                                          sizeof(rt_word));
+
+    memset(hbuf, 0, THR_SIZE * S * HST_BINS * sizeof(rt_word));
+
+    /* synthetic scene within the range of far0 rays */
+    for (k = 0; k < NUM_BOX; k++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            rt_real c = HSH(MAX_SIZE * 1 + k * 9 + j);
+            rt_real e = HSH(MAX_SIZE * 1 + k * 9 + j + 3);
+
+            fbox[k * 6 + j + 0] = c - RT_FABS(e) / 2.0f - 4.0f;
+            fbox[k * 6 + j + 3] = c + RT_FABS(e) / 2.0f + 4.0f;
+        }
+    }
+
+    for (k = 0; k < NUM_TRI; k++)
+    {
+        for (j = 0; j < 3; j++)
+        {
+            rt_real c = HSH(MAX_SIZE * 2 + k * 9 + j);
+
+            ftri[k * 9 + j + 0] = c;
+            ftri[k * 9 + j + 3] = c + HSH(MAX_SIZE * 2 + k * 9 + j + 3);
+            ftri[k * 9 + j + 6] = c + HSH(MAX_SIZE * 2 + k * 9 + j + 6);
+        }
+    }
+
+    rt_SIMD_INFOX *inf0 = (rt_SIMD_INFOX *)heap.alloc(sizeof(rt_SIMD_INFOX));
 
     RT_SIMD_SET(inf0->gpc01, +1.0f);
     RT_SIMD_SET(inf0->gpc02, -0.5f);
     RT_SIMD_SET(inf0->gpc03, +3.0f);
     RT_SIMD_SET(inf0->gpc04, 0x7FFFFFFF);
     RT_SIMD_SET(inf0->gpc05, 0x3F800000);
+    RT_SIMD_SET(inf0->gpc06, 0x7F800000);
+    RT_SIMD_SET(inf0->gpc07, 0x00007FFF);
+    RT_SIMD_SET(inf0->gpc08, 0x77800000);
+    RT_SIMD_SET(inf0->gpc09, +31743.0f);
+    RT_SIMD_SET(inf0->gpc10, 0x08800000);
+    RT_SIMD_SET(inf0->gpc11, 0x38800000);
+    RT_SIMD_SET(inf0->gpc12, 0x07800000);
+    RT_SIMD_SET(inf0->gpc13, 0x00007C00);
+    RT_SIMD_SET(inf0->gpc14, 0x00000FFF);
+
+    for (k = 0; k < S; k++)
+    {
+        inf0->gpc15[k] = k;
+    }
 
     inf0->far0 = far0;
     inf0->fco1 = fco1;
@@ -1948,20 +10974,85 @@ rt_cell main(rt_cell argc, rt_char *argv[])
     inf0->iso1 = iso1;
     inf0->iso2 = iso2;
 
+    inf0->par0 = par0;
+
+    inf0->dre1 = dre1;
+    inf0->dre2 = dre2;
+
+    inf0->fmat = fmat;
+    inf0->fscr = fscr;
+
+    inf0->fbox = fbox;
+    inf0->ftri = ftri;
+
+    inf0->alpha = -1.25f;
+
+    inf0->fpck = fpck;
+    inf0->thrd = thrd;
+
+    inf0->sbuf = sbuf;
+    inf0->hbuf = hbuf;
+
     inf0->cyc  = CYC_SIZE;
     inf0->size = ARR_SIZE;
 
+#if defined (RT_COUNT)
+
+    inf0->cyc = 1;
+
+    for (k = 0; k < RUN_LEVEL; k++)
+    {
+        inf0->size = run_size[k];
+        s_test[k](inf0);
+    }
+
+    s_rcpnr(inf0);
+    s_rsqnr(inf0);
+    s_cbrnr(inf0);
+
+    cnt_print();
+
+    return 0;
+
+#endif /* RT_COUNT */
+
     rt_time time1 = 0;
     rt_time time2 = 0;
     rt_time tC = 0;
     rt_time tS = 0;
 
-    rt_cell i;
+    rt_cell i, e = 0;
+
+    if (fuzz_runs > 0)
+    {
+        RT_LOGI("Fuzz seed: 0x%08X\n", fuzz_seed);
+    }
 
     for (i = 0; i < RUN_LEVEL; i++)
     {
         RT_LOGI("-----------------  RUN LEVEL = %2d  -----------------\n", i+1);
 
+        inf0->size = run_size[i];
+
+        if (fuzz_runs > 0)
+        {
+            e += fuzz_test(inf0, i) > 0 ? 1 : 0;
+
+            RT_LOGI("----------------------------------------------------\n");
+            continue;
+        }
+
+        if (bench_size > 0)
+        {
+            if (b_test[i].unit != RT_NULL)
+            {
+                bench_test(inf0, i);
+            }
+
+            RT_LOGI("----------------------------------------------------\n");
+            continue;
+        }
+
         time1 = get_time();
 
         c_test[i](inf0);
@@ -1984,11 +11075,25 @@ rt_cell main(rt_cell argc, rt_char *argv[])
 
         p_test[i](inf0);
 
+        e += ulp_test(inf0, i);
+
         RT_LOGI("----------------------------------------------------\n");
     }
 
-    free(info);
-    free(marr);
+    if (n_mode)
+    {
+        nr_table(inf0);
+    }
+
+#if RUN_LEVEL >= 40
+    if (h_mode)
+    {
+        hist_table(inf0);
+    }
+#endif /* RUN_LEVEL 40 */
+
+    tset.release();
+    heap.release();
 
 #if   defined (RT_WIN32) /* Win32, MSVC ------------------------------------- */
 
@@ -1998,7 +11103,7 @@ rt_cell main(rt_cell argc, rt_char *argv[])
 
 #endif /* ------------- OS specific ----------------------------------------- */
 
-    return 0;
+    return e > 0 ? 1 : 0;
 }
 
 /******************************************************************************/
@@ -2007,6 +11112,7 @@ rt_cell main(rt_cell argc, rt_char *argv[])
 
 #undef Q /* short name for RT_SIMD_QUADS */
 #undef S /* short name for RT_SIMD_WIDTH */
+#undef P /* short name for RT_POINTER/32 */
 
 #if   defined (RT_WIN32) /* Win32, MSVC ------------------------------------- */
 
@@ -2021,9 +11127,56 @@ rt_time get_time()
     return (rt_time)(tm.QuadPart * 1000 / fr.QuadPart);
 }
 
+struct rt_PARA
+{
+    rt_FUNC_PARA func;
+    rt_pntr data;
+    rt_cell index;
+};
+
+DWORD WINAPI sys_para_run(LPVOID arg)
+{
+    rt_PARA *p = (rt_PARA *)arg;
+    p->func(p->data, p->index);
+    return 0;
+}
+
+/*
+ * Run func(data, k) for k = 0..num-1 in num threads (0 in calling thread),
+ * return when all are done, runs in calling thread if thread fails to start.
+ */
+rt_void sys_para(rt_cell num, rt_FUNC_PARA func, rt_pntr data)
+{
+    rt_PARA para[THR_SIZE];
+    HANDLE thrd[THR_SIZE];
+    rt_cell k;
+
+    for (k = 1; k < num && k < THR_SIZE; k++)
+    {
+        para[k].func  = func;
+        para[k].data  = data;
+        para[k].index = k;
+        thrd[k] = CreateThread(NULL, 0, sys_para_run, &para[k], 0, NULL);
+    }
+
+    func(data, 0);
+
+    for (k = 1; k < num && k < THR_SIZE; k++)
+    {
+        if (thrd[k] == NULL)
+        {
+            func(data, k);
+            continue;
+        }
+        WaitForSingleObject(thrd[k], INFINITE);
+        CloseHandle(thrd[k]);
+    }
+}
+
 #elif defined (RT_LINUX) /* Linux, GCC -------------------------------------- */
 
 #include <sys/time.h>
+#include <pthread.h>
 
 rt_time get_time()
 {
@@ -2032,6 +11185,52 @@ rt_time get_time()
     return (rt_time)(tm.tv_sec * 1000 + tm.tv_usec / 1000);
 }
 
+struct rt_PARA
+{
+    rt_FUNC_PARA func;
+    rt_pntr data;
+    rt_cell index;
+};
+
+rt_pntr sys_para_run(rt_pntr arg)
+{
+    rt_PARA *p = (rt_PARA *)arg;
+    p->func(p->data, p->index);
+    return RT_NULL;
+}
+
+/*
+ * Run func(data, k) for k = 0..num-1 in num threads (0 in calling thread),
+ * return when all are done, runs in calling thread if thread fails to start.
+ */
+rt_void sys_para(rt_cell num, rt_FUNC_PARA func, rt_pntr data)
+{
+    rt_PARA para[THR_SIZE];
+    pthread_t thrd[THR_SIZE];
+    rt_bool done[THR_SIZE];
+    rt_cell k;
+
+    for (k = 1; k < num && k < THR_SIZE; k++)
+    {
+        para[k].func  = func;
+        para[k].data  = data;
+        para[k].index = k;
+        done[k] = pthread_create(&thrd[k], NULL, sys_para_run, &para[k]) != 0;
+    }
+
+    func(data, 0);
+
+    for (k = 1; k < num && k < THR_SIZE; k++)
+    {
+        if (done[k])
+        {
+            func(data, k);
+            continue;
+        }
+        pthread_join(thrd[k], NULL);
+    }
+}
+
 #endif /* ------------- OS specific ----------------------------------------- */
 
 /******************************************************************************/
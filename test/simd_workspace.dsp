@@ -115,8 +115,20 @@ SOURCE=..\core\rtarch_x86_sse.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\core\rtarena.h
+# End Source File
+# Begin Source File
+
 SOURCE=..\core\rtbase.h
 # End Source File
+# Begin Source File
+
+SOURCE=..\core\rtmem.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\core\rtsoa.h
+# End Source File
 # End Group
 # End Target
 # End Project